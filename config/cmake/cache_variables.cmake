@@ -6,6 +6,8 @@ set(JT_ENABLE_AUDIO_TESTS OFF CACHE BOOL "enable unittests that require a displa
 set(JT_ENABLE_CLANG_TIDY OFF CACHE BOOL "enable clang tidy checks")
 set(JT_ENABLE_DEBUG ON CACHE BOOL "enable debug options")
 set(JT_ENABLE_TRACY ON CACHE BOOL "enable tracy options")
+set(JT_ENABLE_TRACE_PROFILER ON CACHE BOOL "enable the built-in chrome trace profiler")
+set(JT_LOG_MAX_LEVEL "" CACHE STRING "highest compiled in log level, e.g. Info. Empty uses Verbose for debug builds, Info otherwise")
 set(JT_ENABLE_LTO_OPTIMIZATION OFF CACHE BOOL "enable final optimization (LTO)")
 
 # if JT_ENABLE_WEB is ON, it is required to use SDL
@@ -24,6 +26,14 @@ if (JT_ENABLE_TRACY)
     add_definitions(-DTRACY_ENABLE)
 endif ()
 
+if (NOT JT_LOG_MAX_LEVEL STREQUAL "")
+    add_definitions(-DJT_LOG_MAX_LEVEL=${JT_LOG_MAX_LEVEL})
+endif ()
+
+if (JT_ENABLE_TRACE_PROFILER)
+    add_definitions(-DJT_ENABLE_TRACE_PROFILER)
+endif ()
+
 if (USE_SFML)
     add_definitions(-DUSE_SFML)
 else ()
@@ -177,3 +177,24 @@ function(jt_link_fmod TGT)
     endif()
 
 endfunction()
+
+# Compile all Tiled json maps in the assets folder into the binary map format (see
+# CompiledMap). Levels without an up to date compiled map are loaded from json at runtime.
+function(jt_compile_levels TGT)
+    file(GLOB LEVEL_FILES CONFIGURE_DEPENDS ${CMAKE_SOURCE_DIR}/assets/*.json)
+    set(COMPILED_LEVEL_FILES)
+    foreach (LEVEL_FILE ${LEVEL_FILES})
+        get_filename_component(LEVEL_NAME ${LEVEL_FILE} NAME_WE)
+        set(COMPILED_LEVEL_FILE ${CMAKE_CURRENT_BINARY_DIR}/assets/${LEVEL_NAME}.jtmap)
+        add_custom_command(OUTPUT ${COMPILED_LEVEL_FILE}
+                COMMAND ${CMAKE_COMMAND} -E make_directory ${CMAKE_CURRENT_BINARY_DIR}/assets
+                COMMAND jt_level_compiler ${LEVEL_FILE} ${COMPILED_LEVEL_FILE}
+                DEPENDS jt_level_compiler ${LEVEL_FILE}
+                WORKING_DIRECTORY ${CMAKE_SOURCE_DIR}
+                COMMENT "Compiling level ${LEVEL_NAME}")
+        list(APPEND COMPILED_LEVEL_FILES ${COMPILED_LEVEL_FILE})
+    endforeach ()
+
+    add_custom_target(${TGT}_levels DEPENDS ${COMPILED_LEVEL_FILES})
+    add_dependencies(${TGT} ${TGT}_levels)
+endfunction()
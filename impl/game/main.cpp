@@ -17,6 +17,9 @@
 #include <input/input_manager.hpp>
 #include <input/keyboard/keyboard_input.hpp>
 #include <input/mouse/mouse_input.hpp>
+#include <input/recording_input_manager.hpp>
+#include <input/replay_input_manager.hpp>
+#include <log/async_logger.hpp>
 #include <log/default_logging.hpp>
 #include <log/log_history.hpp>
 #include <log/logger.hpp>
@@ -26,6 +29,7 @@
 #include <state_manager/state_manager.hpp>
 #include <state_start_with_button.hpp>
 #include <memory>
+#include <string>
 
 std::shared_ptr<jt::GameBase> game;
 
@@ -36,7 +40,25 @@ void gameloop()
     }
 }
 
-int main(int /*argc*/, char* /*argv*/[])
+/// Wrap the input for recording ("--record <file>") or replaying ("--replay <file>") a session.
+/// A replay pins the random seed stored in the recording.
+std::unique_ptr<jt::InputManagerInterface> createInputDecorator(
+    int argc, char* argv[], jt::InputManagerInterface& input)
+{
+    for (int i = 1; i + 1 < argc; ++i) {
+        std::string const argument { argv[i] };
+        if (argument == "--record") {
+            return std::make_unique<jt::RecordingInputManager>(
+                input, argv[i + 1], jt::Random::getSeed());
+        }
+        if (argument == "--replay") {
+            return std::make_unique<jt::ReplayInputManager>(argv[i + 1]);
+        }
+    }
+    return nullptr;
+}
+
+int main(int argc, char* argv[])
 {
     hideConsoleInRelease();
 
@@ -45,9 +67,18 @@ int main(int /*argc*/, char* /*argv*/[])
     auto logHistory = std::make_shared<jt::LogHistory>();
     jt::CacheImpl cache { nullptr, logHistory };
 
+#ifdef JT_ENABLE_WEB
+    // the web build runs without threads
     jt::Logger logger {};
     jt::createDefaultLogTargets(logger);
     logger.addLogTarget(logHistory);
+#else
+    // keep file and console output off the frame. The history is not thread safe and read by the
+    // console every frame, so it is only written from the main thread in logger.update().
+    jt::AsyncLogger logger {};
+    jt::createDefaultLogTargets(logger);
+    logger.addMainThreadLogTarget(logHistory);
+#endif
 
     jt::RenderWindow window { static_cast<unsigned int>(GP::GetWindowSize().x),
         static_cast<unsigned int>(GP::GetWindowSize().y), GP::GameName() };
@@ -56,6 +87,8 @@ int main(int /*argc*/, char* /*argv*/[])
     jt::Camera cam { GP::GetZoom() };
     jt::LoggingCamera loggingCamera { cam, logger };
     jt::GfxImpl gfx { loggingRenderWindow, loggingCamera };
+    // pack sprites into shared atlas pages to reduce texture switches while drawing
+    gfx.textureManager().setAtlasEnabled(true);
 
     auto const mouse = std::make_shared<jt::MouseInput>();
     auto const keyboard = std::make_shared<jt::KeyboardInputSelectedKeys>();
@@ -106,6 +139,7 @@ int main(int /*argc*/, char* /*argv*/[])
     auto const gamepad0 = std::make_shared<jt::GamepadInput>(0);
     auto const gamepad1 = std::make_shared<jt::GamepadInput>(1);
     jt::InputManager input { mouse, keyboard, { gamepad0, gamepad1 } };
+    auto const inputDecorator = createInputDecorator(argc, argv, input);
 
     jt::AudioImpl audio {};
 
@@ -115,8 +149,9 @@ int main(int /*argc*/, char* /*argv*/[])
 
     jt::ActionCommandManager actionCommandManager(logger);
 
+    jt::InputManagerInterface& gameInput = inputDecorator ? *inputDecorator : input;
     game = std::make_shared<jt::Game>(
-        gfx, input, audio, loggingStateManager, logger, actionCommandManager, cache);
+        gfx, gameInput, audio, loggingStateManager, logger, actionCommandManager, cache);
 
     addBasicActionCommands(game);
     game->startGame(gameloop);
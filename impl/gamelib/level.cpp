@@ -5,12 +5,12 @@
 #include <game_interface.hpp>
 #include <math_helper.hpp>
 #include <strutils.hpp>
-#include <tilemap/tileson_loader.hpp>
+#include <tilemap/tileset_info.hpp>
 #include <Box2D/Box2D.h>
 
-Level::Level(std::string const& fileName, std::weak_ptr<jt::Box2DWorldInterface> world)
+Level::Level(std::shared_ptr<LevelData const> data, std::weak_ptr<jt::Box2DWorldInterface> world)
 {
-    m_fileName = fileName;
+    m_data = data;
     m_world = world;
 }
 
@@ -27,20 +27,18 @@ void Level::doCreate()
     m_background->setColor(c);
     m_background->setCamMovementFactor(0.3f);
 
-    jt::tilemap::TilesonLoader loader { getGame()->cache().getTilemapCache(), m_fileName };
-
-    loadLevelSize(loader);
-    loadLevelSettings(loader);
-    loadLevelTileLayer(loader);
-    loadLevelCollisions(loader);
-    loadLevelKillboxes(loader);
-    loadLevelPowerups(loader);
-    loadMovingPlatforms(loader);
+    loadLevelSize();
+    loadLevelSettings();
+    loadLevelTileLayer();
+    loadLevelCollisions();
+    loadLevelKillboxes();
+    loadLevelPowerups();
+    loadMovingPlatforms();
 }
 
-void Level::loadMovingPlatforms(jt::tilemap::TilesonLoader& loader)
+void Level::loadMovingPlatforms()
 {
-    auto const platform_infos = loader.loadObjectsFromLayer("platforms");
+    auto const& platform_infos = m_data->platforms;
 
     std::map<std::string, std::pair<jt::Vector2f, float>> allPositionsInLevel;
     for (auto const& p : platform_infos) {
@@ -95,15 +93,15 @@ void Level::loadMovingPlatforms(jt::tilemap::TilesonLoader& loader)
     }
 }
 
-void Level::loadLevelSize(jt::tilemap::TilesonLoader const& loader)
+void Level::loadLevelSize()
 {
-    auto const sizeInTiles = loader.getMapSizeInTiles();
+    auto const sizeInTiles = m_data->mapSizeInTiles;
     m_levelSizeInPixel = jt::Vector2f { 16.0f * sizeInTiles.x, 16.0f * sizeInTiles.y };
 }
 
-void Level::loadLevelKillboxes(jt::tilemap::TilesonLoader& loader)
+void Level::loadLevelKillboxes()
 {
-    auto const killboxInfos = loader.loadObjectsFromLayer("killboxes");
+    auto const& killboxInfos = m_data->killboxes;
     for (auto const& i : killboxInfos) {
         std::string name { i.name };
         std::string type { "" };
@@ -118,9 +116,9 @@ void Level::loadLevelKillboxes(jt::tilemap::TilesonLoader& loader)
     }
 }
 
-void Level::loadLevelPowerups(jt::tilemap::TilesonLoader& loader)
+void Level::loadLevelPowerups()
 {
-    auto const powerUpInfos = loader.loadObjectsFromLayer("powerups");
+    auto const& powerUpInfos = m_data->powerUps;
     for (auto const& i : powerUpInfos) {
         auto pu = std::make_shared<PowerUp>(i);
         pu->setGameInstance(getGame());
@@ -129,12 +127,10 @@ void Level::loadLevelPowerups(jt::tilemap::TilesonLoader& loader)
     }
 }
 
-void Level::loadLevelCollisions(jt::tilemap::TilesonLoader& loader)
+void Level::loadLevelCollisions()
 {
-    auto tileCollisions = loader.loadCollisionsFromLayer("ground");
-
-    tileCollisions.refineColliders(16);
-    for (auto const& r : tileCollisions.getRects()) {
+    // colliders are refined while loading the level data
+    for (auto const& r : m_data->groundColliders) {
         b2BodyDef bodyDef;
         bodyDef.fixedRotation = true;
         bodyDef.type = b2_staticBody;
@@ -152,15 +148,15 @@ void Level::loadLevelCollisions(jt::tilemap::TilesonLoader& loader)
     }
 }
 
-void Level::loadLevelTileLayer(jt::tilemap::TilesonLoader& loader)
+void Level::loadLevelTileLayer()
 {
-    m_tileLayerGround = std::make_shared<jt::tilemap::TileLayer>(
-        loader.loadTilesFromLayer("ground", textureManager(), "assets/"));
+    m_tileLayerGround = std::make_shared<jt::tilemap::TileLayer>(m_data->groundTiles,
+        jt::tilemap::createTilesetSprites(m_data->tilesets, textureManager()));
 }
 
-void Level::loadLevelSettings(jt::tilemap::TilesonLoader& loader)
+void Level::loadLevelSettings()
 {
-    auto settings = loader.loadObjectsFromLayer("settings");
+    auto const& settings = m_data->settings;
     for (auto const& info : settings) {
 
         if (info.name == "map_settings") {
@@ -264,3 +260,15 @@ void Level::checkIfPlayerIsInPowerup(
 jt::Vector2f Level::getLevelSizeInPixel() const { return m_levelSizeInPixel; }
 
 int Level::getNumberOfInitiallyAvailablePatches() const { return m_initiallyAvailablePatches; }
+
+std::vector<std::string> Level::getNextLevelFileNames() const
+{
+    std::vector<std::string> fileNames;
+    for (auto const& info : m_data->settings) {
+        if (info.name != "exit" || !info.properties.strings.contains("next_level")) {
+            continue;
+        }
+        fileNames.push_back("assets/" + info.properties.strings.at("next_level"));
+    }
+    return fileNames;
+}
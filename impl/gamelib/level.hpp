@@ -1,6 +1,7 @@
 #ifndef JAMTEMPLATE_LEVEL_HPP
 #define JAMTEMPLATE_LEVEL_HPP
 
+#include "level_loader.hpp"
 #include "power_up.hpp"
 #include <box2dwrapper/box2d_object.hpp>
 #include <box2dwrapper/box2d_world_interface.hpp>
@@ -10,12 +11,11 @@
 #include <moving_platform.hpp>
 #include <shape.hpp>
 #include <tilemap/tile_layer.hpp>
-#include <tilemap/tileson_loader.hpp>
 #include <functional>
 
 class Level : public jt::GameObject {
 public:
-    Level(std::string const& fileName, std::weak_ptr<jt::Box2DWorldInterface> world);
+    Level(std::shared_ptr<LevelData const> data, std::weak_ptr<jt::Box2DWorldInterface> world);
     jt::Vector2f getPlayerStart() const;
 
     void checkIfPlayerIsInKillbox(
@@ -31,6 +31,10 @@ public:
 
     int getNumberOfInitiallyAvailablePatches() const;
 
+    /// Get the file names of the levels the exits of this level lead to
+    /// \return the level file names, including the assets folder
+    std::vector<std::string> getNextLevelFileNames() const;
+
 private:
     void doCreate() override;
     void doUpdate(float const elapsed) override;
@@ -39,7 +43,7 @@ private:
     std::shared_ptr<jt::Shape> m_flatColorBackground { nullptr };
     std::shared_ptr<jt::Sprite> m_background { nullptr };
 
-    std::string m_fileName { "" };
+    std::shared_ptr<LevelData const> m_data { nullptr };
     std::weak_ptr<jt::Box2DWorldInterface> m_world {};
 
     std::vector<std::shared_ptr<jt::Box2DObject>> m_colliders {};
@@ -55,13 +59,13 @@ private:
 
     int m_initiallyAvailablePatches { 0 };
 
-    void loadLevelSettings(jt::tilemap::TilesonLoader& loader);
-    void loadLevelTileLayer(jt::tilemap::TilesonLoader& loader);
-    void loadLevelCollisions(jt::tilemap::TilesonLoader& loader);
-    void loadLevelKillboxes(jt::tilemap::TilesonLoader& loader);
-    void loadLevelPowerups(jt::tilemap::TilesonLoader& loader);
-    void loadLevelSize(jt::tilemap::TilesonLoader const& loader);
-    void loadMovingPlatforms(jt::tilemap::TilesonLoader& loader);
+    void loadLevelSettings();
+    void loadLevelTileLayer();
+    void loadLevelCollisions();
+    void loadLevelKillboxes();
+    void loadLevelPowerups();
+    void loadLevelSize();
+    void loadMovingPlatforms();
 };
 
 #endif // JAMTEMPLATE_LEVEL_HPP
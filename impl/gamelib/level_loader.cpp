@@ -0,0 +1,105 @@
+#include "level_loader.hpp"
+#include <tilemap/compiled_map_loader.hpp>
+#include <trace_profiler.hpp>
+#include <exception>
+
+namespace {
+
+// textures used by the objects of every level
+std::vector<std::string> const levelTextureFileNames { "assets/background.aseprite",
+    "assets/goal.aseprite", "assets/soap.aseprite", "assets/patch.aseprite" };
+
+} // namespace
+
+std::shared_ptr<LevelData const> loadLevelData(std::string const& fileName,
+    jt::TilemapCacheInterface& cache, jt::TextureManagerInterface& textureManager)
+{
+    JT_PROFILE_ZONE("loadLevelData");
+    auto data = std::make_shared<LevelData>();
+    data->fileName = fileName;
+
+    auto const loader = jt::tilemap::createTilemapLoader(cache, fileName);
+    data->mapSizeInTiles = loader->getMapSizeInTiles();
+    data->settings = loader->loadObjectsFromLayer("settings");
+    data->killboxes = loader->loadObjectsFromLayer("killboxes");
+    data->powerUps = loader->loadObjectsFromLayer("powerups");
+    data->platforms = loader->loadObjectsFromLayer("platforms");
+    data->groundTiles = loader->loadTileInfosFromLayer("ground");
+    data->tilesets = loader->getTilesets("assets/");
+
+    auto collisions = loader->loadCollisionsFromLayer("ground");
+    collisions.refineColliders(16);
+    data->groundColliders = collisions.getRects();
+
+    for (auto const& tileset : data->tilesets) {
+        textureManager.prepare(tileset.imageFileName);
+    }
+    for (auto const& textureFileName : levelTextureFileNames) {
+        textureManager.prepare(textureFileName);
+    }
+    return data;
+}
+
+LevelLoader::LevelLoader(jt::TilemapCacheInterface& cache,
+    jt::TextureManagerInterface& textureManager, jt::JobSystemInterface& jobSystem)
+    : m_cache { cache }
+    , m_textureManager { textureManager }
+    , m_jobSystem { jobSystem }
+{
+}
+
+void LevelLoader::prefetch(std::string const& fileName)
+{
+    if (fileName.empty() || m_levels.contains(fileName)) {
+        return;
+    }
+    m_levels[fileName] = startLoading(fileName);
+}
+
+std::shared_ptr<LevelData const> LevelLoader::get(std::string const& fileName)
+{
+    JT_PROFILE_ZONE("LevelLoader::get");
+    // the previous level and prefetched levels that were not chosen are not needed anymore. A
+    // running load of a discarded level finishes in the background, its result is dropped.
+    std::erase_if(m_levels, [&fileName](auto const& kvp) { return kvp.first != fileName; });
+
+    auto& entry = m_levels[fileName];
+    if (!entry.data.valid()) {
+        entry = startLoading(fileName);
+    }
+    if (entry.job) {
+        m_jobSystem.wait(entry.job);
+    }
+    return entry.data.get();
+}
+
+bool LevelLoader::contains(std::string const& fileName) const
+{
+    return m_levels.contains(fileName);
+}
+
+std::size_t LevelLoader::getNumberOfLevels() const noexcept { return m_levels.size(); }
+
+LevelLoader::Entry LevelLoader::startLoading(std::string const& fileName)
+{
+    Entry entry {};
+#ifdef JT_ENABLE_WEB
+    // no worker threads in the web build, load when the level is requested
+    entry.data = std::async(std::launch::deferred,
+        [fileName, &cache = m_cache, &textureManager = m_textureManager]() {
+            return loadLevelData(fileName, cache, textureManager);
+        }).share();
+#else
+    auto promise = std::make_shared<std::promise<std::shared_ptr<LevelData const>>>();
+    entry.data = promise->get_future().share();
+    entry.job = m_jobSystem.schedule(
+        [promise, fileName, &cache = m_cache, &textureManager = m_textureManager]() {
+            try {
+                promise->set_value(loadLevelData(fileName, cache, textureManager));
+            } catch (...) {
+                promise->set_exception(std::current_exception());
+            }
+        });
+#endif
+    return entry;
+}
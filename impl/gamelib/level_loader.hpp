@@ -0,0 +1,93 @@
+#ifndef JAMTEMPLATE_LEVEL_LOADER_HPP
+#define JAMTEMPLATE_LEVEL_LOADER_HPP
+
+#include <jobs/job_system_interface.hpp>
+#include <rect.hpp>
+#include <texture_manager_interface.hpp>
+#include <tilemap/info_rect.hpp>
+#include <tilemap/tile_info.hpp>
+#include <tilemap/tilemap_cache_interface.hpp>
+#include <tilemap/tileset_info.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <future>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// Everything a Level is created from. Can be loaded without the main thread, only creating the
+/// drawables (texture upload) and the Box2D bodies is left to Level::doCreate().
+struct LevelData {
+    std::string fileName { "" };
+    jt::Vector2u mapSizeInTiles { 0u, 0u };
+
+    std::vector<jt::tilemap::InfoRect> settings {};
+    std::vector<jt::tilemap::InfoRect> killboxes {};
+    std::vector<jt::tilemap::InfoRect> powerUps {};
+    std::vector<jt::tilemap::InfoRect> platforms {};
+
+    std::vector<jt::tilemap::TileInfo> groundTiles {};
+    std::vector<jt::tilemap::TilesetInfo> tilesets {};
+    /// colliders of the ground layer, already refined
+    std::vector<jt::Rectf> groundColliders {};
+};
+
+/// Load the level data from the map file and decode all textures used by the level, so that they
+/// only need to be uploaded when the level is created.
+/// \param fileName the file name of the json map
+/// \param cache the tilemap cache
+/// \param textureManager the texture manager, only prepare() is called
+/// \return the level data
+std::shared_ptr<LevelData const> loadLevelData(std::string const& fileName,
+    jt::TilemapCacheInterface& cache, jt::TextureManagerInterface& textureManager);
+
+/// Loads levels as jobs on the game's job system. A level can be prefetched while another level is
+/// played, so switching to it does not stall the main thread. In the web build, there are no
+/// worker threads and levels are loaded when they are requested.
+class LevelLoader {
+public:
+    /// Constructor. Cache, texture manager and job system need to outlive the level loader.
+    /// \param cache the tilemap cache
+    /// \param textureManager the texture manager
+    /// \param jobSystem the job system levels are loaded on
+    LevelLoader(jt::TilemapCacheInterface& cache, jt::TextureManagerInterface& textureManager,
+        jt::JobSystemInterface& jobSystem);
+
+    /// Start loading a level in the background. Does nothing if the level is already loaded or
+    /// being loaded.
+    /// \param fileName the file name of the json map
+    void prefetch(std::string const& fileName);
+
+    /// Get the data of a level. Waits for a running background load (executing other jobs
+    /// meanwhile) or loads the level synchronously if it was not prefetched. All other levels are
+    /// discarded, including prefetched levels that were never requested, so prefetch the next
+    /// levels after calling get().
+    /// \param fileName the file name of the json map
+    /// \return the level data
+    std::shared_ptr<LevelData const> get(std::string const& fileName);
+
+    /// Check if a level was prefetched or requested before
+    /// \param fileName the file name of the json map
+    /// \return true if the level is loaded or being loaded
+    bool contains(std::string const& fileName) const;
+
+    /// Get the number of levels loaded or being loaded
+    /// \return number of levels
+    std::size_t getNumberOfLevels() const noexcept;
+
+private:
+    jt::TilemapCacheInterface& m_cache;
+    jt::TextureManagerInterface& m_textureManager;
+    jt::JobSystemInterface& m_jobSystem;
+    struct Entry {
+        std::shared_future<std::shared_ptr<LevelData const>> data {};
+        // job that fulfills data, nullptr if data is deferred
+        jt::JobHandle job { nullptr };
+    };
+    std::map<std::string, Entry> m_levels {};
+
+    Entry startLoading(std::string const& fileName);
+};
+
+#endif // JAMTEMPLATE_LEVEL_LOADER_HPP
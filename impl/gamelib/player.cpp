@@ -11,7 +11,7 @@
 #include <user_data_entries.hpp>
 
 Player::Player(std::shared_ptr<jt::Box2DWorldInterface> world,
-    std::weak_ptr<jt::ParticleSystem<jt::Animation, 200>> exhaustParticleSFstem)
+    std::weak_ptr<jt::BatchedParticleSystem> exhaustParticleSFstem)
     : m_exhaustParticleSystem { exhaustParticleSFstem }
 {
     b2BodyDef bodyDef;
@@ -5,7 +5,7 @@
 #include <animation.hpp>
 #include <box2dwrapper/box2d_object.hpp>
 #include <game_object.hpp>
-#include <particle_system.hpp>
+#include <batched_particle_system.hpp>
 #include <shape.hpp>
 #include <Box2D/Box2D.h>
 #include <memory>
@@ -14,7 +14,7 @@ class Player : public jt::GameObject {
 public:
     using Sptr = std::shared_ptr<Player>;
     Player(std::shared_ptr<jt::Box2DWorldInterface> world,
-        std::weak_ptr<jt::ParticleSystem<jt::Animation, 200>> exhaustParticleSFstem);
+        std::weak_ptr<jt::BatchedParticleSystem> exhaustParticleSFstem);
 
     ~Player() override;
 
@@ -45,7 +45,7 @@ private:
     std::shared_ptr<jt::Shape> m_indicator;
     std::shared_ptr<jt::Shape> m_punctureIndicator;
     std::shared_ptr<jt::Box2DObject> m_physicsObject;
-    std::weak_ptr<jt::ParticleSystem<jt::Animation, 200>> m_exhaustParticleSystem;
+    std::weak_ptr<jt::BatchedParticleSystem> m_exhaustParticleSystem;
 
     b2Fixture* m_bubbleSensorFixture { nullptr };
 
@@ -8,12 +8,16 @@
 #include <game_interface.hpp>
 #include <game_properties.hpp>
 #include <input/input_manager.hpp>
+#include <math_helper.hpp>
 #include <random/random.hpp>
 #include <state_menu.hpp>
 #include <tweens/tween_alpha.hpp>
-#include <tweens/tween_position.hpp>
 
-StateGame::StateGame(std::string const& levelName) { m_levelName = levelName; }
+StateGame::StateGame(std::string const& levelName, std::shared_ptr<LevelLoader> levelLoader)
+{
+    m_levelName = levelName;
+    m_levelLoader = levelLoader;
+}
 
 void StateGame::onCreate()
 {
@@ -27,28 +31,25 @@ void StateGame::onCreate()
     add(m_hud);
     loadLevel();
 
-    m_particlesBubbleExhaust = jt::ParticleSystem<jt::Animation, 200>::createPS(
-        [this]() {
-            auto a = std::make_shared<jt::Animation>();
-            a->loadFromAseprite("assets/particles.aseprite", textureManager());
-
-            a->play(std::to_string(jt::Random::getInt(0, 6)));
-
-            a->setPosition({ -2000, -2000 });
-            a->setOrigin(jt::OriginMode::CENTER);
-            return a;
-        },
-        [this](auto& a, auto pos) {
-            a->setPosition(pos);
-            a->update(0.0f);
+    m_particlesBubbleExhaust = std::make_shared<jt::BatchedParticleSystem>(
+        200u, [this](jt::ParticleProperties& p, jt::Vector2f const& pos) {
             auto const playerPosition = this->m_player->getAnimation()->getPosition();
             auto direction = pos - playerPosition;
             jt::MathHelper::normalizeMe(direction);
-            add(jt::TweenPosition::create(
-                a, 1.0, pos, pos + direction * 20 + jt::Random::getRandomPointInCircle(8)));
-            add(jt::TweenAlpha::create(a, 1.0, 255, 0));
-            add(jt::TweenScale::create(a, 1.0, { .5, .5 }, { 1.0, 1.0 }));
+            auto const lifetime = 1.0f;
+            p.position = pos;
+            p.velocity
+                = (direction * 20 + jt::Random::getRandomPointInCircle(8)) * (1.0f / lifetime);
+            p.lifetime = lifetime;
+            p.colorEnd = jt::Color { 255, 255, 255, 0 };
+            p.scaleStart = jt::Vector2f { 0.5f, 0.5f };
+            p.scaleEnd = jt::Vector2f { 1.0f, 1.0f };
+            // particles.aseprite has the animation tags "0" to "6"
+            p.frames = m_particlesBubbleExhaust->getFrameRange(
+                std::to_string(jt::Random::getInt(0, 6)));
         });
+    m_particlesBubbleExhaust->addFramesFromAseprite(
+        "assets/particles.aseprite", textureManager());
     add(m_particlesBubbleExhaust);
 
     createPlayer();
@@ -110,11 +111,20 @@ void StateGame::clampCameraToScreen()
 
 void StateGame::loadLevel()
 {
-    m_level = std::make_shared<Level>("assets/" + m_levelName, m_world);
+    if (!m_levelLoader) {
+        m_levelLoader = std::make_shared<LevelLoader>(
+            getGame()->cache().getTilemapCache(), textureManager(), getGame()->jobSystem());
+    }
+    m_level = std::make_shared<Level>(m_levelLoader->get("assets/" + m_levelName), m_world);
     add(m_level);
     m_hud->setPatches(m_level->getNumberOfInitiallyAvailablePatches());
 
     clampCameraToScreen();
+
+    // load the next level in the background while this one is played
+    for (auto const& fileName : m_level->getNextLevelFileNames()) {
+        m_levelLoader->prefetch(fileName);
+    }
 }
 
 void StateGame::onUpdate(float const elapsed)
@@ -185,7 +195,8 @@ void StateGame::restartLevel()
         auto const tween
             = jt::TweenAlpha::create(m_overlay, 1.0f, std::uint8_t { 0 }, std::uint8_t { 255 });
         tween->addCompleteCallback([this]() {
-            getGame()->stateManager().switchState(std::make_shared<StateGame>(m_levelName));
+            getGame()->stateManager().switchState(
+                std::make_shared<StateGame>(m_levelName, m_levelLoader));
         });
         add(tween);
     }
@@ -198,7 +209,8 @@ void StateGame::transitionToLevel(std::string const& newLevelName)
         auto const tween
             = jt::TweenAlpha::create(m_overlay, 1.0f, std::uint8_t { 0 }, std::uint8_t { 255 });
         tween->addCompleteCallback([this, newLevelName]() {
-            getGame()->stateManager().switchState(std::make_shared<StateGame>(newLevelName));
+            getGame()->stateManager().switchState(
+                std::make_shared<StateGame>(newLevelName, m_levelLoader));
         });
         add(tween);
     }
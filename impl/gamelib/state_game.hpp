@@ -8,7 +8,8 @@
 #include <contact_callback_player_ground.hpp>
 #include <game_state.hpp>
 #include <level.hpp>
-#include <particle_system.hpp>
+#include <level_loader.hpp>
+#include <batched_particle_system.hpp>
 #include <player.hpp>
 #include <screeneffects/vignette.hpp>
 #include <shape.hpp>
@@ -17,16 +18,22 @@
 
 class StateGame : public jt::GameState {
 public:
-    explicit StateGame(std::string const& levelName = "level_01.json");
+    /// Constructor
+    /// \param levelName the file name of the level in the assets folder
+    /// \param levelLoader the level loader, e.g. from the previous state so that prefetched levels
+    /// are reused. A new level loader is created if nullptr.
+    explicit StateGame(std::string const& levelName = "level_01.json",
+        std::shared_ptr<LevelLoader> levelLoader = nullptr);
 
 private:
     std::shared_ptr<jt::Box2DWorldInterface> m_world { nullptr };
-    std::shared_ptr<jt::ParticleSystem<jt::Animation, 200>> m_particlesBubbleExhaust;
+    std::shared_ptr<jt::BatchedParticleSystem> m_particlesBubbleExhaust;
 
     std::string m_levelName { "" };
 
     std::shared_ptr<Hud> m_hud { nullptr };
 
+    std::shared_ptr<LevelLoader> m_levelLoader { nullptr };
     std::shared_ptr<Level> m_level { nullptr };
     std::shared_ptr<Player> m_player { nullptr };
     std::shared_ptr<jt::Shape> m_overlay { nullptr };
@@ -0,0 +1,23 @@
+#ifndef JAMTEMPLATE_HEADLESS_BENCH_LEGACY_PATHFINDER_HPP
+#define JAMTEMPLATE_HEADLESS_BENCH_LEGACY_PATHFINDER_HPP
+
+#include <pathfinder/node_interface.hpp>
+#include <memory>
+#include <vector>
+
+namespace legacy {
+
+/// jt::pathfinder::calculatePath as it was before the A* rewrite: linear scan over an open list
+/// that is copied on every step, nodes ranked by distance to start. Only kept as reference for
+/// the pathfinder benchmark, without the console output for missing paths. Visits and sets values
+/// on the nodes, so all nodes need to be reset before every call.
+/// \param start the start node
+/// \param end the end node
+/// \return the nodes of the path from start to end. Empty if start == end or no path exists.
+std::vector<std::shared_ptr<jt::pathfinder::NodeInterface>> calculatePath(
+    std::shared_ptr<jt::pathfinder::NodeInterface> const& start,
+    std::shared_ptr<jt::pathfinder::NodeInterface> const& end);
+
+} // namespace legacy
+
+#endif // JAMTEMPLATE_HEADLESS_BENCH_LEGACY_PATHFINDER_HPP
@@ -0,0 +1,448 @@
+#include "particle_benchmark.hpp"
+#include "pathfinder_benchmark.hpp"
+#include "state_game.hpp"
+#include <action_commands/action_command_manager.hpp>
+#include <audio/audio/audio_null.hpp>
+#include <cache/cache_impl.hpp>
+#include <game_base.hpp>
+#include <game_object_collection.hpp>
+#include <graphics/gfx_null.hpp>
+#include <graphics/logging_render_window.hpp>
+#include <input/gamepad/gamepad_input.hpp>
+#include <input/input_manager.hpp>
+#include <log/async_logger.hpp>
+#include <log/log_history_null.hpp>
+#include <log/log_target_file.hpp>
+#include <log/logger.hpp>
+#include <log/logger_null.hpp>
+#include <logging_camera.hpp>
+#include <nlohmann.hpp>
+#include <random/random.hpp>
+#include <state_manager/logging_state_manager.hpp>
+#include <state_manager/state_manager.hpp>
+#include <trace_profiler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct BenchOptions {
+    /// "game" runs StateGame, "particles" and "legacy-particles" run StateParticleBenchmark with
+    /// the frame loop of the game, all other names run a micro benchmark instead
+    std::string benchmarkName { "game" };
+    std::string levelName { "bubble_test_level.json" };
+    std::size_t numberOfFrames { 3600u };
+    float timestep { 1.0f / 60.0f };
+    unsigned int seed { 1337u };
+    std::string outputFileName { "" };
+    std::string traceFileName { "" };
+    /// "null", "sync" or "async". The sync and async loggers also enable the logging decorators.
+    std::string loggerName { "null" };
+    std::string logLevelName { "info" };
+    /// number of additional objects that are updated in the parallel simulate phase. Enables the
+    /// phased object update of the state if not 0.
+    std::size_t numberOfParallelObjects { 0u };
+    /// number of queries per map size for the pathfinder benchmark
+    std::size_t numberOfQueries { 16u };
+};
+
+struct FrameTiming {
+    float updateTimeInSeconds { 0.0f };
+    float drawTimeInSeconds { 0.0f };
+    std::size_t numberOfAliveGameObjects { 0u };
+    std::size_t numberOfObjectsInState { 0u };
+    jt::GameObjectUpdateTimings objectUpdate {};
+};
+
+/// Game without a game loop of its own. Every frame runs exactly one update with a fixed
+/// timestep and one draw, so the results do not depend on the speed of the machine.
+class HeadlessGame : public jt::GameBase {
+public:
+    using jt::GameBase::GameBase;
+
+    void startGame(GameLoopFunctionPtr /*gameloop_function*/) override { }
+
+    FrameTiming runFixedFrame(float timestep)
+    {
+        m_logger.update();
+        m_actionCommandManager.update();
+
+        FrameTiming timing {};
+        auto const updateStart = std::chrono::steady_clock::now();
+        update(timestep);
+        auto const drawStart = std::chrono::steady_clock::now();
+        draw();
+        auto const drawEnd = std::chrono::steady_clock::now();
+
+        timing.updateTimeInSeconds = std::chrono::duration<float>(drawStart - updateStart).count();
+        timing.drawTimeInSeconds = std::chrono::duration<float>(drawEnd - drawStart).count();
+        timing.numberOfAliveGameObjects = getNumberOfAliveGameObjects();
+        auto const state = m_stateManager.getCurrentState();
+        timing.numberOfObjectsInState = state ? state->getNumberOfObjects() : 0u;
+        if (state && state->getParallelUpdateObjects()) {
+            timing.objectUpdate = state->getObjectUpdateTimings();
+        }
+        return timing;
+    }
+};
+
+/// Object with an independent, moderately expensive update, used to measure the parallel simulate
+/// phase. The serial commit phase adds the result to a shared checksum, which only stays the same
+/// across runs if both phases are correct.
+class OrbitingObject : public jt::GameObject {
+public:
+    OrbitingObject(std::size_t index, double& checksum)
+        : m_angle { static_cast<float>(index) * 0.01f }
+        , m_radius { 10.0f + static_cast<float>(index % 100u) }
+        , m_checksum { checksum }
+    {
+    }
+
+    bool canSimulateInParallel() const override { return true; }
+
+private:
+    float m_angle { 0.0f };
+    float m_radius { 0.0f };
+    jt::Vector2f m_position { 0.0f, 0.0f };
+    double& m_checksum;
+
+    void doSimulate(float const elapsed) override
+    {
+        // a few substeps to give each object a noticeable amount of work
+        for (auto i = 0; i != 16; ++i) {
+            m_angle += elapsed / 16.0f * 100.0f / m_radius;
+            m_position = jt::Vector2f { std::cos(m_angle), std::sin(m_angle) } * m_radius;
+        }
+    }
+
+    void doCommit(float const /*elapsed*/) override
+    {
+        m_checksum += static_cast<double>(m_position.x + m_position.y);
+    }
+};
+
+/// Gfx that wraps window and camera in the logging decorators, like the game does
+class LoggingGfx : public jt::GfxInterface {
+public:
+    LoggingGfx(jt::GfxInterface& decoratee, jt::LoggerInterface& logger)
+        : m_decoratee { decoratee }
+        , m_window { decoratee.window(), logger }
+        , m_camera { decoratee.camera(), logger }
+    {
+    }
+
+    jt::RenderWindowInterface& window() override { return m_window; }
+    jt::CamInterface& camera() override { return m_camera; }
+    std::shared_ptr<jt::RenderTargetInterface> target() override { return m_decoratee.target(); }
+    jt::TextureManagerInterface& textureManager() override
+    {
+        return m_decoratee.textureManager();
+    }
+
+    void reset() override { m_decoratee.reset(); }
+    void update(float elapsed) override { m_decoratee.update(elapsed); }
+    void clear() override { m_decoratee.clear(); }
+    void display() override { m_decoratee.display(); }
+    void createZLayer(int z) override { m_decoratee.createZLayer(z); }
+    jt::CompositorStats getCompositorStats() const override
+    {
+        return m_decoratee.getCompositorStats();
+    }
+
+private:
+    jt::GfxInterface& m_decoratee;
+    jt::LoggingRenderWindow m_window;
+    jt::LoggingCamera m_camera;
+};
+
+/// Scripted gamepad input. The left stick slowly turns around, the bubble is punctured and
+/// patched in a fixed rhythm, so every run sees the same input.
+class InputScript {
+public:
+    void setFrame(std::size_t frame) noexcept { m_frame = frame; }
+
+    jt::Vector2f axis(jt::GamepadAxisCode code) const
+    {
+        if (code._value != jt::GamepadAxisCode::ALeft) {
+            return jt::Vector2f { 0.0f, 0.0f };
+        }
+        // one turn every four seconds at 60 fps, raw axis values range from -100 to 100
+        auto const angle
+            = static_cast<float>(m_frame % 240u) / 240.0f * 2.0f * std::numbers::pi_v<float>;
+        return jt::Vector2f { std::cos(angle) * 100.0f, std::sin(angle) * 100.0f };
+    }
+
+    bool button(jt::GamepadButtonCode code) const
+    {
+        if (code._value == jt::GamepadButtonCode::GBA) {
+            return m_frame % 90u < 5u;
+        }
+        if (code._value == jt::GamepadButtonCode::GBB) {
+            return m_frame % 200u >= 100u && m_frame % 200u < 105u;
+        }
+        return false;
+    }
+
+private:
+    std::size_t m_frame { 0u };
+};
+
+void printUsage(std::string const& programName)
+{
+    std::cerr << "usage: " << programName
+              << " [--benchmark <game|particles|legacy-particles|pathfinder>]"
+                 " [--queries <n>]"
+                 " [--level <file>] [--frames <n>] [--timestep <seconds>] [--seed <n>]"
+                 " [--output <file>] [--trace <file>] [--logger <null|sync|async>]"
+                 " [--log-level <fatal|error|warning|info|debug|verbose>]"
+                 " [--parallel-objects <n>]"
+              << std::endl;
+}
+
+std::optional<jt::LogLevel> getLogLevel(std::string const& name)
+{
+    std::map<std::string, jt::LogLevel> const levels { { "fatal", jt::LogLevel::Fatal },
+        { "error", jt::LogLevel::Error }, { "warning", jt::LogLevel::Warning },
+        { "info", jt::LogLevel::Info }, { "debug", jt::LogLevel::Debug },
+        { "verbose", jt::LogLevel::Verbose } };
+    auto const level = levels.find(name);
+    if (level == levels.end()) {
+        return std::nullopt;
+    }
+    return level->second;
+}
+
+bool parseOptions(int argc, char* argv[], BenchOptions& options)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string const argument { argv[i] };
+        if (i + 1 == argc) {
+            return false;
+        }
+        std::string const value { argv[++i] };
+        if (argument == "--benchmark") {
+            options.benchmarkName = value;
+        } else if (argument == "--queries") {
+            options.numberOfQueries = std::stoul(value);
+        } else if (argument == "--level") {
+            // levels are loaded from the assets folder, accept both "assets/x.json" and "x.json"
+            std::string const prefix { "assets/" };
+            options.levelName = value.starts_with(prefix) ? value.substr(prefix.size()) : value;
+        } else if (argument == "--frames") {
+            options.numberOfFrames = std::stoul(value);
+        } else if (argument == "--timestep") {
+            options.timestep = std::stof(value);
+        } else if (argument == "--seed") {
+            options.seed = static_cast<unsigned int>(std::stoul(value));
+        } else if (argument == "--output") {
+            options.outputFileName = value;
+        } else if (argument == "--trace") {
+            options.traceFileName = value;
+        } else if (argument == "--logger") {
+            options.loggerName = value;
+        } else if (argument == "--log-level") {
+            options.logLevelName = value;
+        } else if (argument == "--parallel-objects") {
+            options.numberOfParallelObjects = std::stoul(value);
+        } else {
+            return false;
+        }
+    }
+    return (options.benchmarkName == "game" || options.benchmarkName == "particles"
+               || options.benchmarkName == "legacy-particles"
+               || options.benchmarkName == "pathfinder")
+        && options.numberOfQueries != 0u && options.numberOfFrames != 0u && options.timestep > 0.0f
+        && getLogLevel(options.logLevelName).has_value()
+        && (options.loggerName == "null" || options.loggerName == "sync"
+            || options.loggerName == "async");
+}
+
+std::unique_ptr<jt::LoggerInterface> createLogger(BenchOptions const& options)
+{
+    std::unique_ptr<jt::LoggerInterface> logger;
+    if (options.loggerName == "sync") {
+        logger = std::make_unique<jt::Logger>();
+    } else if (options.loggerName == "async") {
+        logger = std::make_unique<jt::AsyncLogger>();
+    } else {
+        return std::make_unique<jt::null_objects::LoggerNull>();
+    }
+    logger->addLogTarget(std::make_shared<jt::LogTargetFile>());
+    logger->setLogLevel(getLogLevel(options.logLevelName).value());
+    return logger;
+}
+
+nlohmann::json createSummary(std::vector<float> values)
+{
+    std::sort(values.begin(), values.end());
+    auto const percentile = [&values](float p) {
+        auto const index = static_cast<std::size_t>(
+            std::ceil(p / 100.0f * static_cast<float>(values.size())));
+        return values[std::clamp<std::size_t>(index, 1u, values.size()) - 1u] * 1000.0f;
+    };
+    float sum { 0.0f };
+    for (auto const v : values) {
+        sum += v;
+    }
+
+    nlohmann::json j;
+    j["meanMs"] = sum / static_cast<float>(values.size()) * 1000.0f;
+    j["minMs"] = values.front() * 1000.0f;
+    j["p50Ms"] = percentile(50.0f);
+    j["p90Ms"] = percentile(90.0f);
+    j["p99Ms"] = percentile(99.0f);
+    j["maxMs"] = values.back() * 1000.0f;
+    return j;
+}
+
+nlohmann::json createReport(BenchOptions const& options, std::vector<FrameTiming> const& frames,
+    float totalTimeInSeconds, double parallelObjectChecksum)
+{
+    std::vector<float> updateTimes;
+    std::vector<float> drawTimes;
+    std::vector<float> frameTimes;
+    std::vector<float> simulateTimes;
+    std::vector<float> commitTimes;
+    nlohmann::json perFrame = nlohmann::json::array();
+    for (auto const& f : frames) {
+        updateTimes.push_back(f.updateTimeInSeconds);
+        drawTimes.push_back(f.drawTimeInSeconds);
+        frameTimes.push_back(f.updateTimeInSeconds + f.drawTimeInSeconds);
+        simulateTimes.push_back(f.objectUpdate.simulateTimeInSeconds);
+        commitTimes.push_back(f.objectUpdate.commitTimeInSeconds);
+        perFrame.push_back(nlohmann::json { { "updateMs", f.updateTimeInSeconds * 1000.0f },
+            { "drawMs", f.drawTimeInSeconds * 1000.0f },
+            { "aliveGameObjects", f.numberOfAliveGameObjects },
+            { "objectsInState", f.numberOfObjectsInState },
+            { "parallelObjects", f.objectUpdate.numberOfParallelObjects } });
+    }
+
+    nlohmann::json j;
+    j["benchmark"] = options.benchmarkName;
+    if (options.benchmarkName == "game") {
+        j["level"] = options.levelName;
+    } else {
+        j["particles"] = StateParticleBenchmark::numberOfParticles;
+    }
+    j["frames"] = frames.size();
+    j["timestep"] = options.timestep;
+    j["seed"] = options.seed;
+    j["logger"] = options.loggerName;
+    j["logLevel"] = options.logLevelName;
+    j["totalTimeSeconds"] = totalTimeInSeconds;
+    j["framesPerSecond"] = static_cast<float>(frames.size()) / totalTimeInSeconds;
+    j["update"] = createSummary(updateTimes);
+    j["draw"] = createSummary(drawTimes);
+    j["frame"] = createSummary(frameTimes);
+    if (options.numberOfParallelObjects != 0u) {
+        j["parallelObjects"] = options.numberOfParallelObjects;
+        j["parallelObjectChecksum"] = parallelObjectChecksum;
+        j["simulate"] = createSummary(simulateTimes);
+        j["commit"] = createSummary(commitTimes);
+    }
+    j["perFrame"] = perFrame;
+    return j;
+}
+
+void writeReport(BenchOptions const& options, nlohmann::json const& report)
+{
+    if (options.outputFileName.empty()) {
+        std::cout << report.dump(2) << std::endl;
+    } else {
+        std::ofstream file { options.outputFileName };
+        file << report.dump(2) << std::endl;
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    BenchOptions options {};
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    jt::Random::setSeed(options.seed);
+    if (!options.traceFileName.empty()) {
+        // the trace is written when the program exits, so it also covers an early exit
+        jt::TraceProfiler::setThreadName("main");
+        jt::TraceProfiler::writeChromeTraceAtExit(options.traceFileName);
+        jt::TraceProfiler::setEnabled(true);
+    }
+
+    if (options.benchmarkName == "pathfinder") {
+        nlohmann::json report;
+        report["benchmark"] = options.benchmarkName;
+        report["seed"] = options.seed;
+        report["maps"] = runPathfinderBenchmark(options.numberOfQueries);
+        writeReport(options, report);
+        return 0;
+    }
+
+    auto const logger = createLogger(options);
+    auto const useLoggingDecorators = options.loggerName != "null";
+    jt::CacheImpl cache { nullptr, std::make_shared<jt::null_objects::LogHistoryNull>() };
+    jt::null_objects::GfxNull gfxNull {};
+    LoggingGfx loggingGfx { gfxNull, *logger };
+    jt::GfxInterface& gfx = useLoggingDecorators ? static_cast<jt::GfxInterface&>(loggingGfx)
+                                                 : static_cast<jt::GfxInterface&>(gfxNull);
+
+    InputScript script {};
+    auto const gamepad = std::make_shared<jt::GamepadInput>(
+        0, [&script](auto code) { return script.axis(code); },
+        [&script](auto code) { return script.button(code); });
+    jt::InputManager input { nullptr, nullptr, { gamepad } };
+
+    jt::null_objects::AudioNull audio {};
+    std::shared_ptr<jt::GameState> initialState { nullptr };
+    if (options.benchmarkName == "game") {
+        initialState = std::make_shared<StateGame>(options.levelName);
+    } else {
+        initialState = std::make_shared<StateParticleBenchmark>(
+            options.benchmarkName == "legacy-particles");
+    }
+    jt::StateManager stateManager { initialState };
+    jt::LoggingStateManager loggingStateManager { stateManager, *logger };
+    jt::StateManagerInterface& gameStateManager = useLoggingDecorators
+        ? static_cast<jt::StateManagerInterface&>(loggingStateManager)
+        : static_cast<jt::StateManagerInterface&>(stateManager);
+    jt::ActionCommandManager actionCommandManager { *logger };
+
+    auto const game = std::make_shared<HeadlessGame>(
+        gfx, input, audio, gameStateManager, *logger, actionCommandManager, cache);
+
+    double parallelObjectChecksum { 0.0 };
+    std::vector<FrameTiming> frames;
+    frames.reserve(options.numberOfFrames);
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t frame = 0u; frame != options.numberOfFrames; ++frame) {
+        script.setFrame(frame);
+        JT_PROFILE_FRAME_MARK;
+        frames.push_back(game->runFixedFrame(options.timestep));
+        if (frame == 0u && options.numberOfParallelObjects != 0u) {
+            // the state is created in the first frame, objects can only be added afterwards
+            auto const state = gameStateManager.getCurrentState();
+            state->setParallelUpdateObjects(true);
+            for (std::size_t i = 0u; i != options.numberOfParallelObjects; ++i) {
+                state->add(std::make_shared<OrbitingObject>(i, parallelObjectChecksum));
+            }
+        }
+    }
+    auto const totalTimeInSeconds
+        = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+
+    writeReport(options, createReport(options, frames, totalTimeInSeconds, parallelObjectChecksum));
+    return 0;
+}
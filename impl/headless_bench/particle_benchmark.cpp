@@ -0,0 +1,99 @@
+#include "particle_benchmark.hpp"
+#include <random/random.hpp>
+#include <tweens/tween_alpha.hpp>
+#include <tweens/tween_position.hpp>
+#include <tweens/tween_scale.hpp>
+#include <string>
+
+namespace {
+
+std::string const particleFileName { "assets/particles.aseprite" };
+
+jt::Vector2f getSpawnPosition() { return jt::Random::getRandomPointIn(jt::Vector2f { 400, 300 }); }
+
+jt::Vector2f getDirection() { return jt::Random::getRandomPointOnCircle(1.0f); }
+
+} // namespace
+
+StateParticleBenchmark::StateParticleBenchmark(bool useLegacyParticleSystem)
+    : m_useLegacyParticleSystem { useLegacyParticleSystem }
+{
+}
+
+std::string StateParticleBenchmark::getName() const
+{
+    return m_useLegacyParticleSystem ? "LegacyParticleBenchmark" : "ParticleBenchmark";
+}
+
+void StateParticleBenchmark::onCreate()
+{
+    if (m_useLegacyParticleSystem) {
+        createLegacyParticleSystem();
+        add(m_legacyParticles);
+    } else {
+        createBatchedParticleSystem();
+        add(m_batchedParticles);
+    }
+}
+
+void StateParticleBenchmark::createLegacyParticleSystem()
+{
+    // same setup as the bubble exhaust of StateGame before BatchedParticleSystem was added
+    m_legacyParticles = jt::ParticleSystem<jt::Animation, numberOfParticles>::createPS(
+        [this]() {
+            auto a = std::make_shared<jt::Animation>();
+            a->loadFromAseprite(particleFileName, textureManager());
+            a->play(std::to_string(jt::Random::getInt(0, 6)));
+            a->setPosition({ -2000, -2000 });
+            a->setOrigin(jt::OriginMode::CENTER);
+            return a;
+        },
+        [this](auto& a, auto pos) {
+            a->setPosition(pos);
+            a->update(0.0f);
+            add(jt::TweenPosition::create(a, lifetime, pos,
+                pos + getDirection() * 20 + jt::Random::getRandomPointInCircle(8)));
+            add(jt::TweenAlpha::create(a, lifetime, 255, 0));
+            add(jt::TweenScale::create(a, lifetime, { .5, .5 }, { 1.0, 1.0 }));
+        });
+}
+
+void StateParticleBenchmark::createBatchedParticleSystem()
+{
+    m_batchedParticles = std::make_shared<jt::BatchedParticleSystem>(
+        numberOfParticles, [this](jt::ParticleProperties& p, jt::Vector2f const& pos) {
+            p.position = pos;
+            p.velocity
+                = (getDirection() * 20 + jt::Random::getRandomPointInCircle(8)) * (1.0f / lifetime);
+            p.lifetime = lifetime;
+            p.colorEnd = jt::Color { 255, 255, 255, 0 };
+            p.scaleStart = jt::Vector2f { 0.5f, 0.5f };
+            p.scaleEnd = jt::Vector2f { 1.0f, 1.0f };
+            p.frames = m_batchedParticles->getFrameRange(std::to_string(jt::Random::getInt(0, 6)));
+        });
+    m_batchedParticles->addFramesFromAseprite(particleFileName, textureManager());
+}
+
+void StateParticleBenchmark::onEnter() { }
+
+void StateParticleBenchmark::onUpdate(float const elapsed)
+{
+    // fire as many particles per second as die, so numberOfParticles stay alive
+    m_particlesToFire += static_cast<float>(numberOfParticles) * elapsed / lifetime;
+    auto const num = static_cast<unsigned int>(m_particlesToFire);
+    m_particlesToFire -= static_cast<float>(num);
+    fire(num);
+}
+
+void StateParticleBenchmark::fire(unsigned int num)
+{
+    for (auto i = 0u; i != num; ++i) {
+        if (m_useLegacyParticleSystem) {
+            m_legacyParticles->fire(1, getSpawnPosition());
+        } else {
+            m_batchedParticles->fire(1, getSpawnPosition());
+        }
+    }
+}
+
+void StateParticleBenchmark::onDraw() const { }
@@ -0,0 +1,46 @@
+#ifndef JAMTEMPLATE_HEADLESS_BENCH_PARTICLE_BENCHMARK_HPP
+#define JAMTEMPLATE_HEADLESS_BENCH_PARTICLE_BENCHMARK_HPP
+
+#include <animation.hpp>
+#include <batched_particle_system.hpp>
+#include <game_state.hpp>
+#include <particle_system.hpp>
+#include <cstddef>
+#include <memory>
+
+/// State that keeps 50000 particles alive, used to compare BatchedParticleSystem with the
+/// ParticleSystem<Animation> plus tweens setup that StateGame used before. Both variants use the
+/// bubble exhaust particle image and the same motion.
+class StateParticleBenchmark : public jt::GameState {
+public:
+    static constexpr std::size_t numberOfParticles { 50000u };
+    /// lifetime of a particle in seconds
+    static constexpr float lifetime { 1.0f };
+
+    /// Constructor
+    /// \param useLegacyParticleSystem use ParticleSystem<Animation> with tweens instead of
+    /// BatchedParticleSystem
+    explicit StateParticleBenchmark(bool useLegacyParticleSystem);
+
+private:
+    bool m_useLegacyParticleSystem { false };
+    std::shared_ptr<jt::ParticleSystem<jt::Animation, numberOfParticles>> m_legacyParticles {
+        nullptr
+    };
+    std::shared_ptr<jt::BatchedParticleSystem> m_batchedParticles { nullptr };
+    // fractional number of particles that were not fired in the last frame
+    float m_particlesToFire { 0.0f };
+
+    std::string getName() const override;
+
+    void onCreate() override;
+    void onEnter() override;
+    void onUpdate(float const elapsed) override;
+    void onDraw() const override;
+
+    void createLegacyParticleSystem();
+    void createBatchedParticleSystem();
+    void fire(unsigned int num);
+};
+
+#endif // JAMTEMPLATE_HEADLESS_BENCH_PARTICLE_BENCHMARK_HPP
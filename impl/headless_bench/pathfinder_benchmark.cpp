@@ -0,0 +1,150 @@
+#include "pathfinder_benchmark.hpp"
+#include "legacy_pathfinder.hpp"
+#include <pathfinder/grid_pathfinder.hpp>
+#include <pathfinder/navigation_grid.hpp>
+#include <pathfinder/node.hpp>
+#include <pathfinder/pathfinder.hpp>
+#include <random/random.hpp>
+#include <trace_profiler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using NodeT = std::shared_ptr<jt::pathfinder::NodeInterface>;
+
+struct BenchmarkMap {
+    unsigned int size { 0u };
+    std::vector<NodeT> nodes {};
+    std::vector<std::size_t> walkableIndices {};
+};
+
+// Vertical walls every eight columns with a few random gaps, so paths need long detours.
+// Connections are created like NodeLayer does.
+BenchmarkMap createMap(unsigned int size)
+{
+    BenchmarkMap map {};
+    map.size = size;
+    map.nodes.reserve(static_cast<std::size_t>(size) * size);
+    for (auto y = 0u; y != size; ++y) {
+        for (auto x = 0u; x != size; ++x) {
+            auto node = std::make_shared<jt::pathfinder::Node>();
+            node->setPosition(jt::Vector2u { x, y });
+            node->setBlocked(x % 8u == 4u && !jt::Random::getChance(0.05f));
+            if (!node->getBlocked()) {
+                map.walkableIndices.push_back(map.nodes.size());
+            }
+            map.nodes.push_back(node);
+        }
+    }
+
+    for (auto y = 0u; y != size; ++y) {
+        for (auto x = 0u; x != size; ++x) {
+            auto const& node = map.nodes[x + y * size];
+            if (node->getBlocked()) {
+                continue;
+            }
+            for (int j = -1; j != 2; ++j) {
+                for (int i = -1; i != 2; ++i) {
+                    auto const ox = static_cast<int>(x) + i;
+                    auto const oy = static_cast<int>(y) + j;
+                    if ((i == 0 && j == 0) || ox < 0 || oy < 0 || ox >= static_cast<int>(size)
+                        || oy >= static_cast<int>(size)) {
+                        continue;
+                    }
+                    auto const& other = map.nodes[static_cast<std::size_t>(ox + oy * size)];
+                    if (!other->getBlocked()) {
+                        node->addNeighbour(other);
+                    }
+                }
+            }
+        }
+    }
+    return map;
+}
+
+void resetNodes(BenchmarkMap const& map)
+{
+    for (auto const& n : map.nodes) {
+        n->setValue(-1.0f);
+        n->unvisit();
+    }
+}
+
+nlohmann::json runForMapSize(unsigned int size, std::size_t numberOfQueries)
+{
+    JT_PROFILE_ZONE("runPathfinderBenchmark::runForMapSize");
+    auto const map = createMap(size);
+    std::vector<std::pair<std::size_t, std::size_t>> queries;
+    auto const maxIndex = static_cast<int>(map.walkableIndices.size()) - 1;
+    while (queries.size() != numberOfQueries) {
+        auto const start = map.walkableIndices[jt::Random::getInt(0, maxIndex)];
+        auto const end = map.walkableIndices[jt::Random::getInt(0, maxIndex)];
+        if (start != end) {
+            queries.emplace_back(start, end);
+        }
+    }
+
+    std::chrono::duration<double> legacyDuration { 0.0 };
+    std::size_t legacyPaths { 0u };
+    for (auto const& [start, end] : queries) {
+        // the legacy pathfinder needs fresh nodes, resetting them is not part of the measurement
+        resetNodes(map);
+        auto const queryStart = std::chrono::steady_clock::now();
+        legacyPaths += legacy::calculatePath(map.nodes[start], map.nodes[end]).empty() ? 0u : 1u;
+        legacyDuration += std::chrono::steady_clock::now() - queryStart;
+    }
+
+    std::size_t nodeGraphPaths { 0u };
+    auto const nodeGraphStart = std::chrono::steady_clock::now();
+    for (auto const& [start, end] : queries) {
+        nodeGraphPaths
+            += jt::pathfinder::calculatePath(map.nodes[start], map.nodes[end]).empty() ? 0u : 1u;
+    }
+    std::chrono::duration<double> const nodeGraphDuration
+        = std::chrono::steady_clock::now() - nodeGraphStart;
+
+    jt::pathfinder::NavigationGrid const grid { map.nodes };
+    jt::pathfinder::GridPathfinder pathfinder {};
+    std::vector<jt::pathfinder::NavigationGrid::NodeId> path;
+    // warm up, so the scratch memory is allocated before measuring
+    pathfinder.calculatePath(grid, static_cast<jt::pathfinder::NavigationGrid::NodeId>(0u),
+        static_cast<jt::pathfinder::NavigationGrid::NodeId>(map.size - 1u), path);
+    std::size_t gridPaths { 0u };
+    auto const gridStart = std::chrono::steady_clock::now();
+    for (auto const& [start, end] : queries) {
+        auto const found = pathfinder.calculatePath(grid,
+            static_cast<jt::pathfinder::NavigationGrid::NodeId>(start),
+            static_cast<jt::pathfinder::NavigationGrid::NodeId>(end), path);
+        gridPaths += found ? 1u : 0u;
+    }
+    std::chrono::duration<double> const gridDuration = std::chrono::steady_clock::now() - gridStart;
+
+    nlohmann::json j;
+    j["mapSize"] = size;
+    j["walkableTiles"] = map.walkableIndices.size();
+    j["queries"] = queries.size();
+    j["legacyMs"] = legacyDuration.count() * 1000.0;
+    j["nodeGraphMs"] = nodeGraphDuration.count() * 1000.0;
+    j["gridMs"] = gridDuration.count() * 1000.0;
+    j["nodeGraphSpeedup"] = legacyDuration.count() / std::max(nodeGraphDuration.count(), 1.0e-9);
+    j["gridSpeedup"] = legacyDuration.count() / std::max(gridDuration.count(), 1.0e-9);
+    j["legacyPathsFound"] = legacyPaths;
+    j["nodeGraphPathsFound"] = nodeGraphPaths;
+    j["gridPathsFound"] = gridPaths;
+    return j;
+}
+
+} // namespace
+
+nlohmann::json runPathfinderBenchmark(std::size_t numberOfQueries)
+{
+    nlohmann::json j = nlohmann::json::array();
+    for (auto const size : { 64u, 128u, 256u }) {
+        j.push_back(runForMapSize(size, numberOfQueries));
+    }
+    return j;
+}
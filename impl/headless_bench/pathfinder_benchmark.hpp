@@ -0,0 +1,14 @@
+#ifndef JAMTEMPLATE_HEADLESS_BENCH_PATHFINDER_BENCHMARK_HPP
+#define JAMTEMPLATE_HEADLESS_BENCH_PATHFINDER_BENCHMARK_HPP
+
+#include <nlohmann.hpp>
+#include <cstddef>
+
+/// Compare the pathfinder before the A* rewrite (legacy::calculatePath) with
+/// jt::pathfinder::calculatePath and GridPathfinder. All three run the same queries on the same
+/// generated maps with long walls.
+/// \param numberOfQueries number of queries per map size
+/// \return the results as json
+nlohmann::json runPathfinderBenchmark(std::size_t numberOfQueries);
+
+#endif // JAMTEMPLATE_HEADLESS_BENCH_PATHFINDER_BENCHMARK_HPP
@@ -1,6 +1,12 @@
 #include "basic_action_commands.hpp"
 #include <game_base.hpp>
 #include <math_helper.hpp>
+#include <sprite.hpp>
+#include <trace_profiler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
 
 namespace {
 void addCommandHelp(std::shared_ptr<jt::GameBase>& game)
@@ -80,6 +86,58 @@ void addCommandsCam(std::shared_ptr<jt::GameBase>& game)
         }));
 }
 
+// returns the number of sprites constructed per second
+template <typename CreateFunction>
+double measureSpriteConstruction(std::size_t count, CreateFunction const& create)
+{
+    std::vector<std::shared_ptr<jt::Sprite>> sprites {};
+    sprites.reserve(count);
+    auto const start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0u; i != count; ++i) {
+        sprites.push_back(create());
+    }
+    std::chrono::duration<double> const duration = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(count) / std::max(duration.count(), 1.0e-9);
+}
+
+// Compares the sprite construction from before texture handles with the current constructors.
+// The old constructor looked up the image and its flash image by name via get() and took the
+// whole texture, which is what the legacy case does.
+void benchmarkSpriteConstruction(jt::LoggerInterface& logger,
+    jt::TextureManagerInterface& textureManager, std::string const& fileName, std::size_t count)
+{
+    jt::Recti const rect { 0, 0, 1, 1 };
+    // make sure all textures exist, so only the lookups are measured
+    auto const handle = textureManager.getHandle(fileName);
+    textureManager.getRegion(handle);
+    textureManager.get(fileName);
+    textureManager.get(textureManager.getFlashName(fileName));
+
+    auto const legacyRate = measureSpriteConstruction(count, [&]() {
+        auto sprite = std::make_shared<jt::Sprite>();
+        sprite->fromTexture(textureManager.get(fileName));
+        textureManager.get(textureManager.getFlashName(fileName));
+        return sprite;
+    });
+    auto const stringRate = measureSpriteConstruction(count, [&]() {
+        return std::make_shared<jt::Sprite>(fileName, rect, textureManager);
+    });
+    auto const handleRate = measureSpriteConstruction(count, [&]() {
+        return std::make_shared<jt::Sprite>(handle, rect, textureManager);
+    });
+    auto const formatRate = [legacyRate](double rate) {
+        return std::to_string(static_cast<std::uint64_t>(rate)) + " sprites/s (x"
+            + jt::MathHelper::floatToStringWithXDecimalDigits(
+                static_cast<float>(rate / legacyRate), 2)
+            + ")";
+    };
+    logger.action("sprite construction with " + std::to_string(count) + " sprites of '"
+        + fileName + "'");
+    logger.action(" - legacy, get() and fromTexture: " + formatRate(legacyRate));
+    logger.action(" - file name: " + formatRate(stringRate));
+    logger.action(" - handle: " + formatRate(handleRate));
+}
+
 void addCommandTextureManager(std::shared_ptr<jt::GameBase>& game)
 {
     game->storeActionCommand(game->actionCommandManager().registerTemporaryCommand(
@@ -87,6 +145,50 @@ void addCommandTextureManager(std::shared_ptr<jt::GameBase>& game)
         [&logger = game->logger(), &textureManager = game->gfx().textureManager()](auto /*args*/) {
             logger.action(
                 "stored textures: " + std::to_string(textureManager.getNumberOfTextures()));
+            auto const stats = textureManager.getStats();
+            logger.action("atlas pages: " + std::to_string(stats.numberOfPages)
+                + ", packed images: " + std::to_string(stats.numberOfPackedImages)
+                + ", standalone images: " + std::to_string(stats.numberOfStandaloneImages)
+                + ", flash textures: " + std::to_string(stats.numberOfFlashTextures)
+                + ", occupancy: " + std::to_string(stats.getOccupancy())
+                + ", texture binds: " + std::to_string(stats.numberOfTextureBinds) + " of "
+                + std::to_string(stats.numberOfDraws) + " draws");
+            logger.action("deferred flash images: "
+                + std::to_string(stats.numberOfDeferredFlashImages)
+                + ", saved texture bytes: " + std::to_string(stats.savedFlashTextureBytes)
+                + ", mask bytes: " + std::to_string(stats.flashMaskBytes));
+        }));
+    game->storeActionCommand(game->actionCommandManager().registerTemporaryCommand(
+        "textureManagerBenchmark",
+        [&logger = game->logger(), &textureManager = game->gfx().textureManager()](auto args) {
+            if (args.size() > 2) {
+                logger.error("invalid number of arguments, expected [count] [texture]");
+                return;
+            }
+            std::size_t const count = args.empty() ? 10000u : std::stoul(args.at(0));
+            std::string const fileName = args.size() == 2 ? args.at(1) : "#f#16#16";
+            benchmarkSpriteConstruction(logger, textureManager, fileName, count);
+        }));
+}
+
+void addCommandsTrace(std::shared_ptr<jt::GameBase>& game)
+{
+    game->storeActionCommand(game->actionCommandManager().registerTemporaryCommand(
+        "trace.start", [&logger = game->logger()](auto /*args*/) {
+            jt::TraceProfiler::clear();
+            jt::TraceProfiler::setEnabled(true);
+            logger.action("trace recording started");
+        }));
+    game->storeActionCommand(game->actionCommandManager().registerTemporaryCommand(
+        "trace.stop", [&logger = game->logger()](auto args) {
+            if (args.size() > 1) {
+                logger.error("invalid number of arguments");
+                return;
+            }
+            jt::TraceProfiler::setEnabled(false);
+            auto const fileName = args.empty() ? std::string { "trace.json" } : args.at(0);
+            jt::TraceProfiler::writeChromeTrace(fileName);
+            logger.action("trace written to " + fileName);
         }));
 }
 
@@ -103,5 +205,6 @@ void jt::addBasicActionCommands(std::shared_ptr<jt::GameBase> game)
     addCommandClear(game);
     addCommandsCam(game);
     addCommandTextureManager(game);
+    addCommandsTrace(game);
     addCommandsMusicPlayer(game);
 }
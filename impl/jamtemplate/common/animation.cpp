@@ -1,5 +1,5 @@
 ﻿#include "animation.hpp"
-#include <aselib/aseprite_data.hpp>
+#include <graphics/aseprite_cache.hpp>
 #include <math_helper.hpp>
 #include <nlohmann.hpp>
 #include <sprite.hpp>
@@ -9,19 +9,94 @@
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace {
 
-std::shared_ptr<jt::Sprite>& getCurrentSprite(
-    jt::Animation::AnimationMapType& frames, std::string const& animName, size_t const animIndex)
+std::mutex sharedFramesMutex {};
+// frame tables of aseprite files, shared by all animations loaded from the same file
+std::map<std::string, std::weak_ptr<jt::Animation::FrameTable const>> sharedFrames {};
+
+jt::Animation::FrameSequence createFrameSequence(std::string const& fileName,
+    jt::Vector2u const& imageSize, std::vector<unsigned int> const& frameIndices,
+    std::vector<float> const& frameTimesInSeconds)
 {
-    auto const cit = frames.find(animName);
-    if (cit == frames.cend()) {
-        throw std::invalid_argument { "AnimName: '" + animName + "' not part of animation" };
+    if (frameIndices.empty()) {
+        throw std::invalid_argument { "animation frame indices are empty." };
+    }
+    if (frameTimesInSeconds.empty()) {
+        throw std::invalid_argument { "frametimes are empty." };
+    }
+    if (frameTimesInSeconds.size() != frameIndices.size()) {
+        throw std::invalid_argument { "different sizes for frametimes and frame indices" };
     }
 
-    return cit->second.at(animIndex);
+    jt::Animation::FrameSequence sequence {};
+    sequence.fileName = fileName;
+    sequence.rects.reserve(frameIndices.size());
+    for (auto const idx : frameIndices) {
+        sequence.rects.push_back(jt::Recti { static_cast<int>(idx * imageSize.x), 0,
+            static_cast<int>(imageSize.x), static_cast<int>(imageSize.y) });
+    }
+    sequence.frameTimesInSeconds = frameTimesInSeconds;
+    return sequence;
+}
+
+std::shared_ptr<jt::Animation::FrameTable const> createAsepriteFrames(
+    std::string const& asepriteFileName)
+{
+    auto const ase = jt::loadDecodedAseprite(asepriteFileName);
+    auto const imageSize = ase->getFrameSize();
+    auto frames = std::make_shared<jt::Animation::FrameTable>();
+
+    if (ase->getTags().empty()) {
+        // no custom animation defined in aseprite, use all frames as default "idle" animation
+        std::vector<unsigned int> frameIDs = jt::MathHelper::numbersBetween(
+            0u, static_cast<unsigned int>(ase->getNumberOfFrames()));
+        std::vector<float> const frameTimes(frameIDs.size(), 0.1f);
+
+        (*frames)["idle"] = createFrameSequence(asepriteFileName, imageSize, frameIDs, frameTimes);
+        return frames;
+    }
+
+    auto const& frameDurations = ase->getFrameDurations();
+    for (auto const& tag : ase->getTags()) {
+        std::vector<unsigned int> frameIDs
+            = jt::MathHelper::numbersBetween(tag.fromFrame, tag.toFrame);
+
+        std::vector<float> frame_times;
+        frame_times.resize(frameIDs.size());
+        std::transform(frameIDs.cbegin(), frameIDs.cend(), frame_times.begin(),
+            [&frameDurations](auto const id) {
+                // aseprite stores the frametime in milliseconds, JT expects it in seconds.
+                return static_cast<float>(frameDurations.at(id)) / 1000.0f;
+            });
+
+        auto& sequence = (*frames)[tag.name];
+        sequence = createFrameSequence(asepriteFileName, imageSize, frameIDs, frame_times);
+        sequence.isLooping = tag.repeat;
+    }
+    return frames;
+}
+
+std::shared_ptr<jt::Animation::FrameTable const> getSharedAsepriteFrames(
+    std::string const& asepriteFileName)
+{
+    {
+        std::lock_guard const lock { sharedFramesMutex };
+        if (auto frames = sharedFrames[asepriteFileName].lock()) {
+            return frames;
+        }
+    }
+    // load without holding the lock, so multiple files can be loaded in parallel
+    auto frames = createAsepriteFrames(asepriteFileName);
+    std::lock_guard const lock { sharedFramesMutex };
+    if (auto existing = sharedFrames[asepriteFileName].lock()) {
+        return existing;
+    }
+    sharedFrames[asepriteFileName] = frames;
+    return frames;
 }
 
 } // namespace
@@ -42,41 +117,23 @@ void jt::Animation::add(std::string const& fileName, std::string const& animName
     jt::Vector2u const& imageSize, std::vector<unsigned int> const& frameIndices,
     std::vector<float> const& frameTimesInSeconds, jt::TextureManagerInterface& textureManager)
 {
-    if (frameIndices.empty()) {
-        throw std::invalid_argument { "animation frame indices are empty." };
-    }
     if (animName.empty()) {
         throw std::invalid_argument { "animation name is empty." };
     }
-    if (frameTimesInSeconds.empty()) {
-        throw std::invalid_argument { "frametimes are empty." };
-    }
-
-    if (frameTimesInSeconds.size() != frameIndices.size()) {
-        throw std::invalid_argument { "different sizes for frametimes and frame indices" };
-    }
+    auto sequence = createFrameSequence(fileName, imageSize, frameIndices, frameTimesInSeconds);
 
-    if (m_frames.contains(animName)) {
+    if (m_frames->contains(animName)) {
         std::cout << "Warning: Overwriting old animation with name: " << animName << std::endl;
     }
-
-    m_frames[animName] = std::vector<jt::Sprite::Sptr> {};
-
-    for (auto const idx : frameIndices) {
-        jt::Recti const rect { static_cast<int>(idx * imageSize.x), 0,
-            static_cast<int>(imageSize.x), static_cast<int>(imageSize.y) };
-        auto sptr = std::make_shared<Sprite>(fileName, rect, textureManager);
-        m_frames[animName].push_back(sptr);
-    }
-    m_time[animName] = frameTimesInSeconds;
-    m_isLooping[animName] = true;
+    prepareSprite(fileName, sequence.rects.front(), textureManager);
+    getMutableFrames()[animName] = std::move(sequence);
 }
 
 void jt::Animation::loadFromJson(
     std::string const& jsonFileName, TextureManagerInterface& textureManager)
 {
-    m_frames.clear();
-    m_time.clear();
+    m_frames = std::make_shared<FrameTable const>();
+    m_ownFrames = nullptr;
 
     if (!jsonFileName.ends_with(".json")) {
         throw std::invalid_argument { "file '" + jsonFileName + "' is not a json file" };
@@ -147,54 +204,29 @@ void jt::Animation::loadFromJson(
 void jt::Animation::loadFromAseprite(
     std::string const& asepriteFileName, jt::TextureManagerInterface& textureManager)
 {
-    aselib::AsepriteData ase { asepriteFileName };
-
-    auto const imageSize
-        = jt::Vector2u { ase.m_header.m_width_in_pixel, ase.m_header.m_height_in_pixel };
-
-    if (ase.m_frames[0].m_chunks.m_tag_chunks.empty()) {
-        // no custom animation defined in aseprite, use all frames as default "idle" animation
-        std::vector<unsigned int> frameIDs
-            = jt::MathHelper::numbersBetween(0u, static_cast<unsigned int>(ase.m_frames.size()));
-
-        add(asepriteFileName, "idle", imageSize, frameIDs, 0.1f, textureManager);
-
-    } else {
-        for (auto const& tagChunk : ase.m_frames[0].m_chunks.m_tag_chunks) {
-            for (auto const& tag : tagChunk.m_tags) {
-                auto const animName = tag.m_tag_name;
-                auto const startFrame = tag.m_from_frame;
-                auto const endFrame = tag.m_to_frame;
-                auto const repeat = tag.m_repeat_animation == 0;
-
-                std::vector<unsigned int> frameIDs = jt::MathHelper::numbersBetween(
-                    static_cast<unsigned int>(startFrame), static_cast<unsigned int>(endFrame));
-
-                std::vector<float> frame_times;
-                frame_times.resize(frameIDs.size());
-                std::transform(
-                    frameIDs.cbegin(), frameIDs.cend(), frame_times.begin(), [&ase](auto const id) {
-                        // aseprite stores the frametime in milliseconds, JT expects it in seconds.
-                        return ase.m_frames.at(id).m_frame_header.m_frame_duration / 1000.0f;
-                    });
-
-                add(asepriteFileName, animName, imageSize, frameIDs, frame_times, textureManager);
-                setLooping(animName, repeat);
-            }
-        }
+    auto const frames = getSharedAsepriteFrames(asepriteFileName);
+    prepareSprite(asepriteFileName, frames->begin()->second.rects.front(), textureManager);
+    if (m_frames->empty()) {
+        m_frames = frames;
+        m_ownFrames = nullptr;
+        return;
+    }
+    auto& ownFrames = getMutableFrames();
+    for (auto const& kvp : *frames) {
+        ownFrames[kvp.first] = kvp.second;
     }
 }
 
 bool jt::Animation::hasAnimation(std::string const& animationName) const
 {
-    return (m_frames.contains(animationName));
+    return (m_frames->contains(animationName));
 }
 
 std::vector<std::string> jt::Animation::getAllAvailableAnimationNames() const
 {
     std::vector<std::string> names;
-    names.resize(m_frames.size());
-    std::transform(m_frames.cbegin(), m_frames.cend(), names.begin(),
+    names.resize(m_frames->size());
+    std::transform(m_frames->cbegin(), m_frames->cend(), names.begin(),
         [](auto kvp) -> std::string { return kvp.first; });
 
     return names;
@@ -202,12 +234,12 @@ std::vector<std::string> jt::Animation::getAllAvailableAnimationNames() const
 
 std::string jt::Animation::getRandomAnimationName() const
 {
-    if (m_frames.empty()) {
+    if (m_frames->empty()) {
         throw std::invalid_argument {
             "can not get random animation name if no animation has been added"
         };
     }
-    return jt::SystemHelper::select_randomly(m_frames).first;
+    return jt::SystemHelper::select_randomly(*m_frames).first;
 }
 
 void jt::Animation::play(std::string const& animationName, size_t startFrameIndex, bool restart)
@@ -223,86 +255,63 @@ void jt::Animation::play(std::string const& animationName, size_t startFrameInde
         m_currentAnimName = animationName;
         m_frameTime = 0;
     }
+    showCurrentFrame();
 }
 
 void jt::Animation::setColor(jt::Color const& col)
 {
-    for (auto& kvp : m_frames) {
-        for (auto& spr : kvp.second) {
-            spr->setColor(col);
-        }
+    if (m_sprite) {
+        m_sprite->setColor(col);
     }
 }
 
-jt::Color jt::Animation::getColor() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getColor();
-}
+jt::Color jt::Animation::getColor() const { return getCurrentSprite().getColor(); }
 
 void jt::Animation::setPosition(jt::Vector2f const& pos) { m_position = pos; }
 
 jt::Vector2f jt::Animation::getPosition() const { return m_position; }
 
-jt::Rectf jt::Animation::getGlobalBounds() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getGlobalBounds();
-}
+jt::Rectf jt::Animation::getGlobalBounds() const { return getCurrentSprite().getGlobalBounds(); }
 
-jt::Rectf jt::Animation::getLocalBounds() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getLocalBounds();
-}
+jt::Rectf jt::Animation::getLocalBounds() const { return getCurrentSprite().getLocalBounds(); }
 
 void jt::Animation::setScale(jt::Vector2f const& scale)
 {
-    for (auto& kvp : m_frames) {
-        for (auto& spr : kvp.second) {
-            spr->setScale(scale);
-        }
+    if (m_sprite) {
+        m_sprite->setScale(scale);
     }
 }
 
-jt::Vector2f jt::Animation::getScale() const
-{
-    return getCurrentSprite(m_frames, m_currentAnimName, m_currentIdx)->getScale();
-}
+jt::Vector2f jt::Animation::getScale() const { return getCurrentSprite().getScale(); }
 
 void jt::Animation::setOriginInternal(jt::Vector2f const& origin)
 {
-    for (auto const& kvp : m_frames) {
-        for (auto const& sptr : kvp.second) {
-            sptr->setOrigin(origin);
-        }
+    if (m_sprite) {
+        m_sprite->setOrigin(origin);
     }
 }
 
 void jt::Animation::setOutline(jt::Color const& color, int width)
 {
     DrawableImpl::setOutline(color, width);
-    for (auto const& kvp : m_frames) {
-        for (auto const& sprite : kvp.second) {
-            sprite->setOutline(color, width);
-        }
+    if (m_sprite) {
+        m_sprite->setOutline(color, width);
     }
 }
 
 void jt::Animation::setShadow(jt::Color const& color, jt::Vector2f const& offset)
 {
     DrawableImpl::setShadow(color, offset);
-    for (auto const& kvp : m_frames) {
-        for (auto const& sprite : kvp.second) {
-            sprite->setShadow(color, offset);
-        }
+    if (m_sprite) {
+        m_sprite->setShadow(color, offset);
     }
 }
 
 void jt::Animation::setShadowActive(bool active)
 {
     DrawableImpl::setShadowActive(active);
-    for (auto const& kvp : m_frames) {
-        for (auto const& sprite : kvp.second) {
-            sprite->setShadowActive(active);
-        }
+    if (m_sprite) {
+        m_sprite->setShadowActive(active);
     }
 }
 
@@ -317,18 +326,16 @@ void jt::Animation::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) co
                 + "'\n";
         return;
     }
-    m_frames.at(m_currentAnimName).at(m_currentIdx)->setBlendMode(getBlendMode());
-    m_frames.at(m_currentAnimName).at(m_currentIdx)->draw(sptr);
+    m_sprite->setBlendMode(getBlendMode());
+    m_sprite->draw(sptr);
 }
 
 void jt::Animation::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const /*sptr*/) const { }
 
 void jt::Animation::doFlashImpl(float t, jt::Color col)
 {
-    for (auto& kvp : m_frames) {
-        for (auto& sprite : kvp.second) {
-            sprite->flash(t, col);
-        }
+    if (m_sprite) {
+        m_sprite->flash(t, col);
     }
 }
 
@@ -343,52 +350,91 @@ void jt::Animation::doUpdate(float elapsed)
     // proceed time
     m_frameTime += elapsed * m_animationplaybackSpeed;
 
-    auto const frame_time = m_time[m_currentAnimName][m_currentIdx];
+    auto const& sequence = m_frames->at(m_currentAnimName);
+    auto const frame_time = sequence.frameTimesInSeconds.at(m_currentIdx);
     // increase index
     while (m_frameTime >= frame_time) {
         m_frameTime -= frame_time;
         m_currentIdx++;
     }
     // wrap index or fix index at last frame
-    if (m_currentIdx >= m_frames.at(m_currentAnimName).size()) {
+    if (m_currentIdx >= sequence.rects.size()) {
         if (getCurrentAnimationIsLooping()) {
             m_currentIdx = 0;
         } else {
-            m_currentIdx = m_frames.at(m_currentAnimName).size() - 1;
+            m_currentIdx = sequence.rects.size() - 1;
         }
     }
 
-    // update values for current sprite
-    auto const& currentSprite = m_frames.at(m_currentAnimName).at(m_currentIdx);
-    currentSprite->setPosition(m_position + getShakeOffset() + getOffset());
-    currentSprite->setIgnoreCamMovement(DrawableImpl::getIgnoreCamMovement());
+    // update values for the sprite
+    showCurrentFrame();
+    m_sprite->setPosition(m_position + getShakeOffset() + getOffset());
+    m_sprite->setIgnoreCamMovement(DrawableImpl::getIgnoreCamMovement());
+    m_sprite->update(elapsed);
+}
 
-    // update all sprites
-    for (auto& kvp : m_frames) {
-        for (auto& sprite : kvp.second) {
-            sprite->update(elapsed);
-        }
+void jt::Animation::doRotate(float rot)
+{
+    if (m_sprite) {
+        m_sprite->setRotation(rot);
     }
 }
 
-void jt::Animation::doRotate(float rot)
+jt::Animation::FrameTable& jt::Animation::getMutableFrames()
 {
-    for (auto& kvp : m_frames) {
-        for (auto& sprite : kvp.second) {
-            sprite->setRotation(rot);
-        }
+    // copy on write, the frame table might be shared with other animations
+    if (!m_ownFrames) {
+        m_ownFrames = std::make_shared<FrameTable>(*m_frames);
+        m_frames = m_ownFrames;
+    }
+    return *m_ownFrames;
+}
+
+jt::Sprite& jt::Animation::getCurrentSprite() const
+{
+    if (!m_sprite || !hasAnimation(m_currentAnimName)) {
+        throw std::invalid_argument { "AnimName: '" + m_currentAnimName
+            + "' not part of animation" };
+    }
+    return *m_sprite;
+}
+
+void jt::Animation::prepareSprite(std::string const& fileName, jt::Recti const& rect,
+    jt::TextureManagerInterface& textureManager)
+{
+    if (m_sprite && m_textureManager == &textureManager) {
+        // load the texture now instead of when the animation is played for the first time
+        textureManager.getRegion(textureManager.getHandle(fileName));
+        return;
     }
+    m_textureManager = &textureManager;
+    m_textureFileName = fileName;
+    m_textureHandle = textureManager.getHandle(fileName);
+    m_sprite = std::make_shared<jt::Sprite>(m_textureHandle, rect, textureManager);
+}
+
+void jt::Animation::showCurrentFrame()
+{
+    if (!m_sprite || !m_isValid) {
+        return;
+    }
+    auto const& sequence = m_frames->at(m_currentAnimName);
+    if (m_textureFileName != sequence.fileName) {
+        m_textureFileName = sequence.fileName;
+        m_textureHandle = m_textureManager->getHandle(sequence.fileName);
+    }
+    m_sprite->setTextureRect(m_textureHandle, sequence.rects.at(m_currentIdx));
 }
 
 float jt::Animation::getCurrentAnimationSingleFrameTime() const
 {
-    return m_time.at(m_currentAnimName).at(m_currentIdx);
+    return m_frames->at(m_currentAnimName).frameTimesInSeconds.at(m_currentIdx);
 }
 
 float jt::Animation::getCurrentAnimTotalTime() const
 {
     float sum = 0.0f;
-    for (auto frameTime : m_time.at(m_currentAnimName)) {
+    for (auto frameTime : m_frames->at(m_currentAnimName).frameTimesInSeconds) {
         sum += frameTime;
     }
     return sum;
@@ -400,7 +446,7 @@ float jt::Animation::getAnimTotalTimeFor(std::string const& animName)
         throw std::invalid_argument { "no animation with name " + animName };
     }
     float sum = 0.0f;
-    for (auto frameTime : m_time.at(animName)) {
+    for (auto frameTime : m_frames->at(animName).frameTimesInSeconds) {
         sum += frameTime;
     }
     return sum;
@@ -408,7 +454,7 @@ float jt::Animation::getAnimTotalTimeFor(std::string const& animName)
 
 std::size_t jt::Animation::getNumberOfFramesInCurrentAnimation() const
 {
-    return m_frames.at(m_currentAnimName).size();
+    return m_frames->at(m_currentAnimName).rects.size();
 }
 
 std::string jt::Animation::getCurrentAnimationName() const { return m_currentAnimName; }
@@ -418,7 +464,7 @@ bool jt::Animation::getCurrentAnimationIsLooping() const
     if (!hasAnimation(m_currentAnimName)) {
         return true;
     }
-    return m_isLooping.at(m_currentAnimName);
+    return m_frames->at(m_currentAnimName).isLooping;
 }
 
 bool jt::Animation::getIsLoopingFor(std::string const& animName) const
@@ -426,7 +472,7 @@ bool jt::Animation::getIsLoopingFor(std::string const& animName) const
     if (!hasAnimation(animName)) {
         throw std::invalid_argument { "no animation with name " + animName };
     }
-    return m_isLooping.at(animName);
+    return m_frames->at(animName).isLooping;
 }
 
 void jt::Animation::setLooping(std::string const& animName, bool isLooping)
@@ -434,13 +480,15 @@ void jt::Animation::setLooping(std::string const& animName, bool isLooping)
     if (!hasAnimation(animName)) {
         throw std::invalid_argument { "invalid animation name: " + animName };
     }
-    m_isLooping[animName] = isLooping;
+    if (m_frames->at(animName).isLooping != isLooping) {
+        getMutableFrames().at(animName).isLooping = isLooping;
+    }
 }
 
 void jt::Animation::setLoopingAll(bool isLooping)
 {
-    for (auto& l : m_isLooping) {
-        l.second = isLooping;
+    for (auto const& kvp : *m_frames) {
+        setLooping(kvp.first, isLooping);
     }
 }
 
@@ -449,14 +497,14 @@ std::size_t jt::Animation::getCurrentAnimationFrameIndex() const { return m_curr
 void jt::Animation::setFrameTimes(
     std::string const& animationName, std::vector<float> const& frameTimes)
 {
-    if (!m_frames.contains(animationName)) {
+    if (!m_frames->contains(animationName)) {
         throw std::invalid_argument { "cannot set frame times for invalid animation: "
             + animationName };
     }
-    if (frameTimes.size() != m_frames[animationName].size()) {
+    if (frameTimes.size() != m_frames->at(animationName).rects.size()) {
         throw std::invalid_argument { "frame times size does not match frame index size" };
     }
-    m_time[animationName] = frameTimes;
+    getMutableFrames().at(animationName).frameTimesInSeconds = frameTimes;
 }
 
 void jt::Animation::setAnimationSpeedFactor(float factor) { m_animationplaybackSpeed = factor; }
@@ -2,6 +2,8 @@
 #define JAMTEMPLATE_ANIMATION_HPP
 
 #include <graphics/drawable_impl.hpp>
+#include <graphics/texture_handle.hpp>
+#include <rect.hpp>
 #include <map>
 #include <memory>
 #include <string>
@@ -16,7 +18,17 @@ class TextureManagerInterface;
 class Animation : public DrawableImpl {
 public:
     using Sptr = std::shared_ptr<Animation>;
-    using AnimationMapType = std::map<std::string, std::vector<std::shared_ptr<Sprite>>>;
+
+    /// Frames of a single animation
+    struct FrameSequence {
+        /// image all frames are taken from
+        std::string fileName {};
+        /// part of the image shown in each frame
+        std::vector<jt::Recti> rects {};
+        std::vector<float> frameTimesInSeconds {};
+        bool isLooping { true };
+    };
+    using FrameTable = std::map<std::string, FrameSequence>;
 
     /// Add a new animation to the pool of available animations
     ///
@@ -173,8 +185,17 @@ public:
     float getAnimationSpeedFactor() const;
 
 private:
-    mutable AnimationMapType m_frames {};
-    std::map<std::string, std::vector<float>> m_time {};
+    // Frame tables loaded from aseprite files are shared by all animations loaded from the same
+    // file. m_ownFrames is only set if the table is owned by this animation and can be changed.
+    std::shared_ptr<FrameTable const> m_frames { std::make_shared<FrameTable const>() };
+    std::shared_ptr<FrameTable> m_ownFrames { nullptr };
+
+    // a single sprite shows all frames by switching the shown part of the texture
+    std::shared_ptr<jt::Sprite> m_sprite { nullptr };
+    jt::TextureManagerInterface* m_textureManager { nullptr };
+    // texture of the currently shown frame
+    std::string m_textureFileName {};
+    jt::TextureHandle m_textureHandle {};
 
     bool m_isValid { false };
 
@@ -187,8 +208,6 @@ private:
 
     float m_frameTime { 0.0f };
 
-    std::map<std::string, bool> m_isLooping {};
-
     float m_animationplaybackSpeed { 1.0f };
 
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
@@ -201,6 +220,12 @@ private:
     virtual void doUpdate(float elapsed) override;
 
     void doRotate(float rot) override;
+
+    FrameTable& getMutableFrames();
+    jt::Sprite& getCurrentSprite() const;
+    void prepareSprite(std::string const& fileName, jt::Recti const& rect,
+        jt::TextureManagerInterface& textureManager);
+    void showCurrentFrame();
 };
 
 } // namespace jt
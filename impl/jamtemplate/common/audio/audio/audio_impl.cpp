@@ -1,7 +1,7 @@
 #include "audio_impl.hpp"
 #include <audio/sound/sound.hpp>
 #include <random/random.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 #include <fmod_errors.h>
 #include <sstream>
 
@@ -29,7 +29,7 @@ void jt::checkResult(FMOD_RESULT result)
 
 jt::AudioImpl::AudioImpl()
 {
-    ZoneScopedN("jt::AudioImpl::AudioImpl");
+    JT_PROFILE_ZONE("jt::AudioImpl::AudioImpl");
     checkResult(FMOD::Studio::System::create(&m_studioSystem));
     checkResult(m_studioSystem->initialize(128, getStudioInitFlags(), FMOD_INIT_NORMAL, nullptr));
 
@@ -0,0 +1,230 @@
+#include "batched_particle_system.hpp"
+#include <graphics/aseprite_cache.hpp>
+#include <graphics/drawable_impl.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+jt::BatchedParticleSystem::BatchedParticleSystem(
+    std::size_t capacity, ResetCallbackType const& reset)
+    : m_resetCallback { reset }
+    , m_capacity { capacity }
+{
+    if (m_capacity == 0u) {
+        throw std::invalid_argument { "particle system capacity must not be zero" };
+    }
+    m_positionX.resize(m_capacity);
+    m_positionY.resize(m_capacity);
+    m_velocityX.resize(m_capacity);
+    m_velocityY.resize(m_capacity);
+    m_age.resize(m_capacity);
+    m_inverseLifetime.resize(m_capacity);
+    m_scaleStart.resize(m_capacity);
+    m_scaleEnd.resize(m_capacity);
+    m_colorStart.resize(m_capacity);
+    m_colorEnd.resize(m_capacity);
+    m_frames.resize(m_capacity);
+}
+
+void jt::BatchedParticleSystem::addFrame(std::string const& fileName, jt::Recti const& rect,
+    jt::TextureManagerInterface& textureManager)
+{
+    m_frameSprites.push_back(std::make_shared<jt::Sprite>(fileName, rect, textureManager));
+    m_frameSizes.push_back(
+        jt::Vector2f { static_cast<float>(rect.width), static_cast<float>(rect.height) });
+}
+
+void jt::BatchedParticleSystem::addFramesFromAseprite(
+    std::string const& asepriteFileName, jt::TextureManagerInterface& textureManager)
+{
+    auto const ase = jt::loadDecodedAseprite(asepriteFileName);
+    auto const offset = getNumberOfFrames();
+    for (auto const& tag : ase->getTags()) {
+        auto const from = std::min(tag.fromFrame, tag.toFrame);
+        auto const to = std::max(tag.fromFrame, tag.toFrame);
+        // aseprite stores the frametime in milliseconds, JT expects it in seconds.
+        auto const frameTime = static_cast<float>(ase->getFrameDurations().at(from)) / 1000.0f;
+        m_frameRanges[tag.name]
+            = jt::ParticleFrameRange { offset + from, to - from + 1u, frameTime, tag.repeat };
+    }
+
+    auto const w = static_cast<int>(ase->getFrameSize().x);
+    auto const h = static_cast<int>(ase->getFrameSize().y);
+    for (auto i = 0; i != static_cast<int>(ase->getNumberOfFrames()); ++i) {
+        addFrame(asepriteFileName, jt::Recti { i * w, 0, w, h }, textureManager);
+    }
+}
+
+std::size_t jt::BatchedParticleSystem::getNumberOfFrames() const noexcept
+{
+    return m_frameSprites.size();
+}
+
+jt::ParticleFrameRange const& jt::BatchedParticleSystem::getFrameRange(
+    std::string const& tagName) const
+{
+    auto const range = m_frameRanges.find(tagName);
+    if (range == m_frameRanges.end()) {
+        throw std::invalid_argument { "particle system has no frames for tag '" + tagName + "'" };
+    }
+    return range->second;
+}
+
+void jt::BatchedParticleSystem::fire(unsigned int num, jt::Vector2f const& pos)
+{
+    for (auto i = 0u; i != num; ++i) {
+        jt::ParticleProperties particle {};
+        particle.position = pos;
+        if (m_resetCallback) {
+            m_resetCallback(particle, pos);
+        }
+        spawn(particle);
+    }
+}
+
+void jt::BatchedParticleSystem::spawn(jt::ParticleProperties const& particle)
+{
+    if (m_count < m_capacity) {
+        writeParticle(m_count, particle);
+        ++m_count;
+        return;
+    }
+    writeParticle(m_replaceIndex, particle);
+    m_replaceIndex = (m_replaceIndex + 1u) % m_capacity;
+}
+
+std::size_t jt::BatchedParticleSystem::getNumberOfAliveParticles() const noexcept
+{
+    return m_count;
+}
+
+std::size_t jt::BatchedParticleSystem::getCapacity() const noexcept { return m_capacity; }
+
+void jt::BatchedParticleSystem::clear() noexcept { m_count = 0u; }
+
+void jt::BatchedParticleSystem::setZ(int z) noexcept { m_z = z; }
+
+void jt::BatchedParticleSystem::setBlendMode(jt::BlendMode mode) noexcept { m_blendMode = mode; }
+
+void jt::BatchedParticleSystem::writeParticle(
+    std::size_t index, jt::ParticleProperties const& particle)
+{
+    m_positionX[index] = particle.position.x;
+    m_positionY[index] = particle.position.y;
+    m_velocityX[index] = particle.velocity.x;
+    m_velocityY[index] = particle.velocity.y;
+    m_age[index] = 0.0f;
+    m_inverseLifetime[index] = particle.lifetime > 0.0f ? 1.0f / particle.lifetime : 1.0e6f;
+    m_scaleStart[index] = particle.scaleStart;
+    m_scaleEnd[index] = particle.scaleEnd;
+    m_colorStart[index] = particle.colorStart;
+    m_colorEnd[index] = particle.colorEnd;
+    m_frames[index] = particle.frames;
+}
+
+void jt::BatchedParticleSystem::moveParticle(std::size_t from, std::size_t to)
+{
+    m_positionX[to] = m_positionX[from];
+    m_positionY[to] = m_positionY[from];
+    m_velocityX[to] = m_velocityX[from];
+    m_velocityY[to] = m_velocityY[from];
+    m_age[to] = m_age[from];
+    m_inverseLifetime[to] = m_inverseLifetime[from];
+    m_scaleStart[to] = m_scaleStart[from];
+    m_scaleEnd[to] = m_scaleEnd[from];
+    m_colorStart[to] = m_colorStart[from];
+    m_colorEnd[to] = m_colorEnd[from];
+    m_frames[to] = m_frames[from];
+}
+
+std::size_t jt::BatchedParticleSystem::getCurrentFrame(std::size_t index) const noexcept
+{
+    auto const& range = m_frames[index];
+    std::size_t step { 0u };
+    if (range.numberOfFrames > 1u && range.frameTime > 0.0f) {
+        step = static_cast<std::size_t>(m_age[index] / range.frameTime);
+        step = range.isLooping ? step % range.numberOfFrames
+                               : std::min(step, range.numberOfFrames - 1u);
+    }
+    auto const frame = range.firstFrame + step;
+    return frame < m_frameSprites.size() ? frame : 0u;
+}
+
+void jt::BatchedParticleSystem::doUpdate(float const elapsed)
+{
+    auto const n = m_count;
+    // plain loops over contiguous float arrays, so the compiler can vectorize them
+    float* const px = m_positionX.data();
+    float* const py = m_positionY.data();
+    float const* const vx = m_velocityX.data();
+    float const* const vy = m_velocityY.data();
+    float* const age = m_age.data();
+    for (std::size_t i = 0u; i < n; ++i) {
+        px[i] += vx[i] * elapsed;
+        py[i] += vy[i] * elapsed;
+        age[i] += elapsed;
+    }
+
+    // remove dead particles by moving the last alive particle into their slot
+    std::size_t i = 0u;
+    while (i < m_count) {
+        if (m_age[i] * m_inverseLifetime[i] < 1.0f) {
+            ++i;
+            continue;
+        }
+        --m_count;
+        if (i != m_count) {
+            moveParticle(m_count, i);
+        }
+    }
+    if (m_replaceIndex >= m_count) {
+        m_replaceIndex = 0u;
+    }
+}
+
+void jt::BatchedParticleSystem::doDraw() const
+{
+    if (m_count == 0u || m_frameSprites.empty()) {
+        return;
+    }
+    auto const target = renderTarget();
+    if (!target) [[unlikely]] {
+        return;
+    }
+
+    m_batch.clear();
+    for (std::size_t i = 0u; i != m_count; ++i) {
+        auto const t = m_age[i] * m_inverseLifetime[i];
+        auto const frame = getCurrentFrame(i);
+
+        auto const& s0 = m_scaleStart[i];
+        auto const& s1 = m_scaleEnd[i];
+        auto const& size = m_frameSizes[frame];
+        auto const halfW = 0.5f * size.x * (s0.x + (s1.x - s0.x) * t);
+        auto const halfH = 0.5f * size.y * (s0.y + (s1.y - s0.y) * t);
+        auto const x = m_positionX[i];
+        auto const y = m_positionY[i];
+
+        auto const& c0 = m_colorStart[i];
+        auto const& c1 = m_colorEnd[i];
+        auto const lerpChannel = [t](std::uint8_t a, std::uint8_t b) {
+            return static_cast<std::uint8_t>(
+                static_cast<float>(a) + (static_cast<float>(b) - static_cast<float>(a)) * t);
+        };
+        jt::Color const col { lerpChannel(c0.r, c1.r), lerpChannel(c0.g, c1.g),
+            lerpChannel(c0.b, c1.b), lerpChannel(c0.a, c1.a) };
+
+        m_batch.add(*m_frameSprites[frame],
+            SpriteBatch::QuadCorners { jt::Vector2f { x - halfW, y - halfH },
+                jt::Vector2f { x + halfW, y - halfH }, jt::Vector2f { x + halfW, y + halfH },
+                jt::Vector2f { x - halfW, y + halfH } },
+            col);
+    }
+
+#if USE_SFML
+    // the camera is applied via the view of the render target
+    jt::Vector2f const offset { 0.0f, 0.0f };
+#else
+    auto const offset = jt::DrawableImpl::getStaticCamOffset();
+#endif
+    m_batch.draw(target->get(m_z), offset, m_blendMode);
+}
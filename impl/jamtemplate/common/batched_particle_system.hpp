@@ -0,0 +1,153 @@
+#ifndef JAMTEMPLATE_BATCHED_PARTICLE_SYSTEM_HPP
+#define JAMTEMPLATE_BATCHED_PARTICLE_SYSTEM_HPP
+
+#include <color/color.hpp>
+#include <game_object.hpp>
+#include <sprite.hpp>
+#include <sprite_batch.hpp>
+#include <texture_manager_interface.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// Consecutive frames of a BatchedParticleSystem that are played as an animation over the lifetime
+/// of a particle, e.g. the frames of an aseprite tag
+struct ParticleFrameRange {
+    /// index of the first frame
+    std::size_t firstFrame { 0u };
+    std::size_t numberOfFrames { 1u };
+    /// time per frame in seconds
+    float frameTime { 0.1f };
+    /// if false, the last frame is shown once the animation is finished
+    bool isLooping { true };
+};
+
+/// Spawn parameters of a single particle of a BatchedParticleSystem
+struct ParticleProperties {
+    jt::Vector2f position { 0.0f, 0.0f };
+    /// velocity in pixel per second
+    jt::Vector2f velocity { 0.0f, 0.0f };
+    /// lifetime in seconds
+    float lifetime { 1.0f };
+    /// scale is interpolated linearly from scaleStart to scaleEnd over the lifetime
+    jt::Vector2f scaleStart { 1.0f, 1.0f };
+    jt::Vector2f scaleEnd { 1.0f, 1.0f };
+    /// color is interpolated linearly from colorStart to colorEnd over the lifetime
+    jt::Color colorStart { jt::colors::White };
+    jt::Color colorEnd { jt::colors::White };
+    /// frames used to draw the particle, the default is the single frame 0
+    jt::ParticleFrameRange frames {};
+};
+
+/// Particle system that stores particle data in a structure of arrays and draws all particles with
+/// one batched vertex array. Particles are plain data, not drawables, so this is suitable for very
+/// large amounts of simple particles that move with constant velocity and fade/scale over their
+/// lifetime. All particles are drawn centered on their position.
+class BatchedParticleSystem : public GameObject {
+public:
+    using ResetCallbackType
+        = std::function<void(jt::ParticleProperties& particle, jt::Vector2f const& pos)>;
+
+    /// Constructor
+    /// \param capacity the maximum number of particles alive at the same time. If a particle is
+    /// fired while the system is full, an existing particle is replaced.
+    /// \param reset reset callback, used to set up the properties of fired particles
+    BatchedParticleSystem(std::size_t capacity, ResetCallbackType const& reset);
+
+    /// Add a frame that can be used by particles
+    /// \param fileName the image file name
+    /// \param rect the part of the image to use
+    /// \param textureManager the texture manager
+    void addFrame(std::string const& fileName, jt::Recti const& rect,
+        jt::TextureManagerInterface& textureManager);
+
+    /// Add all frames from an aseprite file. Frame i of the aseprite file will be frame
+    /// getNumberOfFrames() + i of the particle system. The tags of the aseprite file are available
+    /// via getFrameRange afterwards, with the frame time of the first frame of each tag.
+    /// \param asepriteFileName the aseprite file name
+    /// \param textureManager the texture manager
+    void addFramesFromAseprite(
+        std::string const& asepriteFileName, jt::TextureManagerInterface& textureManager);
+
+    /// Get the number of frames that have been added
+    /// \return number of frames
+    std::size_t getNumberOfFrames() const noexcept;
+
+    /// Get the frames of an aseprite tag added via addFramesFromAseprite
+    /// \param tagName the name of the tag
+    /// \return the frame range, throws std::invalid_argument if there is no such tag
+    jt::ParticleFrameRange const& getFrameRange(std::string const& tagName) const;
+
+    /// Fire the particle system, creating num particles
+    /// \param num the amount of particles to spawn
+    /// \param pos the position where to spawn the particles
+    void fire(unsigned int num = 1, jt::Vector2f const& pos = jt::Vector2f {});
+
+    /// Spawn a single particle
+    /// \param particle the particle properties
+    void spawn(jt::ParticleProperties const& particle);
+
+    /// Get the number of alive particles
+    /// \return number of alive particles
+    std::size_t getNumberOfAliveParticles() const noexcept;
+
+    /// Get the maximum number of alive particles
+    /// \return capacity
+    std::size_t getCapacity() const noexcept;
+
+    /// Remove all particles
+    void clear() noexcept;
+
+    /// Set the z layer particles are drawn to
+    /// \param z the z layer
+    void setZ(int z) noexcept;
+
+    /// Set the blend mode particles are drawn with
+    /// \param mode the blend mode
+    void setBlendMode(jt::BlendMode mode) noexcept;
+
+private:
+    ResetCallbackType m_resetCallback {};
+    std::size_t m_capacity { 0u };
+    std::size_t m_count { 0u };
+    // slot to replace if a particle is spawned while the system is full
+    std::size_t m_replaceIndex { 0u };
+
+    // structure of arrays, only the first m_count entries are alive
+    std::vector<float> m_positionX {};
+    std::vector<float> m_positionY {};
+    std::vector<float> m_velocityX {};
+    std::vector<float> m_velocityY {};
+    std::vector<float> m_age {};
+    std::vector<float> m_inverseLifetime {};
+    std::vector<jt::Vector2f> m_scaleStart {};
+    std::vector<jt::Vector2f> m_scaleEnd {};
+    std::vector<jt::Color> m_colorStart {};
+    std::vector<jt::Color> m_colorEnd {};
+    std::vector<jt::ParticleFrameRange> m_frames {};
+
+    std::vector<std::shared_ptr<jt::Sprite>> m_frameSprites {};
+    std::vector<jt::Vector2f> m_frameSizes {};
+    std::map<std::string, jt::ParticleFrameRange> m_frameRanges {};
+
+    mutable jt::SpriteBatch m_batch {};
+    int m_z { 0 };
+    jt::BlendMode m_blendMode { jt::BlendMode::ALPHA };
+
+    void doUpdate(float const elapsed) override;
+    void doDraw() const override;
+
+    void writeParticle(std::size_t index, jt::ParticleProperties const& particle);
+    void moveParticle(std::size_t from, std::size_t to);
+    std::size_t getCurrentFrame(std::size_t index) const noexcept;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_BATCHED_PARTICLE_SYSTEM_HPP
@@ -1,5 +1,14 @@
 #include "logging_box2d_contact_manager.hpp"
+#include <log/log_macros.hpp>
+#include <array>
 #include <stdexcept>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 2> box2dTags { "jt", "box2d" };
+
+} // namespace
 
 jt::LoggingBox2DContactManager::LoggingBox2DContactManager(
     std::shared_ptr<jt::Box2DContactManagerInterface> decoratee, jt::LoggerInterface& logger)
@@ -19,8 +28,8 @@ jt::LoggingBox2DContactManager::LoggingBox2DContactManager(
 size_t jt::LoggingBox2DContactManager::size() const
 {
     auto const size = m_decoratee->size();
-    m_logger.verbose(
-        "Box2DContactManager.size() called: " + std::to_string(size), { "jt", "box2d" });
+    JT_LOG_VERBOSE(
+        m_logger, "Box2DContactManager.size() called: " + std::to_string(size), box2dTags);
 
     return size;
 }
@@ -42,16 +51,16 @@ void jt::LoggingBox2DContactManager::unregisterCallback(std::string const& callb
 
 std::vector<std::string> jt::LoggingBox2DContactManager::getAllCallbackIdentifiers() const
 {
-    m_logger.verbose("Box2DContactManager getAllCallbackIdentifiers", { "jt", "box2d" });
+    JT_LOG_VERBOSE(m_logger, "Box2DContactManager getAllCallbackIdentifiers", box2dTags);
     return m_decoratee->getAllCallbackIdentifiers();
 }
 void jt::LoggingBox2DContactManager::BeginContact(b2Contact* contact)
 {
-    m_logger.debug("Box2DContactManager BeginContact", { "jt", "box2d" });
+    JT_LOG_DEBUG(m_logger, "Box2DContactManager BeginContact", box2dTags);
     m_decoratee->BeginContact(contact);
 }
 void jt::LoggingBox2DContactManager::EndContact(b2Contact* contact)
 {
-    m_logger.debug("Box2DContactManager EndContact", { "jt", "box2d" });
+    JT_LOG_DEBUG(m_logger, "Box2DContactManager EndContact", box2dTags);
     m_decoratee->EndContact(contact);
 }
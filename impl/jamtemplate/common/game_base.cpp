@@ -1,9 +1,20 @@
 ﻿#include "game_base.hpp"
 #include "performance_measurement.hpp"
 #include <build_info.hpp>
-#include <tracy/Tracy.hpp>
+#include <jobs/job_system.hpp>
+#include <jobs/job_system_null.hpp>
+#include <log/log_macros.hpp>
+#include <trace_profiler.hpp>
 
+#include <array>
 #include <string>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 1> gameTags { "jt" };
+
+} // namespace
 
 jt::GameBase::GameBase(jt::GfxInterface& gfx, jt::InputManagerInterface& input,
     jt::AudioInterface& audio, jt::StateManagerInterface& stateManager, jt::LoggerInterface& logger,
@@ -16,14 +27,22 @@ jt::GameBase::GameBase(jt::GfxInterface& gfx, jt::InputManagerInterface& input,
     , m_actionCommandManager { actionCommandManager }
     , m_cache { cache }
 {
+#ifdef JT_ENABLE_WEB
+    m_jobSystem = std::make_unique<jt::null_objects::JobSystemNull>();
+#else
+    m_jobSystem = std::make_unique<jt::JobSystem>();
+#endif
     m_logger.info("git commit hash: " + jt::BuildInfo::gitCommitHash(), { "jt", "build info" });
     m_logger.info("build date: " + jt::BuildInfo::timestamp(), { "jt", "build info" });
+    m_logger.info("job system workers: " + std::to_string(m_jobSystem->getNumberOfWorkers()),
+        { "jt", "jobs" });
 }
 
 void jt::GameBase::runOneFrame()
 {
-    ZoneScopedN("jt::GameBase::runOneFrame");
-    m_logger.verbose("runOneFrame", { "jt" });
+    JT_PROFILE_ZONE("jt::GameBase::runOneFrame");
+    JT_LOG_VERBOSE(m_logger, "runOneFrame", gameTags);
+    m_logger.update();
     m_actionCommandManager.update();
 
     auto const now = std::chrono::steady_clock::now();
@@ -57,7 +76,7 @@ void jt::GameBase::runOneFrame()
     }
 
     m_age += elapsedSeconds;
-    FrameMark;
+    JT_PROFILE_FRAME_MARK;
 }
 
 std::weak_ptr<jt::GameInterface> jt::GameBase::getPtr() { return shared_from_this(); }
@@ -86,6 +105,8 @@ jt::ActionCommandManagerInterface& jt::GameBase::actionCommandManager()
 
 jt::CacheInterface& jt::GameBase::cache() { return m_cache; }
 
+jt::JobSystemInterface& jt::GameBase::jobSystem() { return *m_jobSystem; }
+
 std::string getTimeString()
 {
     auto t = std::time(nullptr);
@@ -97,8 +118,8 @@ std::string getTimeString()
 
 void jt::GameBase::doUpdate(float const elapsed)
 {
-    ZoneScopedN("jt::GameBase::doUpdate");
-    m_logger.verbose("update game", { "jt" });
+    JT_PROFILE_ZONE("jt::GameBase::doUpdate");
+    JT_LOG_VERBOSE(m_logger, "update game", gameTags);
     m_stateManager.update(getPtr(), elapsed);
     TracyPlot("GameObjects Alive", static_cast<std::int64_t>(getNumberOfAliveGameObjects()));
     TracyPlot("GameObjects Created", static_cast<std::int64_t>(getNumberOfCreatedGameObjects()));
@@ -116,8 +137,8 @@ void jt::GameBase::doUpdate(float const elapsed)
 
 void jt::GameBase::doDraw() const
 {
-    ZoneScopedN("jt::GameBase::doDraw");
-    m_logger.verbose("draw game", { "jt" });
+    JT_PROFILE_ZONE("jt::GameBase::doDraw");
+    JT_LOG_VERBOSE(m_logger, "draw game", gameTags);
     gfx().window().startRenderGui();
     gfx().clear();
     m_stateManager.draw(gfx().target());
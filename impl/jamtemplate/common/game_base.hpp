@@ -33,6 +33,8 @@ public:
 
     CacheInterface& cache() override;
 
+    JobSystemInterface& jobSystem() override;
+
     /// Start game
     /// \param gameloop_function
     virtual void startGame(GameLoopFunctionPtr gameloop_function) = 0;
@@ -60,6 +62,8 @@ protected:
 
     CacheInterface& m_cache;
 
+    std::unique_ptr<JobSystemInterface> m_jobSystem { nullptr };
+
     std::chrono::steady_clock::time_point m_timeLast {};
 
     float m_lag { 0.0f };
@@ -6,6 +6,7 @@
 #include <cache/cache_interface.hpp>
 #include <graphics/gfx_interface.hpp>
 #include <input/input_manager_interface.hpp>
+#include <jobs/job_system_interface.hpp>
 #include <log/logger_interface.hpp>
 #include <state_manager/state_manager_interface.hpp>
 #include <memory>
@@ -42,6 +43,10 @@ public:
     /// \return the cache
     virtual CacheInterface& cache() = 0;
 
+    /// Get the job system to run work on worker threads
+    /// \return the job system
+    virtual JobSystemInterface& jobSystem() = 0;
+
     /// Reset the Game internals, i.e. on a state switch
     virtual void reset() = 0;
 
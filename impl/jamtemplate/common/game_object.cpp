@@ -23,6 +23,16 @@ void jt::GameObject::update(float const elapsed)
     doUpdate(elapsed);
 }
 
+bool jt::GameObject::canSimulateInParallel() const { return false; }
+
+void jt::GameObject::simulate(float const elapsed)
+{
+    m_age += elapsed;
+    doSimulate(elapsed);
+}
+
+void jt::GameObject::commit(float const elapsed) { doCommit(elapsed); }
+
 void jt::GameObject::draw() const { doDraw(); };
 
 float jt::GameObject::getAge() const { return m_age; }
@@ -61,7 +71,13 @@ bool jt::GameObject::isAlive() const { return m_alive; }
 
 void jt::GameObject::destroy() { doDestroy(); }
 
-void jt::GameObject::doUpdate(float const /*elapsed*/) {};
+void jt::GameObject::doUpdate(float const elapsed)
+{
+    doSimulate(elapsed);
+    doCommit(elapsed);
+};
+void jt::GameObject::doSimulate(float const /*elapsed*/) {};
+void jt::GameObject::doCommit(float const /*elapsed*/) {};
 void jt::GameObject::doDraw() const {};
 void jt::GameObject::doCreate() {};
 void jt::GameObject::doKill() {};
@@ -32,6 +32,26 @@ public:
     /// \param elapsed the elapsed time in seconds
     void update(float const elapsed) final;
 
+    /// Check if the GameObject can be updated in the parallel simulate phase of a
+    /// GameObjectCollection. Derived classes that return true need to split their update into
+    /// doSimulate() and doCommit() instead of overriding doUpdate().
+    /// \return false by default
+    bool canSimulateInParallel() const override;
+
+    /// Run the thread safe part of the update
+    ///
+    /// Will call doSimulate(). This might run on a worker thread, see doSimulate().
+    ///
+    /// \param elapsed the elapsed time in seconds
+    void simulate(float const elapsed) final;
+
+    /// Run the serial part of the update after simulate()
+    ///
+    /// Will call doCommit()
+    ///
+    /// \param elapsed the elapsed time in seconds
+    void commit(float const elapsed) final;
+
     /// Draw the GameObject
     ///
     /// Will call doDraw
@@ -96,7 +116,15 @@ private:
     std::vector<std::shared_ptr<void>> m_storedActionCommands;
 
     virtual void doCreate();
+    /// Defaults to doSimulate() followed by doCommit()
     virtual void doUpdate(float const elapsed);
+
+    // Runs concurrently to other objects if canSimulateInParallel() returns true. Only modify
+    // the object itself here. Do NOT touch the game, the gamestate, tweens or physics. Logging is
+    // fine with jt::AsyncLogger, but not with the single threaded jt::Logger.
+    virtual void doSimulate(float const elapsed);
+    // Place for everything that touches shared state, e.g. adding objects or tweens.
+    virtual void doCommit(float const elapsed);
     virtual void doDraw() const;
 
     virtual void doKill();
@@ -1,5 +1,8 @@
 #include "game_object_collection.hpp"
+#include <performance_measurement.hpp>
+#include <trace_profiler.hpp>
 #include <algorithm>
+#include <chrono>
 
 void jt::GameObjectCollection::clear() noexcept
 {
@@ -22,6 +25,56 @@ void jt::GameObjectCollection::update(float elapsed)
     }
 }
 
+void jt::GameObjectCollection::update(float elapsed, jt::JobSystemInterface& jobSystem)
+{
+    addNewObjects();
+    cleanUpObjects();
+
+    m_parallelObjects.clear();
+    for (auto const& go : m_objects) {
+        if (go->canSimulateInParallel()) {
+            m_parallelObjects.push_back(go.get());
+        }
+    }
+    m_lastUpdateTimings.numberOfParallelObjects = m_parallelObjects.size();
+    m_lastUpdateTimings.numberOfSerialObjects = m_objects.size() - m_parallelObjects.size();
+
+    auto const simulateStart = std::chrono::steady_clock::now();
+    {
+        JT_PROFILE_ZONE("jt::GameObjectCollection::simulate");
+        jobSystem.parallelFor(
+            m_parallelObjects.size(), [this, elapsed](std::size_t begin, std::size_t end) {
+                for (auto i = begin; i != end; ++i) {
+                    m_parallelObjects[i]->simulate(elapsed);
+                }
+            });
+    }
+    m_lastUpdateTimings.simulateTimeInSeconds = jt::getDurationInSecondsSince(simulateStart);
+
+    auto const commitStart = std::chrono::steady_clock::now();
+    {
+        JT_PROFILE_ZONE("jt::GameObjectCollection::commit");
+        // m_parallelObjects is in the order of m_objects, so a single cursor is enough to decide
+        // which objects were simulated already.
+        std::size_t nextParallelObject { 0u };
+        for (auto& go : m_objects) {
+            if (nextParallelObject != m_parallelObjects.size()
+                && m_parallelObjects[nextParallelObject] == go.get()) {
+                ++nextParallelObject;
+                go->commit(elapsed);
+            } else {
+                go->update(elapsed);
+            }
+        }
+    }
+    m_lastUpdateTimings.commitTimeInSeconds = jt::getDurationInSecondsSince(commitStart);
+}
+
+jt::GameObjectUpdateTimings jt::GameObjectCollection::getLastUpdateTimings() const noexcept
+{
+    return m_lastUpdateTimings;
+}
+
 void jt::GameObjectCollection::draw() const
 {
     for (auto const& go : m_objects) {
@@ -2,10 +2,23 @@
 #define JAMTEMPLATE_GAME_OBJECT_COLLECTION_HPP
 
 #include <game_object_interface.hpp>
+#include <jobs/job_system_interface.hpp>
+#include <cstddef>
 #include <memory>
 #include <vector>
 
 namespace jt {
+
+/// Timings of the last phased update of a GameObjectCollection
+struct GameObjectUpdateTimings {
+    /// duration of the parallel simulate phase
+    float simulateTimeInSeconds { 0.0f };
+    /// duration of the serial phase (commit and update of objects that do not run in parallel)
+    float commitTimeInSeconds { 0.0f };
+    std::size_t numberOfParallelObjects { 0u };
+    std::size_t numberOfSerialObjects { 0u };
+};
+
 class GameObjectCollection {
 public:
     /// clear all GameObjects
@@ -19,6 +32,17 @@ public:
     /// \param elapsed the elapsed time in seconds
     void update(float elapsed);
 
+    /// Update all GameObjects in two phases. First simulate() is called for all objects that can
+    /// simulate in parallel, distributed over the workers of jobSystem. Afterwards, in the order
+    /// of insertion, commit() is called for those objects and update() for all other objects.
+    /// \param elapsed the elapsed time in seconds
+    /// \param jobSystem the job system to run the simulate phase on
+    void update(float elapsed, jt::JobSystemInterface& jobSystem);
+
+    /// Get the timings of the last phased update
+    /// \return the timings
+    jt::GameObjectUpdateTimings getLastUpdateTimings() const noexcept;
+
     /// Draw all GameObjects
     void draw() const;
 
@@ -38,6 +62,11 @@ private:
     /// but to place them in this vector first and add them to m_objects,
     /// once it is safe to do so.
     std::vector<std::shared_ptr<jt::GameObjectInterface>> m_objectsToAdd {};
+
+    /// objects updated in the simulate phase of the current phased update, kept to reuse memory
+    std::vector<jt::GameObjectInterface*> m_parallelObjects {};
+    jt::GameObjectUpdateTimings m_lastUpdateTimings {};
+
     void addNewObjects();
     void cleanUpObjects();
 };
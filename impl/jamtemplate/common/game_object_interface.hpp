@@ -10,6 +10,13 @@ public:
 
     virtual void create() = 0;
     virtual void update(float elapsed) = 0;
+
+    /// Check if simulate() may be called from worker threads concurrently to other objects
+    virtual bool canSimulateInParallel() const = 0;
+    /// Thread safe part of update(), see canSimulateInParallel()
+    virtual void simulate(float elapsed) = 0;
+    /// Serial part of update(), called after simulate() of all objects is done
+    virtual void commit(float elapsed) = 0;
     virtual void draw() const = 0;
 
     virtual void kill() = 0;
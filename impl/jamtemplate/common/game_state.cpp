@@ -3,8 +3,17 @@
 #include <game_state.hpp>
 #include <log/console.hpp>
 #include <log/info_screen.hpp>
+#include <log/log_macros.hpp>
 #include <tween_collection.hpp>
 #include <algorithm>
+#include <array>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 2> gameStateTags { "jt", "GameState" };
+
+} // namespace
 
 jt::GameState::GameState()
 {
@@ -45,7 +54,7 @@ void jt::GameState::doEnter() { internalEnter(); }
 
 void jt::GameState::internalCreate()
 {
-    getGame()->logger().debug("create GameState: " + getName(), { "jt", "GameState" });
+    JT_LOG_DEBUG(getGame()->logger(), "create GameState: " + getName(), gameStateTags);
     onCreate();
     add(std::make_shared<jt::Console>());
     add(std::make_shared<jt::InfoScreen>());
@@ -54,7 +63,7 @@ void jt::GameState::internalCreate()
 
 void jt::GameState::internalEnter()
 {
-    getGame()->logger().debug("enter GameState: " + getName(), { "jt", "GameState" });
+    JT_LOG_DEBUG(getGame()->logger(), "enter GameState: " + getName(), gameStateTags);
     m_tweens->clear();
     onEnter();
 }
@@ -92,7 +101,14 @@ void jt::GameState::internalDraw() const
     onDraw();
 }
 
-void jt::GameState::updateObjects(float elapsed) { m_objects->update(elapsed); }
+void jt::GameState::updateObjects(float elapsed)
+{
+    if (m_doParallelUpdateObjects) {
+        m_objects->update(elapsed, getGame()->jobSystem());
+    } else {
+        m_objects->update(elapsed);
+    }
+}
 
 void jt::GameState::updateTweens(float elapsed)
 {
@@ -115,6 +131,18 @@ void jt::GameState::setAutoUpdateObjects(bool performAutoUpdate) noexcept
 
 bool jt::GameState::getAutoUpdateObjects() const noexcept { return m_doAutoUpdateObjects; }
 
+void jt::GameState::setParallelUpdateObjects(bool performParallelUpdate) noexcept
+{
+    m_doParallelUpdateObjects = performParallelUpdate;
+}
+
+bool jt::GameState::getParallelUpdateObjects() const noexcept { return m_doParallelUpdateObjects; }
+
+jt::GameObjectUpdateTimings jt::GameState::getObjectUpdateTimings() const noexcept
+{
+    return m_objects->getLastUpdateTimings();
+}
+
 void jt::GameState::setAutoUpdateTweens(bool performAutoUpdate) noexcept
 {
     m_doAutoUpdateTweens = performAutoUpdate;
@@ -11,6 +11,7 @@
 namespace jt {
 
 class GameObjectCollection;
+struct GameObjectUpdateTimings;
 class TweenCollection;
 
 class GameState : public jt::GameObject {
@@ -55,6 +56,20 @@ public:
     /// \return
     bool getAutoUpdateObjects() const noexcept;
 
+    /// Set parallel update of Objects
+    /// note: objects that return true from canSimulateInParallel() are then simulated on the
+    /// game's job system, followed by a serial commit phase. Other objects are updated as before.
+    /// \param performParallelUpdate
+    void setParallelUpdateObjects(bool performParallelUpdate) noexcept;
+
+    /// Get parallel update of Objects
+    /// \return
+    bool getParallelUpdateObjects() const noexcept;
+
+    /// Get the timings of the last parallel update of Objects
+    /// \return the timings
+    jt::GameObjectUpdateTimings getObjectUpdateTimings() const noexcept;
+
     /// Set auto update of Tweens
     /// note: if the user sets autoupdate to false,
     /// he has to take care to do the respective calls himself
@@ -84,6 +99,7 @@ private:
     std::unique_ptr<jt::GameObjectCollection> m_objects;
 
     bool m_doAutoUpdateObjects { true };
+    bool m_doParallelUpdateObjects { false };
     bool m_doAutoUpdateTweens { true };
     bool m_doAutoDraw { true };
 
@@ -0,0 +1,50 @@
+#include "alpha_mask.hpp"
+#include <trace_profiler.hpp>
+#include <bit>
+#include <cstring>
+
+namespace {
+// position of the alpha byte (the fourth byte in memory) when reading a pixel as one integer
+constexpr unsigned int alphaShift { std::endian::native == std::endian::little ? 24u : 0u };
+} // namespace
+
+// Both kernels are branch free loops over contiguous memory, so the compiler can vectorize them.
+
+std::size_t jt::AlphaMask::getSizeInBytes() const noexcept { return mask.size(); }
+
+jt::AlphaMask jt::createAlphaMask(
+    std::uint8_t const* rgba, unsigned int width, unsigned int height, std::size_t pitch)
+{
+    JT_PROFILE_ZONE("jt::createAlphaMask");
+    AlphaMask alphaMask { width, height, {} };
+    alphaMask.mask.resize(static_cast<std::size_t>(width) * height);
+
+    for (auto y = 0u; y != height; ++y) {
+        std::uint8_t const* const src = rgba + y * pitch;
+        std::uint8_t* const dst = alphaMask.mask.data() + static_cast<std::size_t>(y) * width;
+        for (std::size_t x = 0u; x != width; ++x) {
+            std::uint32_t pixel { 0u };
+            std::memcpy(&pixel, src + 4u * x, sizeof(pixel));
+            auto const isVisible = static_cast<unsigned int>(((pixel >> alphaShift) & 0xFFu) != 0u);
+            // 0 - 1 wraps around to 255
+            dst[x] = static_cast<std::uint8_t>(0u - isVisible);
+        }
+    }
+    return alphaMask;
+}
+
+std::vector<std::uint8_t> jt::createFlashPixels(AlphaMask const& mask)
+{
+    JT_PROFILE_ZONE("jt::createFlashPixels");
+    auto const numberOfPixels = mask.mask.size();
+    std::vector<std::uint8_t> pixels(numberOfPixels * 4u);
+
+    std::uint8_t const* const src = mask.mask.data();
+    std::uint8_t* const dst = pixels.data();
+    for (std::size_t i = 0u; i != numberOfPixels; ++i) {
+        // spread the mask byte to all four channels: white or fully transparent
+        std::uint32_t const pixel = src[i] * 0x01010101u;
+        std::memcpy(dst + 4u * i, &pixel, sizeof(pixel));
+    }
+    return pixels;
+}
@@ -0,0 +1,39 @@
+#ifndef JAMTEMPLATE_ALPHA_MASK_HPP
+#define JAMTEMPLATE_ALPHA_MASK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jt {
+
+/// Alpha channel of an image with one byte per pixel, 255 for visible and 0 for fully transparent
+/// pixels. This is all that is needed to create the flash image of a texture, at a quarter of the
+/// memory of the image.
+struct AlphaMask {
+    unsigned int width { 0u };
+    unsigned int height { 0u };
+    std::vector<std::uint8_t> mask {};
+
+    /// Get the memory used by the mask
+    /// \return size in bytes
+    std::size_t getSizeInBytes() const noexcept;
+};
+
+/// Create an alpha mask from RGBA pixels
+/// \param rgba pixel data with 4 bytes per pixel, alpha being the fourth byte
+/// \param width width in pixel
+/// \param height height in pixel
+/// \param pitch bytes per row, at least 4 * width
+/// \return the alpha mask
+AlphaMask createAlphaMask(
+    std::uint8_t const* rgba, unsigned int width, unsigned int height, std::size_t pitch);
+
+/// Create the pixels of a flash image: white where the mask is set, transparent otherwise
+/// \param mask the alpha mask
+/// \return pixel data with 4 bytes per pixel and a pitch of 4 * width
+std::vector<std::uint8_t> createFlashPixels(AlphaMask const& mask);
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_ALPHA_MASK_HPP
@@ -0,0 +1,410 @@
+#include "aseprite_cache.hpp"
+#include <aselib/image_builder.hpp>
+#include <strutils.hpp>
+#include <trace_profiler.hpp>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+// Cache file layout: FileHeader, FrameRecords, TagRecords, tag name blob and the RGBA pixels. All
+// records are referenced by absolute byte offsets and consist of 4 byte fields, so they can be
+// used in place from the memory mapped file. All values are little endian.
+
+constexpr std::array<char, 4> magic { 'J', 'T', 'A', 'S' };
+
+/// Increase whenever the layout of any record or the decoding of aseprite files changes
+constexpr std::uint32_t formatVersion { 1u };
+
+constexpr char const* fileExtension { ".jtase" };
+
+struct FileHeader {
+    std::array<char, 4> magic {};
+    std::uint32_t version { 0u };
+    /// hash of the aseprite file content and the postfix options, split into two halves
+    std::uint32_t keyLow { 0u };
+    std::uint32_t keyHigh { 0u };
+    std::uint32_t imageWidth { 0u };
+    std::uint32_t imageHeight { 0u };
+    std::uint32_t frameWidth { 0u };
+    std::uint32_t frameHeight { 0u };
+    std::uint32_t frameOffset { 0u };
+    std::uint32_t frameCount { 0u };
+    std::uint32_t tagOffset { 0u };
+    std::uint32_t tagCount { 0u };
+    std::uint32_t stringsOffset { 0u };
+    std::uint32_t stringsSize { 0u };
+    std::uint32_t pixelOffset { 0u };
+    std::uint32_t pixelSize { 0u };
+};
+
+struct FrameRecord {
+    std::uint32_t durationInMs { 0u };
+};
+
+struct TagRecord {
+    std::uint32_t nameOffset { 0u };
+    std::uint32_t nameLength { 0u };
+    std::uint32_t fromFrame { 0u };
+    std::uint32_t toFrame { 0u };
+    std::uint32_t repeat { 0u };
+};
+
+template <typename T>
+constexpr bool isValidRecord()
+{
+    return std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> && alignof(T) == 4u
+        && sizeof(T) % 4u == 0u;
+}
+
+static_assert(std::endian::native == std::endian::little,
+    "cached aseprite files are stored little endian and used in place");
+static_assert(isValidRecord<FileHeader>());
+static_assert(isValidRecord<FrameRecord>());
+static_assert(isValidRecord<TagRecord>());
+
+std::mutex cacheDirectoryMutex {};
+#if defined(JT_ENABLE_WEB)
+// assets are preloaded into memory, a disk cache would only cost time
+std::string cacheDirectory {};
+#else
+std::string cacheDirectory { ".jtcache" };
+#endif
+
+std::pair<std::string, std::string> splitFileName(std::string const& fileName)
+{
+    auto const asepritePos = fileName.rfind(".aseprite");
+    if (asepritePos == std::string::npos) {
+        throw std::invalid_argument { "'" + fileName + "' is not an aseprite file" };
+    }
+    return { fileName.substr(0, asepritePos + 9), fileName.substr(asepritePos + 9) };
+}
+
+std::uint64_t hashBytes(std::uint64_t hash, void const* data, std::size_t size)
+{
+    // FNV-1a
+    auto const bytes = static_cast<unsigned char const*>(data);
+    for (std::size_t i = 0u; i != size; ++i) {
+        hash ^= static_cast<std::uint64_t>(bytes[i]);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::uint64_t calculateKey(std::string const& baseFileName, std::string const& postFix)
+{
+    JT_PROFILE_ZONE("jt::loadDecodedAseprite hash");
+    jt::MappedFile const source { baseFileName };
+    auto key = hashBytes(0xcbf29ce484222325ull, source.data(), source.size());
+    key = hashBytes(key, postFix.data(), postFix.size());
+    return hashBytes(key, &formatVersion, sizeof(formatVersion));
+}
+
+std::string getCacheFileName(std::string const& directory, std::uint64_t key)
+{
+    constexpr std::string_view digits { "0123456789abcdef" };
+    std::string name(16u, '0');
+    for (auto i = 0u; i != 16u; ++i) {
+        name[15u - i] = digits[(key >> (4u * i)) & 0xfu];
+    }
+    return (std::filesystem::path { directory } / (name + fileExtension)).string();
+}
+
+std::shared_ptr<jt::DecodedAseprite const> decode(
+    std::string const& baseFileName, std::string const& postFix)
+{
+    JT_PROFILE_ZONE("jt::loadDecodedAseprite decode");
+    aselib::AsepriteData const aseData { baseFileName };
+
+    std::unique_ptr<aselib::Image> aseImage { nullptr };
+    if (strutil::contains(postFix, ".layer=")) {
+        auto const layerPos = postFix.find(".layer=");
+        auto const layerName = postFix.substr(layerPos + 7);
+        aseImage = std::make_unique<aselib::Image>(aselib::makeImageFromLayer(aseData, layerName));
+    } else {
+        auto const ignore_transparent = strutil::contains(postFix, ".ignore_transparent");
+        aseImage = std::make_unique<aselib::Image>(
+            aselib::makeImageFromAse(aseData, !ignore_transparent));
+    }
+
+    auto const w = aseImage->m_width;
+    auto const h = aseImage->m_height;
+    std::vector<std::uint8_t> pixels(static_cast<std::size_t>(w) * h * 4u);
+    auto out = pixels.begin();
+    for (auto j = 0u; j != h; ++j) {
+        for (auto i = 0u; i != w; ++i) {
+            auto const& p = aseImage->m_pixels[aseImage->posToIndex(i, j)];
+            *out++ = p.r;
+            *out++ = p.g;
+            *out++ = p.b;
+            *out++ = p.a;
+        }
+    }
+
+    std::vector<std::uint32_t> frameDurations {};
+    frameDurations.reserve(aseData.m_frames.size());
+    for (auto const& frame : aseData.m_frames) {
+        frameDurations.push_back(frame.m_frame_header.m_frame_duration);
+    }
+
+    std::vector<jt::AsepriteTag> tags {};
+    if (!aseData.m_frames.empty()) {
+        for (auto const& tagChunk : aseData.m_frames[0].m_chunks.m_tag_chunks) {
+            for (auto const& tag : tagChunk.m_tags) {
+                tags.push_back(jt::AsepriteTag { tag.m_tag_name, tag.m_from_frame,
+                    tag.m_to_frame, tag.m_repeat_animation == 0 });
+            }
+        }
+    }
+
+    return std::make_shared<jt::DecodedAseprite const>(jt::Vector2u { w, h },
+        jt::Vector2u { aseData.m_header.m_width_in_pixel, aseData.m_header.m_height_in_pixel },
+        std::move(frameDurations), std::move(tags), std::move(pixels));
+}
+
+class FileBuilder {
+public:
+    template <typename T>
+    std::uint32_t append(T const* records, std::size_t count)
+    {
+        auto const offset = static_cast<std::uint32_t>(m_data.size());
+        auto const bytes = sizeof(T) * count;
+        // keep every record 4 byte aligned, even after the unaligned string blob
+        m_data.resize(m_data.size() + (bytes + 3u) / 4u * 4u);
+        if (bytes != 0u) {
+            std::memcpy(m_data.data() + offset, records, bytes);
+        }
+        return offset;
+    }
+
+    template <typename T>
+    std::uint32_t append(std::vector<T> const& records)
+    {
+        return append(records.data(), records.size());
+    }
+
+    std::vector<char>& getData() noexcept { return m_data; }
+
+private:
+    std::vector<char> m_data {};
+};
+
+void writeCacheFile(std::string const& directory, std::string const& cacheFileName,
+    std::uint64_t key, jt::DecodedAseprite const& decoded)
+{
+    JT_PROFILE_ZONE("jt::loadDecodedAseprite write");
+    std::vector<FrameRecord> frames {};
+    for (auto const duration : decoded.getFrameDurations()) {
+        frames.push_back(FrameRecord { duration });
+    }
+    std::vector<TagRecord> tags {};
+    std::vector<char> strings {};
+    for (auto const& tag : decoded.getTags()) {
+        tags.push_back(TagRecord { static_cast<std::uint32_t>(strings.size()),
+            static_cast<std::uint32_t>(tag.name.size()), tag.fromFrame, tag.toFrame,
+            tag.repeat ? 1u : 0u });
+        strings.insert(strings.end(), tag.name.begin(), tag.name.end());
+    }
+
+    FileHeader header {};
+    header.magic = magic;
+    header.version = formatVersion;
+    header.keyLow = static_cast<std::uint32_t>(key);
+    header.keyHigh = static_cast<std::uint32_t>(key >> 32u);
+    header.imageWidth = decoded.getImageSize().x;
+    header.imageHeight = decoded.getImageSize().y;
+    header.frameWidth = decoded.getFrameSize().x;
+    header.frameHeight = decoded.getFrameSize().y;
+    header.frameCount = static_cast<std::uint32_t>(frames.size());
+    header.tagCount = static_cast<std::uint32_t>(tags.size());
+    header.stringsSize = static_cast<std::uint32_t>(strings.size());
+    header.pixelSize = static_cast<std::uint32_t>(decoded.getPixels().size());
+
+    FileBuilder builder {};
+    builder.append(&header, 1u);
+    header.frameOffset = builder.append(frames);
+    header.tagOffset = builder.append(tags);
+    header.stringsOffset = builder.append(strings);
+    header.pixelOffset = builder.append(decoded.getPixels().data(), decoded.getPixels().size());
+    std::memcpy(builder.getData().data(), &header, sizeof(header));
+
+    // write to a temporary file first, so concurrent loads never map a half written file
+    std::error_code ec;
+    std::filesystem::create_directories(directory, ec);
+    auto const tempFileName = cacheFileName + "."
+        + std::to_string(std::hash<std::thread::id> {}(std::this_thread::get_id())) + ".tmp";
+    {
+        auto const& data = builder.getData();
+        std::ofstream file { tempFileName, std::ios::binary | std::ios::trunc };
+        file.write(data.data(), static_cast<std::streamsize>(data.size()));
+        if (!file) {
+            std::cerr << "Warning: cannot write aseprite cache file '" << tempFileName << "'"
+                      << std::endl;
+            file.close();
+            std::filesystem::remove(tempFileName, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tempFileName, cacheFileName, ec);
+    if (ec) {
+        std::filesystem::remove(tempFileName, ec);
+    }
+}
+
+template <typename T>
+bool isArrayInFile(jt::MappedFile const& file, std::uint32_t offset, std::uint32_t count) noexcept
+{
+    return offset % alignof(T) == 0u && offset <= file.size()
+        && (file.size() - offset) / sizeof(T) >= count;
+}
+
+template <typename T>
+std::span<T const> getArray(
+    jt::MappedFile const& file, std::uint32_t offset, std::uint32_t count) noexcept
+{
+    return std::span<T const> { reinterpret_cast<T const*>(file.data() + offset), count };
+}
+
+std::shared_ptr<jt::DecodedAseprite const> readCacheFile(
+    std::string const& cacheFileName, std::uint64_t key)
+{
+    JT_PROFILE_ZONE("jt::loadDecodedAseprite read");
+    std::error_code ec;
+    if (!std::filesystem::exists(cacheFileName, ec)) {
+        return nullptr;
+    }
+    std::unique_ptr<jt::MappedFile> file { nullptr };
+    try {
+        file = std::make_unique<jt::MappedFile>(cacheFileName);
+    } catch (std::invalid_argument const&) {
+        return nullptr;
+    }
+
+    if (!isArrayInFile<FileHeader>(*file, 0u, 1u)) {
+        return nullptr;
+    }
+    auto const& header = getArray<FileHeader>(*file, 0u, 1u).front();
+    if (header.magic != magic || header.version != formatVersion
+        || header.keyLow != static_cast<std::uint32_t>(key)
+        || header.keyHigh != static_cast<std::uint32_t>(key >> 32u)
+        || !isArrayInFile<FrameRecord>(*file, header.frameOffset, header.frameCount)
+        || !isArrayInFile<TagRecord>(*file, header.tagOffset, header.tagCount)
+        || !isArrayInFile<char>(*file, header.stringsOffset, header.stringsSize)
+        || !isArrayInFile<std::uint8_t>(*file, header.pixelOffset, header.pixelSize)
+        || static_cast<std::uint64_t>(header.imageWidth) * header.imageHeight * 4u
+            != header.pixelSize) {
+        return nullptr;
+    }
+
+    std::vector<std::uint32_t> frameDurations {};
+    frameDurations.reserve(header.frameCount);
+    for (auto const& frame : getArray<FrameRecord>(*file, header.frameOffset, header.frameCount)) {
+        frameDurations.push_back(frame.durationInMs);
+    }
+
+    auto const strings = getArray<char>(*file, header.stringsOffset, header.stringsSize);
+    std::vector<jt::AsepriteTag> tags {};
+    tags.reserve(header.tagCount);
+    for (auto const& tag : getArray<TagRecord>(*file, header.tagOffset, header.tagCount)) {
+        if (tag.nameOffset > strings.size() || strings.size() - tag.nameOffset < tag.nameLength) {
+            return nullptr;
+        }
+        tags.push_back(jt::AsepriteTag { std::string { strings.data() + tag.nameOffset,
+                                             tag.nameLength },
+            tag.fromFrame, tag.toFrame, tag.repeat != 0u });
+    }
+
+    auto const pixels = getArray<std::uint8_t>(*file, header.pixelOffset, header.pixelSize);
+    return std::make_shared<jt::DecodedAseprite const>(
+        jt::Vector2u { header.imageWidth, header.imageHeight },
+        jt::Vector2u { header.frameWidth, header.frameHeight }, std::move(frameDurations),
+        std::move(tags), std::move(file), pixels);
+}
+
+} // namespace
+
+jt::DecodedAseprite::DecodedAseprite(jt::Vector2u const& imageSize, jt::Vector2u const& frameSize,
+    std::vector<std::uint32_t> frameDurations, std::vector<jt::AsepriteTag> tags,
+    std::vector<std::uint8_t> pixels)
+    : m_imageSize { imageSize }
+    , m_frameSize { frameSize }
+    , m_frameDurations { std::move(frameDurations) }
+    , m_tags { std::move(tags) }
+    , m_ownedPixels { std::move(pixels) }
+    , m_pixels { m_ownedPixels }
+{
+}
+
+jt::DecodedAseprite::DecodedAseprite(jt::Vector2u const& imageSize, jt::Vector2u const& frameSize,
+    std::vector<std::uint32_t> frameDurations, std::vector<jt::AsepriteTag> tags,
+    std::unique_ptr<jt::MappedFile> file, std::span<std::uint8_t const> pixels)
+    : m_imageSize { imageSize }
+    , m_frameSize { frameSize }
+    , m_frameDurations { std::move(frameDurations) }
+    , m_tags { std::move(tags) }
+    , m_file { std::move(file) }
+    , m_pixels { pixels }
+{
+}
+
+jt::Vector2u jt::DecodedAseprite::getImageSize() const noexcept { return m_imageSize; }
+
+jt::Vector2u jt::DecodedAseprite::getFrameSize() const noexcept { return m_frameSize; }
+
+std::size_t jt::DecodedAseprite::getNumberOfFrames() const noexcept
+{
+    return m_frameDurations.size();
+}
+
+std::vector<std::uint32_t> const& jt::DecodedAseprite::getFrameDurations() const noexcept
+{
+    return m_frameDurations;
+}
+
+std::vector<jt::AsepriteTag> const& jt::DecodedAseprite::getTags() const noexcept
+{
+    return m_tags;
+}
+
+std::span<std::uint8_t const> jt::DecodedAseprite::getPixels() const noexcept { return m_pixels; }
+
+std::shared_ptr<jt::DecodedAseprite const> jt::loadDecodedAseprite(std::string const& fileName)
+{
+    JT_PROFILE_ZONE("jt::loadDecodedAseprite");
+    auto const [baseFileName, postFix] = splitFileName(fileName);
+    auto const directory = getAsepriteCacheDirectory();
+    if (directory.empty()) {
+        return decode(baseFileName, postFix);
+    }
+
+    auto const key = calculateKey(baseFileName, postFix);
+    auto const cacheFileName = getCacheFileName(directory, key);
+    if (auto cached = readCacheFile(cacheFileName, key)) {
+        return cached;
+    }
+    auto decoded = decode(baseFileName, postFix);
+    writeCacheFile(directory, cacheFileName, key, *decoded);
+    return decoded;
+}
+
+void jt::setAsepriteCacheDirectory(std::string const& directory)
+{
+    std::lock_guard const lock { cacheDirectoryMutex };
+    cacheDirectory = directory;
+}
+
+std::string jt::getAsepriteCacheDirectory()
+{
+    std::lock_guard const lock { cacheDirectoryMutex };
+    return cacheDirectory;
+}
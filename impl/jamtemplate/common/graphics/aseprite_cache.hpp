@@ -0,0 +1,90 @@
+#ifndef JAMTEMPLATE_ASEPRITE_CACHE_HPP
+#define JAMTEMPLATE_ASEPRITE_CACHE_HPP
+
+#include <mapped_file.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// Animation tag defined in an aseprite file
+struct AsepriteTag {
+    std::string name {};
+    unsigned int fromFrame { 0u };
+    unsigned int toFrame { 0u };
+    bool repeat { true };
+};
+
+/// Decoded aseprite file: the image with all frames side by side and the animation metadata. The
+/// pixels are either owned or a view into a memory mapped cache file.
+class DecodedAseprite {
+public:
+    /// Constructor for freshly decoded pixels
+    /// \param imageSize size of the whole image in pixel
+    /// \param frameSize size of a single frame in pixel
+    /// \param frameDurations duration of each frame in milliseconds
+    /// \param tags animation tags
+    /// \param pixels RGBA pixels, 4 byte per pixel, rows without padding
+    DecodedAseprite(jt::Vector2u const& imageSize, jt::Vector2u const& frameSize,
+        std::vector<std::uint32_t> frameDurations, std::vector<jt::AsepriteTag> tags,
+        std::vector<std::uint8_t> pixels);
+
+    /// Constructor for pixels stored in a memory mapped cache file
+    /// \param file the mapped cache file, kept alive as long as this object
+    /// \param pixels view of the RGBA pixels inside the mapped file
+    DecodedAseprite(jt::Vector2u const& imageSize, jt::Vector2u const& frameSize,
+        std::vector<std::uint32_t> frameDurations, std::vector<jt::AsepriteTag> tags,
+        std::unique_ptr<jt::MappedFile> file, std::span<std::uint8_t const> pixels);
+
+    // no copy, no move. The pixel view points into owned memory.
+    DecodedAseprite(DecodedAseprite const&) = delete;
+    DecodedAseprite(DecodedAseprite&&) = delete;
+    DecodedAseprite& operator=(DecodedAseprite const&) = delete;
+    DecodedAseprite& operator=(DecodedAseprite&&) = delete;
+
+    jt::Vector2u getImageSize() const noexcept;
+    jt::Vector2u getFrameSize() const noexcept;
+    std::size_t getNumberOfFrames() const noexcept;
+
+    /// Get the frame durations
+    /// \return duration of each frame in milliseconds
+    std::vector<std::uint32_t> const& getFrameDurations() const noexcept;
+
+    std::vector<jt::AsepriteTag> const& getTags() const noexcept;
+
+    /// Get the pixels of the whole image
+    /// \return RGBA pixels, 4 byte per pixel, rows without padding
+    std::span<std::uint8_t const> getPixels() const noexcept;
+
+private:
+    jt::Vector2u m_imageSize {};
+    jt::Vector2u m_frameSize {};
+    std::vector<std::uint32_t> m_frameDurations {};
+    std::vector<jt::AsepriteTag> m_tags {};
+    std::vector<std::uint8_t> m_ownedPixels {};
+    std::unique_ptr<jt::MappedFile> m_file { nullptr };
+    std::span<std::uint8_t const> m_pixels {};
+};
+
+/// Load an aseprite file via the decoded image cache. The cache file is keyed by a hash of the
+/// aseprite file content and the postfix options, so changed files are decoded again. If nothing
+/// changed, the cache file is memory mapped and aselib is not involved at all.
+/// \param fileName aseprite file name, optionally followed by ".layer=<name>" or
+/// ".ignore_transparent"
+/// \return the decoded aseprite file, throws std::invalid_argument if the file cannot be read
+std::shared_ptr<jt::DecodedAseprite const> loadDecodedAseprite(std::string const& fileName);
+
+/// Set the directory the decoded aseprite files are stored in. The directory is created on demand.
+/// \param directory the cache directory, an empty string disables the disk cache
+void setAsepriteCacheDirectory(std::string const& directory);
+
+std::string getAsepriteCacheDirectory();
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_ASEPRITE_CACHE_HPP
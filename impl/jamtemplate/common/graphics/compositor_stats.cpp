@@ -0,0 +1,63 @@
+#include "compositor_stats.hpp"
+#include <algorithm>
+#include <limits>
+
+std::size_t jt::CompositorStats::getNumberOfCompositedLayers() const noexcept
+{
+    return static_cast<std::size_t>(std::count_if(
+        layers.cbegin(), layers.cend(), [](auto const& l) { return l.isComposited; }));
+}
+
+std::size_t jt::CompositorStats::getNumberOfSkippedLayers() const noexcept
+{
+    return static_cast<std::size_t>(std::count_if(layers.cbegin(), layers.cend(),
+        [](auto const& l) { return !l.isCleared && !l.isComposited; }));
+}
+
+float jt::CompositorStats::getTotalClearTimeInSeconds() const noexcept
+{
+    float sum { 0.0f };
+    for (auto const& l : layers) {
+        sum += l.clearTimeInSeconds;
+    }
+    return sum;
+}
+
+float jt::CompositorStats::getTotalCompositeTimeInSeconds() const noexcept
+{
+    float sum { 0.0f };
+    for (auto const& l : layers) {
+        sum += l.compositeTimeInSeconds;
+    }
+    return sum;
+}
+
+void jt::FramePacingCounter::onPresent(float presentTimeInSeconds)
+{
+    auto const now = std::chrono::steady_clock::now();
+    m_stats.presentTimeInSeconds = presentTimeInSeconds;
+    if (!m_lastPresent.has_value()) {
+        m_lastPresent = now;
+        return;
+    }
+    m_stats.frameIntervalInSeconds
+        = std::chrono::duration<float>(now - m_lastPresent.value()).count();
+    m_lastPresent = now;
+    m_frameIntervals.put(m_stats.frameIntervalInSeconds);
+
+    float sum { 0.0f };
+    float min { std::numeric_limits<float>::max() };
+    float max { 0.0f };
+    auto const head = m_frameIntervals.getHead();
+    for (auto i = 0u; i != m_frameIntervals.size(); ++i) {
+        auto const interval = m_frameIntervals[head + i];
+        sum += interval;
+        min = std::min(min, interval);
+        max = std::max(max, interval);
+    }
+    m_stats.averageFrameIntervalInSeconds = sum / static_cast<float>(m_frameIntervals.size());
+    m_stats.minFrameIntervalInSeconds = min;
+    m_stats.maxFrameIntervalInSeconds = max;
+}
+
+jt::FramePacingStats const& jt::FramePacingCounter::getStats() const noexcept { return m_stats; }
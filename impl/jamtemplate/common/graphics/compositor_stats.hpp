@@ -0,0 +1,68 @@
+#ifndef JAMTEMPLATE_COMPOSITOR_STATS_HPP
+#define JAMTEMPLATE_COMPOSITOR_STATS_HPP
+
+#include <circular_buffer.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace jt {
+
+/// Statistics of a single z layer in the last frame
+struct LayerStats {
+    int z { 0 };
+    /// number of times the layer was requested for drawing
+    std::uint32_t numberOfDrawRequests { 0u };
+    /// the layer was cleared, which only happens if something was drawn to it
+    bool isCleared { false };
+    /// the layer was drawn onto the window
+    bool isComposited { false };
+    float clearTimeInSeconds { 0.0f };
+    float compositeTimeInSeconds { 0.0f };
+};
+
+/// Timing of the presented frames
+struct FramePacingStats {
+    /// time spent presenting the last frame, including the wait for vsync
+    float presentTimeInSeconds { 0.0f };
+    /// time between the last two presents
+    float frameIntervalInSeconds { 0.0f };
+    /// average, minimum and maximum time between presents over the recent frames
+    float averageFrameIntervalInSeconds { 0.0f };
+    float minFrameIntervalInSeconds { 0.0f };
+    float maxFrameIntervalInSeconds { 0.0f };
+};
+
+/// Statistics about combining the z layers into the window image in the last frame
+struct CompositorStats {
+    /// one entry per z layer in ascending z order
+    std::vector<jt::LayerStats> layers {};
+    jt::FramePacingStats pacing {};
+
+    std::size_t getNumberOfCompositedLayers() const noexcept;
+    /// number of layers that were neither cleared nor composited, because nothing was drawn to them
+    std::size_t getNumberOfSkippedLayers() const noexcept;
+    float getTotalClearTimeInSeconds() const noexcept;
+    float getTotalCompositeTimeInSeconds() const noexcept;
+};
+
+/// Measures the time between presented frames
+class FramePacingCounter {
+public:
+    /// Register a present of the window
+    /// \param presentTimeInSeconds the time the present took
+    void onPresent(float presentTimeInSeconds);
+
+    jt::FramePacingStats const& getStats() const noexcept;
+
+private:
+    std::optional<std::chrono::steady_clock::time_point> m_lastPresent {};
+    jt::CircularBuffer<float, 64> m_frameIntervals {};
+    jt::FramePacingStats m_stats {};
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_COMPOSITOR_STATS_HPP
@@ -12,6 +12,10 @@ void jt::DrawableImpl::draw(std::shared_ptr<jt::RenderTargetInterface> targetCon
     if (!targetContainer) [[unlikely]] {
         return;
     }
+    // getting the layer marks it as used for this frame, so skip it if nothing would be drawn
+    if (!isVisible() || !allowDrawFromFlicker()) {
+        return;
+    }
     auto const sptr = targetContainer->get(m_z);
     if (sptr) [[likely]] {
         draw(sptr);
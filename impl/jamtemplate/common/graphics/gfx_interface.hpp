@@ -2,6 +2,7 @@
 #define JAMTEMPLATE_GFX_INTERFACE_HPP
 
 #include <cam_interface.hpp>
+#include <graphics/compositor_stats.hpp>
 #include <graphics/render_target_interface.hpp>
 #include <graphics/render_window_interface.hpp>
 #include <texture_manager_interface.hpp>
@@ -44,6 +45,10 @@ public:
     /// drawn above z layer 1.
     virtual void createZLayer(int z) = 0;
 
+    /// Get statistics about combining the z layers into the window image
+    /// \return the statistics of the last displayed frame
+    virtual jt::CompositorStats getCompositorStats() const = 0;
+
     virtual ~GfxInterface() = default;
 
     // no copy, no move. Avoid slicing.
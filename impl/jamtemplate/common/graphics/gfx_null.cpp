@@ -1,11 +1,51 @@
 #include "gfx_null.hpp"
 #include <render_target_lib.hpp>
+#include <stdexcept>
+#if !USE_SFML
+#include <sdl_2_include.hpp>
+#endif
+
+namespace {
+
+#if USE_SFML
+std::shared_ptr<jt::RenderTarget> createNullRenderTarget(jt::Vector2f const& /*size*/)
+{
+    return std::make_shared<jt::RenderTarget>();
+}
+#else
+std::shared_ptr<jt::RenderTarget> createNullRenderTarget(jt::Vector2f const& size)
+{
+    // SDL needs a renderer to create textures. A software renderer drawing into a surface works
+    // without a window or gpu.
+    auto* const surface = SDL_CreateRGBSurfaceWithFormat(
+        0, static_cast<int>(size.x), static_cast<int>(size.y), 32, SDL_PIXELFORMAT_RGBA32);
+    if (surface == nullptr) {
+        throw std::logic_error { "failed to create surface for GfxNull" };
+    }
+    auto* const renderer = SDL_CreateSoftwareRenderer(surface);
+    if (renderer == nullptr) {
+        SDL_FreeSurface(surface);
+        throw std::logic_error { "failed to create software renderer for GfxNull" };
+    }
+    return std::make_shared<jt::RenderTarget>(
+        std::shared_ptr<SDL_Renderer>(renderer, [surface](SDL_Renderer* r) {
+            SDL_DestroyRenderer(r);
+            SDL_FreeSurface(surface);
+        }));
+}
+#endif
+
+} // namespace
 
 jt::null_objects::GfxNull::GfxNull()
     : m_window { 800, 600, "test" }
-    , m_textureManager { TextureManagerImpl { nullptr } }
-    , m_target { std::make_shared<jt::RenderTarget>() }
+    , m_target { createNullRenderTarget(m_window.getSize()) }
 {
+#if USE_SFML
+    m_textureManager = TextureManagerImpl { nullptr };
+#else
+    m_textureManager = TextureManagerImpl { m_target->m_renderer };
+#endif
 }
 
 jt::RenderWindowInterface& jt::null_objects::GfxNull::window() { return m_window; }
@@ -21,3 +61,5 @@ void jt::null_objects::GfxNull::clear() { }
 void jt::null_objects::GfxNull::display() { }
 
 void jt::null_objects::GfxNull::createZLayer(int /*z*/) { }
+
+jt::CompositorStats jt::null_objects::GfxNull::getCompositorStats() const { return {}; }
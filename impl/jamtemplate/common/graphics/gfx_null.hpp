@@ -26,6 +26,8 @@ public:
 
     void createZLayer(int z) override;
 
+    jt::CompositorStats getCompositorStats() const override;
+
 private:
     RenderWindowNull m_window;
     jt::Camera m_camera;
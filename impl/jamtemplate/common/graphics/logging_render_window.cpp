@@ -1,4 +1,13 @@
 #include "logging_render_window.hpp"
+#include <log/log_macros.hpp>
+#include <array>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 2> renderWindowTags { "jt", "RenderWindow" };
+
+} // namespace
 
 jt::LoggingRenderWindow::LoggingRenderWindow(
     jt::RenderWindowInterface& decoratee, jt::LoggerInterface& logger)
@@ -13,46 +22,46 @@ jt::LoggingRenderWindow::LoggingRenderWindow(
 
 bool jt::LoggingRenderWindow::isOpen() const
 {
-    m_logger.verbose("isOpen", { "jt", "RenderWindow" });
+    JT_LOG_VERBOSE(m_logger, "isOpen", renderWindowTags);
     return m_decoratee.isOpen();
 }
 
 void jt::LoggingRenderWindow::checkForClose()
 {
-    m_logger.verbose("checkForClose", { "jt", "RenderWindow" });
+    JT_LOG_VERBOSE(m_logger, "checkForClose", renderWindowTags);
     m_decoratee.checkForClose();
 }
 
 std::shared_ptr<jt::RenderTargetLayer> jt::LoggingRenderWindow::createRenderTarget()
 {
-    m_logger.debug("createRenderTarget", { "jt", "RenderWindow" });
+    JT_LOG_DEBUG(m_logger, "createRenderTarget", renderWindowTags);
     return m_decoratee.createRenderTarget();
 }
 
 jt::Vector2f jt::LoggingRenderWindow::getSize() const
 {
     auto const size = m_decoratee.getSize();
-    m_logger.verbose(
+    JT_LOG_VERBOSE(m_logger,
         std::string { "getSize: (" } + std::to_string(size.x) + ", " + std::to_string(size.y) + ")",
-        { "jt", "RenderWindow" });
+        renderWindowTags);
     return size;
 }
 
 void jt::LoggingRenderWindow::draw(std::unique_ptr<jt::Sprite>& sprite)
 {
-    m_logger.verbose("draw sprite", { "jt", "RenderWindow" });
+    JT_LOG_VERBOSE(m_logger, "draw sprite", renderWindowTags);
     m_decoratee.draw(sprite);
 }
 
 void jt::LoggingRenderWindow::display()
 {
-    m_logger.verbose("display", { "jt", "RenderWindow" });
+    JT_LOG_VERBOSE(m_logger, "display", renderWindowTags);
     m_decoratee.display();
 }
 
 jt::Vector2f jt::LoggingRenderWindow::getMousePosition()
 {
-    m_logger.verbose("getMousePosition", { "jt", "RenderWindow" });
+    JT_LOG_VERBOSE(m_logger, "getMousePosition", renderWindowTags);
     return m_decoratee.getMousePosition();
 }
 
@@ -70,13 +79,13 @@ bool jt::LoggingRenderWindow::getMouseCursorVisible() const
 
 void jt::LoggingRenderWindow::updateGui(float elapsed)
 {
-    m_logger.verbose("updateGui", { "jt", "RenderWindow" });
+    JT_LOG_VERBOSE(m_logger, "updateGui", renderWindowTags);
     m_decoratee.updateGui(elapsed);
 }
 
 void jt::LoggingRenderWindow::startRenderGui()
 {
-    m_logger.verbose("startRenderGui", { "jt", "RenderWindow" });
+    JT_LOG_VERBOSE(m_logger, "startRenderGui", renderWindowTags);
     m_decoratee.startRenderGui();
 }
 
@@ -0,0 +1,122 @@
+#include "skyline_packer.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+
+jt::SkylinePacker::SkylinePacker(int width, int height)
+    : m_width { width }
+    , m_height { height }
+{
+    if (width <= 0 || height <= 0) {
+        throw std::invalid_argument { "skyline packer size must be positive" };
+    }
+    reset();
+}
+
+std::optional<jt::Recti> jt::SkylinePacker::insert(int width, int height)
+{
+    if (width <= 0 || height <= 0) {
+        return std::nullopt;
+    }
+
+    auto bestIndex = m_skyline.size();
+    auto bestTop = std::numeric_limits<int>::max();
+    auto bestSegmentWidth = std::numeric_limits<int>::max();
+    int bestY { 0 };
+    for (auto i = 0u; i != m_skyline.size(); ++i) {
+        auto const y = fit(i, width, height);
+        if (!y.has_value()) {
+            continue;
+        }
+        auto const top = y.value() + height;
+        // prefer the lowest position, on ties the narrowest segment to keep gaps small
+        if (top < bestTop || (top == bestTop && m_skyline[i].width < bestSegmentWidth)) {
+            bestIndex = i;
+            bestTop = top;
+            bestSegmentWidth = m_skyline[i].width;
+            bestY = y.value();
+        }
+    }
+    if (bestIndex == m_skyline.size()) {
+        return std::nullopt;
+    }
+
+    jt::Recti const rect { m_skyline[bestIndex].x, bestY, width, height };
+    addSegment(bestIndex, rect);
+    m_usedArea += static_cast<std::uint64_t>(width) * static_cast<std::uint64_t>(height);
+    return rect;
+}
+
+void jt::SkylinePacker::reset()
+{
+    m_skyline.clear();
+    m_skyline.push_back(Segment { 0, 0, m_width });
+    m_usedArea = 0u;
+}
+
+int jt::SkylinePacker::getWidth() const noexcept { return m_width; }
+
+int jt::SkylinePacker::getHeight() const noexcept { return m_height; }
+
+std::uint64_t jt::SkylinePacker::getUsedArea() const noexcept { return m_usedArea; }
+
+float jt::SkylinePacker::getOccupancy() const noexcept
+{
+    return static_cast<float>(m_usedArea)
+        / (static_cast<float>(m_width) * static_cast<float>(m_height));
+}
+
+std::optional<int> jt::SkylinePacker::fit(std::size_t index, int width, int height) const
+{
+    if (m_skyline[index].x + width > m_width) {
+        return std::nullopt;
+    }
+    // the rectangle rests on the highest segment below it
+    int y { 0 };
+    auto widthLeft = width;
+    for (auto i = index; widthLeft > 0; ++i) {
+        if (i == m_skyline.size()) {
+            return std::nullopt;
+        }
+        y = std::max(y, m_skyline[i].y);
+        if (y + height > m_height) {
+            return std::nullopt;
+        }
+        widthLeft -= m_skyline[i].width;
+    }
+    return y;
+}
+
+void jt::SkylinePacker::addSegment(std::size_t index, jt::Recti const& rect)
+{
+    m_skyline.insert(m_skyline.begin() + static_cast<std::ptrdiff_t>(index),
+        Segment { rect.left, rect.top + rect.height, rect.width });
+
+    // shrink or remove the segments now covered by the new one
+    auto const right = rect.left + rect.width;
+    auto i = index + 1u;
+    while (i < m_skyline.size() && m_skyline[i].x < right) {
+        auto& segment = m_skyline[i];
+        auto const overlap = right - segment.x;
+        if (overlap < segment.width) {
+            segment.x += overlap;
+            segment.width -= overlap;
+            break;
+        }
+        m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+    mergeSegments();
+}
+
+void jt::SkylinePacker::mergeSegments()
+{
+    for (auto i = 0u; i + 1u < m_skyline.size();) {
+        if (m_skyline[i].y == m_skyline[i + 1u].y) {
+            m_skyline[i].width += m_skyline[i + 1u].width;
+            m_skyline.erase(m_skyline.begin() + static_cast<std::ptrdiff_t>(i + 1u));
+        } else {
+            ++i;
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef JAMTEMPLATE_SKYLINE_PACKER_HPP
+#define JAMTEMPLATE_SKYLINE_PACKER_HPP
+
+#include <rect.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace jt {
+
+/// Packs rectangles into a fixed size area using the skyline bottom-left heuristic. The skyline is
+/// the upper border of all packed rectangles, stored as horizontal segments. A new rectangle is
+/// placed on the segment where its top edge ends up lowest.
+class SkylinePacker {
+public:
+    /// Constructor
+    /// \param width width of the area to pack into
+    /// \param height height of the area to pack into
+    SkylinePacker(int width, int height);
+
+    /// Find a free place for a rectangle and mark it as used
+    /// \param width width of the rectangle
+    /// \param height height of the rectangle
+    /// \return position and size of the packed rectangle or nullopt if it does not fit
+    std::optional<jt::Recti> insert(int width, int height);
+
+    /// Remove all packed rectangles
+    void reset();
+
+    int getWidth() const noexcept;
+    int getHeight() const noexcept;
+
+    /// Get the area covered by packed rectangles
+    /// \return area in pixel
+    std::uint64_t getUsedArea() const noexcept;
+
+    /// Get the fraction of the area covered by packed rectangles
+    /// \return occupancy between 0 and 1
+    float getOccupancy() const noexcept;
+
+private:
+    struct Segment {
+        int x { 0 };
+        int y { 0 };
+        int width { 0 };
+    };
+
+    int m_width { 0 };
+    int m_height { 0 };
+    std::uint64_t m_usedArea { 0u };
+    std::vector<Segment> m_skyline {};
+
+    /// Get the y position a rectangle would be placed at if it starts at segment index
+    /// \return y position or nullopt if the rectangle does not fit
+    std::optional<int> fit(std::size_t index, int width, int height) const;
+    void addSegment(std::size_t index, jt::Recti const& rect);
+    void mergeSegments();
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_SKYLINE_PACKER_HPP
@@ -0,0 +1,35 @@
+#include "texture_handle.hpp"
+#include <stdexcept>
+
+bool jt::TextureHandle::isValid() const noexcept { return id != invalidId; }
+
+jt::TextureHandle jt::TextureNameTable::intern(std::string const& name)
+{
+    auto const [it, inserted]
+        = m_ids.try_emplace(name, static_cast<std::uint32_t>(m_names.size()));
+    if (inserted) {
+        m_names.push_back(name);
+    }
+    return jt::TextureHandle { it->second };
+}
+
+std::string const& jt::TextureNameTable::getName(jt::TextureHandle handle) const
+{
+    if (!contains(handle)) {
+        throw std::invalid_argument { "unknown texture handle " + std::to_string(handle.id) };
+    }
+    return m_names[handle.id];
+}
+
+bool jt::TextureNameTable::contains(jt::TextureHandle handle) const noexcept
+{
+    return handle.id < m_names.size();
+}
+
+std::size_t jt::TextureNameTable::size() const noexcept { return m_names.size(); }
+
+void jt::TextureNameTable::clear() noexcept
+{
+    m_ids.clear();
+    m_names.clear();
+}
@@ -0,0 +1,50 @@
+#ifndef JAMTEMPLATE_TEXTURE_HANDLE_HPP
+#define JAMTEMPLATE_TEXTURE_HANDLE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace jt {
+
+/// Interned texture identifier. Texture identifiers are resolved to a handle once, afterwards all
+/// lookups with the handle are an array index instead of a string comparison.
+struct TextureHandle {
+    static constexpr std::uint32_t invalidId { std::numeric_limits<std::uint32_t>::max() };
+
+    std::uint32_t id { invalidId };
+
+    bool isValid() const noexcept;
+    bool operator==(TextureHandle const& other) const = default;
+};
+
+/// Maps texture identifiers to dense handle ids, starting at zero
+class TextureNameTable {
+public:
+    /// Get the handle for a texture identifier, adds the identifier if it is not known yet
+    /// \param name texture identifier
+    /// \return the handle
+    jt::TextureHandle intern(std::string const& name);
+
+    /// Get the texture identifier of a handle, throws std::invalid_argument for unknown handles
+    /// \param handle the handle
+    /// \return the texture identifier, only valid until the next call to intern()
+    std::string const& getName(jt::TextureHandle handle) const;
+
+    bool contains(jt::TextureHandle handle) const noexcept;
+
+    std::size_t size() const noexcept;
+
+    void clear() noexcept;
+
+private:
+    std::unordered_map<std::string, std::uint32_t> m_ids {};
+    std::vector<std::string> m_names {};
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_TEXTURE_HANDLE_HPP
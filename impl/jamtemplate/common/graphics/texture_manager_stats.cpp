@@ -0,0 +1,43 @@
+#include "texture_manager_stats.hpp"
+
+float jt::TextureManagerStats::getOccupancy() const noexcept
+{
+    if (totalPixels == 0u) {
+        return 0.0f;
+    }
+    return static_cast<float>(usedPixels) / static_cast<float>(totalPixels);
+}
+
+void const* jt::TextureBindCounter::m_lastTexture { nullptr };
+std::uint64_t jt::TextureBindCounter::m_binds { 0u };
+std::uint64_t jt::TextureBindCounter::m_draws { 0u };
+std::uint64_t jt::TextureBindCounter::m_bindsInLastFrame { 0u };
+std::uint64_t jt::TextureBindCounter::m_drawsInLastFrame { 0u };
+
+void jt::TextureBindCounter::onDraw(void const* texture) noexcept
+{
+    ++m_draws;
+    if (texture != m_lastTexture) {
+        ++m_binds;
+        m_lastTexture = texture;
+    }
+}
+
+void jt::TextureBindCounter::endFrame() noexcept
+{
+    m_bindsInLastFrame = m_binds;
+    m_drawsInLastFrame = m_draws;
+    m_binds = 0u;
+    m_draws = 0u;
+    m_lastTexture = nullptr;
+}
+
+std::uint64_t jt::TextureBindCounter::getNumberOfBindsInLastFrame() noexcept
+{
+    return m_bindsInLastFrame;
+}
+
+std::uint64_t jt::TextureBindCounter::getNumberOfDrawsInLastFrame() noexcept
+{
+    return m_drawsInLastFrame;
+}
@@ -0,0 +1,60 @@
+#ifndef JAMTEMPLATE_TEXTURE_MANAGER_STATS_HPP
+#define JAMTEMPLATE_TEXTURE_MANAGER_STATS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace jt {
+
+/// Statistics about atlas pages and memory usage of a texture manager
+struct TextureManagerStats {
+    std::size_t numberOfPages { 0u };
+    /// number of images (including flash images) packed into atlas pages
+    std::size_t numberOfPackedImages { 0u };
+    /// number of images that got a texture of their own, e.g. because they are too large
+    std::size_t numberOfStandaloneImages { 0u };
+    /// number of flash images that got a texture, not included in numberOfStandaloneImages
+    std::size_t numberOfFlashTextures { 0u };
+    /// pixels covered by packed images, including padding
+    std::uint64_t usedPixels { 0u };
+    /// pixels of all atlas pages
+    std::uint64_t totalPixels { 0u };
+    /// texture switches between consecutive sprite draws in the last frame
+    std::uint64_t numberOfTextureBinds { 0u };
+    /// sprite draws in the last frame
+    std::uint64_t numberOfDraws { 0u };
+    /// flash images that are not created yet, because no sprite using them was flashed so far
+    std::size_t numberOfDeferredFlashImages { 0u };
+    /// texture memory not allocated for the deferred flash images
+    std::uint64_t savedFlashTextureBytes { 0u };
+    /// memory of the alpha masks kept to create the deferred flash images
+    std::uint64_t flashMaskBytes { 0u };
+
+    float getOccupancy() const noexcept;
+};
+
+/// Counts how often consecutive sprite draws use a different texture. Every switch is a texture
+/// bind for the renderer and breaks batching, so this is the number the atlas tries to reduce.
+class TextureBindCounter {
+public:
+    /// Register a draw call
+    /// \param texture the texture used by the draw call
+    static void onDraw(void const* texture) noexcept;
+
+    /// Finish the current frame. The counts of the finished frame are returned by the getters.
+    static void endFrame() noexcept;
+
+    static std::uint64_t getNumberOfBindsInLastFrame() noexcept;
+    static std::uint64_t getNumberOfDrawsInLastFrame() noexcept;
+
+private:
+    static void const* m_lastTexture;
+    static std::uint64_t m_binds;
+    static std::uint64_t m_draws;
+    static std::uint64_t m_bindsInLastFrame;
+    static std::uint64_t m_drawsInLastFrame;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_TEXTURE_MANAGER_STATS_HPP
@@ -3,7 +3,7 @@
 #include "input/mouse/mouse_input_null.hpp"
 #include "performance_measurement.hpp"
 #include <input/gamepad/gamepad_input_null.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 
 jt::InputManager::InputManager(std::shared_ptr<jt::MouseInterface> mouse,
     std::shared_ptr<jt::KeyboardInterface> keyboard,
@@ -40,7 +40,7 @@ void jt::InputManager::reset()
 void jt::InputManager::update(
     bool /*shouldProcessKeys*/, bool /*shouldProcessMouse*/, MousePosition const& mp, float elapsed)
 {
-    ZoneScopedN("jt::InputManager::update");
+    JT_PROFILE_ZONE("jt::InputManager::update");
     if (m_mouse) [[likely]] {
         m_mouse->updateMousePosition(mp);
         m_mouse->updateButtons();
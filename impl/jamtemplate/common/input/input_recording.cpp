@@ -0,0 +1,263 @@
+#include "input_recording.hpp"
+#include <input/gamepad/gamepad_defines.hpp>
+#include <input/keyboard/keyboard_defines.hpp>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace {
+
+// Recording layout: FileHeader followed by records. Each record is a 4 byte repeat count and one
+// encoded frame of FileHeader::frameSize bytes. A frame consists of a flags byte, the elapsed time,
+// the mouse position, and bit fields for mouse buttons and keys. Each gamepad adds a bit field for
+// its buttons and the raw axis values. All values are little endian.
+
+constexpr std::array<char, 4> magic { 'J', 'T', 'I', 'R' };
+
+/// Increase whenever the layout of the header or the frames changes
+constexpr std::uint32_t formatVersion { 1u };
+
+struct FileHeader {
+    std::array<char, 4> magic {};
+    std::uint32_t version { 0u };
+    std::uint32_t seed { 0u };
+    std::uint32_t numberOfKeys { 0u };
+    std::uint32_t numberOfMouseButtons { 0u };
+    std::uint32_t numberOfGamepads { 0u };
+    std::uint32_t numberOfGamepadButtons { 0u };
+    std::uint32_t numberOfAxes { 0u };
+    std::uint32_t frameSize { 0u };
+};
+
+static_assert(std::endian::native == std::endian::little,
+    "input recordings are stored little endian and copied byte wise");
+static_assert(std::is_trivially_copyable_v<FileHeader>);
+
+constexpr std::uint8_t flagProcessKeys { 1u };
+constexpr std::uint8_t flagProcessMouse { 2u };
+
+std::size_t getNumberOfKeys() { return jt::KeyCode::_size(); }
+std::size_t getNumberOfGamepadButtons() { return jt::GamepadButtonCode::_size(); }
+std::size_t getNumberOfAxes() { return jt::GamepadAxisCode::_size(); }
+
+std::size_t getBitFieldSize(std::size_t numberOfBits) { return (numberOfBits + 7u) / 8u; }
+
+std::size_t getFrameSize(std::size_t numberOfGamepads)
+{
+    auto const gamepadSize
+        = getBitFieldSize(getNumberOfGamepadButtons()) + getNumberOfAxes() * 2u * sizeof(float);
+    return 1u + sizeof(float) * 5u + getBitFieldSize(jt::MouseButtonCodeSize)
+        + getBitFieldSize(getNumberOfKeys()) + numberOfGamepads * gamepadSize;
+}
+
+template <typename T>
+void append(std::vector<std::uint8_t>& data, T const& value)
+{
+    auto const bytes = reinterpret_cast<std::uint8_t const*>(&value);
+    data.insert(data.end(), bytes, bytes + sizeof(T));
+}
+
+void appendBits(std::vector<std::uint8_t>& data, std::vector<bool> const& bits, std::size_t count)
+{
+    auto const start = data.size();
+    data.resize(start + getBitFieldSize(count), 0u);
+    for (auto i = 0u; i != count && i != bits.size(); ++i) {
+        if (bits[i]) {
+            data[start + i / 8u] |= static_cast<std::uint8_t>(1u << (i % 8u));
+        }
+    }
+}
+
+template <typename T>
+T extract(std::uint8_t const*& data)
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    data += sizeof(T);
+    return value;
+}
+
+void extractBits(std::uint8_t const*& data, std::vector<bool>& bits, std::size_t count)
+{
+    bits.resize(count);
+    for (auto i = 0u; i != count; ++i) {
+        bits[i] = (data[i / 8u] & (1u << (i % 8u))) != 0u;
+    }
+    data += getBitFieldSize(count);
+}
+
+void encodeFrame(jt::InputFrame const& frame, std::size_t numberOfGamepads,
+    std::vector<std::uint8_t>& data)
+{
+    if (frame.gamepads.size() != numberOfGamepads) {
+        throw std::invalid_argument { "input frame contains an unexpected number of gamepads" };
+    }
+    data.clear();
+    std::uint8_t flags { 0u };
+    if (frame.shouldProcessKeys) {
+        flags |= flagProcessKeys;
+    }
+    if (frame.shouldProcessMouse) {
+        flags |= flagProcessMouse;
+    }
+    append(data, flags);
+    append(data, frame.elapsed);
+    append(data, frame.mousePosition.window_x);
+    append(data, frame.mousePosition.window_y);
+    append(data, frame.mousePosition.screen_x);
+    append(data, frame.mousePosition.screen_y);
+    appendBits(data, frame.mouseButtons, jt::MouseButtonCodeSize);
+    appendBits(data, frame.keys, getNumberOfKeys());
+    for (auto const& gamepad : frame.gamepads) {
+        appendBits(data, gamepad.buttons, getNumberOfGamepadButtons());
+        for (auto i = 0u; i != getNumberOfAxes(); ++i) {
+            auto const axis = i < gamepad.axes.size() ? gamepad.axes[i] : jt::Vector2f {};
+            append(data, axis.x);
+            append(data, axis.y);
+        }
+    }
+}
+
+void decodeFrame(std::uint8_t const* data, std::size_t numberOfGamepads, jt::InputFrame& frame)
+{
+    auto const flags = extract<std::uint8_t>(data);
+    frame.shouldProcessKeys = (flags & flagProcessKeys) != 0u;
+    frame.shouldProcessMouse = (flags & flagProcessMouse) != 0u;
+    frame.elapsed = extract<float>(data);
+    frame.mousePosition.window_x = extract<float>(data);
+    frame.mousePosition.window_y = extract<float>(data);
+    frame.mousePosition.screen_x = extract<float>(data);
+    frame.mousePosition.screen_y = extract<float>(data);
+    extractBits(data, frame.mouseButtons, jt::MouseButtonCodeSize);
+    extractBits(data, frame.keys, getNumberOfKeys());
+    frame.gamepads.resize(numberOfGamepads);
+    for (auto& gamepad : frame.gamepads) {
+        extractBits(data, gamepad.buttons, getNumberOfGamepadButtons());
+        gamepad.axes.resize(getNumberOfAxes());
+        for (auto& axis : gamepad.axes) {
+            axis.x = extract<float>(data);
+            axis.y = extract<float>(data);
+        }
+    }
+}
+
+} // namespace
+
+jt::InputFrame jt::createEmptyInputFrame(std::size_t numberOfGamepads)
+{
+    jt::InputFrame frame {};
+    frame.mouseButtons.resize(jt::MouseButtonCodeSize, false);
+    frame.keys.resize(getNumberOfKeys(), false);
+    frame.gamepads.resize(numberOfGamepads);
+    for (auto& gamepad : frame.gamepads) {
+        gamepad.buttons.resize(getNumberOfGamepadButtons(), false);
+        gamepad.axes.resize(getNumberOfAxes());
+    }
+    return frame;
+}
+
+jt::InputRecordingWriter::InputRecordingWriter(
+    std::string const& fileName, unsigned int seed, std::size_t numberOfGamepads)
+    : m_file { fileName, std::ios::binary | std::ios::trunc }
+    , m_numberOfGamepads { numberOfGamepads }
+{
+    if (!m_file) {
+        throw std::invalid_argument { "cannot open input recording file '" + fileName + "'" };
+    }
+    FileHeader header {};
+    header.magic = magic;
+    header.version = formatVersion;
+    header.seed = seed;
+    header.numberOfKeys = static_cast<std::uint32_t>(getNumberOfKeys());
+    header.numberOfMouseButtons = jt::MouseButtonCodeSize;
+    header.numberOfGamepads = static_cast<std::uint32_t>(numberOfGamepads);
+    header.numberOfGamepadButtons = static_cast<std::uint32_t>(getNumberOfGamepadButtons());
+    header.numberOfAxes = static_cast<std::uint32_t>(getNumberOfAxes());
+    header.frameSize = static_cast<std::uint32_t>(getFrameSize(numberOfGamepads));
+    m_file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+}
+
+jt::InputRecordingWriter::~InputRecordingWriter() { flush(); }
+
+void jt::InputRecordingWriter::write(jt::InputFrame const& frame)
+{
+    encodeFrame(frame, m_numberOfGamepads, m_encodedFrame);
+    if (m_pendingRepeatCount != 0u && m_encodedFrame == m_pendingFrame) {
+        ++m_pendingRepeatCount;
+        return;
+    }
+    flush();
+    std::swap(m_pendingFrame, m_encodedFrame);
+    m_pendingRepeatCount = 1u;
+}
+
+void jt::InputRecordingWriter::flush()
+{
+    if (m_pendingRepeatCount == 0u) {
+        return;
+    }
+    m_file.write(reinterpret_cast<char const*>(&m_pendingRepeatCount), sizeof(std::uint32_t));
+    m_file.write(reinterpret_cast<char const*>(m_pendingFrame.data()),
+        static_cast<std::streamsize>(m_pendingFrame.size()));
+    m_pendingRepeatCount = 0u;
+}
+
+jt::InputRecordingReader::InputRecordingReader(std::string const& fileName)
+{
+    std::ifstream file { fileName, std::ios::binary };
+    if (!file) {
+        throw std::invalid_argument { "cannot open input recording file '" + fileName + "'" };
+    }
+    m_data.assign(std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> {});
+
+    FileHeader header {};
+    if (m_data.size() < sizeof(header)) {
+        throw std::invalid_argument { "input recording '" + fileName + "' is too short" };
+    }
+    std::memcpy(&header, m_data.data(), sizeof(header));
+    if (header.magic != magic || header.version != formatVersion) {
+        throw std::invalid_argument { "'" + fileName + "' is not a supported input recording" };
+    }
+    if (header.numberOfKeys != getNumberOfKeys()
+        || header.numberOfMouseButtons != jt::MouseButtonCodeSize
+        || header.numberOfGamepadButtons != getNumberOfGamepadButtons()
+        || header.numberOfAxes != getNumberOfAxes()
+        || header.frameSize != getFrameSize(header.numberOfGamepads)) {
+        throw std::invalid_argument { "input recording '" + fileName
+            + "' was created with different input definitions" };
+    }
+    m_seed = header.seed;
+    m_numberOfGamepads = header.numberOfGamepads;
+    m_frameSize = header.frameSize;
+    m_position = sizeof(header);
+}
+
+unsigned int jt::InputRecordingReader::getSeed() const noexcept { return m_seed; }
+
+std::size_t jt::InputRecordingReader::getNumberOfGamepads() const noexcept
+{
+    return m_numberOfGamepads;
+}
+
+bool jt::InputRecordingReader::read(jt::InputFrame& frame)
+{
+    if (m_remainingRepeatCount == 0u) {
+        auto const recordSize = sizeof(std::uint32_t) + m_frameSize;
+        // the last record might be cut off if the game was not shut down properly
+        if (m_data.size() - m_position < recordSize) {
+            return false;
+        }
+        std::memcpy(&m_remainingRepeatCount, m_data.data() + m_position, sizeof(std::uint32_t));
+        if (m_remainingRepeatCount == 0u) {
+            return false;
+        }
+        m_position += recordSize;
+    }
+    decodeFrame(m_data.data() + m_position - m_frameSize, m_numberOfGamepads, frame);
+    --m_remainingRepeatCount;
+    return true;
+}
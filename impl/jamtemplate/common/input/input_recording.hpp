@@ -0,0 +1,99 @@
+#ifndef JAMTEMPLATE_INPUT_RECORDING_HPP
+#define JAMTEMPLATE_INPUT_RECORDING_HPP
+
+#include <input/mouse/mouse_defines.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// State of a single gamepad in one update tick
+struct GamepadFrame {
+    /// pressed state, indexed by jt::GamepadButtonCode
+    std::vector<bool> buttons {};
+    /// raw axis values, indexed by jt::GamepadAxisCode
+    std::vector<jt::Vector2f> axes {};
+};
+
+/// Input state of a single update tick
+struct InputFrame {
+    bool shouldProcessKeys { true };
+    bool shouldProcessMouse { true };
+    float elapsed { 0.0f };
+    jt::MousePosition mousePosition {};
+    /// pressed state, indexed by jt::MouseButtonCode
+    std::vector<bool> mouseButtons {};
+    /// pressed state, indexed by jt::KeyCode
+    std::vector<bool> keys {};
+    std::vector<jt::GamepadFrame> gamepads {};
+};
+
+/// Create a frame with nothing pressed
+/// \param numberOfGamepads number of gamepads in the frame
+/// \return the frame
+jt::InputFrame createEmptyInputFrame(std::size_t numberOfGamepads);
+
+/// Writes input frames to a binary file. Consecutive identical frames are stored only once
+/// together with a repeat count.
+class InputRecordingWriter {
+public:
+    /// Constructor
+    /// \param fileName the file to write to, an existing file is overwritten
+    /// \param seed random seed of the recorded session
+    /// \param numberOfGamepads number of gamepads in every frame
+    InputRecordingWriter(
+        std::string const& fileName, unsigned int seed, std::size_t numberOfGamepads);
+    ~InputRecordingWriter();
+
+    // no copy, no move. The pending frame would be written twice.
+    InputRecordingWriter(InputRecordingWriter const&) = delete;
+    InputRecordingWriter(InputRecordingWriter&&) = delete;
+    InputRecordingWriter& operator=(InputRecordingWriter const&) = delete;
+    InputRecordingWriter& operator=(InputRecordingWriter&&) = delete;
+
+    /// Append a frame
+    /// \param frame the frame, needs to contain the number of gamepads passed to the constructor
+    void write(jt::InputFrame const& frame);
+
+    /// Write the pending frame to the file stream
+    void flush();
+
+private:
+    std::ofstream m_file {};
+    std::size_t m_numberOfGamepads { 0u };
+    std::vector<std::uint8_t> m_pendingFrame {};
+    std::vector<std::uint8_t> m_encodedFrame {};
+    std::uint32_t m_pendingRepeatCount { 0u };
+};
+
+/// Reads input frames written by InputRecordingWriter
+class InputRecordingReader {
+public:
+    /// Constructor, throws std::invalid_argument if the file is not a valid recording
+    /// \param fileName the recording file
+    explicit InputRecordingReader(std::string const& fileName);
+
+    unsigned int getSeed() const noexcept;
+    std::size_t getNumberOfGamepads() const noexcept;
+
+    /// Read the next frame
+    /// \param frame the frame to be overwritten
+    /// \return false if all frames were read, in this case frame is not changed
+    bool read(jt::InputFrame& frame);
+
+private:
+    std::vector<std::uint8_t> m_data {};
+    std::size_t m_position { 0u };
+    std::size_t m_frameSize { 0u };
+    std::uint32_t m_remainingRepeatCount { 0u };
+    unsigned int m_seed { 0u };
+    std::size_t m_numberOfGamepads { 0u };
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_INPUT_RECORDING_HPP
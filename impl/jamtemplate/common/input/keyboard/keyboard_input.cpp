@@ -2,7 +2,7 @@
 #include "performance_measurement.hpp"
 #include <input/control_commands/control_command_null.hpp>
 #include <input/input_helper.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 
 #include <utility>
 
@@ -25,7 +25,7 @@ jt::KeyboardInput::KeyboardInput(KeyboardKeyCheckFunction checkFunc)
 
 void jt::KeyboardInput::updateKeys()
 {
-    ZoneScopedN( "jt::KeyboardInput::updateKeys" );
+    JT_PROFILE_ZONE( "jt::KeyboardInput::updateKeys" );
     jt::inputhelper::updateValues(m_pressed, m_released, m_justPressed, m_justReleased,
         [this](auto k) { return m_checkFunc(k); });
 }
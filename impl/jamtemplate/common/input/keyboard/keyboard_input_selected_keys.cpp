@@ -2,7 +2,7 @@
 #include "performance_measurement.hpp"
 #include <input/control_commands/control_command_null.hpp>
 #include <input/input_helper.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 
 jt::KeyboardInputSelectedKeys::KeyboardInputSelectedKeys(
     KeyboardInputSelectedKeys::KeyboardKeyCheckFunction checkFunc)
@@ -25,7 +25,7 @@ void jt::KeyboardInputSelectedKeys::listenForKey(jt::KeyCode k)
 
 void jt::KeyboardInputSelectedKeys::updateKeys()
 {
-    ZoneScopedN("jt::KeyboardInputSelectedKeys::updateKeys");
+    JT_PROFILE_ZONE("jt::KeyboardInputSelectedKeys::updateKeys");
     jt::inputhelper::updateValues(m_pressed, m_released, m_justPressed, m_justReleased,
         [this](auto k) { return m_checkFunc(k); });
 }
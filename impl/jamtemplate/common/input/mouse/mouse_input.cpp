@@ -1,7 +1,7 @@
 ﻿#include "mouse_input.hpp"
 #include "performance_measurement.hpp"
 #include <input/input_helper.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 
 jt::MouseInput::MouseInput(MouseButtonCheckFunction checkFunction)
     : m_checkFunction { std::move(checkFunction) }
@@ -21,7 +21,7 @@ jt::MouseInput::MouseInput(MouseButtonCheckFunction checkFunction)
 
 void jt::MouseInput::updateMousePosition(jt::MousePosition const& mp)
 {
-    ZoneScopedN("jt::MouseInput::updateMousePosition");
+    JT_PROFILE_ZONE("jt::MouseInput::updateMousePosition");
     m_mouseWorldX = mp.window_x;
     m_mouseWorldY = mp.window_y;
 
@@ -31,7 +31,7 @@ void jt::MouseInput::updateMousePosition(jt::MousePosition const& mp)
 
 void jt::MouseInput::updateButtons()
 {
-    ZoneScopedN("jt::MouseInput::updateButtons");
+    JT_PROFILE_ZONE("jt::MouseInput::updateButtons");
     jt::inputhelper::updateValues(m_mousePressed, m_mouseReleased, m_mouseJustPressed,
         m_mouseJustReleased, [this](auto b) { return m_checkFunction(b); });
 }
@@ -0,0 +1,67 @@
+#include "recording_input_manager.hpp"
+#include <trace_profiler.hpp>
+
+jt::RecordingInputManager::RecordingInputManager(
+    InputManagerInterface& decoratee, std::string const& fileName, unsigned int seed)
+    : m_decoratee { decoratee }
+    , m_writer { fileName, seed, decoratee.getNumberOfGamepads() }
+    , m_frame { jt::createEmptyInputFrame(decoratee.getNumberOfGamepads()) }
+    , m_keys { jt::getAllKeys() }
+    , m_gamepadButtons { jt::getAllGamepadButtons() }
+    , m_axes { jt::getAllAxis() }
+{
+}
+
+std::shared_ptr<jt::MouseInterface> jt::RecordingInputManager::mouse()
+{
+    return m_decoratee.mouse();
+}
+
+std::shared_ptr<jt::KeyboardInterface> jt::RecordingInputManager::keyboard()
+{
+    return m_decoratee.keyboard();
+}
+
+std::shared_ptr<jt::GamepadInterface> jt::RecordingInputManager::gamepad(int gamepad_id)
+{
+    return m_decoratee.gamepad(gamepad_id);
+}
+
+std::size_t jt::RecordingInputManager::getNumberOfGamepads() const
+{
+    return m_decoratee.getNumberOfGamepads();
+}
+
+void jt::RecordingInputManager::update(
+    bool shouldProcessKeys, bool shouldProcessMouse, MousePosition const& mp, float elapsed)
+{
+    JT_PROFILE_ZONE("jt::RecordingInputManager::update");
+    m_decoratee.update(shouldProcessKeys, shouldProcessMouse, mp, elapsed);
+
+    m_frame.shouldProcessKeys = shouldProcessKeys;
+    m_frame.shouldProcessMouse = shouldProcessMouse;
+    m_frame.elapsed = elapsed;
+    m_frame.mousePosition = mp;
+
+    auto const mouse = m_decoratee.mouse();
+    for (auto const b : jt::getAllMouseButtons()) {
+        m_frame.mouseButtons[static_cast<std::size_t>(b)] = mouse->pressed(b);
+    }
+    auto const keyboard = m_decoratee.keyboard();
+    for (auto const k : m_keys) {
+        m_frame.keys[static_cast<std::size_t>(k._to_integral())] = keyboard->pressed(k);
+    }
+    for (auto i = 0u; i != m_frame.gamepads.size(); ++i) {
+        auto const gamepad = m_decoratee.gamepad(static_cast<int>(i));
+        auto& gamepadFrame = m_frame.gamepads[i];
+        for (auto const b : m_gamepadButtons) {
+            gamepadFrame.buttons[static_cast<std::size_t>(b._to_integral())] = gamepad->pressed(b);
+        }
+        for (auto const a : m_axes) {
+            gamepadFrame.axes[static_cast<std::size_t>(a._to_integral())] = gamepad->getAxisRaw(a);
+        }
+    }
+    m_writer.write(m_frame);
+}
+
+void jt::RecordingInputManager::reset() { m_decoratee.reset(); }
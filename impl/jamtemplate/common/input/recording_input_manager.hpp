@@ -0,0 +1,46 @@
+#ifndef JAMTEMPLATE_RECORDING_INPUT_MANAGER_HPP
+#define JAMTEMPLATE_RECORDING_INPUT_MANAGER_HPP
+
+#include <input/gamepad/gamepad_defines.hpp>
+#include <input/input_manager_interface.hpp>
+#include <input/input_recording.hpp>
+#include <input/keyboard/keyboard_defines.hpp>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// Decorator that records the input state of every update tick to a file, so the session can be
+/// replayed with ReplayInputManager.
+class RecordingInputManager : public InputManagerInterface {
+public:
+    /// Constructor
+    /// \param decoratee the input manager providing the actual input
+    /// \param fileName the file the recording is written to
+    /// \param seed random seed of the session, stored in the recording. Create the recording
+    /// directly after seeding jt::Random, so the replay starts with the same random numbers.
+    RecordingInputManager(
+        InputManagerInterface& decoratee, std::string const& fileName, unsigned int seed);
+
+    std::shared_ptr<MouseInterface> mouse() override;
+    std::shared_ptr<KeyboardInterface> keyboard() override;
+    std::shared_ptr<GamepadInterface> gamepad(int gamepad_id) override;
+    std::size_t getNumberOfGamepads() const override;
+
+    void update(bool shouldProcessKeys, bool shouldProcessMouse, MousePosition const& mp,
+        float elapsed) override;
+    void reset() override;
+
+private:
+    InputManagerInterface& m_decoratee;
+    jt::InputRecordingWriter m_writer;
+    jt::InputFrame m_frame {};
+
+    std::vector<jt::KeyCode> m_keys {};
+    std::vector<jt::GamepadButtonCode> m_gamepadButtons {};
+    std::vector<jt::GamepadAxisCode> m_axes {};
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_RECORDING_INPUT_MANAGER_HPP
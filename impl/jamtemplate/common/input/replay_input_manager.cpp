@@ -0,0 +1,81 @@
+#include "replay_input_manager.hpp"
+#include <input/gamepad/gamepad_input.hpp>
+#include <input/keyboard/keyboard_input.hpp>
+#include <input/mouse/mouse_input.hpp>
+#include <random/random.hpp>
+#include <trace_profiler.hpp>
+
+namespace {
+
+std::vector<std::shared_ptr<jt::GamepadInterface>> createReplayGamepads(
+    std::size_t numberOfGamepads, jt::InputFrame const& frame)
+{
+    std::vector<std::shared_ptr<jt::GamepadInterface>> gamepads;
+    for (auto i = 0u; i != numberOfGamepads; ++i) {
+        gamepads.push_back(std::make_shared<jt::GamepadInput>(
+            static_cast<int>(i),
+            [&frame, i](auto a) {
+                return frame.gamepads[i].axes[static_cast<std::size_t>(a._to_integral())];
+            },
+            [&frame, i](auto b) {
+                return static_cast<bool>(
+                    frame.gamepads[i].buttons[static_cast<std::size_t>(b._to_integral())]);
+            }));
+    }
+    return gamepads;
+}
+
+} // namespace
+
+jt::ReplayInputManager::ReplayInputManager(std::string const& fileName)
+    : m_reader { fileName }
+    , m_frame { jt::createEmptyInputFrame(m_reader.getNumberOfGamepads()) }
+    , m_input { std::make_shared<jt::MouseInput>([this](auto b) {
+                   return static_cast<bool>(m_frame.mouseButtons[static_cast<std::size_t>(b)]);
+               }),
+        std::make_shared<jt::KeyboardInput>([this](auto k) {
+            return static_cast<bool>(m_frame.keys[static_cast<std::size_t>(k._to_integral())]);
+        }),
+        createReplayGamepads(m_reader.getNumberOfGamepads(), m_frame) }
+{
+    jt::Random::pinSeed(m_reader.getSeed());
+}
+
+std::shared_ptr<jt::MouseInterface> jt::ReplayInputManager::mouse() { return m_input.mouse(); }
+
+std::shared_ptr<jt::KeyboardInterface> jt::ReplayInputManager::keyboard()
+{
+    return m_input.keyboard();
+}
+
+std::shared_ptr<jt::GamepadInterface> jt::ReplayInputManager::gamepad(int gamepad_id)
+{
+    return m_input.gamepad(gamepad_id);
+}
+
+std::size_t jt::ReplayInputManager::getNumberOfGamepads() const
+{
+    return m_input.getNumberOfGamepads();
+}
+
+void jt::ReplayInputManager::update(bool /*shouldProcessKeys*/, bool /*shouldProcessMouse*/,
+    MousePosition const& /*mp*/, float elapsed)
+{
+    JT_PROFILE_ZONE("jt::ReplayInputManager::update");
+    if (!m_isFinished && !m_reader.read(m_frame)) {
+        m_isFinished = true;
+    }
+    if (m_isFinished) {
+        // release everything, but keep the last mouse position
+        auto const mousePosition = m_frame.mousePosition;
+        m_frame = jt::createEmptyInputFrame(m_reader.getNumberOfGamepads());
+        m_frame.mousePosition = mousePosition;
+        m_frame.elapsed = elapsed;
+    }
+    m_input.update(m_frame.shouldProcessKeys, m_frame.shouldProcessMouse, m_frame.mousePosition,
+        m_frame.elapsed);
+}
+
+void jt::ReplayInputManager::reset() { m_input.reset(); }
+
+bool jt::ReplayInputManager::isFinished() const noexcept { return m_isFinished; }
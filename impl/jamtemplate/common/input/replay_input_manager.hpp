@@ -0,0 +1,45 @@
+#ifndef JAMTEMPLATE_REPLAY_INPUT_MANAGER_HPP
+#define JAMTEMPLATE_REPLAY_INPUT_MANAGER_HPP
+
+#include <input/input_manager.hpp>
+#include <input/input_manager_interface.hpp>
+#include <input/input_recording.hpp>
+#include <string>
+
+namespace jt {
+
+/// Input manager that replays a recording created by RecordingInputManager. Every update tick
+/// feeds the next recorded frame through InputManager::update, so pressed, just pressed and the
+/// keyboard commands behave exactly like in the recorded session. Once the recording is finished,
+/// nothing is pressed anymore.
+class ReplayInputManager : public InputManagerInterface {
+public:
+    /// Constructor. Pins the seed of jt::Random to the seed stored in the recording.
+    /// \param fileName the recording, throws std::invalid_argument if it cannot be read
+    explicit ReplayInputManager(std::string const& fileName);
+
+    std::shared_ptr<MouseInterface> mouse() override;
+    std::shared_ptr<KeyboardInterface> keyboard() override;
+    std::shared_ptr<GamepadInterface> gamepad(int gamepad_id) override;
+    std::size_t getNumberOfGamepads() const override;
+
+    /// Advance to the next recorded frame. The passed values are ignored, the recorded ones are
+    /// used instead.
+    void update(bool shouldProcessKeys, bool shouldProcessMouse, MousePosition const& mp,
+        float elapsed) override;
+    void reset() override;
+
+    /// Check if all recorded frames were replayed
+    /// \return true if the recording is finished
+    bool isFinished() const noexcept;
+
+private:
+    jt::InputRecordingReader m_reader;
+    jt::InputFrame m_frame {};
+    bool m_isFinished { false };
+    jt::InputManager m_input;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_REPLAY_INPUT_MANAGER_HPP
@@ -0,0 +1,51 @@
+#include "job.hpp"
+#include <utility>
+
+jt::Job::Job(std::function<void()> task)
+    : m_task { std::move(task) }
+{
+}
+
+bool jt::Job::isFinished() const noexcept { return m_finished.load(std::memory_order_acquire); }
+
+void jt::Job::rethrowIfFailed() const
+{
+    if (m_exception) {
+        std::rethrow_exception(m_exception);
+    }
+}
+
+bool jt::Job::addContinuation(std::shared_ptr<Job> const& continuation)
+{
+    std::lock_guard<std::mutex> const lock { m_continuationMutex };
+    if (m_finished.load(std::memory_order_acquire)) {
+        return false;
+    }
+    continuation->m_unfinishedDependencies.fetch_add(1u, std::memory_order_relaxed);
+    m_continuations.push_back(continuation);
+    return true;
+}
+
+bool jt::Job::releaseDependency() noexcept
+{
+    return m_unfinishedDependencies.fetch_sub(1u, std::memory_order_acq_rel) == 1u;
+}
+
+std::vector<std::shared_ptr<jt::Job>> jt::Job::execute()
+{
+    try {
+        m_task();
+    } catch (...) {
+        m_exception = std::current_exception();
+    }
+    // release captured state as early as possible
+    m_task = nullptr;
+
+    std::vector<std::shared_ptr<Job>> continuations {};
+    {
+        std::lock_guard<std::mutex> const lock { m_continuationMutex };
+        m_finished.store(true, std::memory_order_release);
+        std::swap(continuations, m_continuations);
+    }
+    return continuations;
+}
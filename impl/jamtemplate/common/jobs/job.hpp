@@ -0,0 +1,68 @@
+#ifndef JAMTEMPLATE_JOB_HPP
+#define JAMTEMPLATE_JOB_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace jt {
+
+/// A unit of work that can be scheduled on a JobSystemInterface.
+///
+/// A job becomes ready once all of its dependencies are finished. When a job finishes, it
+/// releases all jobs that were waiting for it. Exceptions thrown by the task are stored and
+/// rethrown when waiting for the job.
+class Job {
+public:
+    /// Constructor
+    /// \param task the function to execute
+    explicit Job(std::function<void()> task);
+
+    // no copy, no move. Jobs are referenced by other jobs via shared_ptr.
+    Job(Job const&) = delete;
+    Job(Job&&) = delete;
+    Job& operator=(Job const&) = delete;
+    Job& operator=(Job&&) = delete;
+
+    /// Check if the job was executed
+    /// \return true if the task returned or threw
+    bool isFinished() const noexcept;
+
+    /// Rethrow the exception thrown by the task, if there was one. Only valid once finished.
+    void rethrowIfFailed() const;
+
+    /// Register a job that waits for this job. Needs to be called before the continuation is
+    /// released via releaseDependency() for the last time.
+    /// \param continuation the job waiting for this job
+    /// \return true if this job was not finished yet and continuation needs to wait for it
+    bool addContinuation(std::shared_ptr<Job> const& continuation);
+
+    /// Signal that one dependency (or the initial scheduling guard) is done
+    /// \return true if this was the last outstanding dependency and the job is ready to run
+    bool releaseDependency() noexcept;
+
+    /// Execute the task and mark the job as finished
+    /// \return jobs that were waiting for this job. Each of them needs releaseDependency() called.
+    std::vector<std::shared_ptr<Job>> execute();
+
+private:
+    std::function<void()> m_task {};
+    // starts with one reference that is released once all dependencies are registered
+    std::atomic<std::size_t> m_unfinishedDependencies { 1u };
+    std::atomic<bool> m_finished { false };
+    std::exception_ptr m_exception { nullptr };
+
+    mutable std::mutex m_continuationMutex {};
+    std::vector<std::shared_ptr<Job>> m_continuations {};
+};
+
+/// Handle to a scheduled job, can be used to wait for the job or as dependency for other jobs
+using JobHandle = std::shared_ptr<jt::Job>;
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_JOB_HPP
@@ -0,0 +1,267 @@
+#include "job_system.hpp"
+#include <trace_profiler.hpp>
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+constexpr std::size_t noWorker { static_cast<std::size_t>(-1) };
+
+// Identifies the worker running on the current thread, to push jobs scheduled from within a job
+// to the local deque.
+thread_local jt::JobSystem const* currentJobSystem { nullptr };
+thread_local std::size_t currentWorkerIndex { noWorker };
+
+/// Shared state of one parallelFor call. Chunks are handed out via an atomic counter, so helper
+/// jobs that start after all chunks are taken return without touching the range function.
+struct ParallelForState {
+    jt::JobSystemInterface::RangeFunction const* function { nullptr };
+    std::size_t count { 0u };
+    std::size_t grainSize { 1u };
+    std::size_t numberOfChunks { 0u };
+    std::atomic<std::size_t> nextChunk { 0u };
+    std::atomic<std::size_t> finishedChunks { 0u };
+    std::mutex exceptionMutex {};
+    std::exception_ptr exception { nullptr };
+
+    void process()
+    {
+        while (true) {
+            auto const chunk = nextChunk.fetch_add(1u, std::memory_order_relaxed);
+            if (chunk >= numberOfChunks) {
+                return;
+            }
+            auto const begin = chunk * grainSize;
+            auto const end = std::min(count, begin + grainSize);
+            try {
+                (*function)(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> const lock { exceptionMutex };
+                if (!exception) {
+                    exception = std::current_exception();
+                }
+            }
+            finishedChunks.fetch_add(1u, std::memory_order_release);
+        }
+    }
+
+    bool isFinished() const noexcept
+    {
+        return finishedChunks.load(std::memory_order_acquire) == numberOfChunks;
+    }
+};
+
+} // namespace
+
+jt::JobSystem::JobSystem(std::size_t numberOfWorkers)
+{
+    m_queues.reserve(numberOfWorkers);
+    for (auto i = 0u; i != numberOfWorkers; ++i) {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+    m_workers.reserve(numberOfWorkers);
+    for (auto i = 0u; i != numberOfWorkers; ++i) {
+        m_workers.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+jt::JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> const lock { m_sleepMutex };
+        m_stop = true;
+    }
+    m_sleepCondition.notify_all();
+    for (auto& w : m_workers) {
+        w.join();
+    }
+}
+
+jt::JobHandle jt::JobSystem::schedule(
+    std::function<void()> task, std::vector<jt::JobHandle> const& dependencies)
+{
+    if (!task) {
+        throw std::invalid_argument { "cannot schedule an empty task" };
+    }
+    auto job = std::make_shared<jt::Job>(std::move(task));
+    for (auto const& dependency : dependencies) {
+        if (dependency) {
+            dependency->addContinuation(job);
+        }
+    }
+    // release the scheduling guard. If all dependencies are already done, the job is ready now.
+    if (job->releaseDependency()) {
+        if (m_workers.empty()) {
+            execute(job);
+        } else {
+            enqueue(job);
+        }
+    }
+    return job;
+}
+
+void jt::JobSystem::wait(jt::JobHandle const& job)
+{
+    if (!job) {
+        return;
+    }
+    JT_PROFILE_ZONE("jt::JobSystem::wait");
+    while (!job->isFinished()) {
+        jt::JobHandle next {};
+        if (tryTakeJob(next)) {
+            execute(std::move(next));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    job->rethrowIfFailed();
+}
+
+void jt::JobSystem::parallelFor(
+    std::size_t count, RangeFunction const& function, std::size_t grainSize)
+{
+    if (count == 0u) {
+        return;
+    }
+    JT_PROFILE_ZONE("jt::JobSystem::parallelFor");
+    auto const numberOfThreads = m_workers.size() + 1u;
+    if (grainSize == 0u) {
+        // a few chunks per thread to balance uneven chunks
+        grainSize = std::max<std::size_t>(1u, count / (numberOfThreads * 4u));
+    }
+    auto const numberOfChunks = (count + grainSize - 1u) / grainSize;
+    if (m_workers.empty() || numberOfChunks == 1u) {
+        function(0u, count);
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->function = &function;
+    state->count = count;
+    state->grainSize = grainSize;
+    state->numberOfChunks = numberOfChunks;
+
+    auto const numberOfHelpers = std::min(numberOfChunks - 1u, m_workers.size());
+    for (auto i = 0u; i != numberOfHelpers; ++i) {
+        schedule([state]() { state->process(); });
+    }
+    state->process();
+
+    // function is referenced by the state, so all chunks need to be done before returning
+    while (!state->isFinished()) {
+        jt::JobHandle next {};
+        if (tryTakeJob(next)) {
+            execute(std::move(next));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    if (state->exception) {
+        std::rethrow_exception(state->exception);
+    }
+}
+
+std::size_t jt::JobSystem::getNumberOfWorkers() const noexcept { return m_workers.size(); }
+
+std::size_t jt::JobSystem::getDefaultNumberOfWorkers()
+{
+    auto const hardwareThreads = static_cast<std::size_t>(std::thread::hardware_concurrency());
+    return hardwareThreads > 1u ? hardwareThreads - 1u : 0u;
+}
+
+void jt::JobSystem::enqueue(jt::JobHandle job)
+{
+    auto const queueIndex = currentJobSystem == this
+        ? currentWorkerIndex
+        : m_nextQueue.fetch_add(1u, std::memory_order_relaxed) % m_queues.size();
+    // count before pushing, so the counter never drops below the number of queued jobs
+    m_numberOfQueuedJobs.fetch_add(1u, std::memory_order_release);
+    {
+        auto& queue = *m_queues[queueIndex];
+        std::lock_guard<std::mutex> const lock { queue.mutex };
+        queue.jobs.push_back(std::move(job));
+    }
+    {
+        // pairs with the predicate check in workerLoop, so the notification cannot get lost
+        std::lock_guard<std::mutex> const lock { m_sleepMutex };
+    }
+    m_sleepCondition.notify_one();
+}
+
+bool jt::JobSystem::tryTakeJob(jt::JobHandle& job)
+{
+    if (m_numberOfQueuedJobs.load(std::memory_order_acquire) == 0u) {
+        return false;
+    }
+    auto const isWorker = currentJobSystem == this;
+    if (isWorker) {
+        auto& queue = *m_queues[currentWorkerIndex];
+        std::lock_guard<std::mutex> const lock { queue.mutex };
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.back());
+            queue.jobs.pop_back();
+            m_numberOfQueuedJobs.fetch_sub(1u, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    auto const firstVictim = isWorker ? currentWorkerIndex + 1u : 0u;
+    for (auto i = 0u; i != m_queues.size(); ++i) {
+        auto& queue = *m_queues[(firstVictim + i) % m_queues.size()];
+        std::lock_guard<std::mutex> const lock { queue.mutex };
+        if (!queue.jobs.empty()) {
+            job = std::move(queue.jobs.front());
+            queue.jobs.pop_front();
+            m_numberOfQueuedJobs.fetch_sub(1u, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void jt::JobSystem::execute(jt::JobHandle job)
+{
+    // continuations that become ready are only executed inline if there are no workers to
+    // enqueue them for. A local list avoids recursion for long dependency chains.
+    std::vector<jt::JobHandle> ready { std::move(job) };
+    while (!ready.empty()) {
+        auto current = std::move(ready.back());
+        ready.pop_back();
+        auto continuations = current->execute();
+        for (auto& continuation : continuations) {
+            if (!continuation->releaseDependency()) {
+                continue;
+            }
+            if (m_workers.empty()) {
+                ready.push_back(std::move(continuation));
+            } else {
+                enqueue(std::move(continuation));
+            }
+        }
+    }
+}
+
+void jt::JobSystem::workerLoop(std::size_t workerIndex)
+{
+    currentJobSystem = this;
+    currentWorkerIndex = workerIndex;
+    jt::TraceProfiler::setThreadName("worker " + std::to_string(workerIndex));
+
+    while (true) {
+        jt::JobHandle job {};
+        if (tryTakeJob(job)) {
+            JT_PROFILE_ZONE("jt::JobSystem::execute");
+            execute(std::move(job));
+            continue;
+        }
+        std::unique_lock<std::mutex> lock { m_sleepMutex };
+        m_sleepCondition.wait(lock, [this]() {
+            return m_stop || m_numberOfQueuedJobs.load(std::memory_order_acquire) != 0u;
+        });
+        if (m_stop && m_numberOfQueuedJobs.load(std::memory_order_acquire) == 0u) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,65 @@
+#ifndef JAMTEMPLATE_JOB_SYSTEM_HPP
+#define JAMTEMPLATE_JOB_SYSTEM_HPP
+
+#include <jobs/job_system_interface.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace jt {
+
+/// Work stealing thread pool.
+///
+/// Every worker owns a deque of ready jobs. Jobs scheduled from a worker are pushed to its own
+/// deque and taken back in last in, first out order, which keeps related data in the cache. Idle
+/// workers steal the oldest job from the deques of other workers. Jobs scheduled from other
+/// threads are distributed round robin. Threads that wait for a job execute other jobs meanwhile,
+/// so waiting inside a job does not block a worker. Without worker threads, tasks are executed
+/// immediately on the calling thread.
+class JobSystem : public jt::JobSystemInterface {
+public:
+    /// Constructor
+    /// \param numberOfWorkers number of worker threads to start
+    explicit JobSystem(std::size_t numberOfWorkers = getDefaultNumberOfWorkers());
+
+    /// Destructor, finishes all ready jobs and joins the worker threads
+    ~JobSystem() override;
+
+    jt::JobHandle schedule(
+        std::function<void()> task, std::vector<jt::JobHandle> const& dependencies = {}) override;
+    void wait(jt::JobHandle const& job) override;
+    void parallelFor(
+        std::size_t count, RangeFunction const& function, std::size_t grainSize = 0u) override;
+    std::size_t getNumberOfWorkers() const noexcept override;
+
+    /// Get the default number of worker threads (hardware concurrency - 1)
+    /// \return number of worker threads
+    static std::size_t getDefaultNumberOfWorkers();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex {};
+        std::deque<jt::JobHandle> jobs {};
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues {};
+    std::vector<std::thread> m_workers {};
+    std::atomic<std::size_t> m_nextQueue { 0u };
+    std::atomic<std::size_t> m_numberOfQueuedJobs { 0u };
+
+    std::mutex m_sleepMutex {};
+    std::condition_variable m_sleepCondition {};
+    bool m_stop { false };
+
+    void enqueue(jt::JobHandle job);
+    bool tryTakeJob(jt::JobHandle& job);
+    void execute(jt::JobHandle job);
+    void workerLoop(std::size_t workerIndex);
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_JOB_SYSTEM_HPP
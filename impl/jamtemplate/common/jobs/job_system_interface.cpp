@@ -0,0 +1 @@
+#include "job_system_interface.hpp"
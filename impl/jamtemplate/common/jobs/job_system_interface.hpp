@@ -0,0 +1,61 @@
+#ifndef JAMTEMPLATE_JOB_SYSTEM_INTERFACE_HPP
+#define JAMTEMPLATE_JOB_SYSTEM_INTERFACE_HPP
+
+#include <jobs/job.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+namespace jt {
+
+/// Scheduler for work that can run in parallel to the game loop, e.g. texture decoding,
+/// pathfinding, particle updates or level loading.
+class JobSystemInterface {
+public:
+    /// Function called by parallelFor for the half open index range [begin, end)
+    using RangeFunction = std::function<void(std::size_t begin, std::size_t end)>;
+
+    /// Schedule a task. The task runs once all dependencies are finished.
+    /// \param task the function to execute
+    /// \param dependencies jobs that need to finish before task is started
+    /// \return handle to wait for the job or to use it as dependency for other jobs
+    virtual jt::JobHandle schedule(
+        std::function<void()> task, std::vector<jt::JobHandle> const& dependencies = {})
+        = 0;
+
+    /// Block until the job is finished. The calling thread executes other jobs while waiting.
+    /// Rethrows the exception thrown by the job's task, if any.
+    /// \param job the job to wait for
+    virtual void wait(jt::JobHandle const& job) = 0;
+
+    /// Split the index range [0, count) into chunks and execute them in parallel. The calling
+    /// thread takes part and the function returns once all chunks are done. The first exception
+    /// thrown by a chunk is rethrown.
+    /// \param count number of indices
+    /// \param function called for each chunk, needs to be safe to call concurrently
+    /// \param grainSize minimum number of indices per chunk, 0 picks a size based on the number
+    ///        of workers
+    virtual void parallelFor(
+        std::size_t count, RangeFunction const& function, std::size_t grainSize = 0u)
+        = 0;
+
+    /// Get the number of worker threads, not counting the thread that waits for jobs
+    /// \return number of worker threads
+    virtual std::size_t getNumberOfWorkers() const noexcept = 0;
+
+    virtual ~JobSystemInterface() = default;
+
+    // no copy, no move. Avoid slicing.
+    JobSystemInterface(JobSystemInterface const&) = delete;
+    JobSystemInterface(JobSystemInterface&&) = delete;
+    JobSystemInterface& operator=(JobSystemInterface const&) = delete;
+    JobSystemInterface& operator=(JobSystemInterface&&) = delete;
+
+protected:
+    // default constructor can only be called from derived classes
+    JobSystemInterface() = default;
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_JOB_SYSTEM_INTERFACE_HPP
@@ -0,0 +1,33 @@
+#include "job_system_null.hpp"
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+jt::JobHandle jt::null_objects::JobSystemNull::schedule(
+    std::function<void()> task, std::vector<jt::JobHandle> const& /*dependencies*/)
+{
+    if (!task) {
+        throw std::invalid_argument { "cannot schedule an empty task" };
+    }
+    auto job = std::make_shared<jt::Job>(std::move(task));
+    job->releaseDependency();
+    job->execute();
+    return job;
+}
+
+void jt::null_objects::JobSystemNull::wait(jt::JobHandle const& job)
+{
+    if (job) {
+        job->rethrowIfFailed();
+    }
+}
+
+void jt::null_objects::JobSystemNull::parallelFor(
+    std::size_t count, RangeFunction const& function, std::size_t /*grainSize*/)
+{
+    if (count != 0u) {
+        function(0u, count);
+    }
+}
+
+std::size_t jt::null_objects::JobSystemNull::getNumberOfWorkers() const noexcept { return 0u; }
@@ -0,0 +1,24 @@
+#ifndef JAMTEMPLATE_JOB_SYSTEM_NULL_HPP
+#define JAMTEMPLATE_JOB_SYSTEM_NULL_HPP
+
+#include <jobs/job_system_interface.hpp>
+
+namespace jt {
+namespace null_objects {
+
+/// Job system without worker threads, e.g. for the web build. Tasks are executed immediately on
+/// the calling thread, so dependencies are always finished when a task is scheduled.
+class JobSystemNull : public jt::JobSystemInterface {
+public:
+    jt::JobHandle schedule(
+        std::function<void()> task, std::vector<jt::JobHandle> const& dependencies = {}) override;
+    void wait(jt::JobHandle const& job) override;
+    void parallelFor(
+        std::size_t count, RangeFunction const& function, std::size_t grainSize = 0u) override;
+    std::size_t getNumberOfWorkers() const noexcept override;
+};
+
+} // namespace null_objects
+} // namespace jt
+
+#endif // JAMTEMPLATE_JOB_SYSTEM_NULL_HPP
@@ -0,0 +1,268 @@
+#include "async_logger.hpp"
+#include <log/log_target_interface.hpp>
+#include <trace_profiler.hpp>
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+// time the background thread sleeps if there is nothing to log. Entries logged in the meantime
+// are written in one batch.
+constexpr std::chrono::milliseconds idleTime { 2 };
+
+// maximum number of entries waiting for the main thread. If update() is not called, further
+// entries are only passed to the background thread targets.
+constexpr std::size_t maxNumberOfMainThreadEntries { 100000u };
+
+std::string formatTime(std::int64_t time)
+{
+    std::chrono::system_clock::time_point const timePoint {
+        std::chrono::system_clock::duration { time }
+    };
+    return std::to_string(std::chrono::system_clock::to_time_t(timePoint));
+}
+
+jt::LogEntry createLogEntry(jt::LogRecord const& record)
+{
+    jt::LogEntry entry {};
+    entry.message.assign(record.text.data(), record.messageLength);
+    entry.time = formatTime(record.time);
+    entry.level = record.level;
+
+    std::size_t position = record.messageLength;
+    for (auto i = 0u; i != record.numberOfTags; ++i) {
+        auto const tagLength = static_cast<std::uint8_t>(record.text[position]);
+        entry.tags.emplace_back(record.text.data() + position + 1u, tagLength);
+        position += 1u + tagLength;
+    }
+    return entry;
+}
+
+} // namespace
+
+jt::AsyncLogger::AsyncLogger(std::size_t queueCapacity)
+    : m_queue { queueCapacity }
+{
+    m_thread = std::thread { [this]() { run(); } };
+}
+
+jt::AsyncLogger::~AsyncLogger()
+{
+    m_stopRequested.store(true, std::memory_order_release);
+    m_thread.join();
+}
+
+void jt::AsyncLogger::action(std::string const& string) { addLogEntry(string, LogLevel::Action); }
+
+void jt::AsyncLogger::fatal(std::string const& string, std::vector<std::string> const& tags)
+{
+    if (m_logLevel >= LogLevel::Fatal) {
+        addLogEntry(string, LogLevel::Fatal, tags);
+        // the program is likely to terminate, make sure the message is not lost
+        flush();
+    }
+}
+
+void jt::AsyncLogger::error(std::string const& string, std::vector<std::string> const& tags)
+{
+    if (m_logLevel >= LogLevel::Error) {
+        addLogEntry(string, LogLevel::Error, tags);
+    }
+}
+
+void jt::AsyncLogger::warning(std::string const& string, std::vector<std::string> const& tags)
+{
+    if (m_logLevel >= LogLevel::Warning) {
+        addLogEntry(string, LogLevel::Warning, tags);
+    }
+}
+
+void jt::AsyncLogger::info(std::string const& string, std::vector<std::string> const& tags)
+{
+    if (m_logLevel >= LogLevel::Info) {
+        addLogEntry(string, LogLevel::Info, tags);
+    }
+}
+
+void jt::AsyncLogger::debug(std::string const& string, std::vector<std::string> const& tags)
+{
+#ifdef JT_ENABLE_DEBUG
+    if (m_logLevel >= LogLevel::Debug) {
+        addLogEntry(string, LogLevel::Debug, tags);
+    }
+#endif
+}
+
+void jt::AsyncLogger::verbose(std::string const& string, std::vector<std::string> const& tags)
+{
+#ifdef JT_ENABLE_DEBUG
+    if (m_logLevel >= LogLevel::Verbose) {
+        addLogEntry(string, LogLevel::Verbose, tags);
+    }
+#endif
+}
+
+bool jt::AsyncLogger::isLogLevelEnabled(LogLevel level) const noexcept
+{
+    return m_logLevel.load(std::memory_order_relaxed) >= level;
+}
+
+void jt::AsyncLogger::log(LogLevel level, std::string_view message, LogTags tags)
+{
+    if (!isLogLevelEnabled(level)) {
+        return;
+    }
+    addLogRecord(jt::createLogRecord(message, level, tags));
+    if (level == LogLevel::Fatal) {
+        flush();
+    }
+}
+
+void jt::AsyncLogger::addLogTarget(std::shared_ptr<jt::LogTargetInterface> target)
+{
+    if (target == nullptr) {
+        error("cannot add nullptr log target", { "jt" });
+        return;
+    }
+    std::lock_guard const lock { m_targetsMutex };
+    m_logTargets.push_back(target);
+}
+
+void jt::AsyncLogger::addMainThreadLogTarget(std::shared_ptr<jt::LogTargetInterface> target)
+{
+    if (target == nullptr) {
+        error("cannot add nullptr log target", { "jt" });
+        return;
+    }
+    m_mainThreadLogTargets.push_back(target);
+    m_hasMainThreadLogTargets.store(true, std::memory_order_release);
+}
+
+void jt::AsyncLogger::setLogLevel(LogLevel level) { m_logLevel = level; }
+
+void jt::AsyncLogger::update()
+{
+    {
+        std::lock_guard const lock { m_mainThreadEntriesMutex };
+        if (m_mainThreadEntries.empty()) {
+            return;
+        }
+        // the background thread continues with the cleared vector of the last call, so the
+        // capacity of both vectors is reused
+        std::swap(m_mainThreadEntries, m_mainThreadEntriesInProgress);
+    }
+    JT_PROFILE_ZONE("jt::AsyncLogger::update");
+    for (auto const& entry : m_mainThreadEntriesInProgress) {
+        for (auto& t : m_mainThreadLogTargets) {
+            t->log(entry);
+        }
+    }
+    m_mainThreadEntriesInProgress.clear();
+}
+
+void jt::AsyncLogger::flush()
+{
+    auto const numberOfPushedEntries = m_queue.getNumberOfPushedRecords();
+    while (m_numberOfWrittenEntries.load(std::memory_order_acquire) < numberOfPushedEntries) {
+        std::this_thread::yield();
+    }
+}
+
+std::uint64_t jt::AsyncLogger::getNumberOfDroppedEntries() const noexcept
+{
+    return m_numberOfDroppedEntries.load(std::memory_order_relaxed);
+}
+
+std::uint64_t jt::AsyncLogger::getNumberOfTruncatedEntries() const noexcept
+{
+    return m_numberOfTruncatedEntries.load(std::memory_order_relaxed);
+}
+
+std::size_t jt::AsyncLogger::getQueueDepth() const noexcept { return m_queue.size(); }
+
+std::size_t jt::AsyncLogger::getMaxQueueDepth() const noexcept
+{
+    return m_maxQueueDepth.load(std::memory_order_relaxed);
+}
+
+void jt::AsyncLogger::addLogEntry(
+    std::string const& message, LogLevel level, std::vector<std::string> const& tags)
+{
+    addLogRecord(jt::createLogRecord(message, level, tags));
+}
+
+void jt::AsyncLogger::addLogRecord(jt::LogRecord const& record)
+{
+    if (record.isTruncated) {
+        m_numberOfTruncatedEntries.fetch_add(1u, std::memory_order_relaxed);
+    }
+    if (!m_queue.tryPush(record)) {
+        m_numberOfDroppedEntries.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+void jt::AsyncLogger::run()
+{
+    jt::TraceProfiler::setThreadName("logger");
+    while (!m_stopRequested.load(std::memory_order_acquire)) {
+        if (!processQueue()) {
+            std::this_thread::sleep_for(idleTime);
+        }
+    }
+    // write everything that was logged before the logger was destroyed
+    processQueue();
+}
+
+bool jt::AsyncLogger::processQueue()
+{
+    auto const queueDepth = m_queue.size();
+    auto const numberOfDroppedEntries = getNumberOfDroppedEntries();
+    if (queueDepth == 0u && numberOfDroppedEntries == m_numberOfReportedDroppedEntries) {
+        return false;
+    }
+    JT_PROFILE_ZONE("jt::AsyncLogger::processQueue");
+    if (queueDepth > m_maxQueueDepth.load(std::memory_order_relaxed)) {
+        m_maxQueueDepth.store(queueDepth, std::memory_order_relaxed);
+    }
+
+    std::lock_guard const lock { m_targetsMutex };
+    auto const hasMainThreadLogTargets = m_hasMainThreadLogTargets.load(std::memory_order_acquire);
+    std::vector<jt::LogEntry> mainThreadEntries {};
+    auto const log = [this, hasMainThreadLogTargets, &mainThreadEntries](jt::LogEntry entry) {
+        for (auto& t : m_logTargets) {
+            t->log(entry);
+        }
+        if (hasMainThreadLogTargets) {
+            mainThreadEntries.push_back(std::move(entry));
+        }
+    };
+
+    // only pop the records that were already there, so a busy producer cannot delay the flush
+    jt::LogRecord record {};
+    for (std::size_t i = 0u; i != queueDepth && m_queue.tryPop(record); ++i) {
+        log(createLogEntry(record));
+    }
+    if (numberOfDroppedEntries != m_numberOfReportedDroppedEntries) {
+        log(jt::LogEntry { std::to_string(numberOfDroppedEntries - m_numberOfReportedDroppedEntries)
+                + " log entries dropped, the log queue was full",
+            formatTime(std::chrono::system_clock::now().time_since_epoch().count()),
+            LogLevel::Warning, { "jt" } });
+        m_numberOfReportedDroppedEntries = numberOfDroppedEntries;
+    }
+    for (auto& t : m_logTargets) {
+        t->flush();
+    }
+    if (!mainThreadEntries.empty()) {
+        std::lock_guard const mainThreadLock { m_mainThreadEntriesMutex };
+        auto const freeSlots = maxNumberOfMainThreadEntries
+            - std::min(maxNumberOfMainThreadEntries, m_mainThreadEntries.size());
+        mainThreadEntries.resize(std::min(freeSlots, mainThreadEntries.size()));
+        m_mainThreadEntries.insert(m_mainThreadEntries.end(),
+            std::make_move_iterator(mainThreadEntries.begin()),
+            std::make_move_iterator(mainThreadEntries.end()));
+    }
+    m_numberOfWrittenEntries.store(m_queue.getNumberOfPoppedRecords(), std::memory_order_release);
+    return true;
+}
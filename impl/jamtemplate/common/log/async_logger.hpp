@@ -0,0 +1,106 @@
+#ifndef JAMTEMPLATE_ASYNC_LOGGER_HPP
+#define JAMTEMPLATE_ASYNC_LOGGER_HPP
+
+#include <log/log_entry.hpp>
+#include <log/log_record_queue.hpp>
+#include <log/logger_interface.hpp>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace jt {
+class LogTargetInterface;
+
+/// Logger that passes entries to its targets on a background thread. Logging only copies the
+/// entry into a lock-free queue, formatting and writing happen on the background thread. Entries
+/// are dropped if the queue is full. Logging is thread safe.
+class AsyncLogger : public jt::LoggerInterface {
+public:
+    /// Constructor
+    /// \param queueCapacity maximum number of queued entries, needs to be a power of two
+    explicit AsyncLogger(std::size_t queueCapacity = 4096u);
+    ~AsyncLogger() override;
+
+    void action(std::string const& string) override;
+    void fatal(std::string const& string, std::vector<std::string> const& tags = {}) override;
+    void error(std::string const& string, std::vector<std::string> const& tags = {}) override;
+    void warning(std::string const& string, std::vector<std::string> const& tags = {}) override;
+    void info(std::string const& string, std::vector<std::string> const& tags = {}) override;
+    void debug(std::string const& string, std::vector<std::string> const& tags = {}) override;
+    void verbose(std::string const& string, std::vector<std::string> const& tags = {}) override;
+
+    bool isLogLevelEnabled(LogLevel level) const noexcept override;
+    void log(LogLevel level, std::string_view message, LogTags tags) override;
+
+    /// Add a log target that is called from the background thread
+    /// \param target the target to be added
+    void addLogTarget(std::shared_ptr<LogTargetInterface> target) override;
+
+    /// Add a log target that is only called from the main thread in update(), e.g. for targets
+    /// that are read from the main thread like LogHistory. Needs to be called from the main thread.
+    /// \param target the target to be added
+    void addMainThreadLogTarget(std::shared_ptr<LogTargetInterface> target);
+
+    void setLogLevel(LogLevel level) override;
+
+    /// Pass the entries written by the background thread since the last call to the main thread
+    /// targets. Needs to be called from the main thread.
+    void update() override;
+
+    /// Wait until all entries logged before this call were written by the targets
+    void flush();
+
+    /// Number of entries that were dropped because the queue was full
+    /// \return the number of dropped entries
+    std::uint64_t getNumberOfDroppedEntries() const noexcept;
+
+    /// Number of entries whose message or tags were cut off
+    /// \return the number of truncated entries
+    std::uint64_t getNumberOfTruncatedEntries() const noexcept;
+
+    /// Number of entries waiting for the background thread
+    /// \return the queue depth
+    std::size_t getQueueDepth() const noexcept;
+
+    /// Highest queue depth seen by the background thread
+    /// \return the maximum queue depth
+    std::size_t getMaxQueueDepth() const noexcept;
+
+private:
+    jt::LogRecordQueue m_queue;
+    std::atomic<LogLevel> m_logLevel { LogLevel::Verbose };
+
+    std::atomic<std::uint64_t> m_numberOfDroppedEntries { 0u };
+    std::atomic<std::uint64_t> m_numberOfTruncatedEntries { 0u };
+    std::atomic<std::size_t> m_maxQueueDepth { 0u };
+    std::atomic<std::uint64_t> m_numberOfWrittenEntries { 0u };
+    std::uint64_t m_numberOfReportedDroppedEntries { 0u };
+
+    std::mutex m_targetsMutex {};
+    std::vector<std::shared_ptr<jt::LogTargetInterface>> m_logTargets {};
+
+    // only accessed from the main thread
+    std::vector<std::shared_ptr<jt::LogTargetInterface>> m_mainThreadLogTargets {};
+    std::vector<jt::LogEntry> m_mainThreadEntriesInProgress {};
+
+    // entries created by the background thread that were not passed to the main thread targets yet
+    std::atomic<bool> m_hasMainThreadLogTargets { false };
+    std::mutex m_mainThreadEntriesMutex {};
+    std::vector<jt::LogEntry> m_mainThreadEntries {};
+
+    std::atomic<bool> m_stopRequested { false };
+    std::thread m_thread {};
+
+    void addLogEntry(
+        std::string const& message, LogLevel level, std::vector<std::string> const& tags = {});
+    void addLogRecord(jt::LogRecord const& record);
+    void run();
+    bool processQueue();
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_ASYNC_LOGGER_HPP
@@ -2,12 +2,48 @@
 #include <game_interface.hpp>
 #include <strutils.hpp>
 #include <imgui.h>
+#include <algorithm>
+#include <array>
 #include <string.h>
 
+namespace {
+
+// entries of the level filter combo box
+constexpr std::array<char const*, 8> levelFilterNames { "all", "action", "fatal", "error",
+    "warning", "info", "debug", "verbose" };
+
+jt::LogLevel getFilteredLevel(int levelFilter)
+{
+    return levelFilter == 1 ? jt::LogLevel::Action : static_cast<jt::LogLevel>(levelFilter);
+}
+
+bool containsText(jt::LogHistoryEntry const& entry, std::string const& text)
+{
+    if (entry.message.find(text) != std::string_view::npos) {
+        return true;
+    }
+    for (auto i = 0u; i != entry.numberOfTags; ++i) {
+        if (entry.tags[i].find(text) != std::string_view::npos) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::string getTrimmedInput(std::vector<char> const& buffer)
+{
+    std::string str = buffer.data();
+    strutil::trim(str);
+    return str;
+}
+
+} // namespace
+
 jt::Console::Console()
 {
     m_inputBufferAction.resize(500);
     m_inputBufferFilter.resize(200);
+    m_inputBufferTag.resize(100);
 }
 
 void jt::Console::doCreate() { m_history = getGame()->cache().getLogHistory(); }
@@ -52,9 +88,7 @@ void jt::Console::doDraw() const
             = ImGui::GetStyle().ItemSpacing.y + ImGui::GetFrameHeightWithSpacing();
         ImGui::BeginChild("ScrollingRegion", ImVec2(0, -footer_height_to_reserve), false,
             ImGuiWindowFlags_HorizontalScrollbar);
-        for (auto& entry : m_history->getHistory()) {
-            renderOneLogEntry(entry);
-        }
+        drawEntries();
         if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
             ImGui::SetScrollHereY(1.0f);
         ImGui::EndChild();
@@ -67,6 +101,104 @@ void jt::Console::doDraw() const
 void jt::Console::drawFilter() const
 {
     ImGui::InputText("Filter", m_inputBufferFilter.data(), m_inputBufferFilter.size());
+    ImGui::InputText("Tag", m_inputBufferTag.data(), m_inputBufferTag.size());
+    ImGui::Combo("Level", &m_levelFilter, levelFilterNames.data(),
+        static_cast<int>(levelFilterNames.size()));
+}
+
+bool jt::Console::isFilterActive() const
+{
+    return m_levelFilter != 0 || !getTrimmedInput(m_inputBufferFilter).empty()
+        || !getTrimmedInput(m_inputBufferTag).empty();
+}
+
+void jt::Console::drawEntries() const
+{
+    // only the visible rows are rendered, so a long history does not cost frame time
+    ImGuiListClipper clipper;
+    if (!isFilterActive()) {
+        auto const firstIndex = m_history->getFirstIndex();
+        clipper.Begin(static_cast<int>(m_history->getEndIndex() - firstIndex));
+        while (clipper.Step()) {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+                auto const index = firstIndex + static_cast<std::uint64_t>(row);
+                renderOneLogEntry(m_history->getEntry(index));
+            }
+        }
+        return;
+    }
+
+    updateFilteredIndices();
+    clipper.Begin(static_cast<int>(m_filteredIndices.size()));
+    while (clipper.Step()) {
+        for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+            renderOneLogEntry(
+                m_history->getEntry(m_filteredIndices[static_cast<std::size_t>(row)]));
+        }
+    }
+}
+
+void jt::Console::updateFilteredIndices() const
+{
+    auto const textFilter = getTrimmedInput(m_inputBufferFilter);
+    auto const tagFilter = getTrimmedInput(m_inputBufferTag);
+    auto const wasFilterActive = m_appliedLevelFilter != 0 || !m_appliedTextFilter.empty()
+        || !m_appliedTagFilter.empty();
+    if (wasFilterActive && tagFilter == m_appliedTagFilter && m_levelFilter == m_appliedLevelFilter
+        && textFilter != m_appliedTextFilter
+        && textFilter.find(m_appliedTextFilter) != std::string::npos) {
+        // typing extends the text filter. Entries that contain the new text also contain the old
+        // one, so only the current result needs to be narrowed down.
+        std::erase_if(m_filteredIndices, [this, &textFilter](std::uint64_t index) {
+            return !containsText(m_history->getEntry(index), textFilter);
+        });
+        m_appliedTextFilter = textFilter;
+    } else if (textFilter != m_appliedTextFilter || tagFilter != m_appliedTagFilter
+        || m_levelFilter != m_appliedLevelFilter) {
+        m_filteredIndices.clear();
+        m_filteredUntil = 0u;
+        m_appliedTextFilter = textFilter;
+        m_appliedTagFilter = tagFilter;
+        m_appliedLevelFilter = m_levelFilter;
+    }
+
+    // drop entries that were removed from the history
+    auto const firstIndex = m_history->getFirstIndex();
+    while (!m_filteredIndices.empty() && m_filteredIndices.front() < firstIndex) {
+        m_filteredIndices.pop_front();
+    }
+
+    auto const passesFilter = [this, &textFilter](std::uint64_t index) {
+        auto const entry = m_history->getEntry(index);
+        if (m_levelFilter != 0 && entry.level != getFilteredLevel(m_levelFilter)) {
+            return false;
+        }
+        return textFilter.empty() || containsText(entry, textFilter);
+    };
+    auto const addNewIndices = [this, &passesFilter](std::deque<std::uint64_t> const& indices) {
+        auto it = std::lower_bound(indices.cbegin(), indices.cend(), m_filteredUntil);
+        for (; it != indices.cend(); ++it) {
+            if (passesFilter(*it)) {
+                m_filteredIndices.push_back(*it);
+            }
+        }
+    };
+
+    // start from the smallest index of the history, only new entries are checked
+    m_filteredUntil = std::max(m_filteredUntil, firstIndex);
+    auto const endIndex = m_history->getEndIndex();
+    if (!tagFilter.empty()) {
+        addNewIndices(m_history->getIndicesWithTag(tagFilter));
+    } else if (m_levelFilter != 0) {
+        addNewIndices(m_history->getIndicesWithLevel(getFilteredLevel(m_levelFilter)));
+    } else {
+        for (auto index = m_filteredUntil; index != endIndex; ++index) {
+            if (passesFilter(index)) {
+                m_filteredIndices.push_back(index);
+            }
+        }
+    }
+    m_filteredUntil = endIndex;
 }
 
 void jt::Console::storeInputInCommand() const
@@ -111,21 +243,21 @@ void jt::Console::storeActionInCommand() const
 
 void jt::Console::clearInput() const { strcpy(m_inputBufferAction.data(), ""); }
 
-void jt::Console::renderOneLogEntry(jt::LogEntry const& entry) const
+void jt::Console::renderOneLogEntry(jt::LogHistoryEntry const& entry) const
 {
     ImVec4 color { 1.0f, 1.0f, 1.0f, 1.0f };
 
     std::string timeText = "";
     if (m_drawTime) {
-        timeText = entry.time + ": ";
+        timeText = std::string { entry.time } + ": ";
     }
 
     std::string tagText = "";
     if (m_drawTag) {
-        for (auto const& t : entry.tags) {
-            tagText += "<" + t + ">";
+        for (auto i = 0u; i != entry.numberOfTags; ++i) {
+            tagText += "<" + std::string { entry.tags[i] } + ">";
         }
-        if (!entry.tags.empty()) {
+        if (entry.numberOfTags != 0u) {
             tagText += ": ";
         }
     }
@@ -151,15 +283,7 @@ void jt::Console::renderOneLogEntry(jt::LogEntry const& entry) const
     }
 
     std::string sourceText;
-    std::string text = timeText + levelText + tagText + entry.message + sourceText;
-
-    std::string filterString = m_inputBufferFilter.data();
-    strutil::trim(filterString);
-    if (!filterString.empty()) {
-        if (!strutil::contains(text, filterString)) {
-            return;
-        }
-    }
+    std::string text = timeText + levelText + tagText + std::string { entry.message } + sourceText;
 
     ImGui::PushStyleColor(ImGuiCol_Text, color);
     ImGui::Text("%s", text.c_str());
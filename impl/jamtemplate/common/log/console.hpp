@@ -2,9 +2,10 @@
 #define JAMTEMPLATE_CONSOLE_HPP
 
 #include <game_object.hpp>
-#include <log/log_entry.hpp>
 #include <log/log_history_interface.hpp>
 #include <imgui.h>
+#include <cstdint>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -25,6 +26,8 @@ private:
     mutable int m_historyPos { -1 };
     mutable std::vector<std::string> History;
     mutable std::vector<char> m_inputBufferFilter;
+    mutable std::vector<char> m_inputBufferTag;
+    mutable int m_levelFilter { 0 };
     mutable std::vector<char> m_inputBufferAction;
     mutable std::string m_lastCommand { "" };
     mutable bool m_drawLevel { true };
@@ -32,11 +35,21 @@ private:
     mutable bool m_drawTime { false };
     mutable bool m_drawSource { false };
 
+    // indices of the history entries that pass the filters, updated with new entries only
+    mutable std::deque<std::uint64_t> m_filteredIndices;
+    mutable std::uint64_t m_filteredUntil { 0u };
+    mutable std::string m_appliedTextFilter { "" };
+    mutable std::string m_appliedTagFilter { "" };
+    mutable int m_appliedLevelFilter { 0 };
+
     void doCreate() override;
     void doUpdate(float const /*elapsed*/) override;
     void doDraw() const override;
 
-    void renderOneLogEntry(jt::LogEntry const& entry) const;
+    void drawEntries() const;
+    void updateFilteredIndices() const;
+    bool isFilterActive() const;
+    void renderOneLogEntry(jt::LogHistoryEntry const& entry) const;
     void storeInputInCommand() const;
     void clearInput() const;
     void storeActionInCommand() const;
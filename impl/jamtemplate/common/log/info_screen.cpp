@@ -1,5 +1,6 @@
 #include "info_screen.hpp"
 #include <game_interface.hpp>
+#include <game_object_collection.hpp>
 #include <imgui.h>
 
 jt::InfoScreen::InfoScreen()
@@ -48,6 +49,36 @@ void jt::InfoScreen::doDraw() const
         std::string textures
             = "# Textures stored: " + std::to_string(textureManager().getNumberOfTextures());
         ImGui::Text("%s", textures.c_str());
+
+        auto const stats = textureManager().getStats();
+        ImGui::Text("Atlas pages: %zu", stats.numberOfPages);
+        ImGui::Text("Packed images: %zu", stats.numberOfPackedImages);
+        ImGui::Text("Standalone images: %zu", stats.numberOfStandaloneImages);
+        ImGui::Text("Flash textures: %zu", stats.numberOfFlashTextures);
+        ImGui::Text("Atlas occupancy: %.1f %%", stats.getOccupancy() * 100.0f);
+        ImGui::Text("Texture binds: %llu (%llu draws)",
+            static_cast<unsigned long long>(stats.numberOfTextureBinds),
+            static_cast<unsigned long long>(stats.numberOfDraws));
+        ImGui::Text("Deferred flash images: %zu (%.1f kB saved, %.1f kB masks)",
+            stats.numberOfDeferredFlashImages,
+            static_cast<double>(stats.savedFlashTextureBytes) / 1024.0,
+            static_cast<double>(stats.flashMaskBytes) / 1024.0);
+    }
+    if (!ImGui::CollapsingHeader("Layers")) {
+        auto const stats = getGame()->gfx().getCompositorStats();
+        ImGui::Text("Composited: %zu, skipped: %zu", stats.getNumberOfCompositedLayers(),
+            stats.getNumberOfSkippedLayers());
+        ImGui::Text("Present: %.3f ms, frame interval: %.2f ms (avg %.2f, min %.2f, max %.2f)",
+            stats.pacing.presentTimeInSeconds * 1000.0f,
+            stats.pacing.frameIntervalInSeconds * 1000.0f,
+            stats.pacing.averageFrameIntervalInSeconds * 1000.0f,
+            stats.pacing.minFrameIntervalInSeconds * 1000.0f,
+            stats.pacing.maxFrameIntervalInSeconds * 1000.0f);
+        for (auto const& l : stats.layers) {
+            ImGui::Text("   z %i: %u draws, clear %.3f ms, composite %.3f ms", l.z,
+                l.numberOfDrawRequests, l.clearTimeInSeconds * 1000.0f,
+                l.compositeTimeInSeconds * 1000.0f);
+        }
     }
     if (!ImGui::CollapsingHeader("Performance")) {
 
@@ -84,6 +115,15 @@ void jt::InfoScreen::doDraw() const
             = "# GameObjects (created): " + std::to_string(getNumberOfCreatedGameObjects());
         ImGui::Text("%s", createdGameObjectsText.c_str());
 
+        if (state->getParallelUpdateObjects()) {
+            auto const timings = state->getObjectUpdateTimings();
+            ImGui::Text("Simulate: %.3f ms (%zu objects on %zu workers)",
+                timings.simulateTimeInSeconds * 1000.0f, timings.numberOfParallelObjects,
+                getGame()->jobSystem().getNumberOfWorkers());
+            ImGui::Text("Commit: %.3f ms (%zu serial objects)",
+                timings.commitTimeInSeconds * 1000.0f, timings.numberOfSerialObjects);
+        }
+
         ImGui::PlotLines("AliveGameObjects [#]", m_GameObjectAliveCountVector.data(),
             static_cast<int>(m_GameObjectAliveCountVector.size()), 0, nullptr, 0, FLT_MAX,
             ImVec2 { 0, 100 });
@@ -1,14 +1,119 @@
 #include "log_history.hpp"
+#include <log/log_entry.hpp>
+#include <algorithm>
+#include <stdexcept>
 
-std::vector<jt::LogEntry> const& jt::LogHistory::getHistory() { return m_history; }
+jt::LogHistory::LogHistory(std::size_t capacity)
+    : m_capacity { capacity }
+{
+    if (m_capacity == 0u) {
+        throw std::invalid_argument { "log history capacity needs to be greater than zero" };
+    }
+}
+
+std::uint64_t jt::LogHistory::getFirstIndex() const { return m_firstIndex; }
+
+std::uint64_t jt::LogHistory::getEndIndex() const { return m_endIndex; }
+
+jt::LogHistoryEntry jt::LogHistory::getEntry(std::uint64_t index) const
+{
+    auto const& stored = getStoredEntry(index);
+    jt::LogHistoryEntry entry {};
+    entry.message = m_strings.get(stored.message);
+    entry.time = m_strings.get(stored.time);
+    entry.level = stored.level;
+    entry.numberOfTags = stored.numberOfTags;
+    for (auto i = 0u; i != stored.numberOfTags; ++i) {
+        entry.tags[i] = m_strings.get(stored.tags[i]);
+    }
+    return entry;
+}
+
+std::deque<std::uint64_t> const& jt::LogHistory::getIndicesWithLevel(jt::LogLevel level) const
+{
+    return m_levelIndices.at(static_cast<std::size_t>(level));
+}
+
+std::deque<std::uint64_t> const& jt::LogHistory::getIndicesWithTag(std::string_view tag) const
+{
+    auto const id = m_strings.find(tag);
+    if (!id.has_value()) {
+        return m_noIndices;
+    }
+    auto const it = m_tagIndices.find(id.value());
+    return it == m_tagIndices.end() ? m_noIndices : it->second;
+}
 
-void jt::LogHistory::clear() { m_history.clear(); }
+void jt::LogHistory::clear()
+{
+    // indices keep counting up, so views on the history notice that entries were removed. The slots
+    // of the ring buffer are kept, they are overwritten by the next entries.
+    m_firstIndex = m_endIndex;
+    m_strings.clear();
+    for (auto& indices : m_levelIndices) {
+        indices.clear();
+    }
+    m_tagIndices.clear();
+}
 
 void jt::LogHistory::doLog(jt::LogEntry const& entry)
 {
-    m_history.push_back(entry);
+    if (m_endIndex - m_firstIndex == m_capacity) {
+        removeOldestEntry();
+    }
+
+    StoredEntry stored {};
+    stored.message = m_strings.intern(entry.message);
+    stored.time = m_strings.intern(entry.time);
+    stored.level = entry.level;
+    for (auto const& tag : entry.tags) {
+        if (stored.numberOfTags == stored.tags.size()) {
+            break;
+        }
+        auto const id = m_strings.intern(tag);
+        auto const storedTagsEnd = stored.tags.cbegin() + stored.numberOfTags;
+        if (std::find(stored.tags.cbegin(), storedTagsEnd, id) != storedTagsEnd) {
+            // a tag that appears twice would list the entry twice in the tag indices
+            m_strings.release(id);
+            continue;
+        }
+        stored.tags[stored.numberOfTags++] = id;
+        m_tagIndices[id].push_back(m_endIndex);
+    }
+    m_levelIndices.at(static_cast<std::size_t>(entry.level)).push_back(m_endIndex);
 
-    if (m_history.size() > m_historyMaxSize) {
-        m_history.erase(m_history.begin(), m_history.begin() + m_historyResizeTo + 1);
+    auto const position = static_cast<std::size_t>(m_endIndex % m_capacity);
+    if (position == m_entries.size()) {
+        // the ring buffer grows until the capacity is reached
+        m_entries.push_back(stored);
+    } else {
+        m_entries[position] = stored;
+    }
+    ++m_endIndex;
+}
+
+void jt::LogHistory::removeOldestEntry()
+{
+    auto const& oldest = getStoredEntry(m_firstIndex);
+    // the oldest entry is always the first one in its indices
+    m_levelIndices.at(static_cast<std::size_t>(oldest.level)).pop_front();
+    for (auto i = 0u; i != oldest.numberOfTags; ++i) {
+        auto const it = m_tagIndices.find(oldest.tags[i]);
+        it->second.pop_front();
+        if (it->second.empty()) {
+            m_tagIndices.erase(it);
+        }
+        m_strings.release(oldest.tags[i]);
+    }
+    m_strings.release(oldest.message);
+    m_strings.release(oldest.time);
+    ++m_firstIndex;
+}
+
+jt::LogHistory::StoredEntry const& jt::LogHistory::getStoredEntry(std::uint64_t index) const
+{
+    if (index < m_firstIndex || index >= m_endIndex) {
+        throw std::out_of_range { "log history index out of range" };
     }
+    return m_entries[static_cast<std::size_t>(index % m_capacity)];
 }
@@ -3,20 +3,56 @@
 
 #include <log/log_history_interface.hpp>
 #include <log/log_target_base.hpp>
+#include <log/string_arena.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+#include <vector>
 
 namespace jt {
+
+/// Keeps the latest log entries in a ring buffer. The strings are stored in a StringArena, so
+/// repeated messages, times and tags are only stored once. Indices per level and per tag are
+/// updated with every entry, so filtered views do not need to scan the whole history.
 class LogHistory : public jt::LogHistoryInterface, public jt::LogTargetBase {
 public:
-    std::vector<jt::LogEntry> const& getHistory() override;
-    void clear() override;
+    /// Constructor
+    /// \param capacity maximum number of stored entries, older entries are removed
+    explicit LogHistory(std::size_t capacity = 100000u);
 
-    std::size_t const m_historyMaxSize { 300u };
-    std::size_t const m_historyResizeTo { 150u };
+    std::uint64_t getFirstIndex() const override;
+    std::uint64_t getEndIndex() const override;
+    jt::LogHistoryEntry getEntry(std::uint64_t index) const override;
+    std::deque<std::uint64_t> const& getIndicesWithLevel(jt::LogLevel level) const override;
+    std::deque<std::uint64_t> const& getIndicesWithTag(std::string_view tag) const override;
+    void clear() override;
 
 private:
-    std::vector<LogEntry> m_history;
+    static constexpr auto numberOfLogLevels = static_cast<std::size_t>(LogLevel::Verbose) + 1u;
+
+    struct StoredEntry {
+        std::uint32_t message { 0u };
+        std::uint32_t time { 0u };
+        LogLevel level { LogLevel::Off };
+        std::uint32_t numberOfTags { 0u };
+        std::array<std::uint32_t, LogHistoryEntry::maxNumberOfTags> tags {};
+    };
+
+    std::size_t m_capacity { 0u };
+    std::vector<StoredEntry> m_entries {};
+    std::uint64_t m_firstIndex { 0u };
+    std::uint64_t m_endIndex { 0u };
+
+    jt::StringArena m_strings {};
+    std::array<std::deque<std::uint64_t>, numberOfLogLevels> m_levelIndices {};
+    std::unordered_map<std::uint32_t, std::deque<std::uint64_t>> m_tagIndices {};
+    std::deque<std::uint64_t> const m_noIndices {};
 
     void doLog(LogEntry const& entry) override;
+    void removeOldestEntry();
+    StoredEntry const& getStoredEntry(std::uint64_t index) const;
 };
 } // namespace jt
 #endif // JAMTEMPLATE_LOG_HISTORY_HPP
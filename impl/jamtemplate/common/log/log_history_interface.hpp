@@ -1,16 +1,51 @@
 #ifndef JAMTEMPLATE_LOG_HISTORY_INTERFACE_HPP
 #define JAMTEMPLATE_LOG_HISTORY_INTERFACE_HPP
 
-#include <log/log_entry.hpp>
-#include <vector>
+#include <log/log_level.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string_view>
 
 namespace jt {
 
+/// View of one entry in the log history. The views are valid until the entry is removed from the
+/// history.
+struct LogHistoryEntry {
+    static constexpr std::size_t maxNumberOfTags { 4u };
+
+    std::string_view message {};
+    std::string_view time {};
+    LogLevel level { LogLevel::Off };
+    std::array<std::string_view, maxNumberOfTags> tags {};
+    std::size_t numberOfTags { 0u };
+};
+
 class LogHistoryInterface {
 public:
-    /// Get the history of log entries
-    /// \return the vector of LogEntries
-    virtual std::vector<jt::LogEntry> const& getHistory() = 0;
+    /// Index of the oldest stored entry. Indices keep counting up, also after entries were removed.
+    /// \return the index
+    virtual std::uint64_t getFirstIndex() const = 0;
+
+    /// Index after the newest stored entry
+    /// \return the index
+    virtual std::uint64_t getEndIndex() const = 0;
+
+    /// Get a stored entry
+    /// \param index the index, needs to be in [getFirstIndex(), getEndIndex())
+    /// \return the entry
+    virtual jt::LogHistoryEntry getEntry(std::uint64_t index) const = 0;
+
+    /// Indices of all stored entries with a log level
+    /// \param level the log level
+    /// \return the indices in ascending order
+    virtual std::deque<std::uint64_t> const& getIndicesWithLevel(jt::LogLevel level) const = 0;
+
+    /// Indices of all stored entries with a tag
+    /// \param tag the tag
+    /// \return the indices in ascending order
+    virtual std::deque<std::uint64_t> const& getIndicesWithTag(std::string_view tag) const = 0;
 
     /// Clear all log entries
     virtual void clear() = 0;
@@ -3,7 +3,26 @@
 
 namespace jt {
 
-std::vector<jt::LogEntry> const& null_objects::LogHistoryNull::getHistory() { return m_history; }
+std::uint64_t null_objects::LogHistoryNull::getFirstIndex() const { return 0u; }
+
+std::uint64_t null_objects::LogHistoryNull::getEndIndex() const { return 0u; }
+
+jt::LogHistoryEntry null_objects::LogHistoryNull::getEntry(std::uint64_t /*index*/) const
+{
+    return jt::LogHistoryEntry {};
+}
+
+std::deque<std::uint64_t> const& null_objects::LogHistoryNull::getIndicesWithLevel(
+    jt::LogLevel /*level*/) const
+{
+    return m_noIndices;
+}
+
+std::deque<std::uint64_t> const& null_objects::LogHistoryNull::getIndicesWithTag(
+    std::string_view /*tag*/) const
+{
+    return m_noIndices;
+}
 
 void null_objects::LogHistoryNull::clear() { }
 } // namespace jt
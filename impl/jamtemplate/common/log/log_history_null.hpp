@@ -8,11 +8,15 @@ namespace null_objects {
 
 class LogHistoryNull : public jt::LogHistoryInterface {
 public:
-    std::vector<jt::LogEntry> const& getHistory() override;
+    std::uint64_t getFirstIndex() const override;
+    std::uint64_t getEndIndex() const override;
+    jt::LogHistoryEntry getEntry(std::uint64_t index) const override;
+    std::deque<std::uint64_t> const& getIndicesWithLevel(jt::LogLevel level) const override;
+    std::deque<std::uint64_t> const& getIndicesWithTag(std::string_view tag) const override;
     void clear() override;
 
 private:
-    std::vector<jt::LogEntry> m_history;
+    std::deque<std::uint64_t> const m_noIndices {};
 };
 
 } // namespace null_objects
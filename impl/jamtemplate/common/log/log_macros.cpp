@@ -0,0 +1 @@
+#include "log_macros.hpp"
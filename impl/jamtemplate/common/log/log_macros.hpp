@@ -0,0 +1,49 @@
+#ifndef JAMTEMPLATE_LOG_MACROS_HPP
+#define JAMTEMPLATE_LOG_MACROS_HPP
+
+#include <log/log_level.hpp>
+#include <log/logger_interface.hpp>
+
+// Highest log level that is compiled in, set via the JT_LOG_MAX_LEVEL cmake cache variable.
+#ifndef JT_LOG_MAX_LEVEL
+#ifdef JT_ENABLE_DEBUG
+#define JT_LOG_MAX_LEVEL Verbose
+#else
+#define JT_LOG_MAX_LEVEL Info
+#endif
+#endif
+
+namespace jt {
+
+constexpr jt::LogLevel maxCompiledLogLevel { jt::LogLevel::JT_LOG_MAX_LEVEL };
+
+/// Check if log entries of a level are compiled in
+/// \param level the log level
+/// \return true if the JT_LOG_* macros keep entries of this level
+constexpr bool isLogLevelCompiledIn(jt::LogLevel level) noexcept
+{
+    return level <= maxCompiledLogLevel;
+}
+
+} // namespace jt
+
+// Log a message only if the level is compiled in and enabled in the logger. The message is not
+// evaluated otherwise, so it can be built with string concatenation without any cost for discarded
+// entries. tags are a jt::LogTags, ideally a constexpr std::array<std::string_view, N>.
+#define JT_LOG(logger, level, message, tags)                                                       \
+    do {                                                                                           \
+        if constexpr (jt::isLogLevelCompiledIn(level)) {                                           \
+            if ((logger).isLogLevelEnabled(level)) {                                               \
+                (logger).log(level, message, tags);                                                \
+            }                                                                                      \
+        }                                                                                          \
+    } while (false)
+
+#define JT_LOG_FATAL(logger, message, tags) JT_LOG(logger, jt::LogLevel::Fatal, message, tags)
+#define JT_LOG_ERROR(logger, message, tags) JT_LOG(logger, jt::LogLevel::Error, message, tags)
+#define JT_LOG_WARNING(logger, message, tags) JT_LOG(logger, jt::LogLevel::Warning, message, tags)
+#define JT_LOG_INFO(logger, message, tags) JT_LOG(logger, jt::LogLevel::Info, message, tags)
+#define JT_LOG_DEBUG(logger, message, tags) JT_LOG(logger, jt::LogLevel::Debug, message, tags)
+#define JT_LOG_VERBOSE(logger, message, tags) JT_LOG(logger, jt::LogLevel::Verbose, message, tags)
+
+#endif // JAMTEMPLATE_LOG_MACROS_HPP
@@ -0,0 +1,126 @@
+#include "log_record_queue.hpp"
+#include <math_helper.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+bool appendText(jt::LogRecord& record, char const* text, std::size_t length)
+{
+    auto const available = jt::LogRecord::textCapacity - record.textLength;
+    auto const copiedLength = std::min(length, available);
+    std::memcpy(record.text.data() + record.textLength, text, copiedLength);
+    record.textLength = static_cast<std::uint16_t>(record.textLength + copiedLength);
+    return copiedLength == length;
+}
+
+template <typename TagContainer>
+jt::LogRecord createRecord(std::string_view message, jt::LogLevel level, TagContainer const& tags)
+{
+    jt::LogRecord record {};
+    record.time = std::chrono::system_clock::now().time_since_epoch().count();
+    record.level = level;
+    record.isTruncated = !appendText(record, message.data(), message.size());
+    record.messageLength = record.textLength;
+
+    for (auto const& tag : tags) {
+        // tags are short, a tag that does not fit completely is skipped
+        auto const tagLength = std::min<std::size_t>(tag.size(), 255u);
+        if (record.numberOfTags == 255u
+            || record.textLength + 1u + tagLength > jt::LogRecord::textCapacity) {
+            record.isTruncated = true;
+            break;
+        }
+        auto const lengthByte = static_cast<char>(static_cast<std::uint8_t>(tagLength));
+        appendText(record, &lengthByte, 1u);
+        appendText(record, tag.data(), tagLength);
+        ++record.numberOfTags;
+    }
+    return record;
+}
+
+} // namespace
+
+jt::LogRecord jt::createLogRecord(
+    std::string const& message, LogLevel level, std::vector<std::string> const& tags)
+{
+    return createRecord(message, level, tags);
+}
+
+jt::LogRecord jt::createLogRecord(std::string_view message, LogLevel level, jt::LogTags tags)
+{
+    return createRecord(message, level, tags);
+}
+
+jt::LogRecordQueue::LogRecordQueue(std::size_t capacity)
+    : m_capacity { capacity }
+    , m_mask { capacity - 1u }
+{
+    if (capacity == 0u || !jt::MathHelper::isPowerOfTwo(capacity)) {
+        throw std::invalid_argument { "log record queue capacity needs to be a power of two" };
+    }
+    m_cells = std::make_unique<Cell[]>(capacity);
+    for (std::size_t i = 0u; i != capacity; ++i) {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool jt::LogRecordQueue::tryPush(jt::LogRecord const& record) noexcept
+{
+    auto position = m_pushPosition.load(std::memory_order_relaxed);
+    while (true) {
+        auto& cell = m_cells[position & m_mask];
+        auto const sequence = cell.sequence.load(std::memory_order_acquire);
+        auto const difference
+            = static_cast<std::int64_t>(sequence) - static_cast<std::int64_t>(position);
+        if (difference == 0) {
+            // the cell is free, try to claim it
+            if (m_pushPosition.compare_exchange_weak(
+                    position, position + 1u, std::memory_order_relaxed)) {
+                cell.record = record;
+                cell.sequence.store(position + 1u, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            // the consumer did not free this cell yet, the queue is full
+            return false;
+        } else {
+            // another producer claimed the cell
+            position = m_pushPosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool jt::LogRecordQueue::tryPop(jt::LogRecord& record) noexcept
+{
+    auto const position = m_popPosition.load(std::memory_order_relaxed);
+    auto& cell = m_cells[position & m_mask];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1u) {
+        return false;
+    }
+    record = cell.record;
+    cell.sequence.store(position + m_capacity, std::memory_order_release);
+    m_popPosition.store(position + 1u, std::memory_order_release);
+    return true;
+}
+
+std::uint64_t jt::LogRecordQueue::getNumberOfPushedRecords() const noexcept
+{
+    return m_pushPosition.load(std::memory_order_acquire);
+}
+
+std::uint64_t jt::LogRecordQueue::getNumberOfPoppedRecords() const noexcept
+{
+    return m_popPosition.load(std::memory_order_acquire);
+}
+
+std::size_t jt::LogRecordQueue::size() const noexcept
+{
+    auto const popped = getNumberOfPoppedRecords();
+    auto const pushed = getNumberOfPushedRecords();
+    return static_cast<std::size_t>(pushed > popped ? pushed - popped : 0u);
+}
+
+std::size_t jt::LogRecordQueue::capacity() const noexcept { return m_capacity; }
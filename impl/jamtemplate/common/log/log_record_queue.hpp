@@ -0,0 +1,98 @@
+#ifndef JAMTEMPLATE_LOG_RECORD_QUEUE_HPP
+#define JAMTEMPLATE_LOG_RECORD_QUEUE_HPP
+
+#include <log/log_level.hpp>
+#include <log/logger_interface.hpp>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace jt {
+
+/// Fixed size log entry that can be passed between threads without allocations. Message and tags
+/// are stored in one character buffer and cut off if they do not fit.
+struct LogRecord {
+    static constexpr std::size_t textCapacity { 232u };
+
+    /// system_clock time since epoch
+    std::int64_t time { 0 };
+    LogLevel level { LogLevel::Off };
+    bool isTruncated { false };
+    std::uint8_t numberOfTags { 0u };
+    std::uint16_t messageLength { 0u };
+    std::uint16_t textLength { 0u };
+    /// the message, followed by the tags, each prefixed with its length
+    std::array<char, textCapacity> text {};
+};
+
+/// Create a log record with the current time
+/// \param message the log message
+/// \param level the log level
+/// \param tags the message tags
+/// \return the log record
+jt::LogRecord createLogRecord(
+    std::string const& message, LogLevel level, std::vector<std::string> const& tags);
+
+/// Create a log record with the current time
+/// \param message the log message
+/// \param level the log level
+/// \param tags the message tags
+/// \return the log record
+jt::LogRecord createLogRecord(std::string_view message, LogLevel level, jt::LogTags tags);
+
+/// Bounded lock-free queue for multiple producers and a single consumer. Every cell carries a
+/// sequence number that tells producers and the consumer whose turn it is, so no locks are
+/// needed. Producers never wait, a record is rejected if the queue is full.
+class LogRecordQueue {
+public:
+    /// Constructor
+    /// \param capacity number of records, needs to be a power of two
+    explicit LogRecordQueue(std::size_t capacity);
+
+    /// Add a record, can be called from any thread
+    /// \param record the record to be added
+    /// \return false if the queue was full and the record was dropped
+    bool tryPush(jt::LogRecord const& record) noexcept;
+
+    /// Remove the oldest record, must only be called from a single consumer thread
+    /// \param record the record to be overwritten
+    /// \return false if no record is available
+    bool tryPop(jt::LogRecord& record) noexcept;
+
+    /// Number of records that were successfully pushed since construction
+    /// \return the number of pushed records
+    std::uint64_t getNumberOfPushedRecords() const noexcept;
+
+    /// Number of records that were popped since construction
+    /// \return the number of popped records
+    std::uint64_t getNumberOfPoppedRecords() const noexcept;
+
+    /// Number of records currently in the queue. Only an estimate while producers are active.
+    /// \return the number of records
+    std::size_t size() const noexcept;
+
+    std::size_t capacity() const noexcept;
+
+private:
+    struct Cell {
+        std::atomic<std::uint64_t> sequence { 0u };
+        jt::LogRecord record {};
+    };
+
+    std::size_t m_capacity { 0u };
+    std::size_t m_mask { 0u };
+    std::unique_ptr<Cell[]> m_cells { nullptr };
+
+    // producers and the consumer write to different cache lines
+    alignas(64) std::atomic<std::uint64_t> m_pushPosition { 0u };
+    alignas(64) std::atomic<std::uint64_t> m_popPosition { 0u };
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_LOG_RECORD_QUEUE_HPP
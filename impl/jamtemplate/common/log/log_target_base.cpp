@@ -10,6 +10,10 @@ void LogTargetBase::log(LogEntry const& entry)
     doLog(entry);
 }
 
+void LogTargetBase::flush() { doFlush(); }
+
+void LogTargetBase::doFlush() { }
+
 void LogTargetBase::setLogLevel(LogLevel level) { m_logLevel = level; }
 
 LogLevel LogTargetBase::getLogLevel() const { return m_logLevel; }
@@ -10,12 +10,14 @@ public:
     virtual ~LogTargetBase() = default;
 
     void log(LogEntry const& entry) override;
+    void flush() override;
 
     void setLogLevel(LogLevel level) override;
     LogLevel getLogLevel() const;
 
 private:
     virtual void doLog(LogEntry const& entry) = 0;
+    virtual void doFlush();
 
     LogLevel m_logLevel { LogLevel::Verbose };
 };
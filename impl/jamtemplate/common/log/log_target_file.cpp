@@ -8,5 +8,7 @@ jt::LogTargetFile::LogTargetFile()
 
 void jt::LogTargetFile::doLog(jt::LogEntry const& entry)
 {
-    m_file << entry.time << ": " << entry.message << std::endl;
+    m_file << entry.time << ": " << entry.message << '\n';
 }
+
+void jt::LogTargetFile::doFlush() { m_file.flush(); }
@@ -14,6 +14,7 @@ public:
 
 private:
     void doLog(LogEntry const& entry) override;
+    void doFlush() override;
 
 private:
     std::ofstream m_file;
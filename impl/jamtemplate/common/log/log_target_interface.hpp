@@ -13,6 +13,9 @@ public:
     /// \param entry the entry to be logged
     virtual void log(LogEntry const& entry) = 0;
 
+    /// Write buffered entries, if the target buffers them
+    virtual void flush() = 0;
+
     /// Set the log level of this LogTarget
     /// \param level the loglevel
     virtual void setLogLevel(LogLevel level) = 0;
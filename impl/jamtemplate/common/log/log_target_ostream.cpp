@@ -9,5 +9,7 @@ jt::LogTargetOstream::LogTargetOstream(std::ostream& stream)
 
 void jt::LogTargetOstream::doLog(jt::LogEntry const& entry)
 {
-    m_stream << entry.message << std::endl;
+    m_stream << entry.message << '\n';
 }
+
+void jt::LogTargetOstream::doFlush() { m_stream.flush(); }
@@ -15,6 +15,7 @@ public:
 
 private:
     void doLog(LogEntry const& entry) override;
+    void doFlush() override;
 
 private:
     std::ostream& m_stream;
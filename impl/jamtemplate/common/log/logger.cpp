@@ -62,6 +62,17 @@ void jt::Logger::verbose(
 #endif
 }
 
+bool jt::Logger::isLogLevelEnabled(LogLevel level) const noexcept { return m_logLevel >= level; }
+
+void jt::Logger::log(LogLevel level, std::string_view message, LogTags tags)
+{
+    if (!isLogLevelEnabled(level)) {
+        return;
+    }
+    addLogEntry(LogEntry { std::string { message }, "", level,
+        std::vector<std::string> { tags.begin(), tags.end() } });
+}
+
 void jt::Logger::addLogTarget(std::shared_ptr<jt::LogTargetInterface> target)
 {
     if (target == nullptr) {
@@ -79,7 +90,10 @@ void jt::Logger::addLogEntry(jt::LogEntry entry)
     entry.time = ss.str();
     for (auto& t : m_logTargets) {
         t->log(entry);
+        t->flush();
     }
 }
 
 void jt::Logger::setLogLevel(LogLevel level) { m_logLevel = level; }
+
+void jt::Logger::update() { }
@@ -9,6 +9,8 @@ namespace jt {
 class LogHistoryInterface;
 class LogTargetInterface;
 
+/// Logger that passes entries to its targets directly on the logging thread. Not thread safe, use
+/// AsyncLogger if entries are logged from worker threads.
 class Logger : public jt::LoggerInterface {
 public:
     void action(
@@ -20,8 +22,12 @@ public:
     void debug(std::string const& string, std::vector<std::string> const& tags = {}) override;
     void verbose(std::string const& string, std::vector<std::string> const& tags = {}) override;
 
+    bool isLogLevelEnabled(LogLevel level) const noexcept override;
+    void log(LogLevel level, std::string_view message, LogTags tags) override;
+
     void addLogTarget(std::shared_ptr<LogTargetInterface> target) override;
     void setLogLevel(LogLevel level) override;
+    void update() override;
 
 private:
     std::vector<std::shared_ptr<jt::LogTargetInterface>> m_logTargets;
@@ -3,13 +3,18 @@
 
 #include <log/log_level.hpp>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace jt {
 
 class LogTargetInterface;
 
+/// Tags of a log entry. Usually refers to a constexpr std::array, so no allocation is needed.
+using LogTags = std::span<std::string_view const>;
+
 class LoggerInterface {
 public:
     /// Log a fatal message
@@ -55,6 +60,19 @@ public:
         std::string const& string)
         = 0;
 
+    /// Check if entries of a level are logged. Used by the JT_LOG_* macros to skip creating the
+    /// message of discarded entries.
+    /// \param level the log level
+    /// \return true if entries of this level are logged
+    virtual bool isLogLevelEnabled(jt::LogLevel level) const noexcept = 0;
+
+    /// Log a message. Prefer the JT_LOG_* macros, which only evaluate the message if the level is
+    /// enabled.
+    /// \param level the log level
+    /// \param message the log message
+    /// \param tags the message tags
+    virtual void log(jt::LogLevel level, std::string_view message, jt::LogTags tags) = 0;
+
     /// Add a log target to the logger
     /// \param target the target to be added
     virtual void addLogTarget(std::shared_ptr<LogTargetInterface> target) = 0;
@@ -62,6 +80,10 @@ public:
     /// Set the overall log level
     virtual void setLogLevel(jt::LogLevel level) = 0;
 
+    /// Pass pending entries to targets that are only accessed from the main thread. Called once
+    /// per frame by the game from the main thread.
+    virtual void update() = 0;
+
     /// Destructor
     virtual ~LoggerInterface() = default;
 
@@ -36,6 +36,18 @@ void jt::null_objects::LoggerNull::verbose(std::string const& /*string*/,
 {
 }
 
+bool jt::null_objects::LoggerNull::isLogLevelEnabled(LogLevel /*level*/) const noexcept
+{
+    return false;
+}
+
+void jt::null_objects::LoggerNull::log(
+    LogLevel /*level*/, std::string_view /*message*/, LogTags /*tags*/)
+{
+}
+
 void jt::null_objects::LoggerNull::addLogTarget(std::shared_ptr<LogTargetInterface> /*target*/) { }
 
 void jt::null_objects::LoggerNull::setLogLevel(LogLevel /*level*/) { }
+
+void jt::null_objects::LoggerNull::update() { }
@@ -19,8 +19,12 @@ public:
     void info(std::string const& string, std::vector<std::string> const& tags = {}) override;
     void debug(std::string const& string, std::vector<std::string> const& tags = {}) override;
     void verbose(std::string const& string, std::vector<std::string> const& tags = {}) override;
+    bool isLogLevelEnabled(LogLevel level) const noexcept override;
+    void log(LogLevel level, std::string_view message, LogTags tags) override;
+
     void addLogTarget(std::shared_ptr<LogTargetInterface> target) override;
     void setLogLevel(LogLevel level) override;
+    void update() override;
 };
 } // namespace null_objects
 } // namespace jt
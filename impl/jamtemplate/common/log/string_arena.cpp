@@ -0,0 +1,60 @@
+#include "string_arena.hpp"
+#include <stdexcept>
+
+std::uint32_t jt::StringArena::intern(std::string_view str)
+{
+    auto const it = m_ids.find(str);
+    if (it != m_ids.end()) {
+        ++m_referenceCounts[it->second];
+        return it->second;
+    }
+
+    std::uint32_t id { 0u };
+    if (m_freeIds.empty()) {
+        id = static_cast<std::uint32_t>(m_strings.size());
+        m_strings.emplace_back(str);
+        m_referenceCounts.push_back(1u);
+    } else {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+        m_strings[id].assign(str);
+        m_referenceCounts[id] = 1u;
+    }
+    m_ids.emplace(m_strings[id], id);
+    return id;
+}
+
+void jt::StringArena::release(std::uint32_t id)
+{
+    if (id >= m_referenceCounts.size() || m_referenceCounts[id] == 0u) {
+        throw std::invalid_argument { "cannot release unknown string id" };
+    }
+    if (--m_referenceCounts[id] != 0u) {
+        return;
+    }
+    m_ids.erase(m_strings[id]);
+    // release the memory of long strings, short ones stay in the small buffer anyway
+    std::string {}.swap(m_strings[id]);
+    m_freeIds.push_back(id);
+}
+
+std::string_view jt::StringArena::get(std::uint32_t id) const { return m_strings.at(id); }
+
+std::optional<std::uint32_t> jt::StringArena::find(std::string_view str) const
+{
+    auto const it = m_ids.find(str);
+    if (it == m_ids.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+std::size_t jt::StringArena::size() const noexcept { return m_ids.size(); }
+
+void jt::StringArena::clear()
+{
+    m_ids.clear();
+    m_strings.clear();
+    m_referenceCounts.clear();
+    m_freeIds.clear();
+}
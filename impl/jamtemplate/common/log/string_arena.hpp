@@ -0,0 +1,54 @@
+#ifndef JAMTEMPLATE_STRING_ARENA_HPP
+#define JAMTEMPLATE_STRING_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace jt {
+
+/// Stores each distinct string once and hands out small ids for it. Strings are reference counted
+/// and their slot is reused once the last reference is released.
+class StringArena {
+public:
+    /// Add a reference to a string, storing it if it is not yet known
+    /// \param str the string
+    /// \return the id of the string
+    std::uint32_t intern(std::string_view str);
+
+    /// Remove a reference to a string. The string is removed with the last reference.
+    /// \param id the id returned by intern
+    void release(std::uint32_t id);
+
+    /// Get a stored string
+    /// \param id the id returned by intern
+    /// \return view of the string, valid until the last reference is released
+    std::string_view get(std::uint32_t id) const;
+
+    /// Find the id of a stored string without adding a reference
+    /// \param str the string
+    /// \return the id, or nullopt if the string is not stored
+    std::optional<std::uint32_t> find(std::string_view str) const;
+
+    /// Number of distinct strings stored
+    /// \return the number of strings
+    std::size_t size() const noexcept;
+
+    void clear();
+
+private:
+    // deque does not move its elements when growing, so the map keys stay valid
+    std::deque<std::string> m_strings {};
+    std::vector<std::uint32_t> m_referenceCounts {};
+    std::vector<std::uint32_t> m_freeIds {};
+    std::unordered_map<std::string_view, std::uint32_t> m_ids {};
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_STRING_ARENA_HPP
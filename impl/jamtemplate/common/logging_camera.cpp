@@ -1,4 +1,13 @@
 #include "logging_camera.hpp"
+#include <log/log_macros.hpp>
+#include <array>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 2> cameraTags { "jt", "camera" };
+
+} // namespace
 
 jt::LoggingCamera::LoggingCamera(jt::CamInterface& decoratee, jt::LoggerInterface& logger)
     : m_decoratee { decoratee }
@@ -10,25 +19,25 @@ jt::LoggingCamera::LoggingCamera(jt::CamInterface& decoratee, jt::LoggerInterfac
 
 jt::Vector2f jt::LoggingCamera::getCamOffset()
 {
-    m_logger.verbose("getCamOffset", { "jt", "camera" });
+    JT_LOG_VERBOSE(m_logger, "getCamOffset", cameraTags);
     return m_decoratee.getCamOffset();
 }
 
 void jt::LoggingCamera::setCamOffset(jt::Vector2f const& newOffset)
 {
-    m_logger.verbose("setCamOffset", { "jt", "camera" });
+    JT_LOG_VERBOSE(m_logger, "setCamOffset", cameraTags);
     m_decoratee.setCamOffset(newOffset);
 }
 
 void jt::LoggingCamera::move(jt::Vector2f const& v)
 {
-    m_logger.verbose("move", { "jt", "camera" });
+    JT_LOG_VERBOSE(m_logger, "move", cameraTags);
     m_decoratee.move(v);
 }
 
 float jt::LoggingCamera::getZoom() const
 {
-    m_logger.verbose("getZoom", { "jt", "camera" });
+    JT_LOG_VERBOSE(m_logger, "getZoom", cameraTags);
     return m_decoratee.getZoom();
 }
 
@@ -41,24 +50,24 @@ void jt::LoggingCamera::setZoom(float zoom)
 void jt::LoggingCamera::shake(
     float shakeDurationInSeconds, float maxShakeOffsetInPixel, float shakeIntervalInSeconds)
 {
-    m_logger.debug("shake", { "jt", "camera" });
+    JT_LOG_DEBUG(m_logger, "shake", cameraTags);
     m_decoratee.shake(shakeDurationInSeconds, maxShakeOffsetInPixel, shakeIntervalInSeconds);
 }
 
 jt::Vector2f jt::LoggingCamera::getShakeOffset() const
 {
-    m_logger.verbose("getShakeOffset", { "jt", "camera" });
+    JT_LOG_VERBOSE(m_logger, "getShakeOffset", cameraTags);
     return m_decoratee.getShakeOffset();
 }
 
 void jt::LoggingCamera::update(float elapsed)
 {
-    m_logger.verbose("update", { "jt", "camera" });
+    JT_LOG_VERBOSE(m_logger, "update", cameraTags);
     m_decoratee.update(elapsed);
 }
 
 void jt::LoggingCamera::reset()
 {
-    m_logger.debug("reset", { "jt", "camera" });
+    JT_LOG_DEBUG(m_logger, "reset", cameraTags);
     m_decoratee.reset();
 }
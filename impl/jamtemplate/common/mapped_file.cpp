@@ -0,0 +1,115 @@
+#include "mapped_file.hpp"
+#include <stdexcept>
+
+#if defined(JT_ENABLE_WEB)
+#include <fstream>
+#include <iterator>
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(JT_ENABLE_WEB)
+
+jt::MappedFile::MappedFile(std::string const& fileName)
+{
+    std::ifstream file { fileName, std::ios::binary | std::ios::ate };
+    if (!file) {
+        throw std::invalid_argument { "cannot open file '" + fileName + "'" };
+    }
+    m_buffer.resize(static_cast<std::size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(
+        reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_buffer.size()));
+    m_data = m_buffer.data();
+    m_size = m_buffer.size();
+}
+
+jt::MappedFile::~MappedFile() = default;
+
+#elif defined(_WIN32)
+
+jt::MappedFile::MappedFile(std::string const& fileName)
+{
+    auto const file = CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::invalid_argument { "cannot open file '" + fileName + "'" };
+    }
+    m_fileHandle = file;
+
+    LARGE_INTEGER size {};
+    GetFileSizeEx(file, &size);
+    m_size = static_cast<std::size_t>(size.QuadPart);
+    if (m_size == 0u) {
+        return;
+    }
+
+    m_mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mappingHandle == nullptr) {
+        CloseHandle(file);
+        throw std::invalid_argument { "cannot map file '" + fileName + "'" };
+    }
+    m_data = static_cast<std::byte const*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    if (m_data == nullptr) {
+        CloseHandle(m_mappingHandle);
+        CloseHandle(file);
+        throw std::invalid_argument { "cannot map file '" + fileName + "'" };
+    }
+}
+
+jt::MappedFile::~MappedFile()
+{
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+    if (m_mappingHandle != nullptr) {
+        CloseHandle(m_mappingHandle);
+    }
+    CloseHandle(m_fileHandle);
+}
+
+#else
+
+jt::MappedFile::MappedFile(std::string const& fileName)
+{
+    m_fileDescriptor = open(fileName.c_str(), O_RDONLY);
+    if (m_fileDescriptor == -1) {
+        throw std::invalid_argument { "cannot open file '" + fileName + "'" };
+    }
+
+    struct stat fileInfo { };
+    if (fstat(m_fileDescriptor, &fileInfo) != 0) {
+        close(m_fileDescriptor);
+        throw std::invalid_argument { "cannot read size of file '" + fileName + "'" };
+    }
+    m_size = static_cast<std::size_t>(fileInfo.st_size);
+    if (m_size == 0u) {
+        return;
+    }
+
+    auto const mapped = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+    if (mapped == MAP_FAILED) {
+        close(m_fileDescriptor);
+        throw std::invalid_argument { "cannot map file '" + fileName + "'" };
+    }
+    m_data = static_cast<std::byte const*>(mapped);
+}
+
+jt::MappedFile::~MappedFile()
+{
+    if (m_data != nullptr) {
+        munmap(const_cast<std::byte*>(m_data), m_size);
+    }
+    close(m_fileDescriptor);
+}
+
+#endif
+
+std::byte const* jt::MappedFile::data() const noexcept { return m_data; }
+
+std::size_t jt::MappedFile::size() const noexcept { return m_size; }
@@ -0,0 +1,44 @@
+#ifndef JAMTEMPLATE_MAPPED_FILE_HPP
+#define JAMTEMPLATE_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace jt {
+
+/// Read only memory mapping of a whole file. On platforms without memory mapping (web build), the
+/// file is read into memory instead.
+class MappedFile {
+public:
+    /// Constructor, throws std::invalid_argument if the file cannot be opened or mapped
+    /// \param fileName the file to map
+    explicit MappedFile(std::string const& fileName);
+    ~MappedFile();
+
+    // no copy, no move. Data pointers handed out must stay valid.
+    MappedFile(MappedFile const&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+    std::byte const* data() const noexcept;
+    std::size_t size() const noexcept;
+
+private:
+    std::byte const* m_data { nullptr };
+    std::size_t m_size { 0u };
+
+#if defined(JT_ENABLE_WEB)
+    std::vector<std::byte> m_buffer {};
+#elif defined(_WIN32)
+    void* m_fileHandle { nullptr };
+    void* m_mappingHandle { nullptr };
+#else
+    int m_fileDescriptor { -1 };
+#endif
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_MAPPED_FILE_HPP
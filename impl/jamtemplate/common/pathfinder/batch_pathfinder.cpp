@@ -0,0 +1,75 @@
+#include "batch_pathfinder.hpp"
+#include <pathfinder/grid_pathfinder.hpp>
+#include <trace_profiler.hpp>
+#include <exception>
+#include <utility>
+
+namespace {
+
+jt::pathfinder::GridPathfinder& getThreadLocalPathfinder()
+{
+    thread_local jt::pathfinder::GridPathfinder pathfinder {};
+    return pathfinder;
+}
+
+std::vector<jt::pathfinder::PathResult> processQueries(jt::JobSystemInterface& jobSystem,
+    jt::pathfinder::NavigationGrid const& grid,
+    std::vector<jt::pathfinder::PathQuery> const& queries)
+{
+    JT_PROFILE_ZONE("jt::pathfinder::BatchPathfinder::processQueries");
+    std::vector<jt::pathfinder::PathResult> results(queries.size());
+    // query costs differ a lot, so hand out single queries to balance the workers
+    jobSystem.parallelFor(
+        queries.size(),
+        [&grid, &queries, &results](std::size_t begin, std::size_t end) {
+            auto& pathfinder = getThreadLocalPathfinder();
+            for (auto i = begin; i != end; ++i) {
+                results[i] = pathfinder.calculatePath(grid, queries[i].start, queries[i].end);
+            }
+        },
+        1u);
+    return results;
+}
+
+} // namespace
+
+jt::pathfinder::BatchPathfinder::BatchPathfinder(jt::JobSystemInterface& jobSystem)
+    : m_jobSystem { jobSystem }
+{
+}
+
+std::vector<jt::pathfinder::PathResult> jt::pathfinder::BatchPathfinder::calculatePaths(
+    std::shared_ptr<NavigationGrid const> grid, std::vector<PathQuery> queries)
+{
+    JT_PROFILE_ZONE("jt::pathfinder::BatchPathfinder::calculatePaths");
+    if (queries.empty()) {
+        return std::vector<PathResult> {};
+    }
+    return processQueries(m_jobSystem, *grid, queries);
+}
+
+std::future<std::vector<jt::pathfinder::PathResult>>
+jt::pathfinder::BatchPathfinder::calculatePathsAsync(
+    std::shared_ptr<NavigationGrid const> grid, std::vector<PathQuery> queries)
+{
+    auto promise = std::make_shared<std::promise<std::vector<PathResult>>>();
+    auto future = promise->get_future();
+    if (queries.empty()) {
+        promise->set_value(std::vector<PathResult> {});
+        return future;
+    }
+    m_jobSystem.schedule([&jobSystem = m_jobSystem, promise, grid = std::move(grid),
+                             queries = std::move(queries)]() {
+        try {
+            promise->set_value(processQueries(jobSystem, *grid, queries));
+        } catch (...) {
+            promise->set_exception(std::current_exception());
+        }
+    });
+    return future;
+}
+
+std::size_t jt::pathfinder::BatchPathfinder::getNumberOfWorkers() const noexcept
+{
+    return m_jobSystem.getNumberOfWorkers();
+}
@@ -0,0 +1,62 @@
+#ifndef JAMTEMPLATE_BATCH_PATHFINDER_HPP
+#define JAMTEMPLATE_BATCH_PATHFINDER_HPP
+
+#include <jobs/job_system_interface.hpp>
+#include <pathfinder/navigation_grid.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <vector>
+
+namespace jt {
+namespace pathfinder {
+
+struct PathQuery {
+    jt::Vector2u start { 0u, 0u };
+    jt::Vector2u end { 0u, 0u };
+};
+
+/// Path result for one PathQuery: tile positions from start to end, empty if start == end or no
+/// path exists.
+using PathResult = std::vector<jt::Vector2u>;
+
+/// Calculates many paths on one navigation grid in parallel.
+///
+/// The grid is shared as const and never modified during a batch, so queries do not touch any
+/// shared node state and no reset is needed between batches. Every thread keeps its own
+/// GridPathfinder scratch memory in thread local storage. The queries are spread over the workers
+/// of the game's job system. Without worker threads (e.g. the web build), batches are calculated
+/// on the calling thread.
+class BatchPathfinder {
+public:
+    /// Constructor
+    /// \param jobSystem the job system to run queries on, e.g. GameInterface::jobSystem(). Needs
+    ///        to outlive the batch pathfinder and all batches started with it.
+    explicit BatchPathfinder(jt::JobSystemInterface& jobSystem);
+
+    /// Calculate paths for all queries. The calling thread takes part and blocks until all
+    /// queries are done.
+    /// \param grid the navigation grid
+    /// \param queries the queries
+    /// \return one result per query, in the order of queries
+    std::vector<PathResult> calculatePaths(
+        std::shared_ptr<NavigationGrid const> grid, std::vector<PathQuery> queries);
+
+    /// Calculate paths for all queries in one job without blocking the calling thread.
+    /// \param grid the navigation grid, kept alive until the batch is done
+    /// \param queries the queries
+    /// \return future that becomes ready once all queries are done
+    std::future<std::vector<PathResult>> calculatePathsAsync(
+        std::shared_ptr<NavigationGrid const> grid, std::vector<PathQuery> queries);
+
+    std::size_t getNumberOfWorkers() const noexcept;
+
+private:
+    jt::JobSystemInterface& m_jobSystem;
+};
+
+} // namespace pathfinder
+} // namespace jt
+
+#endif // JAMTEMPLATE_BATCH_PATHFINDER_HPP
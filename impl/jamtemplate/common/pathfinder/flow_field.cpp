@@ -0,0 +1,163 @@
+#include "flow_field.hpp"
+#include <pathfinder/indexed_binary_heap.hpp>
+#include <trace_profiler.hpp>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+jt::pathfinder::FlowField::FlowField(NavigationGrid const& grid, jt::Vector2u const& goal)
+    : m_width { grid.getWidth() }
+    , m_height { grid.getHeight() }
+    , m_goal { goal }
+    , m_gridVersion { grid.getVersion() }
+{
+    JT_PROFILE_ZONE("jt::pathfinder::FlowField::FlowField");
+    calculateCosts(grid);
+    calculateDirections(grid);
+}
+
+void jt::pathfinder::FlowField::calculateCosts(NavigationGrid const& grid)
+{
+    m_costs.assign(grid.getNumberOfNodes(), unreachable);
+    auto const goalId = grid.toNodeId(m_goal);
+    if (goalId == NavigationGrid::invalidNode || grid.isBlocked(goalId)) {
+        return;
+    }
+
+    IndexedBinaryHeap open {};
+    open.reserve(grid.getNumberOfNodes());
+    m_costs[goalId] = 0u;
+    open.pushOrUpdate(goalId, 0.0f);
+    while (!open.empty()) {
+        auto const current = open.pop();
+        auto const currentCost = m_costs[current];
+        grid.forEachNeighbour(current, [&](NavigationGrid::NodeId neighbour, float stepCost) {
+            auto const newCost
+                = currentCost + (stepCost > 1.0f ? diagonalStepCost : straightStepCost);
+            if (newCost >= m_costs[neighbour]) {
+                return;
+            }
+            m_costs[neighbour] = newCost;
+            open.pushOrUpdate(neighbour, static_cast<float>(newCost));
+        });
+    }
+}
+
+void jt::pathfinder::FlowField::calculateDirections(NavigationGrid const& grid)
+{
+    m_directions.assign(m_costs.size(), noDirection);
+    for (auto id = NavigationGrid::NodeId { 0u }; id != m_costs.size(); ++id) {
+        auto bestCost = m_costs[id];
+        if (bestCost == unreachable || bestCost == 0u) {
+            continue;
+        }
+        auto const x = static_cast<int>(id % m_width);
+        auto const y = static_cast<int>(id / m_width);
+        for (auto i = 0u; i != NavigationGrid::neighbourOffsets.size(); ++i) {
+            auto const nx = x + NavigationGrid::neighbourOffsets[i][0];
+            auto const ny = y + NavigationGrid::neighbourOffsets[i][1];
+            if (nx < 0 || ny < 0 || nx >= static_cast<int>(m_width)
+                || ny >= static_cast<int>(m_height)) {
+                continue;
+            }
+            auto const neighbour = static_cast<NavigationGrid::NodeId>(nx + ny * m_width);
+            if (grid.isBlocked(neighbour)) {
+                continue;
+            }
+            if (m_costs[neighbour] < bestCost) {
+                bestCost = m_costs[neighbour];
+                m_directions[id] = static_cast<std::int8_t>(i);
+            }
+        }
+    }
+}
+
+jt::Vector2u const& jt::pathfinder::FlowField::getGoal() const noexcept { return m_goal; }
+
+std::uint64_t jt::pathfinder::FlowField::getGridVersion() const noexcept
+{
+    return m_gridVersion;
+}
+
+bool jt::pathfinder::FlowField::isReachable(jt::Vector2u const& pos) const noexcept
+{
+    return getCost(pos) != unreachable;
+}
+
+std::uint32_t jt::pathfinder::FlowField::getCost(jt::Vector2u const& pos) const noexcept
+{
+    if (pos.x >= m_width || pos.y >= m_height) {
+        return unreachable;
+    }
+    return m_costs[pos.x + pos.y * m_width];
+}
+
+std::int8_t jt::pathfinder::FlowField::getDirectionIndex(jt::Vector2u const& pos) const noexcept
+{
+    if (pos.x >= m_width || pos.y >= m_height) {
+        return noDirection;
+    }
+    return m_directions[pos.x + pos.y * m_width];
+}
+
+jt::Vector2f jt::pathfinder::FlowField::getDirection(jt::Vector2u const& pos) const noexcept
+{
+    auto const index = getDirectionIndex(pos);
+    if (index == noDirection) {
+        return jt::Vector2f { 0.0f, 0.0f };
+    }
+    auto const& offset = NavigationGrid::neighbourOffsets[static_cast<std::size_t>(index)];
+    auto const length = (offset[0] != 0 && offset[1] != 0) ? 1.41421356f : 1.0f;
+    return jt::Vector2f { static_cast<float>(offset[0]) / length,
+        static_cast<float>(offset[1]) / length };
+}
+
+jt::Vector2u jt::pathfinder::FlowField::getNextTile(jt::Vector2u const& pos) const noexcept
+{
+    auto const index = getDirectionIndex(pos);
+    if (index == noDirection) {
+        return pos;
+    }
+    auto const& offset = NavigationGrid::neighbourOffsets[static_cast<std::size_t>(index)];
+    return jt::Vector2u { static_cast<unsigned int>(static_cast<int>(pos.x) + offset[0]),
+        static_cast<unsigned int>(static_cast<int>(pos.y) + offset[1]) };
+}
+
+jt::pathfinder::FlowFieldCache::FlowFieldCache(
+    std::shared_ptr<NavigationGrid const> grid, std::size_t maxNumberOfFields)
+    : m_grid { std::move(grid) }
+    , m_maxNumberOfFields { std::max(maxNumberOfFields, std::size_t { 1u }) }
+{
+    if (!m_grid) {
+        throw std::invalid_argument { "FlowFieldCache requires a navigation grid" };
+    }
+}
+
+std::shared_ptr<jt::pathfinder::FlowField const> jt::pathfinder::FlowFieldCache::getFlowField(
+    jt::Vector2u const& goal)
+{
+    if (!m_fields.empty() && m_fields.front()->getGridVersion() != m_grid->getVersion()) {
+        // all fields are calculated for the same grid version
+        m_fields.clear();
+    }
+
+    auto const it = std::find_if(m_fields.begin(), m_fields.end(), [&goal](auto const& f) {
+        return f->getGoal().x == goal.x && f->getGoal().y == goal.y;
+    });
+    if (it != m_fields.end()) {
+        auto field = *it;
+        m_fields.erase(it);
+        m_fields.push_back(field);
+        return field;
+    }
+
+    if (m_fields.size() == m_maxNumberOfFields) {
+        m_fields.erase(m_fields.begin());
+    }
+    m_fields.push_back(std::make_shared<FlowField const>(*m_grid, goal));
+    return m_fields.back();
+}
+
+void jt::pathfinder::FlowFieldCache::clear() noexcept { m_fields.clear(); }
+
+std::size_t jt::pathfinder::FlowFieldCache::size() const noexcept { return m_fields.size(); }
@@ -0,0 +1,101 @@
+#ifndef JAMTEMPLATE_FLOW_FIELD_HPP
+#define JAMTEMPLATE_FLOW_FIELD_HPP
+
+#include <pathfinder/navigation_grid.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace jt {
+namespace pathfinder {
+
+/// Dijkstra map towards a single goal. Every tile stores its integer cost to the goal and the
+/// direction of the next step, so any number of agents can follow the field with O(1) lookups.
+class FlowField {
+public:
+    /// cost of a straight step, diagonal steps cost diagonalStepCost
+    static constexpr std::uint32_t straightStepCost { 10u };
+    static constexpr std::uint32_t diagonalStepCost { 14u };
+    static constexpr std::uint32_t unreachable { std::numeric_limits<std::uint32_t>::max() };
+
+    /// Constructor, calculates the field
+    /// \param grid the navigation grid
+    /// \param goal the goal tile position
+    FlowField(NavigationGrid const& grid, jt::Vector2u const& goal);
+
+    jt::Vector2u const& getGoal() const noexcept;
+
+    /// Get the version of the grid the field was calculated for
+    /// \return grid version
+    std::uint64_t getGridVersion() const noexcept;
+
+    /// Check if the goal can be reached from a tile
+    /// \param pos the tile position
+    /// \return true if reachable, false otherwise
+    bool isReachable(jt::Vector2u const& pos) const noexcept;
+
+    /// Get the cost to reach the goal from a tile
+    /// \param pos the tile position
+    /// \return the cost (in multiples of straightStepCost) or unreachable
+    std::uint32_t getCost(jt::Vector2u const& pos) const noexcept;
+
+    /// Get the normalized direction to move from a tile towards the goal
+    /// \param pos the tile position
+    /// \return the direction, zero at the goal and on tiles that cannot reach the goal
+    jt::Vector2f getDirection(jt::Vector2u const& pos) const noexcept;
+
+    /// Get the next tile on the way to the goal
+    /// \param pos the tile position
+    /// \return the next tile position, pos itself at the goal or if the goal is unreachable
+    jt::Vector2u getNextTile(jt::Vector2u const& pos) const noexcept;
+
+private:
+    static constexpr std::int8_t noDirection { -1 };
+
+    unsigned int m_width { 0u };
+    unsigned int m_height { 0u };
+    jt::Vector2u m_goal { 0u, 0u };
+    std::uint64_t m_gridVersion { 0u };
+    std::vector<std::uint32_t> m_costs {};
+    // index into NavigationGrid::neighbourOffsets or noDirection
+    std::vector<std::int8_t> m_directions {};
+
+    void calculateCosts(NavigationGrid const& grid);
+    void calculateDirections(NavigationGrid const& grid);
+    std::int8_t getDirectionIndex(jt::Vector2u const& pos) const noexcept;
+};
+
+/// Keeps the flow fields of the most recently used goals. All fields are dropped when the blocked
+/// state of the grid changes. Use NodeLayer::addNavigationGrid to update the grid from
+/// TileNode::setBlocked.
+class FlowFieldCache {
+public:
+    /// Constructor
+    /// \param grid the navigation grid, may be changed between calls to getFlowField
+    /// \param maxNumberOfFields number of fields to keep, least recently used fields are dropped
+    explicit FlowFieldCache(
+        std::shared_ptr<NavigationGrid const> grid, std::size_t maxNumberOfFields = 8u);
+
+    /// Get the flow field for a goal, calculating it if it is not cached
+    /// \param goal the goal tile position
+    /// \return the flow field
+    std::shared_ptr<FlowField const> getFlowField(jt::Vector2u const& goal);
+
+    void clear() noexcept;
+
+    std::size_t size() const noexcept;
+
+private:
+    std::shared_ptr<NavigationGrid const> m_grid;
+    std::size_t m_maxNumberOfFields { 8u };
+    // most recently used field is at the back
+    std::vector<std::shared_ptr<FlowField const>> m_fields {};
+};
+
+} // namespace pathfinder
+} // namespace jt
+
+#endif // JAMTEMPLATE_FLOW_FIELD_HPP
@@ -0,0 +1,97 @@
+#include "grid_pathfinder.hpp"
+#include <trace_profiler.hpp>
+#include <algorithm>
+
+void jt::pathfinder::GridPathfinder::prepare(std::size_t numberOfNodes)
+{
+    if (m_cost.size() != numberOfNodes) {
+        m_cost.assign(numberOfNodes, 0.0f);
+        m_parent.assign(numberOfNodes, NavigationGrid::invalidNode);
+        m_seenGeneration.assign(numberOfNodes, 0u);
+        m_closedGeneration.assign(numberOfNodes, 0u);
+        m_open.reserve(numberOfNodes);
+        m_generation = 0u;
+    }
+    m_open.clear();
+    ++m_generation;
+    if (m_generation == 0u) {
+        // generation counter wrapped around, old tags could be mistaken for current ones
+        std::fill(m_seenGeneration.begin(), m_seenGeneration.end(), 0u);
+        std::fill(m_closedGeneration.begin(), m_closedGeneration.end(), 0u);
+        m_generation = 1u;
+    }
+}
+
+bool jt::pathfinder::GridPathfinder::calculatePath(
+    NavigationGrid const& grid, NodeId start, NodeId end, std::vector<NodeId>& path)
+{
+    JT_PROFILE_ZONE("jt::pathfinder::GridPathfinder::calculatePath");
+    path.clear();
+    m_numberOfExpandedNodes = 0u;
+    auto const numberOfNodes = grid.getNumberOfNodes();
+    if (start >= numberOfNodes || end >= numberOfNodes) {
+        return false;
+    }
+    if (grid.isBlocked(start) || grid.isBlocked(end)) {
+        return false;
+    }
+    if (start == end) {
+        return true;
+    }
+
+    prepare(numberOfNodes);
+    auto const generation = m_generation;
+
+    m_cost[start] = 0.0f;
+    m_parent[start] = NavigationGrid::invalidNode;
+    m_seenGeneration[start] = generation;
+    m_open.pushOrUpdate(start, grid.getHeuristic(start, end));
+
+    while (!m_open.empty()) {
+        auto const current = m_open.pop();
+        if (current == end) {
+            for (auto n = end; n != NavigationGrid::invalidNode; n = m_parent[n]) {
+                path.push_back(n);
+            }
+            std::reverse(path.begin(), path.end());
+            return true;
+        }
+        m_closedGeneration[current] = generation;
+        ++m_numberOfExpandedNodes;
+
+        auto const currentCost = m_cost[current];
+        grid.forEachNeighbour(current, [&](NodeId neighbour, float stepCost) {
+            if (m_closedGeneration[neighbour] == generation) {
+                return;
+            }
+            auto const newCost = currentCost + stepCost;
+            if (m_seenGeneration[neighbour] == generation && m_cost[neighbour] <= newCost) {
+                return;
+            }
+            m_seenGeneration[neighbour] = generation;
+            m_cost[neighbour] = newCost;
+            m_parent[neighbour] = current;
+            m_open.pushOrUpdate(neighbour, newCost + grid.getHeuristic(neighbour, end));
+        });
+    }
+    return false;
+}
+
+std::vector<jt::Vector2u> jt::pathfinder::GridPathfinder::calculatePath(
+    NavigationGrid const& grid, jt::Vector2u const& start, jt::Vector2u const& end)
+{
+    std::vector<jt::Vector2u> positions {};
+    if (!calculatePath(grid, grid.toNodeId(start), grid.toNodeId(end), m_idPath)) {
+        return positions;
+    }
+    positions.reserve(m_idPath.size());
+    for (auto const id : m_idPath) {
+        positions.push_back(grid.toTilePosition(id));
+    }
+    return positions;
+}
+
+std::size_t jt::pathfinder::GridPathfinder::getNumberOfExpandedNodes() const noexcept
+{
+    return m_numberOfExpandedNodes;
+}
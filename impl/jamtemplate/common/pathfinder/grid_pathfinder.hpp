@@ -0,0 +1,62 @@
+#ifndef JAMTEMPLATE_GRID_PATHFINDER_HPP
+#define JAMTEMPLATE_GRID_PATHFINDER_HPP
+
+#include <pathfinder/indexed_binary_heap.hpp>
+#include <pathfinder/navigation_grid.hpp>
+#include <vector.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace jt {
+namespace pathfinder {
+
+/// A* search on a NavigationGrid. Holds all per-search scratch memory, so repeated searches on
+/// grids of the same size do not allocate. Scratch entries are tagged with a search generation,
+/// so they do not need to be cleared between searches.
+///
+/// A GridPathfinder must not be used by multiple threads at the same time.
+class GridPathfinder {
+public:
+    using NodeId = NavigationGrid::NodeId;
+
+    /// Calculate the shortest path from start to end
+    /// \param grid the navigation grid
+    /// \param start start node id
+    /// \param end end node id
+    /// \param path will be filled with the node ids of the path including start and end. Cleared
+    /// if start == end or no path exists, like calculatePath on a node graph. Capacity is reused.
+    /// \return true if a path was found or start == end, false otherwise
+    bool calculatePath(
+        NavigationGrid const& grid, NodeId start, NodeId end, std::vector<NodeId>& path);
+
+    /// Calculate the shortest path from start to end
+    /// \param grid the navigation grid
+    /// \param start start tile position
+    /// \param end end tile position
+    /// \return the tile positions of the path including start and end. Empty if start == end or
+    /// no path exists.
+    std::vector<jt::Vector2u> calculatePath(
+        NavigationGrid const& grid, jt::Vector2u const& start, jt::Vector2u const& end);
+
+    /// Get the number of nodes expanded by the last search
+    /// \return number of expanded nodes
+    std::size_t getNumberOfExpandedNodes() const noexcept;
+
+private:
+    std::vector<float> m_cost {};
+    std::vector<NodeId> m_parent {};
+    // m_cost and m_parent of a node are only valid if m_seenGeneration equals m_generation
+    std::vector<std::uint32_t> m_seenGeneration {};
+    std::vector<std::uint32_t> m_closedGeneration {};
+    std::uint32_t m_generation { 0u };
+    IndexedBinaryHeap m_open {};
+    std::vector<NodeId> m_idPath {};
+    std::size_t m_numberOfExpandedNodes { 0u };
+
+    void prepare(std::size_t numberOfNodes);
+};
+
+} // namespace pathfinder
+} // namespace jt
+
+#endif // JAMTEMPLATE_GRID_PATHFINDER_HPP
@@ -0,0 +1,433 @@
+#include "hierarchical_pathfinder.hpp"
+#include <trace_profiler.hpp>
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+namespace {
+
+constexpr float unreachable { std::numeric_limits<float>::max() };
+
+// entrances shorter than this get one transition in the middle, longer ones one at each end
+constexpr unsigned int maxSingleTransitionEntranceLength { 6u };
+
+} // namespace
+
+jt::pathfinder::HierarchicalPathfinder::HierarchicalPathfinder(
+    NavigationGrid grid, unsigned int clusterSize)
+    : m_grid { std::move(grid) }
+    , m_clusterSize { std::max(clusterSize, 1u) }
+{
+    m_clustersX = (m_grid.getWidth() + m_clusterSize - 1u) / m_clusterSize;
+    m_clustersY = (m_grid.getHeight() + m_clusterSize - 1u) / m_clusterSize;
+    m_clusters.resize(static_cast<std::size_t>(m_clustersX) * m_clustersY);
+    for (auto cy = 0u; cy != m_clustersY; ++cy) {
+        for (auto cx = 0u; cx != m_clustersX; ++cx) {
+            auto& cluster = m_clusters[cx + cy * m_clustersX];
+            cluster.x0 = cx * m_clusterSize;
+            cluster.y0 = cy * m_clusterSize;
+            cluster.width = std::min(m_clusterSize, m_grid.getWidth() - cluster.x0);
+            cluster.height = std::min(m_clusterSize, m_grid.getHeight() - cluster.y0);
+        }
+    }
+
+    auto const numberOfNodes = m_grid.getNumberOfNodes();
+    m_abstractNodeIndex.assign(numberOfNodes, invalidIndex);
+    m_abstractCost.assign(numberOfNodes, 0.0f);
+    m_abstractParent.assign(numberOfNodes, NavigationGrid::invalidNode);
+    m_abstractSeen.assign(numberOfNodes, 0u);
+    m_abstractClosed.assign(numberOfNodes, 0u);
+    m_abstractOpen.reserve(numberOfNodes);
+
+    auto const clusterArea = static_cast<std::size_t>(m_clusterSize) * m_clusterSize;
+    m_localCost.assign(clusterArea, unreachable);
+    m_localParent.assign(clusterArea, NavigationGrid::invalidNode);
+    m_localOpen.reserve(clusterArea);
+
+    rebuildDirtyClusters();
+}
+
+jt::pathfinder::NavigationGrid const&
+jt::pathfinder::HierarchicalPathfinder::getGrid() const noexcept
+{
+    return m_grid;
+}
+
+void jt::pathfinder::HierarchicalPathfinder::setBlocked(jt::Vector2u const& pos, bool blocked)
+{
+    auto const tile = m_grid.toNodeId(pos);
+    if (tile == NavigationGrid::invalidNode || m_grid.isBlocked(tile) == blocked) {
+        return;
+    }
+    m_grid.setBlocked(pos, blocked);
+    m_clusters[getClusterIndex(tile)].dirty = true;
+    m_anyClusterDirty = true;
+}
+
+std::vector<jt::Vector2u> jt::pathfinder::HierarchicalPathfinder::calculatePath(
+    jt::Vector2u const& start, jt::Vector2u const& end)
+{
+    JT_PROFILE_ZONE("jt::pathfinder::HierarchicalPathfinder::calculatePath");
+    rebuildDirtyClusters();
+    std::vector<jt::Vector2u> path {};
+    auto const startTile = m_grid.toNodeId(start);
+    auto const endTile = m_grid.toNodeId(end);
+    if (startTile == NavigationGrid::invalidNode || endTile == NavigationGrid::invalidNode) {
+        return path;
+    }
+    if (startTile == endTile || m_grid.isBlocked(startTile) || m_grid.isBlocked(endTile)) {
+        return path;
+    }
+
+    if (!searchAbstractGraph(startTile, endTile)) {
+        return path;
+    }
+
+    path.push_back(start);
+    for (auto i = 1u; i < m_abstractPath.size(); ++i) {
+        auto const from = m_abstractPath[i - 1u];
+        auto const to = m_abstractPath[i];
+        if (getClusterIndex(from) != getClusterIndex(to)) {
+            // inter cluster edges always connect adjacent tiles
+            path.push_back(m_grid.toTilePosition(to));
+        } else {
+            appendPathInCluster(from, to, path);
+        }
+    }
+    return path;
+}
+
+std::size_t jt::pathfinder::HierarchicalPathfinder::getNumberOfClusters() const noexcept
+{
+    return m_clusters.size();
+}
+
+std::size_t jt::pathfinder::HierarchicalPathfinder::getNumberOfAbstractNodes() const noexcept
+{
+    std::size_t count { 0u };
+    for (auto const& c : m_clusters) {
+        count += c.nodes.size();
+    }
+    return count;
+}
+
+std::size_t jt::pathfinder::HierarchicalPathfinder::getNumberOfClusterBuilds() const noexcept
+{
+    return m_numberOfClusterBuilds;
+}
+
+std::size_t jt::pathfinder::HierarchicalPathfinder::getClusterIndex(NodeId tile) const noexcept
+{
+    auto const pos = m_grid.toTilePosition(tile);
+    return pos.x / m_clusterSize + (pos.y / m_clusterSize) * m_clustersX;
+}
+
+void jt::pathfinder::HierarchicalPathfinder::rebuildDirtyClusters()
+{
+    if (!m_anyClusterDirty) {
+        return;
+    }
+    JT_PROFILE_ZONE("jt::pathfinder::HierarchicalPathfinder::rebuildDirtyClusters");
+    // entrances of a cluster depend on the tiles of all adjacent clusters, so the neighbours of a
+    // dirty cluster have to be rebuilt as well
+    std::vector<std::uint8_t> needsBuild(m_clusters.size(), 0u);
+    for (auto cy = 0u; cy != m_clustersY; ++cy) {
+        for (auto cx = 0u; cx != m_clustersX; ++cx) {
+            if (!m_clusters[cx + cy * m_clustersX].dirty) {
+                continue;
+            }
+            for (auto ny = std::max(cy, 1u) - 1u; ny != std::min(cy + 2u, m_clustersY); ++ny) {
+                for (auto nx = std::max(cx, 1u) - 1u; nx != std::min(cx + 2u, m_clustersX); ++nx) {
+                    needsBuild[nx + ny * m_clustersX] = 1u;
+                }
+            }
+        }
+    }
+    for (auto i = 0u; i != m_clusters.size(); ++i) {
+        if (needsBuild[i]) {
+            buildCluster(i);
+        }
+    }
+    m_anyClusterDirty = false;
+}
+
+template <typename Callback>
+void jt::pathfinder::HierarchicalPathfinder::forEachTransition(
+    Cluster const& cluster, Callback&& callback) const
+{
+    auto const width = m_grid.getWidth();
+    auto const height = m_grid.getHeight();
+    auto const walkable = [this](unsigned int x, unsigned int y) {
+        return !m_grid.isBlocked(m_grid.toNodeId(jt::Vector2u { x, y }));
+    };
+    auto const id = [this](unsigned int x, unsigned int y) {
+        return m_grid.toNodeId(jt::Vector2u { x, y });
+    };
+
+    // Straight entrances along one side. Both clusters of a side see the same tile pairs, so they
+    // pick the same transitions.
+    auto const scanSide
+        = [&](unsigned int insideX, unsigned int insideY, unsigned int outsideX,
+              unsigned int outsideY, unsigned int stepX, unsigned int stepY, unsigned int length) {
+              unsigned int segmentStart { 0u };
+              unsigned int segmentLength { 0u };
+              auto const emitSegment = [&]() {
+                  if (segmentLength == 0u) {
+                      return;
+                  }
+                  auto const emit = [&](unsigned int i) {
+                      callback(id(insideX + i * stepX, insideY + i * stepY),
+                          id(outsideX + i * stepX, outsideY + i * stepY), 1.0f);
+                  };
+                  if (segmentLength < maxSingleTransitionEntranceLength) {
+                      emit(segmentStart + segmentLength / 2u);
+                  } else {
+                      emit(segmentStart);
+                      emit(segmentStart + segmentLength - 1u);
+                  }
+                  segmentLength = 0u;
+              };
+              for (auto i = 0u; i != length; ++i) {
+                  if (walkable(insideX + i * stepX, insideY + i * stepY)
+                      && walkable(outsideX + i * stepX, outsideY + i * stepY)) {
+                      if (segmentLength == 0u) {
+                          segmentStart = i;
+                      }
+                      ++segmentLength;
+                  } else {
+                      emitSegment();
+                  }
+              }
+              emitSegment();
+          };
+
+    auto const right = cluster.x0 + cluster.width - 1u;
+    auto const bottom = cluster.y0 + cluster.height - 1u;
+    if (cluster.x0 != 0u) {
+        scanSide(cluster.x0, cluster.y0, cluster.x0 - 1u, cluster.y0, 0u, 1u, cluster.height);
+    }
+    if (right + 1u < width) {
+        scanSide(right, cluster.y0, right + 1u, cluster.y0, 0u, 1u, cluster.height);
+    }
+    if (cluster.y0 != 0u) {
+        scanSide(cluster.x0, cluster.y0, cluster.x0, cluster.y0 - 1u, 1u, 0u, cluster.width);
+    }
+    if (bottom + 1u < height) {
+        scanSide(cluster.x0, bottom, cluster.x0, bottom + 1u, 1u, 0u, cluster.width);
+    }
+
+    // Diagonal moves out of the cluster only need their own transition if both tiles next to the
+    // diagonal are blocked. Otherwise the move is covered by straight entrances.
+    for (auto y = cluster.y0; y <= bottom; ++y) {
+        for (auto x = cluster.x0; x <= right; ++x) {
+            if (x != cluster.x0 && x != right && y != cluster.y0 && y != bottom) {
+                continue;
+            }
+            if (!walkable(x, y)) {
+                continue;
+            }
+            for (auto const& offset : NavigationGrid::neighbourOffsets) {
+                if (offset[0] == 0 || offset[1] == 0) {
+                    continue;
+                }
+                auto const ox = static_cast<int>(x) + offset[0];
+                auto const oy = static_cast<int>(y) + offset[1];
+                if (ox < 0 || oy < 0 || ox >= static_cast<int>(width)
+                    || oy >= static_cast<int>(height)) {
+                    continue;
+                }
+                auto const ux = static_cast<unsigned int>(ox);
+                auto const uy = static_cast<unsigned int>(oy);
+                if (ux >= cluster.x0 && ux <= right && uy >= cluster.y0 && uy <= bottom) {
+                    continue;
+                }
+                if (walkable(ux, uy) && !walkable(ux, y) && !walkable(x, uy)) {
+                    callback(id(x, y), id(ux, uy), NavigationGrid::getStepCost(1, 1));
+                }
+            }
+        }
+    }
+}
+
+void jt::pathfinder::HierarchicalPathfinder::buildCluster(std::size_t clusterIndex)
+{
+    auto& cluster = m_clusters[clusterIndex];
+    for (auto const& n : cluster.nodes) {
+        m_abstractNodeIndex[n.tile] = invalidIndex;
+    }
+    cluster.nodes.clear();
+
+    forEachTransition(cluster, [this, &cluster](NodeId inside, NodeId outside, float cost) {
+        auto index = m_abstractNodeIndex[inside];
+        if (index == invalidIndex) {
+            index = static_cast<std::uint32_t>(cluster.nodes.size());
+            m_abstractNodeIndex[inside] = index;
+            cluster.nodes.push_back(AbstractNode { inside, {} });
+        }
+        cluster.nodes[index].interEdges.push_back(InterEdge { outside, cost });
+    });
+
+    auto const count = cluster.nodes.size();
+    cluster.intraCosts.assign(count * count, unreachable);
+    for (auto i = 0u; i != count; ++i) {
+        searchInCluster(cluster, cluster.nodes[i].tile, NavigationGrid::invalidNode);
+        for (auto j = 0u; j != count; ++j) {
+            cluster.intraCosts[i * count + j]
+                = m_localCost[toLocalIndex(cluster, cluster.nodes[j].tile)];
+        }
+    }
+    cluster.dirty = false;
+    ++m_numberOfClusterBuilds;
+}
+
+std::uint32_t jt::pathfinder::HierarchicalPathfinder::toLocalIndex(
+    Cluster const& cluster, NodeId tile) const noexcept
+{
+    auto const pos = m_grid.toTilePosition(tile);
+    return (pos.x - cluster.x0) + (pos.y - cluster.y0) * cluster.width;
+}
+
+void jt::pathfinder::HierarchicalPathfinder::searchInCluster(
+    Cluster const& cluster, NodeId from, NodeId target)
+{
+    std::fill(m_localCost.begin(), m_localCost.end(), unreachable);
+    m_localOpen.clear();
+
+    auto const startIndex = toLocalIndex(cluster, from);
+    m_localCost[startIndex] = 0.0f;
+    m_localParent[startIndex] = NavigationGrid::invalidNode;
+    m_localOpen.pushOrUpdate(startIndex, 0.0f);
+
+    // Dijkstra, so a single search yields the costs to all other abstract nodes of the cluster
+    while (!m_localOpen.empty()) {
+        auto const currentIndex = m_localOpen.pop();
+        auto const current = m_grid.toNodeId(jt::Vector2u {
+            cluster.x0 + currentIndex % cluster.width, cluster.y0 + currentIndex / cluster.width });
+        if (current == target) {
+            return;
+        }
+        auto const currentCost = m_localCost[currentIndex];
+        m_grid.forEachNeighbour(current, [&](NodeId neighbour, float stepCost) {
+            auto const pos = m_grid.toTilePosition(neighbour);
+            if (pos.x < cluster.x0 || pos.y < cluster.y0 || pos.x >= cluster.x0 + cluster.width
+                || pos.y >= cluster.y0 + cluster.height) {
+                return;
+            }
+            auto const neighbourIndex = toLocalIndex(cluster, neighbour);
+            auto const newCost = currentCost + stepCost;
+            if (newCost >= m_localCost[neighbourIndex]) {
+                return;
+            }
+            m_localCost[neighbourIndex] = newCost;
+            m_localParent[neighbourIndex] = current;
+            m_localOpen.pushOrUpdate(neighbourIndex, newCost);
+        });
+    }
+}
+
+bool jt::pathfinder::HierarchicalPathfinder::searchAbstractGraph(NodeId start, NodeId end)
+{
+    m_abstractPath.clear();
+
+    // connect start and end to the abstract nodes of their clusters
+    auto const startClusterIndex = getClusterIndex(start);
+    auto const endClusterIndex = getClusterIndex(end);
+    auto const& startCluster = m_clusters[startClusterIndex];
+    auto const& endCluster = m_clusters[endClusterIndex];
+
+    searchInCluster(startCluster, start, NavigationGrid::invalidNode);
+    m_startCosts.clear();
+    for (auto const& n : startCluster.nodes) {
+        m_startCosts.push_back(m_localCost[toLocalIndex(startCluster, n.tile)]);
+    }
+    auto const directCost = startClusterIndex == endClusterIndex
+        ? m_localCost[toLocalIndex(startCluster, end)]
+        : unreachable;
+
+    searchInCluster(endCluster, end, NavigationGrid::invalidNode);
+    m_endCosts.clear();
+    for (auto const& n : endCluster.nodes) {
+        m_endCosts.push_back(m_localCost[toLocalIndex(endCluster, n.tile)]);
+    }
+
+    ++m_generation;
+    if (m_generation == 0u) {
+        std::fill(m_abstractSeen.begin(), m_abstractSeen.end(), 0u);
+        std::fill(m_abstractClosed.begin(), m_abstractClosed.end(), 0u);
+        m_generation = 1u;
+    }
+    auto const generation = m_generation;
+    m_abstractOpen.clear();
+
+    auto const relax = [&](NodeId from, NodeId to, float cost) {
+        if (cost == unreachable || m_abstractClosed[to] == generation) {
+            return;
+        }
+        auto const newCost = m_abstractCost[from] + cost;
+        if (m_abstractSeen[to] == generation && m_abstractCost[to] <= newCost) {
+            return;
+        }
+        m_abstractSeen[to] = generation;
+        m_abstractCost[to] = newCost;
+        m_abstractParent[to] = from;
+        m_abstractOpen.pushOrUpdate(to, newCost + m_grid.getHeuristic(to, end));
+    };
+
+    m_abstractSeen[start] = generation;
+    m_abstractCost[start] = 0.0f;
+    m_abstractParent[start] = NavigationGrid::invalidNode;
+    m_abstractOpen.pushOrUpdate(start, m_grid.getHeuristic(start, end));
+
+    while (!m_abstractOpen.empty()) {
+        auto const current = m_abstractOpen.pop();
+        if (current == end) {
+            for (auto n = end; n != NavigationGrid::invalidNode; n = m_abstractParent[n]) {
+                m_abstractPath.push_back(n);
+            }
+            std::reverse(m_abstractPath.begin(), m_abstractPath.end());
+            return true;
+        }
+        m_abstractClosed[current] = generation;
+
+        if (current == start) {
+            for (auto i = 0u; i != startCluster.nodes.size(); ++i) {
+                if (startCluster.nodes[i].tile != start) {
+                    relax(current, startCluster.nodes[i].tile, m_startCosts[i]);
+                }
+            }
+            relax(current, end, directCost);
+        }
+
+        auto const index = m_abstractNodeIndex[current];
+        if (index == invalidIndex) {
+            continue;
+        }
+        auto const clusterIndex = getClusterIndex(current);
+        auto const& cluster = m_clusters[clusterIndex];
+        auto const count = cluster.nodes.size();
+        for (auto j = 0u; j != count; ++j) {
+            if (j != index) {
+                relax(current, cluster.nodes[j].tile, cluster.intraCosts[index * count + j]);
+            }
+        }
+        for (auto const& e : cluster.nodes[index].interEdges) {
+            relax(current, e.to, e.cost);
+        }
+        if (clusterIndex == endClusterIndex) {
+            relax(current, end, m_endCosts[index]);
+        }
+    }
+    return false;
+}
+
+void jt::pathfinder::HierarchicalPathfinder::appendPathInCluster(
+    NodeId from, NodeId to, std::vector<jt::Vector2u>& path)
+{
+    auto const& cluster = m_clusters[getClusterIndex(from)];
+    searchInCluster(cluster, from, to);
+    auto const first = path.size();
+    for (auto n = to; n != from; n = m_localParent[toLocalIndex(cluster, n)]) {
+        path.push_back(m_grid.toTilePosition(n));
+    }
+    std::reverse(path.begin() + static_cast<std::ptrdiff_t>(first), path.end());
+}
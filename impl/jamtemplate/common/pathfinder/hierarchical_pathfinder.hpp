@@ -0,0 +1,124 @@
+#ifndef JAMTEMPLATE_HIERARCHICAL_PATHFINDER_HPP
+#define JAMTEMPLATE_HIERARCHICAL_PATHFINDER_HPP
+
+#include <pathfinder/indexed_binary_heap.hpp>
+#include <pathfinder/navigation_grid.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jt {
+namespace pathfinder {
+
+/// Hierarchical pathfinding (HPA*) for large tile maps.
+///
+/// The map is partitioned into square clusters. Walkable tile pairs on the border between two
+/// clusters form entrances, every entrance adds a node on both sides to an abstract graph. Nodes of
+/// the same cluster are connected by the costs of the shortest path inside the cluster. A query
+/// searches the small abstract graph first and then refines every abstract edge with a search
+/// restricted to a single cluster. Paths are near optimal.
+///
+/// Changing the blocked state of a tile only marks its cluster as dirty. Dirty clusters and their
+/// direct neighbours are rebuilt before the next query.
+///
+/// A HierarchicalPathfinder must not be used by multiple threads at the same time.
+class HierarchicalPathfinder {
+public:
+    using NodeId = NavigationGrid::NodeId;
+
+    /// Constructor
+    /// \param grid the navigation grid, e.g. from NodeLayer::createNavigationGrid
+    /// \param clusterSize the cluster width and height in tiles
+    explicit HierarchicalPathfinder(NavigationGrid grid, unsigned int clusterSize = 16u);
+
+    NavigationGrid const& getGrid() const noexcept;
+
+    /// Change the blocked state of a tile. Use NodeLayer::addPathfinder to have this called
+    /// automatically from TileNode::setBlocked.
+    /// \param pos the tile position
+    /// \param blocked the new blocked state
+    void setBlocked(jt::Vector2u const& pos, bool blocked);
+
+    /// Calculate a path from start to end
+    /// \param start start tile position
+    /// \param end end tile position
+    /// \return the tile positions of the path including start and end. Empty if start == end or
+    /// no path exists.
+    std::vector<jt::Vector2u> calculatePath(jt::Vector2u const& start, jt::Vector2u const& end);
+
+    std::size_t getNumberOfClusters() const noexcept;
+
+    /// Get the number of nodes in the abstract graph
+    /// \return number of abstract nodes
+    std::size_t getNumberOfAbstractNodes() const noexcept;
+
+    /// Get the number of times a single cluster was built, including the initial build
+    /// \return number of cluster builds
+    std::size_t getNumberOfClusterBuilds() const noexcept;
+
+private:
+    static constexpr std::uint32_t invalidIndex { 0xFFFFFFFFu };
+
+    struct InterEdge {
+        NodeId to { NavigationGrid::invalidNode };
+        float cost { 0.0f };
+    };
+
+    struct AbstractNode {
+        NodeId tile { NavigationGrid::invalidNode };
+        std::vector<InterEdge> interEdges {};
+    };
+
+    struct Cluster {
+        unsigned int x0 { 0u };
+        unsigned int y0 { 0u };
+        unsigned int width { 0u };
+        unsigned int height { 0u };
+        std::vector<AbstractNode> nodes {};
+        // shortest path cost inside the cluster between nodes i and j at i * nodes.size() + j
+        std::vector<float> intraCosts {};
+        bool dirty { true };
+    };
+
+    NavigationGrid m_grid;
+    unsigned int m_clusterSize { 16u };
+    unsigned int m_clustersX { 0u };
+    unsigned int m_clustersY { 0u };
+    std::vector<Cluster> m_clusters {};
+    // index of the abstract node of a tile inside its cluster or invalidIndex
+    std::vector<std::uint32_t> m_abstractNodeIndex {};
+    bool m_anyClusterDirty { true };
+    std::size_t m_numberOfClusterBuilds { 0u };
+
+    // scratch for searches restricted to one cluster, indexed by tile position inside the cluster
+    std::vector<float> m_localCost {};
+    std::vector<NodeId> m_localParent {};
+    IndexedBinaryHeap m_localOpen {};
+
+    // scratch for searches on the abstract graph, indexed by tile id
+    std::vector<float> m_abstractCost {};
+    std::vector<NodeId> m_abstractParent {};
+    std::vector<std::uint32_t> m_abstractSeen {};
+    std::vector<std::uint32_t> m_abstractClosed {};
+    std::uint32_t m_generation { 0u };
+    IndexedBinaryHeap m_abstractOpen {};
+    std::vector<float> m_startCosts {};
+    std::vector<float> m_endCosts {};
+    std::vector<NodeId> m_abstractPath {};
+
+    std::size_t getClusterIndex(NodeId tile) const noexcept;
+    void rebuildDirtyClusters();
+    void buildCluster(std::size_t clusterIndex);
+    template <typename Callback>
+    void forEachTransition(Cluster const& cluster, Callback&& callback) const;
+    void searchInCluster(Cluster const& cluster, NodeId from, NodeId target);
+    std::uint32_t toLocalIndex(Cluster const& cluster, NodeId tile) const noexcept;
+    bool searchAbstractGraph(NodeId start, NodeId end);
+    void appendPathInCluster(NodeId from, NodeId to, std::vector<jt::Vector2u>& path);
+};
+
+} // namespace pathfinder
+} // namespace jt
+
+#endif // JAMTEMPLATE_HIERARCHICAL_PATHFINDER_HPP
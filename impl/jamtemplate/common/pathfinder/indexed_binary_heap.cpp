@@ -0,0 +1,102 @@
+#include "indexed_binary_heap.hpp"
+
+void jt::pathfinder::IndexedBinaryHeap::reserve(std::size_t capacity)
+{
+    m_elements.clear();
+    m_elements.reserve(capacity);
+    m_positions.assign(capacity, notInHeap);
+}
+
+void jt::pathfinder::IndexedBinaryHeap::clear() noexcept
+{
+    for (auto const& e : m_elements) {
+        m_positions[e.id] = notInHeap;
+    }
+    m_elements.clear();
+}
+
+bool jt::pathfinder::IndexedBinaryHeap::empty() const noexcept { return m_elements.empty(); }
+
+std::size_t jt::pathfinder::IndexedBinaryHeap::size() const noexcept { return m_elements.size(); }
+
+bool jt::pathfinder::IndexedBinaryHeap::contains(IdT id) const noexcept
+{
+    return m_positions[id] != notInHeap;
+}
+
+void jt::pathfinder::IndexedBinaryHeap::pushOrUpdate(IdT id, float key)
+{
+    auto const pos = m_positions[id];
+    if (pos == notInHeap) {
+        m_elements.push_back(Element { key, id });
+        m_positions[id] = m_elements.size() - 1u;
+        siftUp(m_elements.size() - 1u);
+        return;
+    }
+    auto const oldKey = m_elements[pos].key;
+    m_elements[pos].key = key;
+    if (key < oldKey) {
+        siftUp(pos);
+    } else {
+        siftDown(pos);
+    }
+}
+
+jt::pathfinder::IndexedBinaryHeap::IdT jt::pathfinder::IndexedBinaryHeap::top() const noexcept
+{
+    return m_elements.front().id;
+}
+
+jt::pathfinder::IndexedBinaryHeap::IdT jt::pathfinder::IndexedBinaryHeap::pop()
+{
+    auto const id = m_elements.front().id;
+    m_positions[id] = notInHeap;
+    auto const last = m_elements.back();
+    m_elements.pop_back();
+    if (!m_elements.empty()) {
+        place(0u, last);
+        siftDown(0u);
+    }
+    return id;
+}
+
+void jt::pathfinder::IndexedBinaryHeap::siftUp(std::size_t index) noexcept
+{
+    auto const element = m_elements[index];
+    while (index != 0u) {
+        auto const parent = (index - 1u) / 2u;
+        if (!(element.key < m_elements[parent].key)) {
+            break;
+        }
+        place(index, m_elements[parent]);
+        index = parent;
+    }
+    place(index, element);
+}
+
+void jt::pathfinder::IndexedBinaryHeap::siftDown(std::size_t index) noexcept
+{
+    auto const element = m_elements[index];
+    auto const count = m_elements.size();
+    while (true) {
+        auto child = 2u * index + 1u;
+        if (child >= count) {
+            break;
+        }
+        if (child + 1u < count && m_elements[child + 1u].key < m_elements[child].key) {
+            ++child;
+        }
+        if (!(m_elements[child].key < element.key)) {
+            break;
+        }
+        place(index, m_elements[child]);
+        index = child;
+    }
+    place(index, element);
+}
+
+void jt::pathfinder::IndexedBinaryHeap::place(std::size_t index, Element const& element) noexcept
+{
+    m_elements[index] = element;
+    m_positions[element.id] = index;
+}
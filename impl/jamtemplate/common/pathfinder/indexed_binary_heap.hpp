@@ -0,0 +1,67 @@
+#ifndef JAMTEMPLATE_INDEXED_BINARY_HEAP_HPP
+#define JAMTEMPLATE_INDEXED_BINARY_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace jt {
+namespace pathfinder {
+
+/// Binary min heap of integer ids with float keys that supports decrease-key in O(log n).
+/// The position of each id inside the heap is tracked in a flat array, so ids have to be in the
+/// range [0, capacity).
+class IndexedBinaryHeap {
+public:
+    using IdT = std::uint32_t;
+
+    /// Resize the heap, so that ids in the range [0, capacity) can be stored. Clears the heap.
+    /// \param capacity the number of ids
+    void reserve(std::size_t capacity);
+
+    /// Remove all ids from the heap. Only touches the ids currently stored in the heap.
+    void clear() noexcept;
+
+    bool empty() const noexcept;
+    std::size_t size() const noexcept;
+
+    /// Check if an id is in the heap
+    /// \param id the id
+    /// \return true if contained, false otherwise
+    bool contains(IdT id) const noexcept;
+
+    /// Add an id to the heap, or update its key if it is already contained
+    /// \param id the id
+    /// \param key the key, smallest key is on top
+    void pushOrUpdate(IdT id, float key);
+
+    /// Get the id with the smallest key
+    /// \return id on top of the heap
+    IdT top() const noexcept;
+
+    /// Remove the id with the smallest key
+    /// \return id that was on top of the heap
+    IdT pop();
+
+private:
+    static constexpr std::size_t notInHeap { std::numeric_limits<std::size_t>::max() };
+
+    struct Element {
+        float key { 0.0f };
+        IdT id { 0u };
+    };
+
+    std::vector<Element> m_elements {};
+    // position of each id inside m_elements or notInHeap
+    std::vector<std::size_t> m_positions {};
+
+    void siftUp(std::size_t index) noexcept;
+    void siftDown(std::size_t index) noexcept;
+    void place(std::size_t index, Element const& element) noexcept;
+};
+
+} // namespace pathfinder
+} // namespace jt
+
+#endif // JAMTEMPLATE_INDEXED_BINARY_HEAP_HPP
@@ -0,0 +1,89 @@
+#include "navigation_grid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+
+jt::pathfinder::NavigationGrid::NavigationGrid(unsigned int width, unsigned int height)
+    : m_width { width }
+    , m_height { height }
+{
+    m_blocked.assign(static_cast<std::size_t>(m_width) * m_height, 0u);
+}
+
+jt::pathfinder::NavigationGrid::NavigationGrid(
+    std::vector<std::shared_ptr<NodeInterface>> const& nodes)
+{
+    for (auto const& n : nodes) {
+        auto const& pos = n->getTilePosition();
+        m_width = std::max(m_width, pos.x + 1u);
+        m_height = std::max(m_height, pos.y + 1u);
+    }
+    m_blocked.assign(static_cast<std::size_t>(m_width) * m_height, 1u);
+    for (auto const& n : nodes) {
+        m_blocked[toNodeId(n->getTilePosition())] = n->getBlocked() ? 1u : 0u;
+    }
+}
+
+unsigned int jt::pathfinder::NavigationGrid::getWidth() const noexcept { return m_width; }
+
+unsigned int jt::pathfinder::NavigationGrid::getHeight() const noexcept { return m_height; }
+
+std::size_t jt::pathfinder::NavigationGrid::getNumberOfNodes() const noexcept
+{
+    return m_blocked.size();
+}
+
+bool jt::pathfinder::NavigationGrid::contains(jt::Vector2u const& pos) const noexcept
+{
+    return pos.x < m_width && pos.y < m_height;
+}
+
+jt::pathfinder::NavigationGrid::NodeId jt::pathfinder::NavigationGrid::toNodeId(
+    jt::Vector2u const& pos) const noexcept
+{
+    if (!contains(pos)) {
+        return invalidNode;
+    }
+    return static_cast<NodeId>(pos.x) + static_cast<NodeId>(pos.y) * m_width;
+}
+
+jt::Vector2u jt::pathfinder::NavigationGrid::toTilePosition(NodeId id) const noexcept
+{
+    return jt::Vector2u { id % m_width, id / m_width };
+}
+
+bool jt::pathfinder::NavigationGrid::isBlocked(NodeId id) const noexcept
+{
+    return m_blocked[id] != 0u;
+}
+
+void jt::pathfinder::NavigationGrid::setBlocked(jt::Vector2u const& pos, bool blocked)
+{
+    auto const id = toNodeId(pos);
+    if (id == invalidNode) {
+        return;
+    }
+    std::uint8_t const newValue = blocked ? 1u : 0u;
+    if (m_blocked[id] == newValue) {
+        return;
+    }
+    m_blocked[id] = newValue;
+    ++m_version;
+}
+
+std::uint64_t jt::pathfinder::NavigationGrid::getVersion() const noexcept { return m_version; }
+
+float jt::pathfinder::NavigationGrid::getStepCost(int dx, int dy) noexcept
+{
+    return (dx != 0 && dy != 0) ? 1.41421356f : 1.0f;
+}
+
+float jt::pathfinder::NavigationGrid::getHeuristic(NodeId a, NodeId b) const noexcept
+{
+    auto const dx = static_cast<float>(
+        std::abs(static_cast<int>(a % m_width) - static_cast<int>(b % m_width)));
+    auto const dy = static_cast<float>(
+        std::abs(static_cast<int>(a / m_width) - static_cast<int>(b / m_width)));
+    // straight moves cost 1, diagonal moves cost sqrt(2)
+    return (dx + dy) + (1.41421356f - 2.0f) * std::min(dx, dy);
+}
@@ -0,0 +1,115 @@
+#ifndef JAMTEMPLATE_NAVIGATION_GRID_HPP
+#define JAMTEMPLATE_NAVIGATION_GRID_HPP
+
+#include <pathfinder/node_interface.hpp>
+#include <vector.hpp>
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace jt {
+namespace pathfinder {
+
+/// Flat grid representation of a tile based navigation graph. Tiles are addressed by integer node
+/// ids (x + y * width), blocked flags are stored in a contiguous array. Every walkable tile is
+/// connected to its up to eight walkable neighbours, matching the connections NodeLayer creates.
+class NavigationGrid {
+public:
+    using NodeId = std::uint32_t;
+    static constexpr NodeId invalidNode { std::numeric_limits<NodeId>::max() };
+
+    /// Offsets of the eight neighbours, straight neighbours first
+    static constexpr std::array<std::array<int, 2>, 8> neighbourOffsets { { { 1, 0 }, { -1, 0 },
+        { 0, 1 }, { 0, -1 }, { 1, 1 }, { -1, 1 }, { 1, -1 }, { -1, -1 } } };
+
+    /// Create an empty grid
+    NavigationGrid() = default;
+
+    /// Create a grid where all tiles are walkable
+    /// \param width width in tiles
+    /// \param height height in tiles
+    NavigationGrid(unsigned int width, unsigned int height);
+
+    /// Create a grid from pathfinder nodes. Tiles without a node are blocked.
+    /// \param nodes the nodes, e.g. from TilesonLoader::loadNodesFromLayer
+    explicit NavigationGrid(std::vector<std::shared_ptr<NodeInterface>> const& nodes);
+
+    unsigned int getWidth() const noexcept;
+    unsigned int getHeight() const noexcept;
+
+    /// Get the number of nodes (width * height)
+    /// \return number of nodes
+    std::size_t getNumberOfNodes() const noexcept;
+
+    /// Check if a tile position is inside the grid
+    /// \param pos the tile position
+    /// \return true if inside, false otherwise
+    bool contains(jt::Vector2u const& pos) const noexcept;
+
+    /// Get the node id for a tile position
+    /// \param pos the tile position
+    /// \return the node id or invalidNode if the position is outside of the grid
+    NodeId toNodeId(jt::Vector2u const& pos) const noexcept;
+
+    /// Get the tile position of a node id
+    /// \param id the node id
+    /// \return the tile position
+    jt::Vector2u toTilePosition(NodeId id) const noexcept;
+
+    bool isBlocked(NodeId id) const noexcept;
+
+    void setBlocked(jt::Vector2u const& pos, bool blocked);
+
+    /// Get the version of the grid, which is increased whenever the blocked state of a tile
+    /// changes. Can be used to invalidate data derived from the grid.
+    /// \return the version
+    std::uint64_t getVersion() const noexcept;
+
+    /// Get the cost to move between two adjacent tiles
+    /// \param dx x offset (-1, 0 or 1)
+    /// \param dy y offset (-1, 0 or 1)
+    /// \return 1 for straight and sqrt(2) for diagonal moves
+    static float getStepCost(int dx, int dy) noexcept;
+
+    /// Octile distance between two nodes, an admissible heuristic for 8-connected grids
+    /// \param a first node id
+    /// \param b second node id
+    /// \return estimated cost
+    float getHeuristic(NodeId a, NodeId b) const noexcept;
+
+    /// Call visitor for every walkable neighbour of a node
+    /// \param id the node id
+    /// \param visitor callable accepting (NodeId neighbour, float stepCost)
+    template <typename Visitor>
+    void forEachNeighbour(NodeId id, Visitor&& visitor) const
+    {
+        auto const x = static_cast<int>(id % m_width);
+        auto const y = static_cast<int>(id / m_width);
+        for (auto const& offset : neighbourOffsets) {
+            auto const nx = x + offset[0];
+            auto const ny = y + offset[1];
+            if (nx < 0 || ny < 0 || nx >= static_cast<int>(m_width)
+                || ny >= static_cast<int>(m_height)) {
+                continue;
+            }
+            auto const neighbour = static_cast<NodeId>(nx) + static_cast<NodeId>(ny) * m_width;
+            if (m_blocked[neighbour]) {
+                continue;
+            }
+            visitor(neighbour, getStepCost(offset[0], offset[1]));
+        }
+    }
+
+private:
+    unsigned int m_width { 0u };
+    unsigned int m_height { 0u };
+    std::vector<std::uint8_t> m_blocked {};
+    std::uint64_t m_version { 0u };
+};
+
+} // namespace pathfinder
+} // namespace jt
+
+#endif // JAMTEMPLATE_NAVIGATION_GRID_HPP
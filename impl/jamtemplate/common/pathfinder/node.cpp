@@ -1,5 +1,6 @@
 #include "node.hpp"
 #include <stdexcept>
+#include <utility>
 
 std::vector<std::weak_ptr<jt::pathfinder::NodeInterface>> const&
 jt::pathfinder::Node::getNeighbours() const
@@ -33,4 +34,18 @@ float jt::pathfinder::Node::getValue() const { return m_value; }
 void jt::pathfinder::Node::setValue(float value) { m_value = value; }
 
 bool jt::pathfinder::Node::getBlocked() const { return m_isBlocked; }
-void jt::pathfinder::Node::setBlocked(bool blocked) { m_isBlocked = blocked; }
+void jt::pathfinder::Node::setBlocked(bool blocked)
+{
+    if (static_cast<bool>(m_isBlocked) == blocked) {
+        return;
+    }
+    m_isBlocked = blocked;
+    if (m_blockedChangedCallback) {
+        m_blockedChangedCallback(m_position, blocked);
+    }
+}
+
+void jt::pathfinder::Node::setBlockedChangedCallback(BlockedChangedCallbackType callback)
+{
+    m_blockedChangedCallback = std::move(callback);
+}
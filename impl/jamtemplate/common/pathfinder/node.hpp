@@ -26,12 +26,15 @@ public:
     void setBlocked(bool blocked) override;
     bool getBlocked() const override;
 
+    void setBlockedChangedCallback(BlockedChangedCallbackType callback) override;
+
 private:
     bool m_visited { false };
     float m_value { -1.0f };
     jt::Vector2u m_position;
     std::vector<std::weak_ptr<jt::pathfinder::NodeInterface>> m_neighbours;
     int m_isBlocked { false };
+    BlockedChangedCallbackType m_blockedChangedCallback {};
 };
 } // namespace pathfinder
 } // namespace jt
@@ -2,6 +2,7 @@
 #define JAMTEMPLATE_NODE_INTERFACE_HPP
 
 #include <vector.hpp>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -9,6 +10,9 @@ namespace jt {
 namespace pathfinder {
 class NodeInterface {
 public:
+    using BlockedChangedCallbackType
+        = std::function<void(jt::Vector2u const& tilePosition, bool blocked)>;
+
     /// get list of neighbour nodes
     /// \return vector of neighbour nodes
     virtual std::vector<std::weak_ptr<NodeInterface>> const& getNeighbours() const = 0;
@@ -45,6 +49,11 @@ public:
     /// get tile blocked
     virtual bool getBlocked() const = 0;
 
+    /// Set a callback that is invoked whenever setBlocked changes the blocked state. Used to keep
+    /// data derived from the nodes (e.g. a HierarchicalPathfinder) up to date.
+    /// \param callback the callback, an empty function removes the callback
+    virtual void setBlockedChangedCallback(BlockedChangedCallbackType callback) = 0;
+
     /// Destructor
     virtual ~NodeInterface() = default;
 
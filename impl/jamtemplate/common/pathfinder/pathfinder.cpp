@@ -1,155 +1,104 @@
 #include "pathfinder.hpp"
 #include <math_helper.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 #include <iostream>
-#include <limits>
+#include <queue>
 #include <stdexcept>
+#include <unordered_map>
 
 namespace {
 
 using NodeT = jt::pathfinder::NodeT;
 
-float calculateDistance(NodeT const& node1, jt::Vector2u const& position2)
+float calculateDistance(jt::Vector2u const& position1, jt::Vector2u const& position2)
 {
-    auto const& thisPosition = node1->getTilePosition();
-
-    auto diff = jt::Vector2f { static_cast<float>(position2.x) - thisPosition.x,
-        static_cast<float>(position2.y) - thisPosition.y };
-    return jt::MathHelper::qlength(diff);
+    auto const diff = jt::Vector2f { static_cast<float>(position2.x) - position1.x,
+        static_cast<float>(position2.y) - position1.y };
+    return jt::MathHelper::length(diff);
 }
 
-NodeT findClosestNodeTo(std::vector<std::weak_ptr<jt::pathfinder::NodeInterface>>& toCheck,
-    jt::Vector2u const& endPosition)
-{
-    if (toCheck.empty()) {
-        throw std::invalid_argument { "cannot find closestNodeToEnd because no nodes given." };
-    }
-
-    auto minDistance = std::numeric_limits<float>::max();
-    NodeT closestNode = nullptr;
-
-    for (auto n : toCheck) {
-        auto currentNode = n.lock();
-        if (!currentNode) {
-            throw std::invalid_argument { "invalid currentNode in findClosetNodeToEnd" };
-        }
-
-        auto currentDistance = calculateDistance(currentNode, endPosition);
-        if (currentDistance < minDistance) {
-            minDistance = currentDistance;
-            closestNode = currentNode;
+struct OpenEntry {
+    float estimate { 0.0f };
+    float cost { 0.0f };
+    NodeT node { nullptr };
+};
+
+struct OpenEntryCompare {
+    bool operator()(OpenEntry const& a, OpenEntry const& b) const
+    {
+        // on equal estimates prefer the node closer to the goal, which expands fewer nodes
+        if (a.estimate == b.estimate) {
+            return a.cost < b.cost;
         }
+        return a.estimate > b.estimate;
     }
+};
 
-    std::vector<std::weak_ptr<jt::pathfinder::NodeInterface>> newToCheck;
-    for (auto n : toCheck) {
-        if (n.lock() != closestNode) {
-            newToCheck.push_back(n);
-        }
-    }
-
-    toCheck = newToCheck;
-    return closestNode;
-}
-
-void setNeighbourValue(
-    NodeT const& currentNode, std::shared_ptr<jt::pathfinder::NodeInterface> const& neighbour_node)
-{
-    auto const dist = calculateDistance(neighbour_node, currentNode->getTilePosition());
-    auto const newValue = dist + currentNode->getValue();
+struct SearchState {
+    float cost { 0.0f };
+    NodeT parent { nullptr };
+    bool closed { false };
+};
 
-    float const oldValue = neighbour_node->getValue();
-    if (oldValue == -1.0 || oldValue > newValue) {
-        neighbour_node->setValue(newValue);
-    }
-}
+} // namespace
 
-void addNeighboursToToCheck(
-    NodeT const& currentNode, std::vector<std::weak_ptr<jt::pathfinder::NodeInterface>>& toCheck)
+std::vector<NodeT> jt::pathfinder::calculatePath(NodeT const& start, NodeT const& end)
 {
-    for (auto n : currentNode->getNeighbours()) {
-        auto neighbour_node = n.lock();
-        if (!neighbour_node) {
-            throw std::invalid_argument { "deleted node in pathfinding" };
-        }
-        if (neighbour_node->wasVisited()) {
-            continue;
-        }
-        setNeighbourValue(currentNode, neighbour_node);
-
-        toCheck.push_back(n);
+    JT_PROFILE_ZONE("jt::pathfinder::calculatePath");
+    if (start == end) {
+        return std::vector<NodeT> {};
     }
-}
 
-bool calculateNodeValuesFromEndToStart(NodeT const& start, NodeT const& end)
-{
+    // A* from end to start, so that following the parents from start yields the path in order.
+    // Node values are set to the cost to reach end, as before.
     auto const& startPosition = start->getTilePosition();
+    std::unordered_map<NodeInterface*, SearchState> states;
+    std::priority_queue<OpenEntry, std::vector<OpenEntry>, OpenEntryCompare> open;
 
-    end->visit();
+    states[end.get()] = SearchState { 0.0f, nullptr, false };
     end->setValue(0.0f);
-
-    std::vector<std::weak_ptr<jt::pathfinder::NodeInterface>> toCheck;
-    addNeighboursToToCheck(end, toCheck);
-
-    while (true) {
-        if (toCheck.empty()) {
-            std::cout << "no path found\n";
-            return false;
-        }
-
-        auto node = findClosestNodeTo(toCheck, startPosition);
-        if (!node) {
-            throw std::invalid_argument { "deleted node in pathfinding" };
-        }
-
-        node->visit();
-        if (node == start) {
-            break;
-        }
-
-        addNeighboursToToCheck(node, toCheck);
-    }
-    return true;
-}
-
-NodeT findNeighbourWithSmallestValue(NodeT const& current)
-{
-    auto minValue = std::numeric_limits<float>::max();
-    NodeT minNode = nullptr;
-    for (auto n : current->getNeighbours()) {
-        auto node = n.lock();
-        auto currentValue = node->getValue();
-        if (currentValue == -1) {
+    open.push(OpenEntry { calculateDistance(end->getTilePosition(), startPosition), 0.0f, end });
+
+    while (!open.empty()) {
+        auto const entry = open.top();
+        open.pop();
+        auto& state = states[entry.node.get()];
+        // outdated entries are skipped instead of updated in place
+        if (state.closed || entry.cost > state.cost) {
             continue;
         }
-        if (currentValue <= minValue) {
-            minValue = currentValue;
-            minNode = node;
+        state.closed = true;
+        entry.node->visit();
+
+        if (entry.node == start) {
+            std::vector<NodeT> nodes;
+            for (auto current = start; current != nullptr;
+                 current = states[current.get()].parent) {
+                nodes.push_back(current);
+            }
+            return nodes;
         }
-    }
-    return minNode;
-}
 
-} // namespace
-
-std::vector<NodeT> jt::pathfinder::calculatePath(NodeT const& start, NodeT const& end)
-{
-    ZoneScopedN("jt::pathfinder::calculatePath");
-    if (start == end) {
-        return std::vector<NodeT> {};
-    }
-    if (!calculateNodeValuesFromEndToStart(start, end)) {
-        return std::vector<NodeT> {};
-    }
-    auto current = start;
-    std::vector<NodeT> nodes;
-
-    nodes.push_back(current);
-
-    while (current != end) {
-        current = findNeighbourWithSmallestValue(current);
-        nodes.push_back(current);
+        auto const& currentPosition = entry.node->getTilePosition();
+        for (auto const& n : entry.node->getNeighbours()) {
+            auto neighbour = n.lock();
+            if (!neighbour) {
+                throw std::invalid_argument { "deleted node in pathfinding" };
+            }
+            auto const newCost
+                = entry.cost + calculateDistance(currentPosition, neighbour->getTilePosition());
+            auto const it = states.find(neighbour.get());
+            if (it != states.end() && (it->second.closed || it->second.cost <= newCost)) {
+                continue;
+            }
+            states[neighbour.get()] = SearchState { newCost, entry.node, false };
+            neighbour->setValue(newCost);
+            open.push(OpenEntry {
+                newCost + calculateDistance(neighbour->getTilePosition(), startPosition), newCost,
+                neighbour });
+        }
     }
 
-    return nodes;
+    std::cout << "no path found\n";
+    return std::vector<NodeT> {};
 }
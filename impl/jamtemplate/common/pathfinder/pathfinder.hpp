@@ -10,6 +10,11 @@ namespace pathfinder {
 
 using NodeT = std::shared_ptr<NodeInterface>;
 
+/// Calculate the shortest path between two nodes of a node graph using A*. For tile based maps,
+/// prefer GridPathfinder on a NavigationGrid, which does not allocate per search.
+/// \param start the start node
+/// \param end the end node
+/// \return the nodes of the path from start to end. Empty if start == end or no path exists.
 std::vector<NodeT> calculatePath(NodeT const& start, NodeT const& end);
 
 } // namespace pathfinder
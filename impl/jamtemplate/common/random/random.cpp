@@ -5,6 +5,8 @@
 #include <stdexcept>
 
 std::default_random_engine jt::Random::m_engine;
+unsigned int jt::Random::m_seed { std::default_random_engine::default_seed };
+bool jt::Random::m_isSeedPinned { false };
 
 int jt::Random::getInt(int min, int max)
 {
@@ -62,10 +64,28 @@ jt::Vector2f jt::Random::getRandomPointOnCircle(float radius)
     return jt::VectorFactory::fromPolar(radius, angle);
 }
 
-void jt::Random::setSeed(unsigned int s) { m_engine.seed(s); }
+void jt::Random::setSeed(unsigned int s)
+{
+    if (m_isSeedPinned) {
+        return;
+    }
+    m_seed = s;
+    m_engine.seed(s);
+}
 
 void jt::Random::useTimeAsRandomSeed() { setSeed(static_cast<unsigned int>(time(nullptr))); }
 
+unsigned int jt::Random::getSeed() noexcept { return m_seed; }
+
+void jt::Random::pinSeed(unsigned int s)
+{
+    m_isSeedPinned = false;
+    setSeed(s);
+    m_isSeedPinned = true;
+}
+
+void jt::Random::unpinSeed() noexcept { m_isSeedPinned = false; }
+
 jt::Color jt::Random::getRandomColorHSV(
     float hmin, float hmax, float smin, float smax, float vmin, float vmax)
 {
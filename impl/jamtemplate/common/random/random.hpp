@@ -64,15 +64,29 @@ public:
     /// \return random point on circle
     static jt::Vector2f getRandomPointOnCircle(float radius);
 
-    /// Set the seed of the rng
+    /// Set the seed of the rng. Ignored while the seed is pinned.
     /// \param s seed value
     static void setSeed(unsigned int s);
 
-    /// Use the current time as the random seed
+    /// Use the current time as the random seed. Ignored while the seed is pinned.
     static void useTimeAsRandomSeed();
 
+    /// Get the seed the rng was seeded with last
+    /// \return the seed value
+    static unsigned int getSeed() noexcept;
+
+    /// Seed the rng and ignore all further seeds until unpinSeed() is called, e.g. to replay a
+    /// recorded session with the same random numbers
+    /// \param s seed value
+    static void pinSeed(unsigned int s);
+
+    /// Accept new seeds via setSeed() again
+    static void unpinSeed() noexcept;
+
 private:
     static std::default_random_engine m_engine;
+    static unsigned int m_seed;
+    static bool m_isSeedPinned;
 };
 
 } // namespace jt
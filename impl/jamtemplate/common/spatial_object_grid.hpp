@@ -2,9 +2,12 @@
 #define JAMTEMPLATE_SPATIAL_OBJECT_GRID_HPP
 
 #include <game_object.hpp>
-#include <system_helper.hpp>
 #include <vector.hpp>
-#include <map>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 
@@ -25,105 +28,309 @@ constexpr CellIndex operator+(CellIndex const& a, CellIndex const& b)
 
 bool operator<(CellIndex const& a, CellIndex const& b);
 
+/// Hash a cell index (spatial hash with two large primes)
+/// \param idx the cell index
+/// \return hash value
+constexpr std::size_t hashCellIndex(CellIndex const& idx) noexcept
+{
+    return static_cast<std::size_t>((static_cast<std::uint32_t>(idx.x) * 73856093u)
+        ^ (static_cast<std::uint32_t>(idx.y) * 19349663u));
+}
+
 } // namespace detail
 
-// TODO possibly add removing objects (also consider for ObjectGroup)
+/// Grid that sorts objects into square cells of cellSize pixels for fast neighbor queries.
+///
+/// Cells are stored in a flat open-addressing hash table. Every object gets a stable handle, so it
+/// can be relocated or removed in O(1). Objects are relocated incrementally during update() when
+/// their position moved them to another cell. Cells without objects are dropped when the table is
+/// rehashed, so objects wandering around do not grow the table forever.
+///
+/// naming convention will differ here from the rest of the project as this is about to mimic the
+/// std::vector interface
 template <typename T, int cellSize>
 class SpatialObjectGrid : public jt::GameObject {
 public:
-    bool empty() const noexcept { return m_allObjects.empty(); };
+    using Handle = std::uint32_t;
+    static constexpr Handle invalidHandle { std::numeric_limits<Handle>::max() };
 
-    void push_back(std::weak_ptr<T> obj)
-    {
-        m_allObjects.push_back(obj);
+    bool empty() const noexcept { return m_numberOfObjects == 0u; };
+
+    std::size_t size() const noexcept { return m_numberOfObjects; };
 
+    /// Add an object to the grid
+    /// \param obj the object to add
+    /// \return handle that can be used to update or remove the object. If the object is already
+    /// stored in the cell of its current position, the existing handle is returned.
+    Handle push_back(std::weak_ptr<T> obj)
+    {
         auto const lockedObject = obj.lock();
-        auto const cellIndex = getCellIndex(lockedObject->getPosition());
+        if (!lockedObject) {
+            return invalidHandle;
+        }
+        auto const cell = getCellIndex(lockedObject->getPosition());
+        auto const existingHandle = findHandleInCell(cell, lockedObject.get());
+        if (existingHandle != invalidHandle) {
+            return existingHandle;
+        }
 
-        if (!m_cells.contains(cellIndex)) {
-            m_cells[cellIndex] = std::vector<std::weak_ptr<T>> {};
+        Handle handle { invalidHandle };
+        if (!m_freeHandles.empty()) {
+            handle = m_freeHandles.back();
+            m_freeHandles.pop_back();
+        } else {
+            handle = static_cast<Handle>(m_entries.size());
+            m_entries.emplace_back();
         }
 
-        m_cells.at(cellIndex).push_back(obj);
+        auto& entry = m_entries[handle];
+        entry.object = obj;
+        entry.alive = true;
+        insertIntoCell(handle, cell);
+        ++m_numberOfObjects;
+        return handle;
     };
 
-    std::vector<std::weak_ptr<T>> getObjectsAround(jt::Vector2f position, float distance) const
+    /// Remove an object from the grid. The handle becomes invalid and might be reused.
+    /// \param handle the handle returned by push_back
+    void remove(Handle handle)
+    {
+        if (!isValid(handle)) {
+            return;
+        }
+        removeFromCell(handle);
+        auto& entry = m_entries[handle];
+        entry.object.reset();
+        entry.alive = false;
+        m_freeHandles.push_back(handle);
+        --m_numberOfObjects;
+    }
+
+    /// Check if a handle refers to an object in the grid
+    /// \param handle the handle
+    /// \return true if valid, false otherwise
+    bool isValid(Handle handle) const noexcept
+    {
+        return handle < m_entries.size() && m_entries[handle].alive;
+    }
+
+    /// Move an object to the cell of its current position. This is done automatically for all
+    /// objects during update(), but can be called for individual objects in between.
+    /// \param handle the handle of the object
+    void updateObject(Handle handle)
+    {
+        if (!isValid(handle)) {
+            return;
+        }
+        auto const lockedObject = m_entries[handle].object.lock();
+        if (!lockedObject) {
+            remove(handle);
+            return;
+        }
+        auto const newIndex = getCellIndex(lockedObject->getPosition());
+        if (newIndex == m_entries[handle].cell) {
+            return;
+        }
+        removeFromCell(handle);
+        insertIntoCell(handle, newIndex);
+    }
+
+    /// Call visitor for every object in cells within distance around position. Does not allocate.
+    /// \param position the position to search around
+    /// \param distance the search distance (rounded up to full cells)
+    /// \param visitor callable accepting std::shared_ptr<T> const&
+    template <typename Visitor>
+    void forEachObjectAround(jt::Vector2f const& position, float distance, Visitor&& visitor) const
     {
+        if (m_numberOfObjects == 0u) {
+            return;
+        }
         auto const cellIndex = getCellIndex(position);
-        std::vector<std::weak_ptr<T>> objects {};
-        auto const offsets = getOffsets(distance);
-        for (auto const& offset : offsets) {
-            auto const currentIndex = cellIndex + offset;
+        int const distanceInCells { static_cast<int>(std::ceil(distance / cellSize)) };
 
-            if (!m_cells.contains(currentIndex)) {
-                continue;
+        for (auto x = -distanceInCells; x != distanceInCells + 1; ++x) {
+            for (auto y = -distanceInCells; y != distanceInCells + 1; ++y) {
+                auto const bucket = findBucket(cellIndex + detail::CellIndex { x, y });
+                if (bucket == invalidBucket) {
+                    continue;
+                }
+                for (auto const handle : m_buckets[bucket].handles) {
+                    auto const lockedObject = m_entries[handle].object.lock();
+                    if (lockedObject) {
+                        visitor(lockedObject);
+                    }
+                }
             }
-
-            objects.insert(
-                objects.end(), m_cells.at(currentIndex).begin(), m_cells.at(currentIndex).end());
         }
+    }
 
+    std::vector<std::weak_ptr<T>> getObjectsAround(jt::Vector2f position, float distance) const
+    {
+        std::vector<std::weak_ptr<T>> objects {};
+        forEachObjectAround(position, distance,
+            [&objects](std::shared_ptr<T> const& obj) { objects.push_back(obj); });
         return objects;
     }
 
     void doUpdate(float const /*elapsed*/) override
     {
-        std::unordered_set<std::shared_ptr<T>> objectsToReplace;
+        for (auto handle = Handle { 0u }; handle != static_cast<Handle>(m_entries.size());
+             ++handle) {
+            if (m_entries[handle].alive) {
+                updateObject(handle);
+            }
+        }
+    }
 
-        for (auto& kvp : m_cells) {
-            std::vector<std::shared_ptr<T>> currentObjects {};
-            std::vector<std::shared_ptr<T>> objectsToRemove {};
+private:
+    struct Entry {
+        std::weak_ptr<T> object {};
+        detail::CellIndex cell {};
+        // position of the handle inside the handles vector of the cell
+        std::size_t slotInCell { 0u };
+        bool alive { false };
+        bool inCell { false };
+    };
 
-            for (auto& object : kvp.second) {
-                auto const lockedObject = object.lock();
-                if (lockedObject == nullptr) {
-                    continue;
-                }
-                currentObjects.push_back(lockedObject);
-                auto const objectPosition = lockedObject->getPosition();
+    struct Bucket {
+        detail::CellIndex cell {};
+        bool used { false };
+        std::vector<Handle> handles {};
+    };
 
-                auto const oldIndex = kvp.first;
-                auto const newIndex = getCellIndex(objectPosition);
+    static constexpr std::size_t invalidBucket { std::numeric_limits<std::size_t>::max() };
 
-                if (oldIndex == newIndex) {
-                    continue;
-                }
+    std::vector<Entry> m_entries {};
+    std::vector<Handle> m_freeHandles {};
+    std::size_t m_numberOfObjects { 0u };
 
-                objectsToRemove.push_back(lockedObject);
-            }
-            jt::SystemHelper::remove_intersection(currentObjects, objectsToRemove);
+    // Buckets are only removed during rehash, so probing does not need tombstones. Buckets of
+    // cells that became empty stay in place until then. Size is a power of two.
+    std::vector<Bucket> m_buckets {};
+    std::size_t m_usedBuckets { 0u };
 
-            objectsToReplace.insert(objectsToRemove.begin(), objectsToRemove.end());
-            kvp.second = jt::SystemHelper::to_weak_pointers(currentObjects);
+    detail::CellIndex getCellIndex(jt::Vector2f const& position) const
+    {
+        return detail::CellIndex { static_cast<int>(std::floor(position.x / cellSize)),
+            static_cast<int>(std::floor(position.y / cellSize)) };
+    }
+
+    std::size_t findBucket(detail::CellIndex const& cell) const noexcept
+    {
+        if (m_buckets.empty()) {
+            return invalidBucket;
         }
+        auto const mask = m_buckets.size() - 1u;
+        for (auto i = detail::hashCellIndex(cell) & mask;; i = (i + 1u) & mask) {
+            auto const& bucket = m_buckets[i];
+            if (!bucket.used) {
+                return invalidBucket;
+            }
+            if (bucket.cell == cell) {
+                return i;
+            }
+        }
+    }
 
-        for (auto const& object : objectsToReplace) {
-            push_back(object);
+    std::size_t findOrCreateBucket(detail::CellIndex const& cell)
+    {
+        // keep load factor below 0.5
+        if ((m_usedBuckets + 1u) * 2u > m_buckets.size()) {
+            rehash(getNumberOfBucketsFor(getNumberOfNonEmptyBuckets() + 1u));
+        }
+        auto const mask = m_buckets.size() - 1u;
+        for (auto i = detail::hashCellIndex(cell) & mask;; i = (i + 1u) & mask) {
+            auto& bucket = m_buckets[i];
+            if (!bucket.used) {
+                bucket.used = true;
+                bucket.cell = cell;
+                ++m_usedBuckets;
+                return i;
+            }
+            if (bucket.cell == cell) {
+                return i;
+            }
         }
     }
 
-private:
-    std::vector<std::weak_ptr<T>> m_allObjects;
-    std::map<detail::CellIndex, std::vector<std::weak_ptr<T>>> m_cells;
+    std::size_t getNumberOfNonEmptyBuckets() const noexcept
+    {
+        return static_cast<std::size_t>(std::count_if(m_buckets.cbegin(), m_buckets.cend(),
+            [](auto const& bucket) { return bucket.used && !bucket.handles.empty(); }));
+    }
 
-    detail::CellIndex getCellIndex(jt::Vector2f const& position) const
+    static std::size_t getNumberOfBucketsFor(std::size_t numberOfCells) noexcept
     {
-        return detail::CellIndex { static_cast<int>(std::floor(position.x / cellSize)),
-            static_cast<int>(std::floor(position.y / cellSize)) };
+        // load factor of at most 0.25 after the rehash, so the next rehash is at least as many
+        // new cells away as there are cells now
+        std::size_t size { 64u };
+        while (numberOfCells * 4u > size) {
+            size *= 2u;
+        }
+        return size;
     }
 
-    std::vector<detail::CellIndex> getOffsets(float distance) const
+    // rebuild the table with newSize buckets, buckets of cells without objects are dropped
+    void rehash(std::size_t newSize)
     {
-        int const distanceInCells { static_cast<int>(std::ceil(distance / cellSize)) };
-        std::vector<detail::CellIndex> offsets;
+        std::vector<Bucket> oldBuckets(newSize);
+        std::swap(oldBuckets, m_buckets);
+        m_usedBuckets = 0u;
+        auto const mask = m_buckets.size() - 1u;
+        for (auto& oldBucket : oldBuckets) {
+            if (!oldBucket.used || oldBucket.handles.empty()) {
+                continue;
+            }
+            auto i = detail::hashCellIndex(oldBucket.cell) & mask;
+            while (m_buckets[i].used) {
+                i = (i + 1u) & mask;
+            }
+            m_buckets[i] = std::move(oldBucket);
+            ++m_usedBuckets;
+        }
+    }
 
-        for (auto x = -distanceInCells; x != distanceInCells + 1; ++x) {
-            for (auto y = -distanceInCells; y != distanceInCells + 1; ++y) {
-                offsets.push_back({ x, y });
+    Handle findHandleInCell(detail::CellIndex const& cell, T const* object) const
+    {
+        auto const bucket = findBucket(cell);
+        if (bucket == invalidBucket) {
+            return invalidHandle;
+        }
+        for (auto const handle : m_buckets[bucket].handles) {
+            if (m_entries[handle].object.lock().get() == object) {
+                return handle;
             }
         }
+        return invalidHandle;
+    }
+
+    void insertIntoCell(Handle handle, detail::CellIndex const& cell)
+    {
+        // a handle must only be stored in one cell, otherwise queries would return its object twice
+        if (m_entries[handle].inCell) {
+            removeFromCell(handle);
+        }
+        auto& handles = m_buckets[findOrCreateBucket(cell)].handles;
+        auto& entry = m_entries[handle];
+        entry.cell = cell;
+        entry.slotInCell = handles.size();
+        entry.inCell = true;
+        handles.push_back(handle);
+    }
 
-        return offsets;
+    void removeFromCell(Handle handle)
+    {
+        auto& entry = m_entries[handle];
+        if (!entry.inCell) {
+            return;
+        }
+        entry.inCell = false;
+        auto& handles = m_buckets[findBucket(entry.cell)].handles;
+        // swap and pop: move the last handle of the cell into the freed slot
+        auto const movedHandle = handles.back();
+        handles[entry.slotInCell] = movedHandle;
+        m_entries[movedHandle].slotInCell = entry.slotInCell;
+        handles.pop_back();
     }
 };
 
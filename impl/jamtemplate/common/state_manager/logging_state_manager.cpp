@@ -1,4 +1,13 @@
 #include "logging_state_manager.hpp"
+#include <log/log_macros.hpp>
+#include <array>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 2> stateManagerTags { "jt", "StateManager" };
+
+} // namespace
 
 jt::LoggingStateManager::LoggingStateManager(
     jt::StateManagerInterface& decoratee, jt::LoggerInterface& logger)
@@ -9,7 +18,7 @@ jt::LoggingStateManager::LoggingStateManager(
 
 std::shared_ptr<jt::GameState> jt::LoggingStateManager::getCurrentState()
 {
-    m_logger.verbose("getCurrentState", { "jt", "StateManager" });
+    JT_LOG_VERBOSE(m_logger, "getCurrentState", stateManagerTags);
     return m_decoratee.getCurrentState();
 }
 void jt::LoggingStateManager::setTransition(
@@ -43,34 +52,34 @@ void jt::LoggingStateManager::switchToStoredState(std::string const& identifier)
 
 void jt::LoggingStateManager::update(std::weak_ptr<jt::GameInterface> gameInstance, float elapsed)
 {
-    m_logger.verbose("update", { "jt", "StateManager" });
+    JT_LOG_VERBOSE(m_logger, "update", stateManagerTags);
     m_decoratee.update(gameInstance, elapsed);
 }
 
 void jt::LoggingStateManager::draw(std::shared_ptr<jt::RenderTargetInterface> rt)
 {
-    m_logger.verbose("draw", { "jt", "StateManager" });
+    JT_LOG_VERBOSE(m_logger, "draw", stateManagerTags);
     m_decoratee.draw(rt);
 }
 std::shared_ptr<jt::StateManagerTransitionInterface> jt::LoggingStateManager::getTransition()
 {
-    m_logger.verbose("getTransition", { "jt", "StateManager" });
+    JT_LOG_VERBOSE(m_logger, "getTransition", stateManagerTags);
     return m_decoratee.getTransition();
 }
 void jt::LoggingStateManager::storeCurrentState(std::string const& identifier)
 {
-    m_logger.debug("store gamestate '" + identifier + "'", { "jt", "StateManager" });
+    JT_LOG_DEBUG(m_logger, "store gamestate '" + identifier + "'", stateManagerTags);
     m_decoratee.storeCurrentState(identifier);
 }
 std::shared_ptr<jt::GameState> jt::LoggingStateManager::getStoredState(
     std::string const& identifier)
 {
-    m_logger.debug("retrieve gamestate '" + identifier + "'", { "jt", "StateManager" });
+    JT_LOG_DEBUG(m_logger, "retrieve gamestate '" + identifier + "'", stateManagerTags);
     return m_decoratee.getStoredState(identifier);
 }
 void jt::LoggingStateManager::clearStoredState(std::string const& identifier)
 {
-    m_logger.debug("clear gamestate '" + identifier + "'", { "jt", "StateManager" });
+    JT_LOG_DEBUG(m_logger, "clear gamestate '" + identifier + "'", stateManagerTags);
     m_decoratee.clearStoredState(identifier);
 }
 std::vector<std::string> jt::LoggingStateManager::getStoredStateIdentifiers() const
@@ -1,6 +1,7 @@
 ﻿#ifndef JAMTEMPLATE_SYSTEMHELPER_HPP
 #define JAMTEMPLATE_SYSTEMHELPER_HPP
 
+#include <random/random.hpp>
 #include <algorithm>
 #include <iterator>
 #include <memory>
@@ -111,7 +112,7 @@ Iter select_randomly(Iter start, Iter end, RandomGenerator& g)
     return start;
 }
 
-/// Select random entry between start and end
+/// Select random entry between start and end. Uses jt::Random, so the result depends on its seed.
 /// \tparam Iter
 /// \param start
 /// \param end
@@ -119,9 +120,12 @@ Iter select_randomly(Iter start, Iter end, RandomGenerator& g)
 template <typename Iter>
 Iter select_randomly(Iter start, Iter end)
 {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    return select_randomly(start, end, gen);
+    if (start == end) {
+        throw std::invalid_argument { "cannot pick randomly from empty container" };
+    }
+    auto const size = std::distance(start, end);
+    std::advance(start, jt::Random::getInt(0, static_cast<int>(size) - 1));
+    return start;
 }
 
 /// Select randomly from container
@@ -0,0 +1,170 @@
+#include "compiled_map.hpp"
+#include <trace_profiler.hpp>
+#include <stdexcept>
+
+jt::tilemap::CompiledMap::CompiledMap(std::string const& fileName)
+    : m_file { fileName }
+{
+    JT_PROFILE_ZONE("jt::tilemap::CompiledMap::CompiledMap");
+    validate(fileName);
+}
+
+std::string jt::tilemap::CompiledMap::getCompiledFileName(std::string const& jsonFileName)
+{
+    auto const extensionStart = jsonFileName.rfind('.');
+    auto const slash = jsonFileName.find_last_of("/\\");
+    if (extensionStart == std::string::npos
+        || (slash != std::string::npos && extensionStart < slash)) {
+        return jsonFileName + compiled::fileExtension;
+    }
+    return jsonFileName.substr(0, extensionStart) + compiled::fileExtension;
+}
+
+void jt::tilemap::CompiledMap::validate(std::string const& fileName)
+{
+    auto const fail = [&fileName](std::string const& reason) {
+        throw std::invalid_argument { "invalid compiled map '" + fileName + "': " + reason };
+    };
+
+    if (!isArrayInFile<compiled::FileHeader>(0u, 1u)) {
+        fail("file too small");
+    }
+    auto const& header = getArray<compiled::FileHeader>(0u, 1u).front();
+    if (header.magic != compiled::magic) {
+        fail("wrong magic number");
+    }
+    if (header.version != compiled::formatVersion) {
+        fail("unsupported version " + std::to_string(header.version));
+    }
+    if (header.stringsOffset > m_file.size()
+        || m_file.size() - header.stringsOffset < header.stringsSize) {
+        fail("string blob out of range");
+    }
+    if (!isArrayInFile<compiled::TilesetRecord>(header.tilesetOffset, header.tilesetCount)
+        || !isArrayInFile<compiled::LayerRecord>(header.layerOffset, header.layerCount)) {
+        fail("header out of range");
+    }
+    m_header = &header;
+
+    for (auto const& tileset : getTilesets()) {
+        if (!isStringInFile(tileset.imagePath)) {
+            fail("tileset image path out of range");
+        }
+    }
+    for (auto const& layer : getLayers()) {
+        if (!isStringInFile(layer.name)) {
+            fail("layer name out of range");
+        }
+        if (!isArrayInFile<compiled::ColliderRecord>(layer.colliderOffset, layer.colliderCount)) {
+            fail("colliders out of range");
+        }
+        if (layer.type == compiled::LayerType::Tile) {
+            if (!isArrayInFile<compiled::TileRecord>(layer.itemOffset, layer.itemCount)) {
+                fail("tiles out of range");
+            }
+            continue;
+        }
+        if (layer.type != compiled::LayerType::Object
+            || !isArrayInFile<compiled::ObjectRecord>(layer.itemOffset, layer.itemCount)) {
+            fail("objects out of range");
+        }
+        for (auto const& object : getObjects(layer)) {
+            if (!isStringInFile(object.type) || !isStringInFile(object.name)
+                || !isArrayInFile<compiled::PropertyRecord>(
+                    object.propertyOffset, object.propertyCount)) {
+                fail("object out of range");
+            }
+            for (auto const& property : getProperties(object)) {
+                if (!isStringInFile(property.name) || !isStringInFile(property.stringValue)) {
+                    fail("property out of range");
+                }
+            }
+        }
+    }
+}
+
+bool jt::tilemap::CompiledMap::isStringInFile(compiled::StringRef const& ref) const noexcept
+{
+    return ref.offset <= m_header->stringsSize
+        && m_header->stringsSize - ref.offset >= ref.length;
+}
+
+jt::Vector2u jt::tilemap::CompiledMap::getMapSizeInTiles() const noexcept
+{
+    return jt::Vector2u { m_header->mapWidthInTiles, m_header->mapHeightInTiles };
+}
+
+std::uint64_t jt::tilemap::CompiledMap::getSourceHash() const noexcept
+{
+    return static_cast<std::uint64_t>(m_header->sourceHashLow)
+        | (static_cast<std::uint64_t>(m_header->sourceHashHigh) << 32u);
+}
+
+jt::tilemap::compiled::SourceStamp jt::tilemap::CompiledMap::getSourceStamp() const noexcept
+{
+    return compiled::SourceStamp { static_cast<std::uint64_t>(m_header->sourceSizeLow)
+            | (static_cast<std::uint64_t>(m_header->sourceSizeHigh) << 32u),
+        static_cast<std::uint64_t>(m_header->sourceTimeLow)
+            | (static_cast<std::uint64_t>(m_header->sourceTimeHigh) << 32u) };
+}
+
+std::span<jt::tilemap::compiled::TilesetRecord const>
+jt::tilemap::CompiledMap::getTilesets() const noexcept
+{
+    return getArray<compiled::TilesetRecord>(m_header->tilesetOffset, m_header->tilesetCount);
+}
+
+std::span<jt::tilemap::compiled::LayerRecord const>
+jt::tilemap::CompiledMap::getLayers() const noexcept
+{
+    return getArray<compiled::LayerRecord>(m_header->layerOffset, m_header->layerCount);
+}
+
+jt::tilemap::compiled::LayerRecord const* jt::tilemap::CompiledMap::findLayer(
+    std::string_view name, compiled::LayerType type) const noexcept
+{
+    for (auto const& layer : getLayers()) {
+        if (layer.type == type && getString(layer.name) == name) {
+            return &layer;
+        }
+    }
+    return nullptr;
+}
+
+std::span<jt::tilemap::compiled::TileRecord const> jt::tilemap::CompiledMap::getTiles(
+    compiled::LayerRecord const& layer) const noexcept
+{
+    if (layer.type != compiled::LayerType::Tile) {
+        return {};
+    }
+    return getArray<compiled::TileRecord>(layer.itemOffset, layer.itemCount);
+}
+
+std::span<jt::tilemap::compiled::ObjectRecord const> jt::tilemap::CompiledMap::getObjects(
+    compiled::LayerRecord const& layer) const noexcept
+{
+    if (layer.type != compiled::LayerType::Object) {
+        return {};
+    }
+    return getArray<compiled::ObjectRecord>(layer.itemOffset, layer.itemCount);
+}
+
+std::span<jt::tilemap::compiled::PropertyRecord const> jt::tilemap::CompiledMap::getProperties(
+    compiled::ObjectRecord const& object) const noexcept
+{
+    return getArray<compiled::PropertyRecord>(object.propertyOffset, object.propertyCount);
+}
+
+std::span<jt::tilemap::compiled::ColliderRecord const> jt::tilemap::CompiledMap::getColliders(
+    compiled::LayerRecord const& layer) const noexcept
+{
+    return getArray<compiled::ColliderRecord>(layer.colliderOffset, layer.colliderCount);
+}
+
+std::string_view jt::tilemap::CompiledMap::getString(
+    compiled::StringRef const& ref) const noexcept
+{
+    return std::string_view { reinterpret_cast<char const*>(m_file.data())
+            + m_header->stringsOffset + ref.offset,
+        ref.length };
+}
@@ -0,0 +1,86 @@
+#ifndef JAMTEMPLATE_COMPILED_MAP_HPP
+#define JAMTEMPLATE_COMPILED_MAP_HPP
+
+#include <mapped_file.hpp>
+#include <tilemap/compiled_map_format.hpp>
+#include <vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace jt {
+namespace tilemap {
+
+/// Zero-copy reader for maps compiled by the level compiler. The file is memory mapped and all
+/// accessors return views into the mapped memory. The complete file is validated on construction,
+/// so accessors do not need to do any bounds checks.
+class CompiledMap {
+public:
+    /// Constructor, throws std::invalid_argument if the file is missing or invalid
+    /// \param fileName the compiled map file
+    explicit CompiledMap(std::string const& fileName);
+
+    /// Get the compiled map file name for a Tiled json map file name
+    /// \param jsonFileName file name of the json map, e.g. "assets/level_01.json"
+    /// \return file name of the compiled map, e.g. "assets/level_01.jtmap"
+    static std::string getCompiledFileName(std::string const& jsonFileName);
+
+    jt::Vector2u getMapSizeInTiles() const noexcept;
+
+    /// Get the hash of the json file the map was compiled from
+    /// \return the hash, see compiled::hashSource
+    std::uint64_t getSourceHash() const noexcept;
+
+    /// Get the size and modification time of the json file the map was compiled from
+    /// \return the stamp, see compiled::getSourceStamp
+    compiled::SourceStamp getSourceStamp() const noexcept;
+
+    std::span<compiled::TilesetRecord const> getTilesets() const noexcept;
+
+    std::span<compiled::LayerRecord const> getLayers() const noexcept;
+
+    /// Find a layer by name and type
+    /// \param name the layer name
+    /// \param type the layer type
+    /// \return the first matching layer or nullptr
+    compiled::LayerRecord const* findLayer(
+        std::string_view name, compiled::LayerType type) const noexcept;
+
+    std::span<compiled::TileRecord const> getTiles(
+        compiled::LayerRecord const& layer) const noexcept;
+    std::span<compiled::ObjectRecord const> getObjects(
+        compiled::LayerRecord const& layer) const noexcept;
+    std::span<compiled::PropertyRecord const> getProperties(
+        compiled::ObjectRecord const& object) const noexcept;
+    std::span<compiled::ColliderRecord const> getColliders(
+        compiled::LayerRecord const& layer) const noexcept;
+
+    std::string_view getString(compiled::StringRef const& ref) const noexcept;
+
+private:
+    jt::MappedFile m_file;
+    compiled::FileHeader const* m_header { nullptr };
+
+    template <typename T>
+    std::span<T const> getArray(std::uint32_t offset, std::uint32_t count) const noexcept
+    {
+        return std::span<T const> { reinterpret_cast<T const*>(m_file.data() + offset), count };
+    }
+
+    template <typename T>
+    bool isArrayInFile(std::uint32_t offset, std::uint32_t count) const noexcept
+    {
+        return offset % alignof(T) == 0u && offset <= m_file.size()
+            && (m_file.size() - offset) / sizeof(T) >= count;
+    }
+
+    bool isStringInFile(compiled::StringRef const& ref) const noexcept;
+    void validate(std::string const& fileName);
+};
+
+} // namespace tilemap
+} // namespace jt
+
+#endif // JAMTEMPLATE_COMPILED_MAP_HPP
@@ -0,0 +1,44 @@
+#include "compiled_map_format.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+std::uint64_t jt::tilemap::compiled::hashSource(void const* data, std::size_t size) noexcept
+{
+    // FNV-1a
+    auto const bytes = static_cast<unsigned char const*>(data);
+    std::uint64_t hash { 0xcbf29ce484222325ull };
+    for (std::size_t i = 0u; i != size; ++i) {
+        hash ^= static_cast<std::uint64_t>(bytes[i]);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+std::optional<jt::tilemap::compiled::SourceStamp> jt::tilemap::compiled::getSourceStamp(
+    std::string const& fileName)
+{
+    std::error_code ec;
+    auto const size = std::filesystem::file_size(fileName, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    auto const time = std::filesystem::last_write_time(fileName, ec);
+    if (ec) {
+        return std::nullopt;
+    }
+    return SourceStamp { static_cast<std::uint64_t>(size),
+        static_cast<std::uint64_t>(time.time_since_epoch().count()) };
+}
+
+std::optional<std::uint64_t> jt::tilemap::compiled::hashSourceFile(std::string const& fileName)
+{
+    std::ifstream file { fileName, std::ios::binary };
+    if (!file) {
+        return std::nullopt;
+    }
+    std::vector<char> const content { std::istreambuf_iterator<char> { file },
+        std::istreambuf_iterator<char> {} };
+    return hashSource(content.data(), content.size());
+}
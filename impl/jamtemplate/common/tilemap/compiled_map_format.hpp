@@ -0,0 +1,168 @@
+#ifndef JAMTEMPLATE_COMPILED_MAP_FORMAT_HPP
+#define JAMTEMPLATE_COMPILED_MAP_FORMAT_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <type_traits>
+
+namespace jt {
+namespace tilemap {
+namespace compiled {
+
+// Binary map format written by the level compiler and read by CompiledMap.
+//
+// The file starts with a FileHeader, all other records are referenced by absolute byte offsets.
+// Every record consists of 4 byte fields, so all records are 4 byte aligned and can be used in
+// place from a memory mapped file. Strings are stored as StringRef into a single string blob and
+// are not null terminated. All values are little endian.
+
+constexpr std::array<char, 4> magic { 'J', 'T', 'M', 'P' };
+
+/// Increase whenever the layout of any record changes
+constexpr std::uint32_t formatVersion { 3u };
+
+/// File extension of compiled maps, replaces the .json extension of the Tiled map
+constexpr char const* fileExtension { ".jtmap" };
+
+struct StringRef {
+    std::uint32_t offset { 0u };
+    std::uint32_t length { 0u };
+};
+
+struct FileHeader {
+    std::array<char, 4> magic {};
+    std::uint32_t version { 0u };
+    std::uint32_t mapWidthInTiles { 0u };
+    std::uint32_t mapHeightInTiles { 0u };
+    std::uint32_t tilesetOffset { 0u };
+    std::uint32_t tilesetCount { 0u };
+    std::uint32_t layerOffset { 0u };
+    std::uint32_t layerCount { 0u };
+    std::uint32_t stringsOffset { 0u };
+    std::uint32_t stringsSize { 0u };
+    /// hash of the Tiled json file the map was compiled from, see hashSource
+    std::uint32_t sourceHashLow { 0u };
+    std::uint32_t sourceHashHigh { 0u };
+    /// size and modification time of the Tiled json file, see getSourceStamp
+    std::uint32_t sourceSizeLow { 0u };
+    std::uint32_t sourceSizeHigh { 0u };
+    std::uint32_t sourceTimeLow { 0u };
+    std::uint32_t sourceTimeHigh { 0u };
+};
+
+struct TilesetRecord {
+    StringRef imagePath {};
+    std::uint32_t columns { 0u };
+    std::uint32_t tileCount { 0u };
+    std::uint32_t tileWidth { 0u };
+    std::uint32_t tileHeight { 0u };
+};
+
+enum class LayerType : std::uint32_t { Tile = 0u, Object = 1u };
+
+struct LayerRecord {
+    StringRef name {};
+    LayerType type { LayerType::Tile };
+    /// TileRecords for tile layers, ObjectRecords for object layers
+    std::uint32_t itemOffset { 0u };
+    std::uint32_t itemCount { 0u };
+    /// Colliders of blocked tiles, already refined with colliderSize. Only used for tile layers.
+    std::uint32_t colliderOffset { 0u };
+    std::uint32_t colliderCount { 0u };
+    float colliderSize { 0.0f };
+};
+
+struct TileRecord {
+    float x { 0.0f };
+    float y { 0.0f };
+    float width { 0.0f };
+    float height { 0.0f };
+    std::int32_t id { -1 };
+    std::uint32_t tileX { 0u };
+    std::uint32_t tileY { 0u };
+    std::uint32_t blocked { 0u };
+};
+
+struct ObjectRecord {
+    float x { 0.0f };
+    float y { 0.0f };
+    float width { 0.0f };
+    float height { 0.0f };
+    float rotation { 0.0f };
+    StringRef type {};
+    StringRef name {};
+    std::uint32_t propertyOffset { 0u };
+    std::uint32_t propertyCount { 0u };
+};
+
+enum class PropertyType : std::uint32_t { Bool = 0u, Float = 1u, Int = 2u, String = 3u };
+
+struct PropertyRecord {
+    StringRef name {};
+    PropertyType type { PropertyType::Bool };
+    /// value for Bool and Int properties
+    std::int32_t intValue { 0 };
+    float floatValue { 0.0f };
+    StringRef stringValue {};
+};
+
+struct ColliderRecord {
+    float left { 0.0f };
+    float top { 0.0f };
+    float width { 0.0f };
+    float height { 0.0f };
+};
+
+template <typename T>
+constexpr bool isValidRecord()
+{
+    return std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T> && alignof(T) == 4u
+        && sizeof(T) % 4u == 0u;
+}
+
+/// Size and modification time of a Tiled json file. If both are unchanged, the compiled map is
+/// up to date without reading the json file.
+struct SourceStamp {
+    std::uint64_t size { 0u };
+    /// ticks of the file clock, only comparable on the same machine
+    std::uint64_t modificationTime { 0u };
+
+    bool operator==(SourceStamp const& other) const = default;
+};
+
+/// Get the stamp of a Tiled json file
+/// \param fileName the json file name
+/// \return the stamp, or nothing if the file does not exist
+std::optional<SourceStamp> getSourceStamp(std::string const& fileName);
+
+/// Hash the content of a Tiled json file (FNV-1a). Used if the stamp of the json file changed,
+/// because copying the assets does not keep modification times.
+/// \param data the file content
+/// \param size the size of the file content in bytes
+/// \return the hash
+std::uint64_t hashSource(void const* data, std::size_t size) noexcept;
+
+/// Hash the content of a Tiled json file with hashSource
+/// \param fileName the json file name
+/// \return the hash, or nothing if the file cannot be read
+std::optional<std::uint64_t> hashSourceFile(std::string const& fileName);
+
+static_assert(std::endian::native == std::endian::little,
+    "compiled maps are stored little endian and used in place");
+static_assert(isValidRecord<FileHeader>());
+static_assert(isValidRecord<TilesetRecord>());
+static_assert(isValidRecord<LayerRecord>());
+static_assert(isValidRecord<TileRecord>());
+static_assert(isValidRecord<ObjectRecord>());
+static_assert(isValidRecord<PropertyRecord>());
+static_assert(isValidRecord<ColliderRecord>());
+
+} // namespace compiled
+} // namespace tilemap
+} // namespace jt
+
+#endif // JAMTEMPLATE_COMPILED_MAP_FORMAT_HPP
@@ -0,0 +1,237 @@
+#include "compiled_map_loader.hpp"
+#include <drawable_helpers.hpp>
+#include <pathfinder/node.hpp>
+#include <tilemap/tileson_loader.hpp>
+#include <trace_profiler.hpp>
+#include <filesystem>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+jt::tilemap::InfoRectProperties parseProperties(
+    jt::tilemap::CompiledMap const& map, jt::tilemap::compiled::ObjectRecord const& object)
+{
+    using jt::tilemap::compiled::PropertyType;
+    jt::tilemap::InfoRectProperties properties;
+    for (auto const& p : map.getProperties(object)) {
+        std::string const name { map.getString(p.name) };
+        if (p.type == PropertyType::Bool) {
+            properties.bools[name] = p.intValue != 0;
+        } else if (p.type == PropertyType::Float) {
+            properties.floats[name] = p.floatValue;
+        } else if (p.type == PropertyType::Int) {
+            properties.ints[name] = p.intValue;
+        } else if (p.type == PropertyType::String) {
+            properties.strings[name] = std::string { map.getString(p.stringValue) };
+        }
+    }
+    return properties;
+}
+
+template <typename Callback>
+bool forEachTileInLayer(
+    jt::tilemap::CompiledMap const& map, std::string const& layerName, Callback&& callback)
+{
+    bool foundLayer { false };
+    for (auto const& layer : map.getLayers()) {
+        if (layer.type != jt::tilemap::compiled::LayerType::Tile
+            || map.getString(layer.name) != layerName) {
+            continue;
+        }
+        foundLayer = true;
+        for (auto const& tile : map.getTiles(layer)) {
+            callback(tile);
+        }
+    }
+    return foundLayer;
+}
+
+jt::Vector2u getTileSize(jt::tilemap::CompiledMap const& map)
+{
+    auto const tilesets = map.getTilesets();
+    if (tilesets.empty()) {
+        throw std::invalid_argument { "compiled map does not contain a tileset" };
+    }
+    return jt::Vector2u { tilesets.front().tileWidth, tilesets.front().tileHeight };
+}
+
+} // namespace
+
+jt::tilemap::CompiledMapLoader::CompiledMapLoader(std::shared_ptr<CompiledMap const> map)
+    : m_map { std::move(map) }
+{
+    if (!m_map) {
+        throw std::invalid_argument { "CompiledMapLoader requires a map" };
+    }
+}
+
+std::vector<jt::tilemap::InfoRect> jt::tilemap::CompiledMapLoader::loadObjectsFromLayer(
+    std::string const& layerName)
+{
+    std::vector<InfoRect> objects;
+    for (auto const& layer : m_map->getLayers()) {
+        if (m_map->getString(layer.name) != layerName) {
+            continue;
+        }
+        auto const records = m_map->getObjects(layer);
+        objects.reserve(objects.size() + records.size());
+        for (auto const& o : records) {
+            objects.push_back(InfoRect { jt::Vector2f { o.x, o.y },
+                jt::Vector2f { o.width, o.height }, o.rotation,
+                std::string { m_map->getString(o.type) }, std::string { m_map->getString(o.name) },
+                parseProperties(*m_map, o) });
+        }
+    }
+    return objects;
+}
+
+std::vector<std::shared_ptr<jt::pathfinder::NodeInterface>>
+jt::tilemap::CompiledMapLoader::loadNodesFromLayer(std::string const& layerName)
+{
+    std::vector<std::shared_ptr<jt::pathfinder::NodeInterface>> nodes;
+    forEachTileInLayer(*m_map, layerName, [&nodes](compiled::TileRecord const& tile) {
+        auto node = std::make_shared<jt::pathfinder::Node>();
+        node->setPosition(jt::Vector2u { tile.tileX, tile.tileY });
+        node->setBlocked(tile.blocked != 0u);
+        nodes.push_back(node);
+    });
+    return nodes;
+}
+
+std::vector<std::shared_ptr<jt::tilemap::TileNode>>
+jt::tilemap::CompiledMapLoader::loadTileNodesFromLayer(std::string const& layerName,
+    jt::TextureManagerInterface& textureManager, bool dismissBlockedTiles)
+{
+    std::vector<std::shared_ptr<TileNode>> nodeTiles;
+    auto const nodes = loadNodesFromLayer(layerName);
+    if (nodes.empty()) {
+        return nodeTiles;
+    }
+    auto const ts = getTileSize(*m_map);
+    for (auto const& node : nodes) {
+        if (dismissBlockedTiles && node->getBlocked()) {
+            continue;
+        }
+        auto color = jt::Color { 1, 1, 1, 100 };
+        if (!node->getBlocked()) {
+            color = jt::Color { 255, 255, 255, 100 };
+        }
+        std::shared_ptr<jt::Shape> drawable = jt::dh::createShapeRect(
+            jt::Vector2f { static_cast<float>(ts.x - 1), static_cast<float>(ts.y - 1) }, color,
+            textureManager);
+        drawable->setPosition(jt::Vector2f { static_cast<float>(ts.x * node->getTilePosition().x),
+            static_cast<float>(ts.y * node->getTilePosition().y) });
+        nodeTiles.emplace_back(std::make_shared<jt::tilemap::TileNode>(drawable, node));
+    }
+    return nodeTiles;
+}
+
+std::tuple<std::vector<jt::tilemap::TileInfo>, std::vector<std::shared_ptr<jt::Sprite>>>
+jt::tilemap::CompiledMapLoader::loadTilesFromLayer(std::string const& layerName,
+    jt::TextureManagerInterface& textureManager, std::string const& tilesetPathPrefix)
+{
+    JT_PROFILE_ZONE("jt::tilemap::CompiledMapLoader::loadTilesFromLayer");
+    return std::tuple<std::vector<TileInfo>, std::vector<std::shared_ptr<jt::Sprite>>>(
+        loadTileInfosFromLayer(layerName),
+        createTilesetSprites(getTilesets(tilesetPathPrefix), textureManager));
+}
+
+std::vector<jt::tilemap::TileInfo> jt::tilemap::CompiledMapLoader::loadTileInfosFromLayer(
+    std::string const& layerName)
+{
+    std::vector<TileInfo> tiles;
+    auto const foundLayer
+        = forEachTileInLayer(*m_map, layerName, [&tiles](compiled::TileRecord const& tile) {
+              tiles.push_back(TileInfo { jt::Vector2f { tile.x, tile.y },
+                  jt::Vector2f { tile.width, tile.height }, tile.id });
+          });
+    if (!foundLayer) {
+        std::cerr << "Warning: no tileset layer found with name : " << layerName << std::endl;
+    }
+    return tiles;
+}
+
+std::vector<jt::tilemap::TilesetInfo> jt::tilemap::CompiledMapLoader::getTilesets(
+    std::string const& tilesetPathPrefix) const
+{
+    std::vector<TilesetInfo> tilesets;
+    for (auto const& tileset : m_map->getTilesets()) {
+        if (tileset.columns == 0u) {
+            continue;
+        }
+        tilesets.push_back(TilesetInfo {
+            tilesetPathPrefix + std::string { m_map->getString(tileset.imagePath) },
+            jt::Vector2u { tileset.tileWidth, tileset.tileHeight }, tileset.columns,
+            tileset.tileCount / tileset.columns });
+    }
+    return tilesets;
+}
+
+jt::TilemapCollisions jt::tilemap::CompiledMapLoader::loadCollisionsFromLayer(
+    std::string const& layerName)
+{
+    TilemapCollisions collisions;
+    auto const layer = m_map->findLayer(layerName, compiled::LayerType::Tile);
+    if (!layer) {
+        return collisions;
+    }
+    auto const ts = getTileSize(*m_map);
+    for (auto const& tile : m_map->getTiles(*layer)) {
+        if (tile.blocked == 0u) {
+            continue;
+        }
+        collisions.add(jt::Rectf { static_cast<float>(tile.tileX * ts.x),
+            static_cast<float>(tile.tileY * ts.y), static_cast<float>(ts.x),
+            static_cast<float>(ts.y) });
+    }
+
+    std::vector<jt::Rectf> refined;
+    refined.reserve(layer->colliderCount);
+    for (auto const& c : m_map->getColliders(*layer)) {
+        refined.push_back(jt::Rectf { c.left, c.top, c.width, c.height });
+    }
+    collisions.setPrecomputedRefinement(layer->colliderSize, std::move(refined));
+    return collisions;
+}
+
+jt::Vector2u jt::tilemap::CompiledMapLoader::getMapSizeInTiles() const
+{
+    return m_map->getMapSizeInTiles();
+}
+
+std::unique_ptr<jt::tilemap::TilemapLoaderInterface> jt::tilemap::createTilemapLoader(
+    jt::TilemapCacheInterface& cache, std::string const& fileName)
+{
+    auto const compiledFileName = CompiledMap::getCompiledFileName(fileName);
+    std::error_code ec;
+    if (!std::filesystem::exists(compiledFileName, ec)) {
+#ifndef JT_ENABLE_WEB
+        // levels are not compiled for the web build
+        std::cerr << "Warning: no compiled map '" << compiledFileName << "', loading '" << fileName
+                  << "' instead" << std::endl;
+#endif
+        return std::make_unique<TilesonLoader>(cache, fileName);
+    }
+    try {
+        auto map = std::make_shared<CompiledMap const>(compiledFileName);
+        // a shipped game might not contain the json file. If it exists, the compiled map needs
+        // to be built from its current content. Only hash the json file if its size or
+        // modification time changed, e.g. because the assets were copied.
+        auto const sourceStamp = compiled::getSourceStamp(fileName);
+        if (!sourceStamp || *sourceStamp == map->getSourceStamp()) {
+            return std::make_unique<CompiledMapLoader>(std::move(map));
+        }
+        auto const sourceHash = compiled::hashSourceFile(fileName);
+        if (!sourceHash || *sourceHash == map->getSourceHash()) {
+            return std::make_unique<CompiledMapLoader>(std::move(map));
+        }
+        std::cerr << "Warning: compiled map '" << compiledFileName << "' is out of date, loading '"
+                  << fileName << "' instead" << std::endl;
+    } catch (std::invalid_argument const& e) {
+        // e.g. compiled with an older format version, the json file is still usable
+        std::cerr << "Warning: " << e.what() << ", loading '" << fileName << "' instead"
+                  << std::endl;
+    }
+    return std::make_unique<TilesonLoader>(cache, fileName);
+}
@@ -0,0 +1,57 @@
+#ifndef JAMTEMPLATE_COMPILED_MAP_LOADER_HPP
+#define JAMTEMPLATE_COMPILED_MAP_LOADER_HPP
+
+#include <tilemap/compiled_map.hpp>
+#include <tilemap/tilemap_cache_interface.hpp>
+#include <tilemap/tilemap_loader_interface.hpp>
+#include <memory>
+#include <string>
+
+namespace jt {
+namespace tilemap {
+
+/// Loads tilemap layers from a map compiled by the level compiler. Collisions are returned with
+/// the colliders refined by the compiler, so refineColliders does not need to do any work.
+class CompiledMapLoader : public TilemapLoaderInterface {
+public:
+    /// Constructor
+    /// \param map the compiled map
+    explicit CompiledMapLoader(std::shared_ptr<CompiledMap const> map);
+
+    std::vector<InfoRect> loadObjectsFromLayer(std::string const& layerName) override;
+
+    std::vector<std::shared_ptr<TileNode>> loadTileNodesFromLayer(std::string const& layerName,
+        jt::TextureManagerInterface& textureManager, bool dismissBlockedTiles = false) override;
+
+    std::vector<std::shared_ptr<jt::pathfinder::NodeInterface>> loadNodesFromLayer(
+        std::string const& layerName) override;
+
+    std::tuple<std::vector<TileInfo>, std::vector<std::shared_ptr<jt::Sprite>>> loadTilesFromLayer(
+        std::string const& layerName, jt::TextureManagerInterface& textureManager,
+        std::string const& tilesetPathPrefix = "assets/") override;
+
+    std::vector<TileInfo> loadTileInfosFromLayer(std::string const& layerName) override;
+
+    std::vector<TilesetInfo> getTilesets(
+        std::string const& tilesetPathPrefix = "assets/") const override;
+
+    TilemapCollisions loadCollisionsFromLayer(std::string const& layerName) override;
+
+    jt::Vector2u getMapSizeInTiles() const override;
+
+private:
+    std::shared_ptr<CompiledMap const> m_map;
+};
+
+/// Create a loader for a Tiled json map. Uses the compiled map next to the json file if it exists
+/// and falls back to parsing the json file otherwise.
+/// \param cache the tilemap cache used for json maps
+/// \param fileName the file name of the json map
+/// \return the loader
+std::unique_ptr<TilemapLoaderInterface> createTilemapLoader(
+    jt::TilemapCacheInterface& cache, std::string const& fileName);
+
+} // namespace tilemap
+} // namespace jt
+
+#endif // JAMTEMPLATE_COMPILED_MAP_LOADER_HPP
@@ -0,0 +1,283 @@
+#include "compiled_map_writer.hpp"
+#include <tilemap/compiled_map_format.hpp>
+#include <tilemap/tilemap_collisions.hpp>
+#include <cstring>
+#include <fstream>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+
+using namespace jt::tilemap::compiled;
+
+class StringBlob {
+public:
+    StringRef add(std::string const& str)
+    {
+        auto const it = m_refs.find(str);
+        if (it != m_refs.end()) {
+            return it->second;
+        }
+        StringRef const ref { static_cast<std::uint32_t>(m_data.size()),
+            static_cast<std::uint32_t>(str.size()) };
+        m_data.insert(m_data.end(), str.begin(), str.end());
+        m_refs[str] = ref;
+        return ref;
+    }
+
+    std::vector<char> const& getData() const noexcept { return m_data; }
+
+private:
+    std::vector<char> m_data {};
+    std::unordered_map<std::string, StringRef> m_refs {};
+};
+
+struct LayerData {
+    LayerRecord record {};
+    std::vector<TileRecord> tiles {};
+    std::vector<ObjectRecord> objects {};
+    std::vector<ColliderRecord> colliders {};
+};
+
+class FileBuilder {
+public:
+    template <typename T>
+    std::uint32_t append(T const* records, std::size_t count)
+    {
+        auto const offset = static_cast<std::uint32_t>(m_data.size());
+        auto const bytes = sizeof(T) * count;
+        m_data.resize(m_data.size() + bytes);
+        if (bytes != 0u) {
+            std::memcpy(m_data.data() + offset, records, bytes);
+        }
+        return offset;
+    }
+
+    template <typename T>
+    std::uint32_t append(std::vector<T> const& records)
+    {
+        return append(records.data(), records.size());
+    }
+
+    template <typename T>
+    void overwrite(std::uint32_t offset, T const& record)
+    {
+        std::memcpy(m_data.data() + offset, &record, sizeof(T));
+    }
+
+    void padToAlignment()
+    {
+        while (m_data.size() % 4u != 0u) {
+            m_data.push_back(std::byte { 0u });
+        }
+    }
+
+    std::uint32_t getSize() const noexcept { return static_cast<std::uint32_t>(m_data.size()); }
+
+    std::vector<std::byte> release() { return std::move(m_data); }
+
+private:
+    std::vector<std::byte> m_data {};
+};
+
+PropertyRecord compileProperty(
+    std::string const& name, tson::Property& property, StringBlob& strings, bool& supported)
+{
+    PropertyRecord record {};
+    record.name = strings.add(name);
+    supported = true;
+    if (property.getType() == tson::Type::Boolean) {
+        record.type = PropertyType::Bool;
+        record.intValue = property.getValue<bool>() ? 1 : 0;
+    } else if (property.getType() == tson::Type::Float) {
+        record.type = PropertyType::Float;
+        record.floatValue = property.getValue<float>();
+    } else if (property.getType() == tson::Type::Int) {
+        record.type = PropertyType::Int;
+        record.intValue = property.getValue<int>();
+    } else if (property.getType() == tson::Type::String) {
+        record.type = PropertyType::String;
+        record.stringValue = strings.add(property.getValue<std::string>());
+    } else {
+        // other property types are ignored by TilesonLoader as well
+        supported = false;
+    }
+    return record;
+}
+
+void compileTileLayer(tson::Map& map, tson::Layer& layer, LayerData& data)
+{
+    data.record.type = LayerType::Tile;
+    jt::TilemapCollisions collisions;
+    auto const& tilesets = map.getTilesets();
+
+    for (auto& [pos, tile] : layer.getTileObjects()) {
+        TileRecord record {};
+        record.x = tile.getPosition().x;
+        record.y = tile.getPosition().y;
+        record.width = static_cast<float>(tile.getTile()->getTileSize().x);
+        record.height = static_cast<float>(tile.getTile()->getTileSize().y);
+        record.id = static_cast<std::int32_t>(tile.getTile()->getId()) - 1;
+        record.tileX = static_cast<std::uint32_t>(std::get<0>(pos));
+        record.tileY = static_cast<std::uint32_t>(std::get<1>(pos));
+
+        auto const blockedProperty = tile.getTile()->getProp("blocked");
+        record.blocked = (blockedProperty && blockedProperty->getValue<bool>()) ? 1u : 0u;
+        data.tiles.push_back(record);
+
+        if (record.blocked != 0u && !tilesets.empty()) {
+            auto const ts = tilesets.at(0).getTileSize();
+            collisions.add(jt::Rectf { static_cast<float>(std::get<0>(pos) * ts.x),
+                static_cast<float>(std::get<1>(pos) * ts.y), static_cast<float>(ts.x),
+                static_cast<float>(ts.y) });
+        }
+    }
+
+    if (!tilesets.empty()) {
+        data.record.colliderSize = static_cast<float>(tilesets.at(0).getTileSize().x);
+        collisions.refineColliders(data.record.colliderSize);
+        for (auto const& r : collisions.getRects()) {
+            data.colliders.push_back(ColliderRecord { r.left, r.top, r.width, r.height });
+        }
+    }
+}
+
+void compileObjectLayer(tson::Layer& layer, LayerData& data,
+    std::vector<PropertyRecord>& properties, StringBlob& strings)
+{
+    data.record.type = LayerType::Object;
+    for (auto& obj : layer.getObjects()) {
+        ObjectRecord record {};
+        record.x = static_cast<float>(obj.getPosition().x);
+        record.y = static_cast<float>(obj.getPosition().y);
+        record.width = static_cast<float>(obj.getSize().x);
+        record.height = static_cast<float>(obj.getSize().y);
+        record.rotation = obj.getRotation();
+        record.type = strings.add(obj.getType());
+        record.name = strings.add(obj.getName());
+        // index for now, converted to a byte offset once the file layout is known
+        record.propertyOffset = static_cast<std::uint32_t>(properties.size());
+        for (auto& [name, property] : obj.getProperties().getProperties()) {
+            bool supported { false };
+            auto const p = compileProperty(name, property, strings, supported);
+            if (supported) {
+                properties.push_back(p);
+                ++record.propertyCount;
+            }
+        }
+        data.objects.push_back(record);
+    }
+}
+
+} // namespace
+
+std::vector<std::byte> jt::tilemap::compileMap(
+    tson::Map& map, std::uint64_t sourceHash, compiled::SourceStamp const& sourceStamp)
+{
+    StringBlob strings;
+
+    std::vector<TilesetRecord> tilesets;
+    for (auto const& tileset : map.getTilesets()) {
+        TilesetRecord record {};
+        record.imagePath = strings.add(tileset.getImagePath().generic_string());
+        record.columns = static_cast<std::uint32_t>(tileset.getColumns());
+        record.tileCount = static_cast<std::uint32_t>(tileset.getTileCount());
+        record.tileWidth = static_cast<std::uint32_t>(tileset.getTileSize().x);
+        record.tileHeight = static_cast<std::uint32_t>(tileset.getTileSize().y);
+        tilesets.push_back(record);
+    }
+
+    std::vector<LayerData> layers;
+    std::vector<PropertyRecord> properties;
+    for (auto& layer : map.getLayers()) {
+        LayerData data {};
+        if (layer.getType() == tson::LayerType::TileLayer) {
+            compileTileLayer(map, layer, data);
+        } else if (layer.getType() == tson::LayerType::ObjectGroup) {
+            compileObjectLayer(layer, data, properties, strings);
+        } else {
+            continue;
+        }
+        data.record.name = strings.add(layer.getName());
+        layers.push_back(std::move(data));
+    }
+
+    FileBuilder file;
+    FileHeader header {};
+    header.magic = magic;
+    header.version = formatVersion;
+    header.mapWidthInTiles = static_cast<std::uint32_t>(map.getSize().x);
+    header.mapHeightInTiles = static_cast<std::uint32_t>(map.getSize().y);
+    header.sourceHashLow = static_cast<std::uint32_t>(sourceHash);
+    header.sourceHashHigh = static_cast<std::uint32_t>(sourceHash >> 32u);
+    header.sourceSizeLow = static_cast<std::uint32_t>(sourceStamp.size);
+    header.sourceSizeHigh = static_cast<std::uint32_t>(sourceStamp.size >> 32u);
+    header.sourceTimeLow = static_cast<std::uint32_t>(sourceStamp.modificationTime);
+    header.sourceTimeHigh = static_cast<std::uint32_t>(sourceStamp.modificationTime >> 32u);
+    file.append(&header, 1u);
+
+    header.tilesetOffset = file.append(tilesets);
+    header.tilesetCount = static_cast<std::uint32_t>(tilesets.size());
+
+    // layer records are written after their items are placed
+    header.layerCount = static_cast<std::uint32_t>(layers.size());
+    header.layerOffset = file.getSize();
+    for (auto const& l : layers) {
+        file.append(&l.record, 1u);
+    }
+
+    auto const propertiesOffset = file.append(properties);
+
+    for (auto i = 0u; i != layers.size(); ++i) {
+        auto& l = layers[i];
+        if (l.record.type == LayerType::Tile) {
+            l.record.itemOffset = file.append(l.tiles);
+            l.record.itemCount = static_cast<std::uint32_t>(l.tiles.size());
+        } else {
+            for (auto& o : l.objects) {
+                o.propertyOffset = propertiesOffset
+                    + o.propertyOffset * static_cast<std::uint32_t>(sizeof(PropertyRecord));
+            }
+            l.record.itemOffset = file.append(l.objects);
+            l.record.itemCount = static_cast<std::uint32_t>(l.objects.size());
+        }
+        l.record.colliderOffset = file.append(l.colliders);
+        l.record.colliderCount = static_cast<std::uint32_t>(l.colliders.size());
+        file.overwrite(
+            header.layerOffset + i * static_cast<std::uint32_t>(sizeof(LayerRecord)), l.record);
+    }
+
+    header.stringsOffset = file.append(strings.getData());
+    header.stringsSize = static_cast<std::uint32_t>(strings.getData().size());
+    file.padToAlignment();
+    file.overwrite(0u, header);
+    return file.release();
+}
+
+std::string jt::tilemap::compileMapFile(
+    std::string const& jsonFileName, std::string const& compiledFileName)
+{
+    // stamp before reading, so a change during compilation makes the compiled map stale
+    auto const sourceStamp = getSourceStamp(jsonFileName);
+    auto const sourceHash = hashSourceFile(jsonFileName);
+    if (!sourceStamp || !sourceHash) {
+        return "cannot read '" + jsonFileName + "'";
+    }
+    tson::Tileson parser;
+    auto map = parser.parse(jsonFileName);
+    if (!map || map->getStatus() != tson::ParseStatus::OK) {
+        return "tilemap json could not be parsed: '" + jsonFileName + "'";
+    }
+
+    auto const data = compileMap(*map, *sourceHash, *sourceStamp);
+    std::ofstream out { compiledFileName, std::ios::binary | std::ios::trunc };
+    if (!out) {
+        return "cannot write '" + compiledFileName + "'";
+    }
+    out.write(
+        reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+    if (!out) {
+        return "cannot write '" + compiledFileName + "'";
+    }
+    return "";
+}
@@ -0,0 +1,32 @@
+#ifndef JAMTEMPLATE_COMPILED_MAP_WRITER_HPP
+#define JAMTEMPLATE_COMPILED_MAP_WRITER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tilemap/compiled_map_format.hpp>
+#include <tileson.h>
+#include <vector>
+
+namespace jt {
+namespace tilemap {
+
+/// Convert a Tiled map into the compiled map format read by CompiledMap. Collisions of blocked
+/// tiles are refined with the tile size of the first tileset.
+/// \param map the parsed Tiled map
+/// \param sourceHash hash of the json file content, see compiled::hashSource
+/// \param sourceStamp size and modification time of the json file
+/// \return the content of the compiled map file
+std::vector<std::byte> compileMap(
+    tson::Map& map, std::uint64_t sourceHash, compiled::SourceStamp const& sourceStamp);
+
+/// Convert a Tiled json map file into a compiled map file
+/// \param jsonFileName the input file name
+/// \param compiledFileName the output file name
+/// \return empty string on success, error message otherwise
+std::string compileMapFile(std::string const& jsonFileName, std::string const& compiledFileName);
+
+} // namespace tilemap
+} // namespace jt
+
+#endif // JAMTEMPLATE_COMPILED_MAP_WRITER_HPP
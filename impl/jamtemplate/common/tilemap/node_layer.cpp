@@ -1,4 +1,5 @@
 #include "node_layer.hpp"
+#include <pathfinder/hierarchical_pathfinder.hpp>
 #include <pathfinder/node.hpp>
 #include <algorithm>
 #include <utility>
@@ -7,6 +8,19 @@ jt::tilemap::NodeLayer::NodeLayer(std::vector<std::shared_ptr<jt::tilemap::TileN
     : m_nodeTiles { std::move(nodeTiles) }
 {
     createNodeConnections();
+    for (auto& t : m_nodeTiles) {
+        t->getNode()->setBlockedChangedCallback([this](auto const& tilePosition, bool blocked) {
+            onBlockedChanged(tilePosition, blocked);
+        });
+    }
+}
+
+jt::tilemap::NodeLayer::~NodeLayer()
+{
+    // nodes are shared and might outlive this NodeLayer
+    for (auto& t : m_nodeTiles) {
+        t->getNode()->setBlockedChangedCallback(nullptr);
+    }
 }
 
 void jt::tilemap::NodeLayer::createNodeConnections()
@@ -58,6 +72,47 @@ std::vector<std::shared_ptr<jt::tilemap::TileNode>> jt::tilemap::NodeLayer::getA
     return m_nodeTiles;
 }
 
+jt::pathfinder::NavigationGrid jt::tilemap::NodeLayer::createNavigationGrid() const
+{
+    std::vector<std::shared_ptr<jt::pathfinder::NodeInterface>> nodes;
+    nodes.reserve(m_nodeTiles.size());
+    for (auto const& t : m_nodeTiles) {
+        nodes.push_back(t->getNode());
+    }
+    return jt::pathfinder::NavigationGrid { nodes };
+}
+
+void jt::tilemap::NodeLayer::addPathfinder(
+    std::weak_ptr<jt::pathfinder::HierarchicalPathfinder> pathfinder)
+{
+    m_pathfinders.push_back(std::move(pathfinder));
+}
+
+void jt::tilemap::NodeLayer::addNavigationGrid(std::weak_ptr<jt::pathfinder::NavigationGrid> grid)
+{
+    m_navigationGrids.push_back(std::move(grid));
+}
+
+void jt::tilemap::NodeLayer::onBlockedChanged(jt::Vector2u const& tilePosition, bool blocked)
+{
+    std::erase_if(m_pathfinders, [&tilePosition, blocked](auto const& weakPathfinder) {
+        auto const pathfinder = weakPathfinder.lock();
+        if (!pathfinder) {
+            return true;
+        }
+        pathfinder->setBlocked(tilePosition, blocked);
+        return false;
+    });
+    std::erase_if(m_navigationGrids, [&tilePosition, blocked](auto const& weakGrid) {
+        auto const grid = weakGrid.lock();
+        if (!grid) {
+            return true;
+        }
+        grid->setBlocked(tilePosition, blocked);
+        return false;
+    });
+}
+
 void jt::tilemap::NodeLayer::reset()
 {
     for (auto& t : m_nodeTiles) {
@@ -1,6 +1,7 @@
 #ifndef JAMTEMPLATE_NODELAYER_HPP
 #define JAMTEMPLATE_NODELAYER_HPP
 
+#include <pathfinder/navigation_grid.hpp>
 #include <texture_manager_interface.hpp>
 #include <tilemap/tile_node.hpp>
 #include <memory>
@@ -9,6 +10,10 @@
 #include <vector>
 
 namespace jt {
+namespace pathfinder {
+class HierarchicalPathfinder;
+} // namespace pathfinder
+
 namespace tilemap {
 
 class NodeLayer {
@@ -19,6 +24,15 @@ public:
     /// \param nodeTiles node tiles, either create them yourself or use TilesonLoader
     explicit NodeLayer(std::vector<std::shared_ptr<TileNode>> nodeTiles);
 
+    /// Destructor, removes the blocked changed callbacks from the nodes
+    ~NodeLayer();
+
+    // no copy, no move. The nodes call back into this NodeLayer.
+    NodeLayer(NodeLayer const&) = delete;
+    NodeLayer(NodeLayer&&) = delete;
+    NodeLayer& operator=(NodeLayer const&) = delete;
+    NodeLayer& operator=(NodeLayer&&) = delete;
+
     /// Get the tile at a specific position. Will return nullptr if no tile exists.
     /// \param pos the position in tile coordinates
     /// \return pointer to the tile (or nullptr)
@@ -26,11 +40,29 @@ public:
 
     std::vector<std::shared_ptr<TileNode>> getAllTiles();
 
+    /// Create a flat navigation grid from the current blocked state of all tiles
+    /// \return the navigation grid
+    jt::pathfinder::NavigationGrid createNavigationGrid() const;
+
+    /// Keep a pathfinder in sync with the tiles. Whenever TileNode::setBlocked or
+    /// Node::setBlocked changes a tile, HierarchicalPathfinder::setBlocked is called, until the
+    /// pathfinder is destroyed.
+    /// \param pathfinder the pathfinder, e.g. created from createNavigationGrid
+    void addPathfinder(std::weak_ptr<jt::pathfinder::HierarchicalPathfinder> pathfinder);
+
+    /// Keep a navigation grid in sync with the tiles, like addPathfinder. A FlowFieldCache using
+    /// this grid drops its fields on the next query after a tile changed.
+    /// \param grid the navigation grid, e.g. created from createNavigationGrid
+    void addNavigationGrid(std::weak_ptr<jt::pathfinder::NavigationGrid> grid);
+
     void reset();
 
 private:
     std::vector<std::shared_ptr<TileNode>> m_nodeTiles;
+    std::vector<std::weak_ptr<jt::pathfinder::HierarchicalPathfinder>> m_pathfinders;
+    std::vector<std::weak_ptr<jt::pathfinder::NavigationGrid>> m_navigationGrids;
     void createNodeConnections();
+    void onBlockedChanged(jt::Vector2u const& tilePosition, bool blocked);
 
     struct Vec2UHasher {
         std::size_t operator()(const jt::Vector2u& k) const
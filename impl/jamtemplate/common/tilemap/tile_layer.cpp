@@ -1,6 +1,9 @@
 ﻿#include "tile_layer.hpp"
 #include <drawable_helpers.hpp>
+#include <math_helper.hpp>
 #include <shape.hpp>
+#include <algorithm>
+#include <cmath>
 #include <memory>
 
 jt::tilemap::TileLayer::TileLayer(std::vector<jt::tilemap::TileInfo> const& tileInfo,
@@ -9,6 +12,7 @@ jt::tilemap::TileLayer::TileLayer(std::vector<jt::tilemap::TileInfo> const& tile
     , m_tiles { tileInfo }
 {
     calculateMapSize();
+    buildChunks();
 }
 
 void jt::tilemap::TileLayer::calculateMapSize()
@@ -35,49 +39,99 @@ jt::tilemap::TileLayer::TileLayer(std::tuple<std::vector<jt::tilemap::TileInfo>
 {
 }
 
-bool jt::tilemap::TileLayer::isTileVisible(jt::tilemap::TileInfo const& tile) const
+void jt::tilemap::TileLayer::buildChunks()
 {
-    if (m_screenSizeHint.x == 0 && m_screenSizeHint.y == 0) {
-        return true;
+    m_chunks.clear();
+    if (m_tiles.empty()) {
+        return;
     }
 
-    jt::Vector2f const camOffset = getStaticCamOffset();
-    if (tile.position.x + camOffset.x + tile.size.x < 0) {
-        return false;
-    }
-    if (tile.position.y + camOffset.y + tile.size.y < 0) {
-        return false;
+    auto const tileSize = m_tiles.at(0).size;
+    m_chunkSizeInPixel = jt::Vector2f { std::max(tileSize.x, 1.0f) * m_chunkSizeInTiles,
+        std::max(tileSize.y, 1.0f) * m_chunkSizeInTiles };
+    m_chunksX = std::max(1, static_cast<int>(std::ceil(m_mapSizeInPixel.x / m_chunkSizeInPixel.x)));
+    m_chunksY = std::max(1, static_cast<int>(std::ceil(m_mapSizeInPixel.y / m_chunkSizeInPixel.y)));
+    m_chunks.resize(static_cast<std::size_t>(m_chunksX) * static_cast<std::size_t>(m_chunksY));
+
+    for (auto i = 0u; i != m_tiles.size(); ++i) {
+        auto const& tile = m_tiles[i];
+        auto const cx = std::clamp(
+            static_cast<int>(std::floor(tile.position.x / m_chunkSizeInPixel.x)), 0, m_chunksX - 1);
+        auto const cy = std::clamp(
+            static_cast<int>(std::floor(tile.position.y / m_chunkSizeInPixel.y)), 0, m_chunksY - 1);
+        m_chunks[static_cast<std::size_t>(cx + cy * m_chunksX)].tileIndices.push_back(i);
     }
-    if (tile.position.x + camOffset.x >= m_screenSizeHint.x + tile.size.x) {
-        return false;
+}
+
+void jt::tilemap::TileLayer::rebuildBatches() const
+{
+    auto const origin = getOrigin();
+    auto const rotation = getRotation();
+    for (auto& chunk : m_chunks) {
+        chunk.batch.clear();
+        for (auto const tileIndex : chunk.tileIndices) {
+            auto const& tile = m_tiles[tileIndex];
+            auto const& sprite = m_tileSetSprites.at(tile.id);
+
+            SpriteBatch::QuadCorners corners { jt::Vector2f { 0.0f, 0.0f },
+                jt::Vector2f { tile.size.x, 0.0f }, jt::Vector2f { tile.size.x, tile.size.y },
+                jt::Vector2f { 0.0f, tile.size.y } };
+            for (auto& c : corners) {
+                c = jt::Vector2f { (c.x - origin.x) * m_scale.x, (c.y - origin.y) * m_scale.y };
+                if (rotation != 0.0f) {
+                    c = jt::MathHelper::rotateBy(c, rotation);
+                }
+                c += tile.position;
+            }
+
+            auto color = jt::colors::White;
+            if (m_colorFunction != nullptr) {
+                color = m_colorFunction(tile.position);
+            }
+            chunk.batch.add(*sprite, corners, color);
+        }
     }
-    if (tile.position.y + camOffset.y >= m_screenSizeHint.y + tile.size.y) {
-        return false;
+    m_batchDirty = false;
+}
+
+std::tuple<int, int, int, int> jt::tilemap::TileLayer::getVisibleChunkRange() const
+{
+    if (m_screenSizeHint.x == 0 && m_screenSizeHint.y == 0) {
+        return { 0, 0, m_chunksX, m_chunksY };
     }
-    return true;
+
+    // visible area in layer coordinates, extended by one tile in each direction
+    auto const tileSize = m_tiles.at(0).size;
+    auto const topLeft = -1.0f * (getStaticCamOffset() + m_position) - tileSize;
+    auto const bottomRight = topLeft + m_screenSizeHint + 2.0f * tileSize;
+
+    auto const x0 = static_cast<int>(std::floor(topLeft.x / m_chunkSizeInPixel.x));
+    auto const y0 = static_cast<int>(std::floor(topLeft.y / m_chunkSizeInPixel.y));
+    auto const x1 = static_cast<int>(std::floor(bottomRight.x / m_chunkSizeInPixel.x)) + 1;
+    auto const y1 = static_cast<int>(std::floor(bottomRight.y / m_chunkSizeInPixel.y)) + 1;
+
+    return { std::clamp(x0, 0, m_chunksX), std::clamp(y0, 0, m_chunksY),
+        std::clamp(x1, 0, m_chunksX), std::clamp(y1, 0, m_chunksY) };
 }
 
 void jt::tilemap::TileLayer::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    auto const posOffset = m_position + getShakeOffset() + getOffset();
-    for (auto const& tile : m_tiles) {
-        // optimization: don't draw tiles which are not visible in this frame
-        if (!isTileVisible(tile)) {
-            continue;
-        }
-
-        auto const pixelPosForTile = tile.position + posOffset;
-        auto const id = tile.id;
-        m_tileSetSprites.at(id)->setPosition(jt::Vector2f { pixelPosForTile.x, pixelPosForTile.y });
-        auto color = jt::colors::White;
-        if (m_colorFunction != nullptr) {
-            color = m_colorFunction(tile.position);
+    if (m_chunks.empty()) {
+        return;
+    }
+    if (m_batchDirty) {
+        rebuildBatches();
+    }
+    auto const posOffset = jt::MathHelper::castToInteger(
+        m_position + getShakeOffset() + getOffset() + getCamOffset());
+
+    // optimization: only draw chunks which are visible in this frame
+    auto const [x0, y0, x1, y1] = getVisibleChunkRange();
+    for (auto cy = y0; cy < y1; ++cy) {
+        for (auto cx = x0; cx < x1; ++cx) {
+            m_chunks[static_cast<std::size_t>(cx + cy * m_chunksX)].batch.draw(
+                sptr, posOffset, getBlendMode());
         }
-        m_tileSetSprites.at(id)->setColor(color);
-        m_tileSetSprites.at(id)->setScale(m_scale);
-        m_tileSetSprites.at(id)->update(0.0f);
-        m_tileSetSprites.at(id)->setBlendMode(getBlendMode());
-        m_tileSetSprites.at(id)->draw(sptr);
     }
 }
 
@@ -100,13 +154,7 @@ void jt::tilemap::TileLayer::doDrawOutline(
 
 void jt::tilemap::TileLayer::doUpdate(float /*elapsed*/) { }
 
-void jt::tilemap::TileLayer::setColor(jt::Color const& col)
-{
-    for (auto& ts : m_tileSetSprites) {
-        ts->setColor(col);
-    }
-    m_color = col;
-}
+void jt::tilemap::TileLayer::setColor(jt::Color const& col) { m_color = col; }
 
 jt::Color jt::tilemap::TileLayer::getColor() const { return m_color; }
 
@@ -124,28 +172,28 @@ jt::Rectf jt::tilemap::TileLayer::getLocalBounds() const
     return jt::Rectf { getPosition().x, getPosition().y, m_mapSizeInPixel.x, m_mapSizeInPixel.y };
 }
 
-void jt::tilemap::TileLayer::setScale(jt::Vector2f const& scale) { m_scale = scale; }
-
-jt::Vector2f jt::tilemap::TileLayer::getScale() const { return m_scale; }
-
-void jt::tilemap::TileLayer::setOriginInternal(jt::Vector2f const& origin)
+void jt::tilemap::TileLayer::setScale(jt::Vector2f const& scale)
 {
-    for (auto& ts : m_tileSetSprites) {
-        ts->setOrigin(origin);
+    if (scale.x != m_scale.x || scale.y != m_scale.y) {
+        m_batchDirty = true;
     }
+    m_scale = scale;
 }
 
-void jt::tilemap::TileLayer::doRotate(float rot)
+jt::Vector2f jt::tilemap::TileLayer::getScale() const { return m_scale; }
+
+void jt::tilemap::TileLayer::setOriginInternal(jt::Vector2f const& /*origin*/)
 {
-    for (auto& ts : m_tileSetSprites) {
-        ts->setRotation(rot);
-    }
+    m_batchDirty = true;
 }
 
+void jt::tilemap::TileLayer::doRotate(float /*rot*/) { m_batchDirty = true; }
+
 void jt::tilemap::TileLayer::setColorFunction(
     std::function<jt::Color(jt::Vector2f const&)> colorFunc)
 {
     m_colorFunction = colorFunc;
+    m_batchDirty = true;
 }
 
 jt::Vector2f jt::tilemap::TileLayer::getMapSizeInPixel() const { return m_mapSizeInPixel; }
@@ -5,11 +5,13 @@
 #include <pathfinder/node_interface.hpp>
 #include <render_target_layer.hpp>
 #include <sprite.hpp>
+#include <sprite_batch.hpp>
 #include <texture_manager_interface.hpp>
 #include <tilemap/info_rect.hpp>
 #include <tilemap/tile_info.hpp>
 #include <functional>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 namespace jt {
@@ -63,10 +65,14 @@ public:
 
     void doRotate(float /*rot*/) override;
 
-    void setColorFunction(std::function<jt::Color(jt::Vector2f const&)>);
+    /// Set a function that determines the color of each tile
+    ///
+    /// The function is evaluated once per tile whenever the tile batch is rebuilt, not every frame.
+    /// \param colorFunc function that maps a tile position to a color
+    void setColorFunction(std::function<jt::Color(jt::Vector2f const&)> colorFunc);
 
 private:
-    mutable std::vector<std::shared_ptr<jt::Sprite>> m_tileSetSprites {};
+    std::vector<std::shared_ptr<jt::Sprite>> m_tileSetSprites {};
     std::function<jt::Color(jt::Vector2f const&)> m_colorFunction { nullptr };
 
     std::vector<TileInfo> m_tiles {};
@@ -77,8 +83,25 @@ private:
 
     jt::Vector2f m_mapSizeInPixel { 0.0f, 0.0f };
 
-    bool isTileVisible(TileInfo const& tile) const;
+    // Tiles are sorted into square chunks, so that drawing only visits chunks overlapping the
+    // screen. Each chunk draws its tiles via one vertex array per tileset texture, which only needs
+    // to be rebuilt if anything affecting the tile vertices (scale, origin, rotation, colors)
+    // changes.
+    struct Chunk {
+        std::vector<std::size_t> tileIndices {};
+        jt::SpriteBatch batch {};
+    };
+    static constexpr int m_chunkSizeInTiles { 16 };
+    mutable std::vector<Chunk> m_chunks {};
+    jt::Vector2f m_chunkSizeInPixel { 0.0f, 0.0f };
+    int m_chunksX { 0 };
+    int m_chunksY { 0 };
+    mutable bool m_batchDirty { true };
+
     void calculateMapSize();
+    void buildChunks();
+    void rebuildBatches() const;
+    std::tuple<int, int, int, int> getVisibleChunkRange() const;
 };
 
 } // namespace tilemap
@@ -1,22 +1,32 @@
 #include "tilemap_cache.hpp"
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 #include <iostream>
 
 std::shared_ptr<tson::Map> jt::TilemapCache::get(std::string const& fileName) const
 {
-    ZoneScopedN("jt::TilemapCache::get");
-    if (!m_maps.contains(fileName)) {
-        tson::Tileson parser;
-
-        auto map = parser.parse(fileName);
-        if (map->getStatus() != tson::ParseStatus::OK) {
-            std::cerr << "tilemap json could not be parsed: '" << fileName << std::endl;
-            throw std::invalid_argument { "tilemap json could not be parsed." };
+    JT_PROFILE_ZONE("jt::TilemapCache::get");
+    {
+        std::lock_guard<std::mutex> const lock { m_mutex };
+        auto const it = m_maps.find(fileName);
+        if (it != m_maps.end()) {
+            return it->second;
         }
-        m_maps[fileName] = std::move(map);
     }
 
-    return m_maps.at(fileName);
+    tson::Tileson parser;
+    std::shared_ptr<tson::Map> map = parser.parse(fileName);
+    if (map->getStatus() != tson::ParseStatus::OK) {
+        std::cerr << "tilemap json could not be parsed: '" << fileName << std::endl;
+        throw std::invalid_argument { "tilemap json could not be parsed." };
+    }
+
+    std::lock_guard<std::mutex> const lock { m_mutex };
+    // another thread might have parsed the same map in the meantime
+    return m_maps.try_emplace(fileName, std::move(map)).first->second;
 }
 
-std::size_t jt::TilemapCache::getNumberOfMaps() const { return m_maps.size(); }
+std::size_t jt::TilemapCache::getNumberOfMaps() const
+{
+    std::lock_guard<std::mutex> const lock { m_mutex };
+    return m_maps.size();
+}
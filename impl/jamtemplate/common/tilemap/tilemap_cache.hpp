@@ -2,14 +2,19 @@
 #define JAMTEMPLATE_TILEMAP_CACHE_HPP
 
 #include <tilemap/tilemap_cache_interface.hpp>
+#include <map>
+#include <mutex>
 
 namespace jt {
+/// Tilemap cache that can be shared with worker threads. Maps are parsed outside of the lock, so
+/// parsing different maps in parallel does not block.
 class TilemapCache : public jt::TilemapCacheInterface {
 public:
     std::shared_ptr<tson::Map> get(std::string const& fileName) const override;
     std::size_t getNumberOfMaps() const;
 
 private:
+    mutable std::mutex m_mutex;
     mutable std::map<std::string, std::shared_ptr<tson::Map>> m_maps;
 };
 } // namespace jt
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <cassert>
 #include <limits>
+#include <utility>
 
 namespace {
 int getEntry(std::vector<int> const& vec, int x, int y, int width)
@@ -21,12 +22,30 @@ void setEntry(std::vector<int>& vec, int x, int y, int width, int value)
 
 } // namespace
 
-void jt::TilemapCollisions::add(jt::Rectf const& r) { m_rects.push_back(r); }
+void jt::TilemapCollisions::add(jt::Rectf const& r)
+{
+    m_rects.push_back(r);
+    m_precomputedRects.clear();
+    m_precomputedSize = 0.0f;
+}
 
 std::vector<jt::Rectf> const& jt::TilemapCollisions::getRects() const { return m_rects; }
 
+void jt::TilemapCollisions::setPrecomputedRefinement(
+    float size, std::vector<jt::Rectf> refinedRects)
+{
+    m_precomputedSize = size;
+    m_precomputedRects = std::move(refinedRects);
+}
+
 void jt::TilemapCollisions::refineColliders(float size)
 {
+    if (m_precomputedSize != 0.0f && m_precomputedSize == size) {
+        m_rects = std::move(m_precomputedRects);
+        m_precomputedRects.clear();
+        m_precomputedSize = 0.0f;
+        return;
+    }
     if (m_rects.empty()) {
         return;
     }
@@ -14,8 +14,16 @@ public:
 
     void refineColliders(float size);
 
+    /// Provide colliders that have already been refined, e.g. by the level compiler. A following
+    /// call to refineColliders with the same size will use them instead of refining again.
+    /// \param size the size the colliders were refined with
+    /// \param refinedRects the refined colliders
+    void setPrecomputedRefinement(float size, std::vector<jt::Rectf> refinedRects);
+
 private:
     std::vector<jt::Rectf> m_rects {};
+    float m_precomputedSize { 0.0f };
+    std::vector<jt::Rectf> m_precomputedRects {};
 };
 
 } // namespace jt
@@ -0,0 +1 @@
+#include "tilemap_loader_interface.hpp"
@@ -0,0 +1,96 @@
+#ifndef JAMTEMPLATE_TILEMAP_LOADER_INTERFACE_HPP
+#define JAMTEMPLATE_TILEMAP_LOADER_INTERFACE_HPP
+
+#include <pathfinder/node_interface.hpp>
+#include <sprite.hpp>
+#include <texture_manager_interface.hpp>
+#include <tilemap/info_rect.hpp>
+#include <tilemap/tile_info.hpp>
+#include <tilemap/tile_node.hpp>
+#include <tilemap/tilemap_collisions.hpp>
+#include <tilemap/tileset_info.hpp>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace jt {
+namespace tilemap {
+
+/// Interface for loading layers of a tilemap, independent of the file format.
+class TilemapLoaderInterface {
+public:
+    /// Load Objects from layer. Can directly be used to construct an ObjectLayer.
+    /// \param layerName the name of the object layer
+    /// \return Vector of InfoRects containing information about the objects
+    virtual std::vector<InfoRect> loadObjectsFromLayer(std::string const& layerName) = 0;
+
+    /// Load TileNodes from Layer. Can be used to construct a NodeLayer
+    /// \param layerName the name of the tile layer
+    /// \param textureManager the texture manager
+    /// \param dismissBlockedTiles true if blocked tiles should not be part of the returned vector
+    /// at all
+    /// \return the vector of TileNodes
+    virtual std::vector<std::shared_ptr<TileNode>> loadTileNodesFromLayer(
+        std::string const& layerName, jt::TextureManagerInterface& textureManager,
+        bool dismissBlockedTiles = false)
+        = 0;
+
+    /// Load NodeInterfaces from Layer (for pathfinding)
+    /// \param layerName the name of the tile layer
+    /// \return the vector of NodeInterfaces
+    virtual std::vector<std::shared_ptr<jt::pathfinder::NodeInterface>> loadNodesFromLayer(
+        std::string const& layerName)
+        = 0;
+
+    /// Load Tiles from Layer. Can be used to construct a TileLayer.
+    /// \param layerName the name of the tile layer.
+    /// \param textureManager the texture manager
+    /// \param tilesetPathPrefix the path where to look for the tileset image.
+    /// \return tuple of vectors for TileInfo and Sprites
+    virtual std::tuple<std::vector<TileInfo>, std::vector<std::shared_ptr<jt::Sprite>>>
+    loadTilesFromLayer(std::string const& layerName, jt::TextureManagerInterface& textureManager,
+        std::string const& tilesetPathPrefix = "assets/")
+        = 0;
+
+    /// Load the tiles of a layer without creating any drawables, e.g. on a worker thread. Use
+    /// createTilesetSprites() with getTilesets() to get the matching sprites.
+    /// \param layerName the name of the tile layer
+    /// \return the tiles of the layer
+    virtual std::vector<TileInfo> loadTileInfosFromLayer(std::string const& layerName) = 0;
+
+    /// Get the tilesets used by the map
+    /// \param tilesetPathPrefix the path where to look for the tileset images
+    /// \return the tilesets
+    virtual std::vector<TilesetInfo> getTilesets(
+        std::string const& tilesetPathPrefix = "assets/") const
+        = 0;
+
+    /// Load Collisions from layer. Will directly return a Tilemap Collision. Note: You most likely
+    /// want to call refineCollisions() on the returned object.
+    /// \param layerName the name of the tile layer
+    /// \return the Tilmap Collisions
+    virtual TilemapCollisions loadCollisionsFromLayer(std::string const& layerName) = 0;
+
+    /// Get the size of the map.
+    /// \return the size of the map in tiles.
+    virtual jt::Vector2u getMapSizeInTiles() const = 0;
+
+    /// Destructor
+    virtual ~TilemapLoaderInterface() = default;
+
+    // no copy, no move. Avoid slicing.
+    TilemapLoaderInterface(TilemapLoaderInterface const&) = delete;
+    TilemapLoaderInterface(TilemapLoaderInterface&&) = delete;
+    TilemapLoaderInterface& operator=(TilemapLoaderInterface const&) = delete;
+    TilemapLoaderInterface& operator=(TilemapLoaderInterface&&) = delete;
+
+protected:
+    // default constructor can only be called from derived classes
+    TilemapLoaderInterface() = default;
+};
+
+} // namespace tilemap
+} // namespace jt
+
+#endif // JAMTEMPLATE_TILEMAP_LOADER_INTERFACE_HPP
@@ -0,0 +1,22 @@
+#include "tileset_info.hpp"
+
+std::vector<std::shared_ptr<jt::Sprite>> jt::tilemap::createTilesetSprites(
+    std::vector<TilesetInfo> const& tilesets, jt::TextureManagerInterface& textureManager)
+{
+    std::vector<std::shared_ptr<jt::Sprite>> tileSetSprites;
+    for (auto const& tileset : tilesets) {
+        auto const w = static_cast<int>(tileset.tileSize.x);
+        auto const h = static_cast<int>(tileset.tileSize.y);
+        auto const columns = static_cast<int>(tileset.columns);
+        auto const rows = static_cast<int>(tileset.rows);
+        tileSetSprites.reserve(tileSetSprites.size() + tileset.columns * tileset.rows);
+        auto const handle = textureManager.getHandle(tileset.imageFileName);
+        for (int rowIndex = 0; rowIndex != rows; ++rowIndex) {
+            for (int columnIndex = 0; columnIndex != columns; ++columnIndex) {
+                tileSetSprites.push_back(std::make_shared<jt::Sprite>(
+                    handle, jt::Recti { columnIndex * w, rowIndex * h, w, h }, textureManager));
+            }
+        }
+    }
+    return tileSetSprites;
+}
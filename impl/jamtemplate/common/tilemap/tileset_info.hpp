@@ -0,0 +1,32 @@
+#ifndef JAMTEMPLATE_TILESET_INFO_HPP
+#define JAMTEMPLATE_TILESET_INFO_HPP
+
+#include <sprite.hpp>
+#include <texture_manager_interface.hpp>
+#include <vector.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace jt {
+namespace tilemap {
+
+struct TilesetInfo {
+    /// file name of the tileset image, including the tileset path prefix
+    std::string imageFileName { "" };
+    jt::Vector2u tileSize { 0u, 0u };
+    unsigned int columns { 0u };
+    unsigned int rows { 0u };
+};
+
+/// Create one sprite per tile of the tilesets. Sprite i corresponds to TileInfo id i.
+/// \param tilesets the tilesets
+/// \param textureManager the texture manager
+/// \return the sprites of all tiles
+std::vector<std::shared_ptr<jt::Sprite>> createTilesetSprites(
+    std::vector<TilesetInfo> const& tilesets, jt::TextureManagerInterface& textureManager);
+
+} // namespace tilemap
+} // namespace jt
+
+#endif // JAMTEMPLATE_TILESET_INFO_HPP
@@ -32,34 +32,6 @@ jt::tilemap::TileInfo parseSingleTile(tson::TileObject& tile)
     return jt::tilemap::TileInfo { pos, size, id };
 }
 
-std::vector<std::shared_ptr<jt::Sprite>> loadTileSetSprites(std::shared_ptr<tson::Map> map,
-    jt::TextureManagerInterface& textureManager, std::string const& tilesetPathPrefix = "assets/")
-{
-    std::vector<std::shared_ptr<jt::Sprite>> tileSetSprites;
-    std::size_t offset { 0 };
-    for (auto i = 0u; i != map->getTilesets().size(); ++i) {
-        auto const tileset = map->getTilesets().at(i);
-        auto const columns = tileset.getColumns();
-        auto const rows = tileset.getTileCount() / columns;
-        auto const ts = tileset.getTileSize();
-        auto const tilesetName = tilesetPathPrefix + tileset.getImagePath().string();
-
-        tileSetSprites.resize(offset + static_cast<size_t>(rows) * static_cast<size_t>(columns));
-        for (int rowIndex = 0; rowIndex != rows; ++rowIndex) {
-            for (int columnIndex = 0; columnIndex != columns; ++columnIndex) {
-                {
-                    tileSetSprites.at(offset + columnIndex + rowIndex * columns)
-                        = std::make_shared<jt::Sprite>(tilesetName,
-                            jt::Recti { columnIndex * ts.x, rowIndex * ts.y, ts.x, ts.y },
-                            textureManager);
-                }
-            }
-        }
-        offset = tileSetSprites.size();
-    }
-    return tileSetSprites;
-}
-
 std::vector<jt::tilemap::TileInfo> loadTiles(
     std::string const& layerName, std::shared_ptr<tson::Map> map)
 {
@@ -192,10 +164,31 @@ std::tuple<std::vector<jt::tilemap::TileInfo>, std::vector<std::shared_ptr<jt::S
 jt::tilemap::TilesonLoader::loadTilesFromLayer(std::string const& layerName,
     jt::TextureManagerInterface& textureManager, std::string const& tilesetPathPrefix)
 {
-    auto const map = m_tilemapCache.get(m_fileName);
-
     return std::tuple<std::vector<TileInfo>, std::vector<std::shared_ptr<jt::Sprite>>>(
-        loadTiles(layerName, map), loadTileSetSprites(map, textureManager, tilesetPathPrefix));
+        loadTileInfosFromLayer(layerName),
+        createTilesetSprites(getTilesets(tilesetPathPrefix), textureManager));
+}
+
+std::vector<jt::tilemap::TileInfo> jt::tilemap::TilesonLoader::loadTileInfosFromLayer(
+    std::string const& layerName)
+{
+    return loadTiles(layerName, m_tilemapCache.get(m_fileName));
+}
+
+std::vector<jt::tilemap::TilesetInfo> jt::tilemap::TilesonLoader::getTilesets(
+    std::string const& tilesetPathPrefix) const
+{
+    auto const map = m_tilemapCache.get(m_fileName);
+    std::vector<TilesetInfo> tilesets;
+    for (auto const& tileset : map->getTilesets()) {
+        auto const columns = tileset.getColumns();
+        auto const ts = tileset.getTileSize();
+        tilesets.push_back(TilesetInfo { tilesetPathPrefix + tileset.getImagePath().string(),
+            jt::Vector2u { static_cast<unsigned int>(ts.x), static_cast<unsigned int>(ts.y) },
+            static_cast<unsigned int>(columns),
+            static_cast<unsigned int>(tileset.getTileCount() / columns) });
+    }
+    return tilesets;
 }
 
 jt::TilemapCollisions jt::tilemap::TilesonLoader::loadCollisionsFromLayer(
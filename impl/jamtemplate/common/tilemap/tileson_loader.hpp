@@ -9,57 +9,40 @@
 #include <tilemap/tile_node.hpp>
 #include <tilemap/tilemap_cache_interface.hpp>
 #include <tilemap/tilemap_collisions.hpp>
+#include <tilemap/tilemap_loader_interface.hpp>
 #include <memory>
 #include <tuple>
 
 namespace jt {
 namespace tilemap {
 
-class TilesonLoader {
+class TilesonLoader : public TilemapLoaderInterface {
 public:
     /// Tileson loader Constructor
     /// \param cache the cache to be used (to avoid duplicate loading of the same json
     /// \param fileName the filename of the json file to be loaded
     TilesonLoader(jt::TilemapCacheInterface& cache, std::string const& fileName);
 
-    /// Load Objects from layer. Can directly be used to construct an ObjectLayer.
-    /// \param layerName the name of the object layer
-    /// \return Vector of InfoRects containing information about the objects
-    std::vector<InfoRect> loadObjectsFromLayer(std::string const& layerName);
+    std::vector<InfoRect> loadObjectsFromLayer(std::string const& layerName) override;
 
-    /// Load TileNodes from Layer. Can be used to construct a NodeLayer
-    /// \param layerName the name of the tile layer
-    /// \param textureManager the texture manager
-    /// \param dismissBlockedTiles true if blocked tiles should not be part of the returned vector
-    /// at all
-    /// \return the vector of TileNodes
     std::vector<std::shared_ptr<TileNode>> loadTileNodesFromLayer(std::string const& layerName,
-        jt::TextureManagerInterface& textureManager, bool dismissBlockedTiles = false);
+        jt::TextureManagerInterface& textureManager, bool dismissBlockedTiles = false) override;
 
-    /// Load NodeInterfaces from Layer (for pathfinding)
-    /// \param layerName the name of the tile layer
-    /// \return the vector of NodeInterfaces
     std::vector<std::shared_ptr<jt::pathfinder::NodeInterface>> loadNodesFromLayer(
-        std::string const& layerName);
+        std::string const& layerName) override;
 
-    /// Load Tiles from Layer. Can be used to construct a TileLayer.
-    /// \param layerName the name of the tile layer.
-    /// \param textureManager the texture manager
-    /// \param tilesetPathPrefix the path where to look for the tileset image.
-    /// \return tuple of vectors for TileInfo and Sprites
     std::tuple<std::vector<TileInfo>, std::vector<std::shared_ptr<jt::Sprite>>> loadTilesFromLayer(
         std::string const& layerName, jt::TextureManagerInterface& textureManager,
-        std::string const& tilesetPathPrefix = "assets/");
+        std::string const& tilesetPathPrefix = "assets/") override;
 
-    /// Load Collisions from layer. Will directly return a Tilemap Collision. Note: You most likely
-    /// want to call refineCollisions() on the returned object.
-    /// \param layerName the name of the tile layer
-    /// \return the Tilmap Collisions
-    TilemapCollisions loadCollisionsFromLayer(std::string const& layerName);
+    std::vector<TileInfo> loadTileInfosFromLayer(std::string const& layerName) override;
 
-    /// Get the size of the map.
-    /// \return the size of the map in tiles.
-    jt::Vector2u getMapSizeInTiles() const;
+    std::vector<TilesetInfo> getTilesets(
+        std::string const& tilesetPathPrefix = "assets/") const override;
+
+    TilemapCollisions loadCollisionsFromLayer(std::string const& layerName) override;
+
+    jt::Vector2u getMapSizeInTiles() const override;
 
 private:
     TilemapCacheInterface& m_tilemapCache;
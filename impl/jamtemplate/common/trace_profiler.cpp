@@ -0,0 +1,193 @@
+#include "trace_profiler.hpp"
+#include <circular_buffer.hpp>
+#include <nlohmann.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using TraceEventRing = jt::CircularBuffer<jt::TraceEvent, jt::TraceProfiler::eventsPerThread>;
+
+struct ThreadBuffer {
+    std::uint32_t threadId { 0u };
+    // only locked by the owning thread while recording, so it is uncontended unless a trace is
+    // written at the same time
+    std::mutex mutex {};
+    std::string name {};
+    std::unique_ptr<TraceEventRing> events { std::make_unique<TraceEventRing>() };
+};
+
+struct Registry {
+    std::mutex mutex {};
+    // buffers are kept after their thread finished, so the events are still part of the trace
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers {};
+    std::string atExitFileName {};
+};
+
+std::atomic<bool> isProfilerEnabled { false };
+
+Registry& getRegistry()
+{
+    static Registry registry {};
+    return registry;
+}
+
+ThreadBuffer& getThreadBuffer()
+{
+    thread_local std::shared_ptr<ThreadBuffer> const buffer = []() {
+        auto newBuffer = std::make_shared<ThreadBuffer>();
+        auto& registry = getRegistry();
+        std::lock_guard const lock { registry.mutex };
+        newBuffer->threadId = static_cast<std::uint32_t>(registry.buffers.size());
+        newBuffer->name = "thread " + std::to_string(newBuffer->threadId);
+        registry.buffers.push_back(newBuffer);
+        return newBuffer;
+    }();
+    return *buffer;
+}
+
+std::chrono::steady_clock::time_point getStartTime()
+{
+    static auto const startTime = std::chrono::steady_clock::now();
+    return startTime;
+}
+
+void writeRegisteredChromeTrace()
+{
+    auto const& fileName = getRegistry().atExitFileName;
+    if (!fileName.empty()) {
+        jt::TraceProfiler::writeChromeTrace(fileName);
+    }
+}
+
+} // namespace
+
+void jt::TraceProfiler::setEnabled(bool enabled) noexcept
+{
+    // fix the time origin before the first event is recorded
+    getStartTime();
+    isProfilerEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool jt::TraceProfiler::isEnabled() noexcept
+{
+    return isProfilerEnabled.load(std::memory_order_relaxed);
+}
+
+void jt::TraceProfiler::setThreadName(std::string const& name)
+{
+    auto& buffer = getThreadBuffer();
+    std::lock_guard const lock { buffer.mutex };
+    buffer.name = name;
+}
+
+std::int64_t jt::TraceProfiler::now() noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - getStartTime())
+        .count();
+}
+
+void jt::TraceProfiler::record(jt::TraceEvent const& event)
+{
+    auto& buffer = getThreadBuffer();
+    std::lock_guard const lock { buffer.mutex };
+    buffer.events->put(event);
+}
+
+void jt::TraceProfiler::markFrame()
+{
+    if (!isEnabled()) {
+        return;
+    }
+    record(jt::TraceEvent { "frame", now(), 0, true });
+}
+
+void jt::TraceProfiler::clear()
+{
+    auto& registry = getRegistry();
+    std::lock_guard const registryLock { registry.mutex };
+    for (auto& buffer : registry.buffers) {
+        std::lock_guard const lock { buffer->mutex };
+        buffer->events = std::make_unique<TraceEventRing>();
+    }
+}
+
+std::string jt::TraceProfiler::createChromeTrace()
+{
+    auto const toMicroseconds
+        = [](std::int64_t nanoseconds) { return static_cast<double>(nanoseconds) / 1000.0; };
+
+    nlohmann::json events = nlohmann::json::array();
+    auto& registry = getRegistry();
+    std::lock_guard const registryLock { registry.mutex };
+    for (auto& buffer : registry.buffers) {
+        std::lock_guard const lock { buffer->mutex };
+        events.push_back(nlohmann::json { { "ph", "M" }, { "name", "thread_name" }, { "pid", 1 },
+            { "tid", buffer->threadId }, { "args", { { "name", buffer->name } } } });
+
+        auto const& ring = *buffer->events;
+        for (auto i = ring.getHead(); i != ring.getHead() + ring.size(); ++i) {
+            auto const& e = ring[i];
+            nlohmann::json j { { "name", e.name }, { "pid", 1 }, { "tid", buffer->threadId },
+                { "ts", toMicroseconds(e.startInNanoseconds) } };
+            if (e.isInstant) {
+                j["ph"] = "i";
+                j["s"] = "g";
+            } else {
+                j["ph"] = "X";
+                j["dur"] = toMicroseconds(e.durationInNanoseconds);
+            }
+            events.push_back(j);
+        }
+    }
+
+    nlohmann::json trace;
+    trace["traceEvents"] = events;
+    trace["displayTimeUnit"] = "ms";
+    return trace.dump();
+}
+
+void jt::TraceProfiler::writeChromeTrace(std::string const& fileName)
+{
+    std::ofstream file { fileName };
+    if (!file) {
+        std::cerr << "cannot write trace file '" << fileName << "'" << std::endl;
+        return;
+    }
+    file << createChromeTrace();
+}
+
+void jt::TraceProfiler::writeChromeTraceAtExit(std::string const& fileName)
+{
+    auto& registry = getRegistry();
+    std::lock_guard const lock { registry.mutex };
+    if (registry.atExitFileName.empty()) {
+        std::atexit(writeRegisteredChromeTrace);
+    }
+    registry.atExitFileName = fileName;
+}
+
+jt::TraceZone::TraceZone(char const* name) noexcept
+    : m_name { name }
+{
+    if (jt::TraceProfiler::isEnabled()) {
+        m_startInNanoseconds = jt::TraceProfiler::now();
+    }
+}
+
+jt::TraceZone::~TraceZone()
+{
+    if (m_startInNanoseconds < 0) {
+        return;
+    }
+    auto const end = jt::TraceProfiler::now();
+    jt::TraceProfiler::record(
+        jt::TraceEvent { m_name, m_startInNanoseconds, end - m_startInNanoseconds, false });
+}
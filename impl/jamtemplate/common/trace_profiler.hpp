@@ -0,0 +1,108 @@
+#ifndef JAMTEMPLATE_TRACE_PROFILER_HPP
+#define JAMTEMPLATE_TRACE_PROFILER_HPP
+
+#include <tracy/Tracy.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace jt {
+
+/// A recorded scope or instant of one thread
+struct TraceEvent {
+    /// name of the zone, not owned
+    char const* name { nullptr };
+    std::int64_t startInNanoseconds { 0 };
+    std::int64_t durationInNanoseconds { 0 };
+    bool isInstant { false };
+};
+
+/// In-process profiler that does not need a profiler client. Scopes are recorded into a ring
+/// buffer per thread and can be written in the Chrome trace event format, which is understood by
+/// chrome://tracing and ui.perfetto.dev. Recording is disabled by default.
+class TraceProfiler {
+public:
+    /// Number of events kept per thread, older events are overwritten
+    static constexpr std::size_t eventsPerThread { 16384u };
+
+    /// Enable or disable recording
+    /// \param enabled true to record events
+    static void setEnabled(bool enabled) noexcept;
+
+    /// Check if events are recorded
+    /// \return true if enabled
+    static bool isEnabled() noexcept;
+
+    /// Set the name of the calling thread as displayed in the trace
+    /// \param name name of the thread
+    static void setThreadName(std::string const& name);
+
+    /// Time since the start of the profiler
+    /// \return time in nanoseconds
+    static std::int64_t now() noexcept;
+
+    /// Record an event for the calling thread
+    /// \param event the event. The name needs to outlive the profiler, typically a string literal.
+    static void record(jt::TraceEvent const& event);
+
+    /// Record the start of a frame
+    static void markFrame();
+
+    /// Remove all recorded events
+    static void clear();
+
+    /// Create the recorded events in the Chrome trace event format
+    /// \return json string
+    static std::string createChromeTrace();
+
+    /// Write the recorded events in the Chrome trace event format
+    /// \param fileName the file to write to
+    static void writeChromeTrace(std::string const& fileName);
+
+    /// Write the recorded events in the Chrome trace event format when the program exits
+    /// \param fileName the file to write to
+    static void writeChromeTraceAtExit(std::string const& fileName);
+};
+
+/// Records the lifetime of the object as a scope of the calling thread. Use via JT_PROFILE_ZONE.
+class TraceZone {
+public:
+    /// Constructor
+    /// \param name name of the zone, needs to outlive the profiler
+    explicit TraceZone(char const* name) noexcept;
+    ~TraceZone();
+
+    TraceZone(TraceZone const&) = delete;
+    TraceZone(TraceZone&&) = delete;
+    TraceZone& operator=(TraceZone const&) = delete;
+    TraceZone& operator=(TraceZone&&) = delete;
+
+private:
+    char const* m_name { nullptr };
+    std::int64_t m_startInNanoseconds { -1 };
+};
+
+} // namespace jt
+
+#define JT_PROFILE_CONCAT_IMPL(a, b) a##b
+#define JT_PROFILE_CONCAT(a, b) JT_PROFILE_CONCAT_IMPL(a, b)
+
+// Profile the enclosing scope with tracy and the built-in trace profiler. name needs to be a
+// string literal.
+#ifdef JT_ENABLE_TRACE_PROFILER
+#define JT_PROFILE_ZONE(name)                                                                      \
+    ZoneScopedN(name);                                                                             \
+    jt::TraceZone const JT_PROFILE_CONCAT(jt_trace_zone_, __LINE__) { name }
+#define JT_PROFILE_ZONE_COLOR(name, color)                                                         \
+    ZoneScopedNC(name, color);                                                                     \
+    jt::TraceZone const JT_PROFILE_CONCAT(jt_trace_zone_, __LINE__) { name }
+#define JT_PROFILE_FRAME_MARK                                                                      \
+    FrameMark;                                                                                     \
+    jt::TraceProfiler::markFrame()
+#else
+#define JT_PROFILE_ZONE(name) ZoneScopedN(name)
+#define JT_PROFILE_ZONE_COLOR(name, color) ZoneScopedNC(name, color)
+#define JT_PROFILE_FRAME_MARK FrameMark
+#endif
+
+#endif // JAMTEMPLATE_TRACE_PROFILER_HPP
@@ -1,11 +1,20 @@
 ﻿#include "game.hpp"
+#include <log/log_macros.hpp>
 
 #include <sdl_2_include.hpp>
+#include <array>
+#include <string_view>
 
 #ifdef JT_ENABLE_WEB
 #include <emscripten.h>
 #endif
 
+namespace {
+
+constexpr std::array<std::string_view, 2> gameTags { "jt", "game" };
+
+} // namespace
+
 namespace jt {
 
 Game::Game(GfxInterface& gfx, InputManagerInterface& input, AudioInterface& audio,
@@ -17,12 +26,12 @@ Game::Game(GfxInterface& gfx, InputManagerInterface& input, AudioInterface& audi
     m_logger.info("Connected gamepads: " + std::to_string(SDL_NumJoysticks()));
     TTF_Init();
 
-    m_logger.debug("Game constructor done", { "jt", "game" });
+    JT_LOG_DEBUG(m_logger, "Game constructor done", gameTags);
 }
 
 void Game::startGame(GameLoopFunctionPtr gameloop_function)
 {
-    m_logger.debug("start game", { "jt", "game" });
+    JT_LOG_DEBUG(m_logger, "start game", gameTags);
 #ifdef JT_ENABLE_WEB
     emscripten_set_main_loop(gameloop_function, 0, 1);
 #else
@@ -1,5 +1,7 @@
 #include "gfx_impl.hpp"
+#include <graphics/texture_manager_stats.hpp>
 #include <render_target_lib.hpp>
+#include <chrono>
 
 namespace jt {
 
@@ -19,7 +21,7 @@ GfxImpl::GfxImpl(RenderWindowInterface& window, CamInterface& cam)
 
     GfxImpl::createZLayer(0);
 
-    m_textureManager = TextureManagerImpl { m_target->get(0) };
+    m_textureManager = TextureManagerImpl { m_target->m_renderer };
 }
 
 RenderWindowInterface& GfxImpl::window() { return m_window; }
@@ -42,21 +44,40 @@ void GfxImpl::clear() { m_target->clearPixels(); }
 
 void GfxImpl::display()
 {
+    auto* const renderer = m_target->m_renderer.get();
     // Detach the texture
-    SDL_SetRenderTarget(m_target->m_renderer.get(), nullptr);
-    SDL_RenderClear(m_target->m_renderer.get());
-
-    for (auto& kvp : m_target->m_textures) {
-        // Now render the textures to our screen
-
-        SDL_Rect sourceRect { m_srcRect.left, m_srcRect.top, m_srcRect.width, m_srcRect.height };
-        SDL_Rect destRect { static_cast<int>(m_camera.getShakeOffset().x),
-            static_cast<int>(m_camera.getShakeOffset().y), m_destRect.width, m_destRect.height };
-        SDL_RenderCopyEx(m_target->m_renderer.get(), kvp.second.get(), &sourceRect, &destRect, 0,
-            nullptr, SDL_FLIP_NONE);
-        m_window.display();
-        SDL_RenderPresent(m_target->m_renderer.get());
+    SDL_SetRenderTarget(renderer, nullptr);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+    SDL_RenderClear(renderer);
+
+    SDL_Rect const sourceRect { m_srcRect.left, m_srcRect.top, m_srcRect.width, m_srcRect.height };
+    SDL_Rect const destRect { static_cast<int>(m_camera.getShakeOffset().x),
+        static_cast<int>(m_camera.getShakeOffset().y), m_destRect.width, m_destRect.height };
+
+    auto layerStats = m_compositorStats.layers.begin();
+    for (auto const& kvp : m_layerTextures) {
+        auto& stats = *layerStats++;
+        stats = m_target->getLayerStats(kvp.first);
+        // nothing was drawn to this layer, so it is still transparent
+        if (!stats.isCleared) {
+            continue;
+        }
+        auto const start = std::chrono::steady_clock::now();
+        SDL_RenderCopy(renderer, kvp.second.get(), &sourceRect, &destRect);
+        stats.isComposited = true;
+        stats.compositeTimeInSeconds
+            = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
     }
+
+    // draw the gui on top and present the frame exactly once
+    auto const presentStart = std::chrono::steady_clock::now();
+    m_window.display();
+    SDL_RenderPresent(renderer);
+    m_framePacing.onPresent(
+        std::chrono::duration<float>(std::chrono::steady_clock::now() - presentStart).count());
+    m_compositorStats.pacing = m_framePacing.getStats();
+
+    jt::TextureBindCounter::endFrame();
 }
 
 void GfxImpl::createZLayer(int z)
@@ -69,6 +90,10 @@ void GfxImpl::createZLayer(int z)
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
     SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
     m_target->add(z, texture);
+    m_layerTextures[z] = texture;
+    m_compositorStats.layers.resize(m_layerTextures.size());
 }
 
+CompositorStats GfxImpl::getCompositorStats() const { return m_compositorStats; }
+
 } // namespace jt
@@ -2,6 +2,7 @@
 #define JAMTEMPLATE_GFX_IMPL_HPP
 
 #include <cam_interface.hpp>
+#include <graphics/compositor_stats.hpp>
 #include <graphics/gfx_interface.hpp>
 #include <graphics/render_target_interface.hpp>
 #include <graphics/render_window_interface.hpp>
@@ -9,6 +10,8 @@
 #include <render_target_lib.hpp>
 #include <texture_manager_impl.hpp>
 #include <sdl_2_include.hpp>
+#include <map>
+#include <memory>
 #include <optional>
 
 namespace jt {
@@ -27,6 +30,8 @@ public:
 
     void createZLayer(int z) override;
 
+    jt::CompositorStats getCompositorStats() const override;
+
 private:
     RenderWindowInterface& m_window;
     CamInterface& m_camera;
@@ -35,6 +40,11 @@ private:
 
     jt::Recti m_srcRect;
     jt::Recti m_destRect;
+
+    /// layer textures in ascending z order, composited into the window once per frame
+    std::map<int, std::shared_ptr<SDL_Texture>> m_layerTextures {};
+    jt::CompositorStats m_compositorStats {};
+    jt::FramePacingCounter m_framePacing {};
 };
 
 } // namespace jt
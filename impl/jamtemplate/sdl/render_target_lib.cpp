@@ -1,4 +1,5 @@
 #include "render_target_lib.hpp"
+#include <chrono>
 #include <stdexcept>
 
 jt::RenderTarget::RenderTarget(std::shared_ptr<jt::RenderTargetLayer> renderer)
@@ -11,32 +12,68 @@ jt::RenderTarget::RenderTarget(std::shared_ptr<jt::RenderTargetLayer> renderer)
 
 std::shared_ptr<jt::RenderTargetLayer> jt::RenderTarget::get(int z)
 {
-    SDL_SetRenderTarget(m_renderer.get(), m_textures[z].get());
+    auto const it = m_layers.find(z);
+    if (it == m_layers.end()) [[unlikely]] {
+        return nullptr;
+    }
+    auto& layer = it->second;
+    if (!layer.stats.isCleared) {
+        clearLayer(layer);
+    } else {
+        SDL_SetRenderTarget(m_renderer.get(), layer.texture.get());
+    }
+    ++layer.stats.numberOfDrawRequests;
     return m_renderer;
 }
 
-void jt::RenderTarget::add(int z, std::shared_ptr<SDL_Texture> texture) { m_textures[z] = texture; }
+void jt::RenderTarget::add(int z, std::shared_ptr<SDL_Texture> texture)
+{
+    m_layers[z] = Layer { texture, false, jt::LayerStats { z } };
+    bool first { true };
+    for (auto& kvp : m_layers) {
+        kvp.second.isBackground = first;
+        first = false;
+    }
+}
 
 void jt::RenderTarget::clearPixels()
 {
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
 
-    // render to the small texture first
-    bool first { true };
-    for (auto& kvp : m_textures) {
-        SDL_SetRenderTarget(m_renderer.get(), kvp.second.get());
-        if (first) {
-            SDL_SetTextureAlphaMod(kvp.second.get(), 255);
-            // SDL does not like drawing to a complete transparent background, so the lowest z layer
-            // needs to be filled with alpha = 255.
-            SDL_SetRenderDrawColor(m_renderer.get(), 0, 0, 0, 255);
-            SDL_RenderClear(m_renderer.get());
-            first = false;
-        } else {
-            // The "upper" z layers need to be cleared transparently (alpha = 0) otherwise the
-            // layers below are not visible.
-            SDL_SetRenderDrawColor(m_renderer.get(), 0, 0, 0, 0);
-            SDL_RenderClear(m_renderer.get());
+    for (auto& kvp : m_layers) {
+        auto& layer = kvp.second;
+        layer.stats = jt::LayerStats { kvp.first };
+        if (layer.isBackground) {
+            clearLayer(layer);
         }
     }
 }
+
+jt::LayerStats jt::RenderTarget::getLayerStats(int z) const
+{
+    auto const it = m_layers.find(z);
+    if (it == m_layers.end()) {
+        return jt::LayerStats { z };
+    }
+    return it->second.stats;
+}
+
+void jt::RenderTarget::clearLayer(Layer& layer) const
+{
+    auto const start = std::chrono::steady_clock::now();
+    SDL_SetRenderTarget(m_renderer.get(), layer.texture.get());
+    if (layer.isBackground) {
+        SDL_SetTextureAlphaMod(layer.texture.get(), 255);
+        // SDL does not like drawing to a complete transparent background, so the lowest z layer
+        // needs to be filled with alpha = 255.
+        SDL_SetRenderDrawColor(m_renderer.get(), 0, 0, 0, 255);
+    } else {
+        // The "upper" z layers need to be cleared transparently (alpha = 0) otherwise the layers
+        // below are not visible.
+        SDL_SetRenderDrawColor(m_renderer.get(), 0, 0, 0, 0);
+    }
+    SDL_RenderClear(m_renderer.get());
+    layer.stats.isCleared = true;
+    layer.stats.clearTimeInSeconds
+        = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+}
@@ -1,6 +1,7 @@
 #ifndef JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 #define JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 
+#include <graphics/compositor_stats.hpp>
 #include <graphics/render_target_interface.hpp>
 #include <sdl_2_include.hpp>
 #include <memory>
@@ -10,15 +11,35 @@ namespace jt {
 class RenderTarget : public RenderTargetInterface {
 public:
     explicit RenderTarget(std::shared_ptr<jt::RenderTargetLayer> renderer = nullptr);
+
+    /// Get the renderer with the layer texture set as render target. The first request in a frame
+    /// clears the layer and marks it as used.
+    /// \param z the z value
+    /// \return the renderer or nullptr if no layer was created for z
     std::shared_ptr<jt::RenderTargetLayer> get(int z) override;
 
     void add(int z, std::shared_ptr<SDL_Texture> texture);
 
+    /// Start a new frame. Layers are cleared lazily on their first use in the frame, except for the
+    /// lowest layer, which is always cleared as it is the background of the window.
     void clearPixels();
 
+    /// Get the statistics of a layer since the last call to clearPixels()
+    /// \param z the z value
+    /// \return the statistics, without composite time
+    jt::LayerStats getLayerStats(int z) const;
+
     std::shared_ptr<SDL_Renderer> m_renderer { nullptr };
 
-    std::map<int, std::shared_ptr<SDL_Texture>> m_textures;
+private:
+    struct Layer {
+        std::shared_ptr<SDL_Texture> texture { nullptr };
+        bool isBackground { false };
+        jt::LayerStats stats {};
+    };
+    std::map<int, Layer> m_layers;
+
+    void clearLayer(Layer& layer) const;
 };
 } // namespace jt
 
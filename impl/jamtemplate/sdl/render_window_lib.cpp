@@ -22,10 +22,15 @@ RenderWindow::RenderWindow(unsigned int width, unsigned int height, std::string
 
 std::shared_ptr<jt::RenderTargetLayer> RenderWindow::createRenderTarget()
 {
+    auto* renderer = SDL_CreateRenderer(
+        m_window.get(), -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE);
+    if (renderer == nullptr) {
+        // No gpu available, e.g. headless runs with SDL_VIDEODRIVER=dummy
+        renderer = SDL_CreateRenderer(
+            m_window.get(), -1, SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE);
+    }
     auto const renderTarget
-        = std::shared_ptr<SDL_Renderer>(SDL_CreateRenderer(m_window.get(), -1,
-                                            SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE),
-            [](SDL_Renderer* r) { SDL_DestroyRenderer(r); });
+        = std::shared_ptr<SDL_Renderer>(renderer, [](SDL_Renderer* r) { SDL_DestroyRenderer(r); });
     if (!renderTarget) {
         throw std::logic_error { "failed to create renderer." };
     }
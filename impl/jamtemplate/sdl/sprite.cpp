@@ -1,4 +1,5 @@
 ﻿#include "sprite.hpp"
+#include <graphics/texture_manager_stats.hpp>
 #include <math_helper.hpp>
 #include <sdl_helper.hpp>
 #include <SDL_image.h>
@@ -11,41 +12,70 @@ Sprite::Sprite() { }
 
 Sprite::Sprite(std::string const& fileName, jt::TextureManagerInterface& textureManager)
 {
-    m_text = textureManager.get(fileName);
-    m_fileName = fileName;
-    int w { 0 };
-    int h { 0 };
-    SDL_QueryTexture(
-        m_text.get(), nullptr, nullptr, &w, &h); // get the width and height of the texture
-    m_sourceRect = jt::Recti { 0, 0, w, h };
-
-    m_textFlash = textureManager.get(textureManager.getFlashName(fileName));
+    m_handle = textureManager.getHandle(fileName);
+    auto const region = textureManager.getRegion(m_handle);
+    m_text = region.texture;
+    m_sourceRect = region.rect;
+    m_textureManager = &textureManager;
+    m_rectInImage = jt::Recti { 0, 0, region.rect.width, region.rect.height };
 }
 
 Sprite::Sprite(
     std::string const& fileName, jt::Recti const& rect, jt::TextureManagerInterface& textureManager)
+    : Sprite { textureManager.getHandle(fileName), rect, textureManager }
 {
-    m_text = textureManager.get(fileName);
-    m_fileName = fileName;
-    int w { 0 };
-    int h { 0 };
-    SDL_QueryTexture(
-        m_text.get(), nullptr, nullptr, &w, &h); // get the width and height of the texture
-    m_sourceRect = jt::Recti { rect };
+}
 
-    m_textFlash = textureManager.get(textureManager.getFlashName(fileName));
+Sprite::Sprite(
+    jt::TextureHandle handle, jt::Recti const& rect, jt::TextureManagerInterface& textureManager)
+{
+    auto const region = textureManager.getRegion(handle);
+    m_text = region.texture;
+    m_handle = handle;
+    // rect is relative to the image, which might be packed anywhere in an atlas page
+    m_sourceRect = jt::Recti { region.rect.left + rect.left, region.rect.top + rect.top,
+        rect.width, rect.height };
+    m_textureManager = &textureManager;
+    m_rectInImage = rect;
 }
 
 void Sprite::fromTexture(std::shared_ptr<SDL_Texture> const& txt)
 {
     m_text = txt;
     m_textFlash = txt;
-    m_fileName = "";
+    m_textureManager = nullptr;
+    m_handle = jt::TextureHandle {};
     int w { 0 };
     int h { 0 };
     SDL_QueryTexture(
         m_text.get(), nullptr, nullptr, &w, &h); // get the width and height of the texture
     m_sourceRect = jt::Recti { 0, 0, w, h };
+    m_flashSourceRect = m_sourceRect;
+}
+
+void Sprite::setTextureRect(jt::TextureHandle handle, jt::Recti const& rect)
+{
+    if (m_textureManager == nullptr) {
+        throw std::logic_error { "sprite was not created by a texture manager" };
+    }
+    auto const region = m_textureManager->getRegion(handle);
+    if (handle != m_handle) {
+        m_text = region.texture;
+        m_handle = handle;
+        cleanImage();
+    }
+    m_rectInImage = rect;
+    m_sourceRect = jt::Recti { region.rect.left + rect.left, region.rect.top + rect.top,
+        rect.width, rect.height };
+
+    if (m_textFlash != nullptr) {
+        // keep showing the matching part of the flash image
+        auto const flashRegion
+            = m_textureManager->getRegion(m_textureManager->getFlashHandle(m_handle));
+        m_textFlash = flashRegion.texture;
+        m_flashSourceRect = jt::Recti { flashRegion.rect.left + rect.left,
+            flashRegion.rect.top + rect.top, rect.width, rect.height };
+    }
 }
 
 void Sprite::setPosition(jt::Vector2f const& pos) { m_position = pos; }
@@ -79,8 +109,10 @@ jt::Vector2f Sprite::getScale() const { return m_scale; }
 jt::Color Sprite::getColorAtPixel(jt::Vector2u pixelPos) const
 {
     if (!m_image) {
+        auto const fileName
+            = m_textureManager == nullptr ? std::string {} : m_textureManager->getName(m_handle);
         m_image = std::shared_ptr<SDL_Surface>(
-            IMG_Load(m_fileName.c_str()), [](SDL_Surface* s) { SDL_FreeSurface(s); });
+            IMG_Load(fileName.c_str()), [](SDL_Surface* s) { SDL_FreeSurface(s); });
         if (!m_image) {
             std::cout << "Warning: file could not be loaded for getpixels\n";
             return jt::colors::Black;
@@ -117,6 +149,7 @@ void Sprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
         static_cast<int>(getOrigin().y * m_scale.y) };
     SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
     setSDLColor(m_color);
+    jt::TextureBindCounter::onDraw(m_text.get());
     SDL_RenderCopyEx(sptr.get(), m_text.get(), &sourceRect, &destRect, getRotation(), &p, flip);
 }
 
@@ -133,6 +166,7 @@ void Sprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) con
         static_cast<int>(getOrigin().y * m_scale.y) };
     SDL_SetRenderDrawBlendMode(sptr.get(), SDL_BLENDMODE_BLEND);
     setSDLColor(getShadowColor());
+    jt::TextureBindCounter::onDraw(m_text.get());
     SDL_RenderCopyEx(sptr.get(), m_text.get(), &sourceRect, &destRect, getRotation(), &p, flip);
 }
 
@@ -151,17 +185,19 @@ void Sprite::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) co
     for (auto const& outlineOffset : getOutlineOffsets()) {
         SDL_Rect const destRect = getDestRect(outlineOffset);
 
+        jt::TextureBindCounter::onDraw(m_text.get());
         SDL_RenderCopyEx(sptr.get(), m_text.get(), &sourceRect, &destRect, getRotation(), &p, flip);
     }
 }
 
 void Sprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
+    if (!sptr || !m_textFlash) [[unlikely]] {
         return;
     }
 
-    SDL_Rect const sourceRect = getSourceRect();
+    SDL_Rect const sourceRect { m_flashSourceRect.left, m_flashSourceRect.top,
+        m_flashSourceRect.width, m_flashSourceRect.height };
     SDL_Rect const destRect = getDestRect();
     auto const flip = jt::getFlipFromScale(m_scale);
     SDL_Point const p { static_cast<int>(getOrigin().x * m_scale.x),
@@ -170,10 +206,24 @@ void Sprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) cons
     SDL_SetTextureColorMod(
         m_textFlash.get(), getFlashColor().r, getFlashColor().g, getFlashColor().b);
     SDL_SetTextureAlphaMod(m_textFlash.get(), getFlashColor().a);
+    jt::TextureBindCounter::onDraw(m_textFlash.get());
     SDL_RenderCopyEx(
         sptr.get(), m_textFlash.get(), &sourceRect, &destRect, getRotation(), &p, flip);
 }
 
+void Sprite::doFlashImpl(float /*t*/, jt::Color /*col*/)
+{
+    if (m_textFlash != nullptr || m_textureManager == nullptr) {
+        return;
+    }
+    // most sprites are never flashed, so the flash image is only requested here
+    auto const flashRegion
+        = m_textureManager->getRegion(m_textureManager->getFlashHandle(m_handle));
+    m_textFlash = flashRegion.texture;
+    m_flashSourceRect = jt::Recti { flashRegion.rect.left + m_rectInImage.left,
+        flashRegion.rect.top + m_rectInImage.top, m_rectInImage.width, m_rectInImage.height };
+}
+
 void Sprite::doRotate(float /*rot*/) noexcept { }
 
 SDL_Rect Sprite::getDestRect(jt::Vector2f const& positionOffset) const
@@ -22,9 +22,29 @@ public:
     Sprite(std::string const& fileName, jt::Recti const& rect,
         jt::TextureManagerInterface& textureManager);
 
+    /// Constructor for a texture handle. Faster than the file name constructors when many
+    /// sprites share a texture, e.g. animation frames or tiles.
+    /// \param handle texture handle from the texture manager
+    /// \param rect part of the texture shown by the sprite
+    /// \param textureManager the texture manager that created the handle
+    Sprite(jt::TextureHandle handle, jt::Recti const& rect,
+        jt::TextureManagerInterface& textureManager);
+
+    /// Show a different part of a texture. All other properties of the sprite are kept, so one
+    /// sprite can show all frames of an animation.
+    /// \param handle texture handle from the texture manager the sprite was created with
+    /// \param rect part of the texture to show
+    void setTextureRect(jt::TextureHandle handle, jt::Recti const& rect);
+
     // DO NOT CALL THIS FROM GAME CODE!
     void fromTexture(std::shared_ptr<SDL_Texture> const& txt);
 
+    // DO NOT CALL THIS FROM GAME CODE!
+    std::shared_ptr<SDL_Texture> getSDLTexture() const { return m_text; }
+
+    // DO NOT CALL THIS FROM GAME CODE!
+    jt::Recti getTextureRect() const { return m_sourceRect; }
+
     // WARNING: This function is slow, because it needs to copy
     // graphics memory to ram first.
     jt::Color getColorAtPixel(jt::Vector2u pixelPos) const;
@@ -52,7 +72,12 @@ private:
     jt::Color m_color { jt::colors::White };
 
     mutable std::shared_ptr<SDL_Texture> m_textFlash;
-    std::string m_fileName { "" };
+    // flash images might be packed at a different position than the image
+    jt::Recti m_flashSourceRect { 0, 0, 0, 0 };
+    // needed to create the flash image on the first call to flash()
+    jt::TextureManagerInterface* m_textureManager { nullptr };
+    jt::Recti m_rectInImage { 0, 0, 0, 0 };
+    jt::TextureHandle m_handle {};
 
     mutable std::shared_ptr<SDL_Surface> m_image { nullptr };
 
@@ -62,6 +87,7 @@ private:
     void doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doFlashImpl(float t, jt::Color col) override;
     void doRotate(float /*rot*/) noexcept override;
 
     SDL_Rect getDestRect(jt::Vector2f const& positionOffset = jt::Vector2f { 0.0f, 0.0f }) const;
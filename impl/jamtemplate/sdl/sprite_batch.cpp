@@ -0,0 +1,106 @@
+#include "sprite_batch.hpp"
+#include <graphics/texture_manager_stats.hpp>
+#include <algorithm>
+
+void jt::SpriteBatch::clear()
+{
+    for (auto& b : m_batches) {
+        b.vertices.clear();
+        b.indices.clear();
+    }
+    m_numberOfQuads = 0u;
+    m_lastSprite = nullptr;
+}
+
+void jt::SpriteBatch::add(
+    jt::Sprite const& sprite, QuadCorners const& corners, jt::Color const& color)
+{
+    if (&sprite != m_lastSprite) {
+        m_lastSprite = &sprite;
+        m_lastBatchIndex = getBatchIndexForTexture(sprite.getSDLTexture());
+        auto const& textureSize = m_batches[m_lastBatchIndex].textureSize;
+
+        auto const rect = sprite.getTextureRect();
+        auto const l = static_cast<float>(rect.left) / textureSize.x;
+        auto const t = static_cast<float>(rect.top) / textureSize.y;
+        auto const r = static_cast<float>(rect.left + rect.width) / textureSize.x;
+        auto const b = static_cast<float>(rect.top + rect.height) / textureSize.y;
+        m_lastTexCoords
+            = { SDL_FPoint { l, t }, SDL_FPoint { r, t }, SDL_FPoint { r, b }, SDL_FPoint { l, b } };
+    }
+    auto& batch = m_batches[m_lastBatchIndex];
+
+    SDL_Color const col { color.r, color.g, color.b, color.a };
+    auto const firstIndex = static_cast<int>(batch.vertices.size());
+    for (auto i = 0u; i != 4u; ++i) {
+        batch.vertices.push_back(
+            SDL_Vertex { SDL_FPoint { corners[i].x, corners[i].y }, col, m_lastTexCoords[i] });
+    }
+    // two triangles per quad: (0, 1, 2) and (0, 2, 3)
+    for (auto const i : { 0, 1, 2, 0, 2, 3 }) {
+        batch.indices.push_back(firstIndex + i);
+    }
+    ++m_numberOfQuads;
+}
+
+void jt::SpriteBatch::draw(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    jt::Vector2f const& offset, jt::BlendMode blendMode) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    SDL_BlendMode sdlBlendMode = SDL_BLENDMODE_BLEND;
+    if (blendMode == jt::BlendMode::ADD) {
+        sdlBlendMode = SDL_BLENDMODE_ADD;
+    } else if (blendMode == jt::BlendMode::MUL) {
+        sdlBlendMode = SDL_BLENDMODE_MOD;
+    }
+
+    for (auto const& b : m_batches) {
+        if (b.vertices.empty()) {
+            continue;
+        }
+        b.translatedVertices.assign(b.vertices.cbegin(), b.vertices.cend());
+        for (auto& v : b.translatedVertices) {
+            v.position.x += offset.x;
+            v.position.y += offset.y;
+        }
+        SDL_SetTextureBlendMode(b.texture.get(), sdlBlendMode);
+        // vertex colors are used instead of color/alpha mods
+        SDL_SetTextureColorMod(b.texture.get(), 255, 255, 255);
+        SDL_SetTextureAlphaMod(b.texture.get(), 255);
+        jt::TextureBindCounter::onDraw(b.texture.get());
+        SDL_RenderGeometry(sptr.get(), b.texture.get(), b.translatedVertices.data(),
+            static_cast<int>(b.translatedVertices.size()), b.indices.data(),
+            static_cast<int>(b.indices.size()));
+        // the texture might be an atlas page shared with sprites that expect alpha blending
+        SDL_SetTextureBlendMode(b.texture.get(), SDL_BLENDMODE_BLEND);
+    }
+}
+
+std::size_t jt::SpriteBatch::getNumberOfQuads() const noexcept { return m_numberOfQuads; }
+
+std::size_t jt::SpriteBatch::getNumberOfDrawCalls() const noexcept
+{
+    return static_cast<std::size_t>(std::count_if(
+        m_batches.cbegin(), m_batches.cend(), [](auto const& b) { return !b.vertices.empty(); }));
+}
+
+std::size_t jt::SpriteBatch::getBatchIndexForTexture(std::shared_ptr<SDL_Texture> const& texture)
+{
+    // linear search: there are typically only very few textures (e.g. tilesets) per batch
+    for (auto i = 0u; i != m_batches.size(); ++i) {
+        if (m_batches[i].texture == texture) {
+            return i;
+        }
+    }
+    int w { 1 };
+    int h { 1 };
+    SDL_QueryTexture(texture.get(), nullptr, nullptr, &w, &h);
+    Batch batch;
+    batch.texture = texture;
+    batch.textureSize = jt::Vector2f { static_cast<float>(w), static_cast<float>(h) };
+    m_batches.push_back(batch);
+    return m_batches.size() - 1u;
+}
@@ -0,0 +1,69 @@
+#ifndef JAMTEMPLATE_SPRITE_BATCH_HPP
+#define JAMTEMPLATE_SPRITE_BATCH_HPP
+
+#include <color/color.hpp>
+#include <graphics/drawable_interface.hpp>
+#include <render_target_layer.hpp>
+#include <sdl_2_include.hpp>
+#include <sprite.hpp>
+#include <vector.hpp>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace jt {
+
+/// Collects textured quads and draws all quads sharing a texture with a single draw call
+class SpriteBatch {
+public:
+    /// Corners of a quad in the order top left, top right, bottom right, bottom left
+    using QuadCorners = std::array<jt::Vector2f, 4>;
+
+    /// Remove all quads from the batch. Allocated memory is kept for reuse.
+    void clear();
+
+    /// Add a quad displaying the texture rect of the sprite
+    /// \param sprite the sprite to take texture and texture rect from
+    /// \param corners the corners of the quad in local coordinates
+    /// \param color the vertex color
+    void add(jt::Sprite const& sprite, QuadCorners const& corners, jt::Color const& color);
+
+    /// Draw all quads
+    /// \param sptr the render target
+    /// \param offset offset added to all quads
+    /// \param blendMode the blend mode used for drawing
+    void draw(std::shared_ptr<jt::RenderTargetLayer> const sptr, jt::Vector2f const& offset,
+        jt::BlendMode blendMode) const;
+
+    /// Get the number of quads in the batch
+    /// \return number of quads
+    std::size_t getNumberOfQuads() const noexcept;
+
+    /// Get the number of draw calls issued by one call to draw
+    /// \return number of draw calls
+    std::size_t getNumberOfDrawCalls() const noexcept;
+
+private:
+    struct Batch {
+        std::shared_ptr<SDL_Texture> texture { nullptr };
+        jt::Vector2f textureSize { 1.0f, 1.0f };
+        std::vector<SDL_Vertex> vertices {};
+        std::vector<int> indices {};
+        // SDL_RenderGeometry has no transform, so the offset is applied to a copy of the vertices
+        mutable std::vector<SDL_Vertex> translatedVertices {};
+    };
+    std::vector<Batch> m_batches {};
+    std::size_t m_numberOfQuads { 0u };
+
+    // cache for consecutive quads using the same sprite (e.g. particles)
+    jt::Sprite const* m_lastSprite { nullptr };
+    std::size_t m_lastBatchIndex { 0u };
+    std::array<SDL_FPoint, 4> m_lastTexCoords {};
+
+    std::size_t getBatchIndexForTexture(std::shared_ptr<SDL_Texture> const& texture);
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_SPRITE_BATCH_HPP
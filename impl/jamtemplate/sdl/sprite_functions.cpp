@@ -71,8 +71,7 @@ std::shared_ptr<SDL_Texture> makeBlankImage(
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
 }
 
-std::shared_ptr<SDL_Texture> makeGlowImage(
-    std::shared_ptr<jt::RenderTargetLayer> renderTarget, float r, std::uint8_t max)
+std::shared_ptr<SDL_Surface> makeGlowSurface(float r, std::uint8_t max)
 {
     auto const s = static_cast<unsigned int>(r + 0.5f * 2);
     std::shared_ptr<SDL_Surface> image = std::shared_ptr<SDL_Surface>(
@@ -95,14 +94,20 @@ std::shared_ptr<SDL_Texture> makeGlowImage(
                 SDL_MapRGBA(image->format, maxUint8, maxUint8, maxUint8, static_cast<uint8_t>(v)));
         }
     }
+    return image;
+}
+
+std::shared_ptr<SDL_Texture> makeGlowImage(
+    std::shared_ptr<jt::RenderTargetLayer> renderTarget, float r, std::uint8_t max)
+{
+    auto const image = makeGlowSurface(r, max);
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
     return std::shared_ptr<SDL_Texture>(
         SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
 }
 
-std::shared_ptr<SDL_Texture> makeVignetteImage(
-    std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w, unsigned int h)
+std::shared_ptr<SDL_Surface> makeVignetteSurface(unsigned int w, unsigned int h)
 {
     std::shared_ptr<SDL_Surface> image
         = std::shared_ptr<SDL_Surface>(SDL_CreateRGBSurfaceWithFormat(0, static_cast<int>(w),
@@ -123,6 +128,13 @@ std::shared_ptr<SDL_Texture> makeVignetteImage(
             jt::setPixel(image.get(), i, j, SDL_MapRGBA(image->format, 0u, 0u, 0u, v));
         }
     }
+    return image;
+}
+
+std::shared_ptr<SDL_Texture> makeVignetteImage(
+    std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w, unsigned int h)
+{
+    auto const image = makeVignetteSurface(w, h);
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
     std::shared_ptr<SDL_Texture> t(SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
@@ -180,8 +192,7 @@ std::shared_ptr<SDL_Texture> makeCircle(
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
 }
 
-std::shared_ptr<SDL_Texture> makeRing(
-    std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w)
+std::shared_ptr<SDL_Surface> makeRingSurface(unsigned int w)
 {
     std::shared_ptr<SDL_Surface> image = std::shared_ptr<SDL_Surface>(
         SDL_CreateRGBSurfaceWithFormat(0, w + 1, w + 1, 32, SDL_PIXELFORMAT_RGBA32),
@@ -204,7 +215,13 @@ std::shared_ptr<SDL_Texture> makeRing(
         jt::setPixel(image.get(), static_cast<unsigned int>(r - xo),
             static_cast<unsigned int>(r - yo), SDL_MapRGBA(image->format, 255, 255, 255, 255));
     }
+    return image;
+}
 
+std::shared_ptr<SDL_Texture> makeRing(
+    std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w)
+{
+    auto const image = makeRingSurface(w);
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
     return std::shared_ptr<SDL_Texture>(
         SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
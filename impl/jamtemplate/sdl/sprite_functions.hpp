@@ -17,9 +17,15 @@ std::shared_ptr<SDL_Texture> makeButtonImage(std::shared_ptr<jt::RenderTargetLay
 std::shared_ptr<SDL_Texture> makeBlankImage(
     std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w, unsigned int h);
 
+/// Create the pixels of a glow image, see makeGlowImage
+std::shared_ptr<SDL_Surface> makeGlowSurface(float r, std::uint8_t max = 255);
+
 std::shared_ptr<SDL_Texture> makeGlowImage(
     std::shared_ptr<jt::RenderTargetLayer> renderTarget, float r, std::uint8_t max = 255);
 
+/// Create the pixels of a vignette image, see makeVignetteImage
+std::shared_ptr<SDL_Surface> makeVignetteSurface(unsigned int w, unsigned int h);
+
 std::shared_ptr<SDL_Texture> makeVignetteImage(
     std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w, unsigned int h);
 
@@ -29,6 +35,9 @@ std::shared_ptr<SDL_Texture> makeRect(
 std::shared_ptr<SDL_Texture> makeCircle(
     std::shared_ptr<jt::RenderTargetLayer> renderTarget, float r);
 
+/// Create the pixels of a ring image, see makeRing
+std::shared_ptr<SDL_Surface> makeRingSurface(unsigned int w);
+
 std::shared_ptr<SDL_Texture> makeRing(
     std::shared_ptr<jt::RenderTargetLayer> renderTarget, unsigned int w);
 
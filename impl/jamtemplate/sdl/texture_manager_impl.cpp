@@ -1,64 +1,46 @@
 ﻿#include "texture_manager_impl.hpp"
-#include <aselib/image_builder.hpp>
-#include <sdl_helper.hpp>
+#include <graphics/alpha_mask.hpp>
+#include <graphics/aseprite_cache.hpp>
 #include <sprite_functions.hpp>
 #include <strutils.hpp>
 #include <SDL_image.h>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
+#include <algorithm>
 #include <array>
+#include <cstring>
 #include <iostream>
 #include <limits>
 #include <stdexcept>
+#include <string_view>
+#include <vector>
 
 namespace jt {
 
 namespace {
 
-std::shared_ptr<SDL_Texture> createImageFromAse(
-    std::string const& filename, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
-{
-    auto const asepritePos = filename.rfind(".aseprite");
-    auto const splittedFilename = filename.substr(0, asepritePos + 9);
-    auto const postFix = filename.substr(asepritePos + 9);
-    aselib::AsepriteData aseData { filename };
+constexpr std::string_view flashPostfix { "___flash__" };
+constexpr int atlasPageSize { 2048 };
+// larger images get a texture of their own, so they do not waste most of an atlas page
+constexpr int maxAtlasImageSize { 512 };
+// transparent gap between packed images
+constexpr int atlasPadding { 1 };
 
-    std::unique_ptr<aselib::Image> aseImage { nullptr };
-    if (strutil::contains(postFix, ".layer=")) {
-        auto const layerPos = postFix.find(".layer=");
-        auto const layerName = postFix.substr(layerPos + 7);
-        aseImage = std::make_unique<aselib::Image>(aselib::makeImageFromLayer(aseData, layerName));
-    } else {
-        auto const ignore_transparent = strutil::contains(postFix, ".ignore_transparent");
-        aseImage = std::make_unique<aselib::Image>(
-            aselib::makeImageFromAse(aseData, !ignore_transparent));
-    }
-
-    auto const w = aseImage->m_width;
-    auto const h = aseImage->m_height;
-    auto const wAsInt = static_cast<int>(w);
-    auto const hAsInt = static_cast<int>(h);
+std::shared_ptr<SDL_Surface> createSurfaceFromAse(std::string const& filename)
+{
+    auto const decoded = jt::loadDecodedAseprite(filename);
+    auto const w = static_cast<int>(decoded->getImageSize().x);
+    auto const h = static_cast<int>(decoded->getImageSize().y);
     std::shared_ptr<SDL_Surface> image = std::shared_ptr<SDL_Surface>(
-        SDL_CreateRGBSurfaceWithFormat(0, wAsInt, hAsInt, 32, SDL_PIXELFORMAT_RGBA32),
+        SDL_CreateRGBSurfaceWithFormat(0, w, h, 32, SDL_PIXELFORMAT_RGBA32),
         [](SDL_Surface* s) { SDL_FreeSurface(s); });
 
-    auto const transparent = SDL_MapRGBA(image->format, 0, 0, 0, 0);
-
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            jt::setPixel(image.get(), i, j, transparent);
-        }
-    }
-
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            auto const& p = aseImage->getPixelAt(i, j);
-            auto const col = SDL_MapRGBA(image->format, p.r, p.g, p.b, p.a);
-            jt::setPixel(image.get(), i, j, col);
-        }
+    auto const rowSize = static_cast<std::size_t>(w) * 4u;
+    auto const pixels = decoded->getPixels();
+    for (auto j = 0; j != h; ++j) {
+        std::memcpy(static_cast<std::uint8_t*>(image->pixels) + j * image->pitch,
+            pixels.data() + static_cast<std::size_t>(j) * rowSize, rowSize);
     }
-    return std::shared_ptr<SDL_Texture>(
-        SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
-        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+    return image;
 }
 
 std::shared_ptr<SDL_Texture> createButtonImage(
@@ -100,8 +82,7 @@ std::shared_ptr<SDL_Texture> createBlankImage(
         renderTarget, static_cast<unsigned int>(w), static_cast<unsigned int>(h));
 }
 
-std::shared_ptr<SDL_Texture> createGlowImage(
-    std::array<std::string, 3> const& ssv, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+std::shared_ptr<SDL_Surface> createGlowSurface(std::array<std::string, 3> const& ssv)
 {
     std::size_t count { 0 };
     auto const glow_size = std::stol(ssv.at(1), &count);
@@ -114,12 +95,11 @@ std::shared_ptr<SDL_Texture> createGlowImage(
         || max > std::numeric_limits<uint8_t>::max()) {
         throw std::invalid_argument { "invalid glowmax" };
     }
-    return SpriteFunctions::makeGlowImage(
-        renderTarget, static_cast<float>(glow_size), static_cast<uint8_t>(max));
+    return SpriteFunctions::makeGlowSurface(
+        static_cast<float>(glow_size), static_cast<uint8_t>(max));
 }
 
-std::shared_ptr<SDL_Texture> createVignetteImage(
-    std::array<std::string, 3> const& ssv, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+std::shared_ptr<SDL_Surface> createVignetteSurface(std::array<std::string, 3> const& ssv)
 {
     if (ssv.size() != 3) {
         throw std::invalid_argument {
@@ -136,7 +116,7 @@ std::shared_ptr<SDL_Texture> createVignetteImage(
         std::cout << "invalid vignette h\n";
         throw std::invalid_argument { "invalid vignette h" };
     }
-    return SpriteFunctions::makeVignetteImage(renderTarget, w, h);
+    return SpriteFunctions::makeVignetteSurface(w, h);
 }
 
 std::shared_ptr<SDL_Texture> createRectImage(
@@ -169,8 +149,7 @@ std::shared_ptr<SDL_Texture> createCircleImage(
     return SpriteFunctions::makeCircle(renderTarget, static_cast<float>(radius));
 }
 
-std::shared_ptr<SDL_Texture> createRingImage(
-    std::array<std::string, 2> const& ssv, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+std::shared_ptr<SDL_Surface> createRingSurface(std::array<std::string, 2> const& ssv)
 {
     if (ssv.size() != 2) {
         throw std::invalid_argument { "create ring image: vector does not contain 1 elements." };
@@ -181,56 +160,116 @@ std::shared_ptr<SDL_Texture> createRingImage(
         throw std::invalid_argument { "invalid ring image size" };
     }
 
-    return SpriteFunctions::makeRing(renderTarget, ringImageSize);
+    return SpriteFunctions::makeRingSurface(ringImageSize);
 }
 
-std::shared_ptr<SDL_Texture> createFlashImage(
-    std::string const& str, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+std::shared_ptr<SDL_Surface> loadSurfaceFromDisk(std::string const& str)
 {
     auto image = std::shared_ptr<SDL_Surface>(
         IMG_Load(str.c_str()), [](SDL_Surface* s) { SDL_FreeSurface(s); });
-    if (!image) {
-        return nullptr;
+    if (image == nullptr) {
+        throw std::invalid_argument { "invalid filename, cannot load texture from '" + str + "'" };
     }
-    int const w = image->w;
-    int const h = image->h;
+    return image;
+}
 
-    auto const white = SDL_MapRGBA(image->format, 255u, 255u, 255u, 255u);
+bool isFileTexture(std::string const& str)
+{
+    return strutil::contains(str, ".aseprite") || !str.starts_with('#');
+}
 
-    for (int x = 0; x != w; ++x) {
-        for (int y = 0; y != h; ++y) {
+// surfaces are kept in RGBA32, so their pixels can be uploaded into atlas pages as they are
+std::shared_ptr<SDL_Surface> convertToRgba32(std::shared_ptr<SDL_Surface> surface)
+{
+    if (surface->format->format == SDL_PIXELFORMAT_RGBA32) {
+        return surface;
+    }
+    auto converted = std::shared_ptr<SDL_Surface>(
+        SDL_ConvertSurfaceFormat(surface.get(), SDL_PIXELFORMAT_RGBA32, 0),
+        [](SDL_Surface* s) { SDL_FreeSurface(s); });
+    if (converted == nullptr) {
+        throw std::invalid_argument { "cannot convert surface to RGBA32" };
+    }
+    return converted;
+}
 
-            uint8_t r = 0u;
-            uint8_t g = 0u;
-            uint8_t b = 0u;
-            uint8_t a = 0u;
-            SDL_GetRGBA(jt::getPixel(image.get(), x, y), image->format, &r, &g, &b, &a);
-            if (a != 0) {
-                jt::setPixel(image.get(), x, y, white);
-            }
-        }
+std::shared_ptr<SDL_Surface> decodeFileSurface(std::string const& str)
+{
+    if (strutil::contains(str, ".aseprite")) {
+        return createSurfaceFromAse(str);
     }
+    return convertToRgba32(loadSurfaceFromDisk(str));
+}
 
+jt::AlphaMask createFlashMask(std::shared_ptr<SDL_Surface> const& surface)
+{
+    return jt::createAlphaMask(static_cast<std::uint8_t const*>(surface->pixels),
+        static_cast<unsigned int>(surface->w), static_cast<unsigned int>(surface->h),
+        static_cast<std::size_t>(surface->pitch));
+}
+
+std::string getImageName(std::string const& flashName)
+{
+    return flashName.substr(0, flashName.size() - flashPostfix.size());
+}
+
+std::shared_ptr<SDL_Texture> createTextureFromSurface(std::shared_ptr<SDL_Surface> const& surface,
+    std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+{
+    if (surface == nullptr) {
+        return nullptr;
+    }
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
     return std::shared_ptr<SDL_Texture>(
-        SDL_CreateTextureFromSurface(renderTarget.get(), image.get()),
+        SDL_CreateTextureFromSurface(renderTarget.get(), surface.get()),
         [](SDL_Texture* t) { SDL_DestroyTexture(t); });
 }
 
-std::shared_ptr<SDL_Texture> loadTextureFromDisk(
-    std::string const& str, std::shared_ptr<jt::RenderTargetLayer> renderTarget)
+// special images that are created in ram and can be packed into the atlas, nullptr otherwise
+std::shared_ptr<SDL_Surface> createSpecialSurface(std::string const& str)
 {
-    if (renderTarget == nullptr) {
-        throw std::logic_error { "rendertarget is null in loadTextureFromDisk" };
+    if (str.at(1) == 'g') {
+        return createGlowSurface(strutil::split<3>(str.substr(1u), '#'));
+    } else if (str.at(1) == 'v') {
+        return createVignetteSurface(strutil::split<3>(str.substr(1u), '#'));
+    } else if (str.at(1) == 'r') {
+        return createRingSurface(strutil::split<2>(str.substr(1u), '#'));
     }
-    auto texture = std::shared_ptr<SDL_Texture>(IMG_LoadTexture(renderTarget.get(), str.c_str()),
-        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+    return nullptr;
+}
+
+int getAtlasPageSize(std::shared_ptr<jt::RenderTargetLayer> const& renderer)
+{
+    SDL_RendererInfo info {};
+    if (SDL_GetRendererInfo(renderer.get(), &info) != 0 || info.max_texture_width <= 0
+        || info.max_texture_height <= 0) {
+        return atlasPageSize;
+    }
+    return std::min({ atlasPageSize, info.max_texture_width, info.max_texture_height });
+}
 
+std::shared_ptr<SDL_Texture> createTextureFromPixels(
+    std::shared_ptr<jt::RenderTargetLayer> const& renderer, void const* rgba, int w, int h)
+{
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
+    auto texture = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTexture(renderer.get(), SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, w, h),
+        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
     if (texture == nullptr) {
-        throw std::invalid_argument { "invalid filename, cannot load texture from '" + str + "'" };
+        return nullptr;
     }
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+    SDL_UpdateTexture(texture.get(), nullptr, rgba, w * 4);
     return texture;
 }
+
+std::shared_ptr<SDL_Texture> createAtlasPageTexture(
+    std::shared_ptr<jt::RenderTargetLayer> const& renderer, int size)
+{
+    std::vector<std::uint32_t> const transparent(
+        static_cast<std::size_t>(size) * static_cast<std::size_t>(size), 0u);
+    return createTextureFromPixels(renderer, transparent.data(), size, size);
+}
 } // namespace
 
 TextureManagerImpl::TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> renderer)
@@ -240,7 +279,7 @@ TextureManagerImpl::TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> re
 
 std::shared_ptr<SDL_Texture> TextureManagerImpl::get(std::string const& str)
 {
-    ZoneScopedNC("jt::TextureManagerImpl::get", tracy::Color::Crimson);
+    JT_PROFILE_ZONE_COLOR("jt::TextureManagerImpl::get", tracy::Color::Crimson);
     if (str.empty()) {
         std::cout << "TextureManager get: string must not be empty" << std::endl;
         throw std::invalid_argument { "TextureManager get: string must not be empty" };
@@ -257,18 +296,20 @@ std::shared_ptr<SDL_Texture> TextureManagerImpl::get(std::string const& str)
         return m_textures[str];
     }
 
-    // Check if special ase parsing is required
-    if (strutil::contains(str, ".aseprite")) {
-        m_textures[str] = createImageFromAse(str, renderer);
-        m_textures[getFlashName(str)] = createFlashImage(str, renderer);
-        return m_textures[str];
+    if (auto const it = m_regions.find(str); it != m_regions.end()) {
+        return copyFromAtlas(str, it->second, renderer);
     }
 
-    // normal filenames do not start with a '#'
-    if (!str.starts_with('#')) {
-        m_textures[str] = loadTextureFromDisk(str, m_renderer.lock());
-        // create Flash Image
-        m_textures[getFlashName(str)] = createFlashImage(str, m_renderer.lock());
+    // flash images of files are only created when they are used for the first time
+    if (str.ends_with(flashPostfix)) {
+        return createFlashTexture(str, renderer);
+    }
+
+    // aseprite files and normal filenames (not starting with a '#'), possibly decoded by prepare()
+    if (isFileTexture(str)) {
+        auto decoded = takeDecodedImage(str);
+        m_textures[str] = createTextureFromSurface(decoded.image, renderer);
+        m_flashMasks[str] = std::move(decoded.flashMask);
         return m_textures[str];
     }
 
@@ -278,35 +319,337 @@ std::shared_ptr<SDL_Texture> TextureManagerImpl::get(std::string const& str)
     } else if (str.at(1) == 'f') {
         auto ssv = strutil::split<3>(str.substr(1u), '#');
         m_textures[str] = createBlankImage(ssv, renderer);
-    } else if (str.at(1) == 'g') {
-        auto ssv = strutil::split<3>(str.substr(1u), '#');
-        m_textures[str] = createGlowImage(ssv, renderer);
-    } else if (str.at(1) == 'v') {
-        auto ssv = strutil::split<3>(str.substr(1u), '#');
-        m_textures[str] = createVignetteImage(ssv, renderer);
+    } else if (str.at(1) == 'g' || str.at(1) == 'v' || str.at(1) == 'r') {
+        m_textures[str] = createTextureFromSurface(createSpecialSurface(str), renderer);
     } else if (str.at(1) == 'x') {
         auto ssv = strutil::split<3>(str.substr(1u), '#');
         m_textures[str] = createRectImage(ssv, renderer);
     } else if (str.at(1) == 'c') {
         auto ssv = strutil::split<2>(str.substr(1u), '#');
         m_textures[str] = createCircleImage(ssv, renderer);
-    } else if (str.at(1) == 'r') {
-        auto ssv = strutil::split<2>(str.substr(1u), '#');
-        m_textures[str] = createRingImage(ssv, renderer);
     } else {
         throw std::invalid_argument("ERROR: cannot get texture with name " + str);
     }
 
-    // create Flash Image
+    // special images are their own flash image
     m_textures[getFlashName(str)] = m_textures[str];
 
     return m_textures[str];
 }
 
-std::string TextureManagerImpl::getFlashName(std::string const& str) { return str + "___flash__"; }
+std::shared_ptr<SDL_Texture> TextureManagerImpl::createFlashTexture(
+    std::string const& flashName, std::shared_ptr<jt::RenderTargetLayer> const& renderer)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::createFlashTexture");
+    auto const str = getImageName(flashName);
+    if (!m_flashMasks.contains(str) && !containsTexture(str) && !m_regions.contains(str)) {
+        get(str);
+        if (containsTexture(flashName)) {
+            return m_textures[flashName];
+        }
+    }
+    auto node = m_flashMasks.extract(str);
+    if (node.empty()) {
+        throw std::invalid_argument { "cannot create flash texture for '" + str + "'" };
+    }
+    auto const& mask = node.mapped();
+    auto const pixels = jt::createFlashPixels(mask);
+    m_textures[flashName] = createTextureFromPixels(renderer, pixels.data(),
+        static_cast<int>(mask.width), static_cast<int>(mask.height));
+    return m_textures[flashName];
+}
+
+std::shared_ptr<SDL_Texture> TextureManagerImpl::copyFromAtlas(std::string const& str,
+    jt::TextureRegion const& region, std::shared_ptr<jt::RenderTargetLayer> const& renderer)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::copyFromAtlas");
+    // atlas pages cannot be read back, so the region is rendered into a texture of its own. This
+    // avoids decoding the image again.
+    SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "0");
+    auto texture = std::shared_ptr<SDL_Texture>(
+        SDL_CreateTexture(renderer.get(), SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_TARGET,
+            region.rect.width, region.rect.height),
+        [](SDL_Texture* t) { SDL_DestroyTexture(t); });
+    if (texture == nullptr) {
+        throw std::logic_error { "cannot create texture for '" + str + "'" };
+    }
+    SDL_SetTextureBlendMode(texture.get(), SDL_BLENDMODE_BLEND);
+
+    auto* oldTarget = SDL_GetRenderTarget(renderer.get());
+    SDL_SetRenderTarget(renderer.get(), texture.get());
+    // copy the pixels including alpha instead of blending them onto the empty texture
+    SDL_SetTextureBlendMode(region.texture.get(), SDL_BLENDMODE_NONE);
+    SDL_Rect const sourceRect { region.rect.left, region.rect.top, region.rect.width,
+        region.rect.height };
+    SDL_RenderCopy(renderer.get(), region.texture.get(), &sourceRect, nullptr);
+    SDL_SetTextureBlendMode(region.texture.get(), SDL_BLENDMODE_BLEND);
+    SDL_SetRenderTarget(renderer.get(), oldTarget);
+
+    m_textures[str] = texture;
+    return texture;
+}
+
+jt::TextureRegion TextureManagerImpl::getRegion(std::string const& str)
+{
+    return getRegion(getHandle(str));
+}
+
+jt::TextureHandle TextureManagerImpl::getHandle(std::string const& str)
+{
+    if (str.empty()) {
+        throw std::invalid_argument { "TextureManager getHandle: string must not be empty" };
+    }
+    auto const handle = m_names.intern(str);
+    if (handle.id >= m_handleEntries.size()) {
+        m_handleEntries.resize(m_names.size());
+    }
+    return handle;
+}
+
+jt::TextureRegion TextureManagerImpl::getRegion(jt::TextureHandle handle)
+{
+    if (!m_names.contains(handle)) {
+        throw std::invalid_argument { "TextureManager getRegion: unknown texture handle" };
+    }
+    if (auto const& region = m_handleEntries[handle.id].region; region.has_value()) {
+        return region.value();
+    }
+    // copy the name, creating the region might intern further names
+    auto const region = createRegion(std::string { m_names.getName(handle) });
+    m_handleEntries[handle.id].region = region;
+    return region;
+}
+
+jt::TextureHandle TextureManagerImpl::getFlashHandle(jt::TextureHandle handle)
+{
+    if (!m_names.contains(handle)) {
+        throw std::invalid_argument { "TextureManager getFlashHandle: unknown texture handle" };
+    }
+    if (m_handleEntries[handle.id].flash.isValid()) {
+        return m_handleEntries[handle.id].flash;
+    }
+    auto const flash = getHandle(getFlashName(m_names.getName(handle)));
+    m_handleEntries[handle.id].flash = flash;
+    return flash;
+}
+
+std::string TextureManagerImpl::getName(jt::TextureHandle handle) const
+{
+    return m_names.getName(handle);
+}
+
+jt::TextureRegion TextureManagerImpl::createRegion(std::string const& str)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::createRegion");
+    if (auto const it = m_regions.find(str); it != m_regions.end()) {
+        return it->second;
+    }
+
+    if (m_atlasEnabled && !str.empty() && !containsTexture(str)) {
+        auto renderer = m_renderer.lock();
+        if (!renderer) {
+            throw std::logic_error { "renderer not available for TextureManager::getRegion()" };
+        }
+        if (!str.ends_with(flashPostfix)) {
+            auto decoded = createDecodedImage(str);
+            if (decoded.image != nullptr) {
+                auto const isPacked = packIntoAtlas(str, decoded.image, renderer);
+                if (!isPacked) {
+                    m_textures[str] = createTextureFromSurface(decoded.image, renderer);
+                }
+                if (!isFileTexture(str)) {
+                    // special images are their own flash image
+                    if (isPacked) {
+                        m_regions[getFlashName(str)] = m_regions[str];
+                    } else {
+                        m_textures[getFlashName(str)] = m_textures[str];
+                    }
+                } else {
+                    m_flashMasks[str] = std::move(decoded.flashMask);
+                }
+                if (isPacked) {
+                    return m_regions[str];
+                }
+            }
+        } else {
+            auto const imageName = getImageName(str);
+            getRegion(imageName);
+            if (auto const it = m_regions.find(str); it != m_regions.end()) {
+                return it->second;
+            }
+            // flash images of packed images are packed as well
+            if (m_regions.contains(imageName) && m_flashMasks.contains(imageName)) {
+                auto const& mask = m_flashMasks.at(imageName);
+                auto const pixels = jt::createFlashPixels(mask);
+                auto const w = static_cast<int>(mask.width);
+                auto const h = static_cast<int>(mask.height);
+                if (!packIntoAtlas(str, pixels.data(), w, h, w * 4, renderer)) {
+                    m_textures[str] = createTextureFromPixels(renderer, pixels.data(), w, h);
+                }
+                m_flashMasks.erase(imageName);
+                if (auto const it = m_regions.find(str); it != m_regions.end()) {
+                    return it->second;
+                }
+            }
+        }
+    }
+
+    auto const texture = get(str);
+    int w { 0 };
+    int h { 0 };
+    SDL_QueryTexture(texture.get(), nullptr, nullptr, &w, &h);
+    return jt::TextureRegion { texture, jt::Recti { 0, 0, w, h } };
+}
+
+void TextureManagerImpl::setAtlasEnabled(bool enabled) { m_atlasEnabled = enabled; }
 
-void TextureManagerImpl::reset() { m_textures.clear(); }
+jt::TextureManagerStats TextureManagerImpl::getStats() const
+{
+    jt::TextureManagerStats stats {};
+    stats.numberOfPages = m_pages.size();
+    stats.numberOfPackedImages = m_regions.size();
+    for (auto const& kvp : m_textures) {
+        if (kvp.first.ends_with(flashPostfix)) {
+            ++stats.numberOfFlashTextures;
+        } else {
+            ++stats.numberOfStandaloneImages;
+        }
+    }
+    for (auto const& page : m_pages) {
+        stats.usedPixels += page.packer.getUsedArea();
+        stats.totalPixels += static_cast<std::uint64_t>(page.packer.getWidth())
+            * static_cast<std::uint64_t>(page.packer.getHeight());
+    }
+    stats.numberOfTextureBinds = jt::TextureBindCounter::getNumberOfBindsInLastFrame();
+    stats.numberOfDraws = jt::TextureBindCounter::getNumberOfDrawsInLastFrame();
+    stats.numberOfDeferredFlashImages = m_flashMasks.size();
+    for (auto const& kvp : m_flashMasks) {
+        auto const& mask = kvp.second;
+        // a flash texture would use four bytes per pixel
+        stats.savedFlashTextureBytes += 4u * static_cast<std::uint64_t>(mask.getSizeInBytes());
+        stats.flashMaskBytes += mask.getSizeInBytes();
+    }
+    return stats;
+}
 
-size_t TextureManagerImpl::getNumberOfTextures() noexcept { return m_textures.size(); }
+bool TextureManagerImpl::packIntoAtlas(std::string const& str,
+    std::shared_ptr<SDL_Surface> const& image,
+    std::shared_ptr<jt::RenderTargetLayer> const& renderer)
+{
+    return packIntoAtlas(str, image->pixels, image->w, image->h, image->pitch, renderer);
+}
+
+bool TextureManagerImpl::packIntoAtlas(std::string const& str, void const* rgba, int w, int h,
+    int pitch, std::shared_ptr<jt::RenderTargetLayer> const& renderer)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::packIntoAtlas");
+    auto const pageSize = getAtlasPageSize(renderer);
+    auto const slotWidth = w + atlasPadding;
+    auto const slotHeight = h + atlasPadding;
+    if (w > maxAtlasImageSize || h > maxAtlasImageSize || slotWidth > pageSize
+        || slotHeight > pageSize) {
+        return false;
+    }
+
+    AtlasPage* page { nullptr };
+    std::optional<jt::Recti> slot {};
+    for (auto& p : m_pages) {
+        slot = p.packer.insert(slotWidth, slotHeight);
+        if (slot.has_value()) {
+            page = &p;
+            break;
+        }
+    }
+    if (!slot.has_value()) {
+        auto texture = createAtlasPageTexture(renderer, pageSize);
+        if (texture == nullptr) {
+            return false;
+        }
+        page = &m_pages.emplace_back(
+            AtlasPage { std::move(texture), jt::SkylinePacker { pageSize, pageSize } });
+        slot = page->packer.insert(slotWidth, slotHeight);
+    }
+
+    jt::Recti const rect { slot->left, slot->top, w, h };
+    SDL_Rect const sdlRect { rect.left, rect.top, rect.width, rect.height };
+    SDL_UpdateTexture(page->texture.get(), &sdlRect, rgba, pitch);
+    m_regions[str] = jt::TextureRegion { page->texture, rect };
+    return true;
+}
+
+std::string TextureManagerImpl::getFlashName(std::string const& str)
+{
+    return str + std::string { flashPostfix };
+}
+
+void TextureManagerImpl::prepare(std::string const& str)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::prepare");
+    if (str.empty() || !isFileTexture(str)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+        if (m_prepared->images.contains(str) || m_prepared->uploaded.contains(str)) {
+            return;
+        }
+    }
+
+    // decode without holding the lock, so multiple files can be prepared in parallel
+    DecodedImage decoded {};
+    decoded.image = decodeFileSurface(str);
+    decoded.flashMask = createFlashMask(decoded.image);
+
+    std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+    if (!m_prepared->uploaded.contains(str)) {
+        m_prepared->images.try_emplace(str, std::move(decoded));
+    }
+}
+
+TextureManagerImpl::DecodedImage TextureManagerImpl::takeDecodedImage(std::string const& str)
+{
+    {
+        std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+        m_prepared->uploaded.insert(str);
+        auto node = m_prepared->images.extract(str);
+        if (!node.empty()) {
+            return std::move(node.mapped());
+        }
+    }
+
+    DecodedImage decoded {};
+    decoded.image = decodeFileSurface(str);
+    decoded.flashMask = createFlashMask(decoded.image);
+    return decoded;
+}
+
+TextureManagerImpl::DecodedImage TextureManagerImpl::createDecodedImage(std::string const& str)
+{
+    if (isFileTexture(str)) {
+        return takeDecodedImage(str);
+    }
+    // special images are their own flash image, so they do not need a mask
+    DecodedImage decoded {};
+    decoded.image = createSpecialSurface(str);
+    return decoded;
+}
+
+void TextureManagerImpl::reset()
+{
+    m_textures.clear();
+    m_regions.clear();
+    m_pages.clear();
+    m_flashMasks.clear();
+    m_names.clear();
+    m_handleEntries.clear();
+    std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+    m_prepared->images.clear();
+    m_prepared->uploaded.clear();
+}
+
+size_t TextureManagerImpl::getNumberOfTextures() noexcept
+{
+    return m_textures.size() + m_pages.size();
+}
 
 } // namespace jt
@@ -1,12 +1,18 @@
 ﻿#ifndef JAMTEMPLATE_TEXTUREMANAGER_HPP
 #define JAMTEMPLATE_TEXTUREMANAGER_HPP
 
+#include <graphics/alpha_mask.hpp>
+#include <graphics/skyline_packer.hpp>
 #include <render_target_layer.hpp>
 #include <sdl_2_include.hpp>
 #include <texture_manager_interface.hpp>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
 #include <string>
+#include <vector>
 
 namespace jt {
 
@@ -15,6 +21,19 @@ public:
     explicit TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> renderer);
     std::shared_ptr<SDL_Texture> get(std::string const& str) override;
 
+    jt::TextureRegion getRegion(std::string const& str) override;
+
+    jt::TextureHandle getHandle(std::string const& str) override;
+    jt::TextureRegion getRegion(jt::TextureHandle handle) override;
+    jt::TextureHandle getFlashHandle(jt::TextureHandle handle) override;
+    std::string getName(jt::TextureHandle handle) const override;
+
+    void setAtlasEnabled(bool enabled) override;
+
+    jt::TextureManagerStats getStats() const override;
+
+    void prepare(std::string const& str) override;
+
     // reset all stored images
     void reset() override;
 
@@ -23,8 +42,57 @@ public:
     std::size_t getNumberOfTextures() noexcept override;
 
 private:
+    struct DecodedImage {
+        // RGBA32 pixels
+        std::shared_ptr<SDL_Surface> image { nullptr };
+        // the flash image is created from the mask when it is used for the first time
+        jt::AlphaMask flashMask {};
+    };
+
+    // images decoded by prepare(), shared with worker threads
+    struct PreparedImages {
+        std::mutex mutex {};
+        std::map<std::string, DecodedImage> images {};
+        // file textures that are already uploaded, so prepare() does not decode them again
+        std::set<std::string> uploaded {};
+    };
+
+    // state of a handle, indexed by the handle id
+    struct HandleEntry {
+        std::optional<jt::TextureRegion> region {};
+        jt::TextureHandle flash {};
+    };
+
+    struct AtlasPage {
+        std::shared_ptr<SDL_Texture> texture { nullptr };
+        jt::SkylinePacker packer;
+    };
+
     std::map<std::string, std::shared_ptr<SDL_Texture>> m_textures;
     std::weak_ptr<jt::RenderTargetLayer> m_renderer;
+    // in a unique_ptr to keep the texture manager movable
+    std::unique_ptr<PreparedImages> m_prepared { std::make_unique<PreparedImages>() };
+
+    jt::TextureNameTable m_names {};
+    std::vector<HandleEntry> m_handleEntries {};
+
+    bool m_atlasEnabled { false };
+    std::vector<AtlasPage> m_pages {};
+    std::map<std::string, jt::TextureRegion> m_regions {};
+    // masks of file images whose flash image was not requested yet
+    std::map<std::string, jt::AlphaMask> m_flashMasks {};
+
+    jt::TextureRegion createRegion(std::string const& str);
+    DecodedImage takeDecodedImage(std::string const& str);
+    DecodedImage createDecodedImage(std::string const& str);
+    bool packIntoAtlas(std::string const& str, std::shared_ptr<SDL_Surface> const& image,
+        std::shared_ptr<jt::RenderTargetLayer> const& renderer);
+    bool packIntoAtlas(std::string const& str, void const* rgba, int w, int h, int pitch,
+        std::shared_ptr<jt::RenderTargetLayer> const& renderer);
+    std::shared_ptr<SDL_Texture> createFlashTexture(
+        std::string const& flashName, std::shared_ptr<jt::RenderTargetLayer> const& renderer);
+    std::shared_ptr<SDL_Texture> copyFromAtlas(std::string const& str,
+        jt::TextureRegion const& region, std::shared_ptr<jt::RenderTargetLayer> const& renderer);
 
     bool containsTexture(std::string const& str) { return (m_textures.count(str) != 0); }
 };
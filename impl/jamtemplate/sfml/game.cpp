@@ -1,11 +1,20 @@
 ﻿#include "game.hpp"
+#include <log/log_macros.hpp>
+#include <array>
+#include <string_view>
+
+namespace {
+
+constexpr std::array<std::string_view, 2> gameTags { "jt", "game" };
+
+} // namespace
 
 jt::Game::Game(GfxInterface& gfx, InputManagerInterface& input, AudioInterface& audio,
     StateManagerInterface& stateManager, LoggerInterface& logger,
     ActionCommandManagerInterface& actionCommandManager, jt::CacheInterface& cache)
     : GameBase { gfx, input, audio, stateManager, logger, actionCommandManager, cache }
 {
-    m_logger.debug("Game constructor", { "jt", "game" });
+    JT_LOG_DEBUG(m_logger, "Game constructor", gameTags);
 }
 
 void jt::Game::startGame(GameLoopFunctionPtr gameloop_function)
@@ -1,10 +1,12 @@
 #include "gfx_impl.hpp"
 #include "performance_measurement.hpp"
+#include <graphics/texture_manager_stats.hpp>
 #include <math_helper.hpp>
 #include <rect_lib.hpp>
 #include <sprite.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 #include <vector_lib.hpp>
+#include <chrono>
 
 namespace {
 
@@ -46,7 +48,7 @@ void jt::GfxImpl::reset() { m_camera.reset(); }
 
 void jt::GfxImpl::update(float elapsed)
 {
-    ZoneScopedN("jt::GfxImpl::update");
+    JT_PROFILE_ZONE("jt::GfxImpl::update");
     m_camera.update(elapsed);
 
     m_target->forall([this](auto t) { t->setView(*m_view); });
@@ -60,25 +62,36 @@ void jt::GfxImpl::clear() { m_target->clearPixels(); }
 
 void jt::GfxImpl::display()
 {
-    m_target->forall([this](auto& layer) { drawOneZLayer(layer); });
+    JT_PROFILE_ZONE("jt::GfxImpl::display");
+    auto layerStats = m_compositorStats.layers.begin();
+    for (auto& kvp : m_layerSprites) {
+        auto& stats = *layerStats++;
+        stats = m_target->getLayerStats(kvp.first);
+        // nothing was drawn to this layer, so it is still transparent
+        if (!stats.isCleared) {
+            continue;
+        }
+        auto const start = std::chrono::steady_clock::now();
+        drawOneZLayer(kvp.second);
+        stats.isComposited = true;
+        stats.compositeTimeInSeconds
+            = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+    }
+    auto const presentStart = std::chrono::steady_clock::now();
     m_window.display();
+    m_framePacing.onPresent(
+        std::chrono::duration<float>(std::chrono::steady_clock::now() - presentStart).count());
+    m_compositorStats.pacing = m_framePacing.getStats();
+
+    jt::TextureBindCounter::endFrame();
 }
 
-void jt::GfxImpl::drawOneZLayer(std::shared_ptr<jt::RenderTargetLayer> const& layer)
+void jt::GfxImpl::drawOneZLayer(std::unique_ptr<jt::Sprite>& layerSprite)
 {
-    if (layer == nullptr) [[unlikely]] {
-        throw std::invalid_argument {
-            "GfXImpl::display called with nullptr jt::RenderTargetLayer"
-        };
-    }
-    // convert renderTarget to sprite and draw that
-    auto spriteForDrawing = std::make_unique<jt::Sprite>();
-    spriteForDrawing->fromTexture(layer->getTexture());
-    auto const shakeOffset = m_camera.getShakeOffset();
-    spriteForDrawing->setPosition(shakeOffset);
+    layerSprite->setPosition(m_camera.getShakeOffset());
     // Note: RenderTexture has a bug and is displayed upside down
-    horizontalFlip(spriteForDrawing, m_camera.getZoom(), m_window.getSize().y);
-    m_window.draw(spriteForDrawing);
+    horizontalFlip(layerSprite, m_camera.getZoom(), m_window.getSize().y);
+    m_window.draw(layerSprite);
 }
 
 void jt::GfxImpl::createZLayer(int z)
@@ -92,4 +105,11 @@ void jt::GfxImpl::createZLayer(int z)
     target->setSmooth(false);
 
     m_target->add(z, target);
+
+    auto layerSprite = std::make_unique<jt::Sprite>();
+    layerSprite->fromTexture(target->getTexture());
+    m_layerSprites[z] = std::move(layerSprite);
+    m_compositorStats.layers.resize(m_layerSprites.size());
 }
+
+jt::CompositorStats jt::GfxImpl::getCompositorStats() const { return m_compositorStats; }
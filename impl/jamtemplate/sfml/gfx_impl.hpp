@@ -2,10 +2,13 @@
 #define JAMTEMPLATE_GFX_IMPL_HPP
 
 #include <camera.hpp>
+#include <graphics/compositor_stats.hpp>
 #include <graphics/gfx_interface.hpp>
 #include <graphics/render_window.hpp>
 #include <render_target_lib.hpp>
 #include <texture_manager_impl.hpp>
+#include <map>
+#include <memory>
 #include <optional>
 
 namespace jt {
@@ -26,6 +29,8 @@ public:
 
     void createZLayer(int z) override;
 
+    jt::CompositorStats getCompositorStats() const override;
+
 private:
     RenderWindowInterface& m_window;
     CamInterface& m_camera;
@@ -34,7 +39,12 @@ private:
     std::optional<jt::TextureManagerImpl> m_textureManager {};
     std::shared_ptr<sf::View> m_view { nullptr };
 
-    void drawOneZLayer(std::shared_ptr<jt::RenderTargetLayer> const& layer);
+    /// sprites showing the layer textures, created once per layer and reused every frame
+    std::map<int, std::unique_ptr<jt::Sprite>> m_layerSprites {};
+    jt::CompositorStats m_compositorStats {};
+    jt::FramePacingCounter m_framePacing {};
+
+    void drawOneZLayer(std::unique_ptr<jt::Sprite>& layerSprite);
 };
 
 } // namespace jt
@@ -1,30 +1,63 @@
 #include "render_target_lib.hpp"
+#include <chrono>
 
 void jt::RenderTarget::forall(
     std::function<void(std::shared_ptr<jt::RenderTargetLayer>&)> const& func)
 {
     for (auto& kvp : m_targets) {
-        func(kvp.second);
+        func(kvp.second.target);
     }
 }
 
-std::shared_ptr<jt::RenderTargetLayer> jt::RenderTarget::get(int z) { return m_targets[z]; }
-
-void jt::RenderTarget::add(int z, std::shared_ptr<jt::RenderTargetLayer> target)
+std::shared_ptr<jt::RenderTargetLayer> jt::RenderTarget::get(int z)
 {
-    m_targets[z] = target;
+    auto const it = m_targets.find(z);
+    if (it == m_targets.end()) [[unlikely]] {
+        return nullptr;
+    }
+    auto& layer = it->second;
+    if (!layer.stats.isCleared) {
+        clearLayer(layer);
+    }
+    ++layer.stats.numberOfDrawRequests;
+    return layer.target;
 }
 
-void jt::RenderTarget::clearPixels() const
+void jt::RenderTarget::add(int z, std::shared_ptr<jt::RenderTargetLayer> target)
 {
+    m_targets[z] = Layer { target, false, jt::LayerStats { z } };
     bool first { true };
+    for (auto& kvp : m_targets) {
+        kvp.second.isBackground = first;
+        first = false;
+    }
+}
 
-    for (auto const& kvp : m_targets) {
-        if (first) {
-            kvp.second->clear(sf::Color::Black);
-            first = false;
-        } else {
-            kvp.second->clear(sf::Color::Transparent);
+void jt::RenderTarget::clearPixels()
+{
+    for (auto& kvp : m_targets) {
+        auto& layer = kvp.second;
+        layer.stats = jt::LayerStats { kvp.first };
+        if (layer.isBackground) {
+            clearLayer(layer);
         }
     }
 }
+
+jt::LayerStats jt::RenderTarget::getLayerStats(int z) const
+{
+    auto const it = m_targets.find(z);
+    if (it == m_targets.end()) {
+        return jt::LayerStats { z };
+    }
+    return it->second.stats;
+}
+
+void jt::RenderTarget::clearLayer(Layer& layer) const
+{
+    auto const start = std::chrono::steady_clock::now();
+    layer.target->clear(layer.isBackground ? sf::Color::Black : sf::Color::Transparent);
+    layer.stats.isCleared = true;
+    layer.stats.clearTimeInSeconds
+        = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count();
+}
@@ -1,20 +1,40 @@
 #ifndef JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 #define JAMTEMPLATE_RENDER_TARGET_LIB_HPP
 
+#include <graphics/compositor_stats.hpp>
 #include <graphics/render_target_interface.hpp>
 
 namespace jt {
 
 class RenderTarget : public RenderTargetInterface {
 public:
+    /// Get the layer for drawing. The first request in a frame clears the layer and marks it as
+    /// used.
+    /// \param z the z value
+    /// \return the layer or nullptr if no layer was created for z
     std::shared_ptr<jt::RenderTargetLayer> get(int z) override;
 
     void forall(std::function<void(std::shared_ptr<jt::RenderTargetLayer>&)> const& func);
     void add(int z, std::shared_ptr<jt::RenderTargetLayer> target);
-    void clearPixels() const;
+
+    /// Start a new frame. Layers are cleared lazily on their first use in the frame, except for the
+    /// lowest layer, which is always cleared as it is the background of the window.
+    void clearPixels();
+
+    /// Get the statistics of a layer since the last call to clearPixels()
+    /// \param z the z value
+    /// \return the statistics, without composite time
+    jt::LayerStats getLayerStats(int z) const;
 
 private:
-    std::map<int, std::shared_ptr<jt::RenderTargetLayer>> m_targets;
+    struct Layer {
+        std::shared_ptr<jt::RenderTargetLayer> target { nullptr };
+        bool isBackground { false };
+        jt::LayerStats stats {};
+    };
+    std::map<int, Layer> m_targets;
+
+    void clearLayer(Layer& layer) const;
 };
 
 } // namespace jt
@@ -1,7 +1,7 @@
 ﻿#include "render_window_lib.hpp"
 #include "performance_measurement.hpp"
 #include <sprite.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
 #include <imgui-SFML.h>
 #include <imgui.h>
 
@@ -49,7 +49,7 @@ jt::Vector2f jt::RenderWindow::getSize() const noexcept { return m_size; }
 
 void jt::RenderWindow::draw(std::unique_ptr<jt::Sprite>& spr)
 {
-    ZoneScopedN("jt::RenderWindow::draw");
+    JT_PROFILE_ZONE("jt::RenderWindow::draw");
     if (!spr) [[unlikely]] {
         throw std::invalid_argument { "Cannot draw nullptr sprite" };
     }
@@ -58,7 +58,7 @@ void jt::RenderWindow::draw(std::unique_ptr<jt::Sprite>& spr)
 
 void jt::RenderWindow::display()
 {
-    ZoneScopedN("jt::RenderWindow::display");
+    JT_PROFILE_ZONE("jt::RenderWindow::display");
     if (m_renderGui) {
         m_hasBeenUpdatedAlready = false;
         ImGui::SFML::Render(*m_window.get());
@@ -1,26 +1,80 @@
 ﻿#include "sprite.hpp"
 #include <color_lib.hpp>
+#include <graphics/texture_manager_stats.hpp>
 #include <math_helper.hpp>
 #include <rect_lib.hpp>
 #include <vector_lib.hpp>
+#include <stdexcept>
+
+namespace {
+
+sf::IntRect getSubRect(jt::TextureRegion const& region, jt::Recti const& rect)
+{
+    return toLib(jt::Recti { region.rect.left + rect.left, region.rect.top + rect.top, rect.width,
+        rect.height });
+}
+
+} // namespace
 
 jt::Sprite::Sprite() { }
 
 jt::Sprite::Sprite(std::string const& fileName, jt::TextureManagerInterface& textureManager)
-    : m_sprite { sf::Sprite { textureManager.get(fileName) } }
-    , m_flashSprite { sf::Sprite { textureManager.get(textureManager.getFlashName(fileName)) } }
+    : m_textureManager { &textureManager }
+    , m_handle { textureManager.getHandle(fileName) }
 {
+    auto const region = textureManager.getRegion(m_handle);
+    m_sprite = sf::Sprite { *region.texture, toLib(region.rect) };
+    m_regionRect = toLib(region.rect);
+    m_rectInImage = jt::Recti { 0, 0, region.rect.width, region.rect.height };
 }
 
 jt::Sprite::Sprite(
     std::string const& fileName, jt::Recti const& rect, jt::TextureManagerInterface& textureManager)
-    : m_sprite { sf::Sprite { textureManager.get(fileName), toLib(rect) } }
-    , m_flashSprite { sf::Sprite {
-          textureManager.get(textureManager.getFlashName(fileName)), toLib(rect) } }
+    : Sprite { textureManager.getHandle(fileName), rect, textureManager }
+{
+}
+
+jt::Sprite::Sprite(
+    jt::TextureHandle handle, jt::Recti const& rect, jt::TextureManagerInterface& textureManager)
+    : m_textureManager { &textureManager }
+    , m_handle { handle }
+    , m_rectInImage { rect }
 {
+    auto const region = textureManager.getRegion(handle);
+    m_sprite = sf::Sprite { *region.texture, getSubRect(region, rect) };
+    m_regionRect = toLib(region.rect);
 }
 
-void jt::Sprite::fromTexture(sf::Texture const& text) { m_sprite.setTexture(text); }
+void jt::Sprite::fromTexture(sf::Texture const& text)
+{
+    m_sprite.setTexture(text);
+    m_regionRect = sf::IntRect {};
+}
+
+void jt::Sprite::setTextureRect(jt::TextureHandle handle, jt::Recti const& rect)
+{
+    if (m_textureManager == nullptr) {
+        throw std::logic_error { "sprite was not created by a texture manager" };
+    }
+    if (handle != m_handle) {
+        auto const region = m_textureManager->getRegion(handle);
+        m_sprite.setTexture(*region.texture);
+        m_regionRect = toLib(region.rect);
+        m_handle = handle;
+        cleanImage();
+    }
+    m_rectInImage = rect;
+    m_sprite.setTextureRect(sf::IntRect { m_regionRect.left + rect.left,
+        m_regionRect.top + rect.top, rect.width, rect.height });
+
+    if (m_flashSprite.getTexture() != nullptr) {
+        // keep showing the matching part of the flash image
+        auto const flashRegion
+            = m_textureManager->getRegion(m_textureManager->getFlashHandle(m_handle));
+        m_flashSprite.setTexture(*flashRegion.texture);
+        m_flashSprite.setTextureRect(getSubRect(flashRegion, m_rectInImage));
+    }
+}
 
 void jt::Sprite::setPosition(jt::Vector2f const& pos) { m_position = pos; }
 
@@ -54,6 +108,14 @@ jt::Color jt::Sprite::getColorAtPixel(jt::Vector2u pixelPos) const
     if (!m_imageStored) {
         m_imageStored = true;
         m_image = m_sprite.getTexture()->copyToImage();
+        if (m_regionRect.width != 0) {
+            // only keep the part of the atlas page that belongs to this sprite
+            sf::Image regionImage {};
+            regionImage.create(static_cast<unsigned int>(m_regionRect.width),
+                static_cast<unsigned int>(m_regionRect.height));
+            regionImage.copy(m_image, 0u, 0u, m_regionRect);
+            m_image = regionImage;
+        }
     }
     return jt::Color { fromLib(m_image.getPixel(pixelPos.x, pixelPos.y)) };
 }
@@ -81,6 +143,7 @@ void jt::Sprite::doDrawShadow(std::shared_ptr<jt::RenderTargetLayer> const sptr)
 
     m_sprite.setPosition(toLib(jt::MathHelper::castToInteger(oldPos + getShadowOffset())));
     m_sprite.setColor(toLib(getShadowColor()));
+    jt::TextureBindCounter::onDraw(m_sprite.getTexture());
     sptr->draw(m_sprite);
 
     m_sprite.setPosition(toLib(oldPos));
@@ -102,6 +165,7 @@ void jt::Sprite::doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr
 
     for (auto const outlineOffset : getOutlineOffsets()) {
         m_sprite.setPosition(toLib(jt::MathHelper::castToInteger(oldPos + outlineOffset)));
+        jt::TextureBindCounter::onDraw(m_sprite.getTexture());
         sptr->draw(m_sprite);
     }
 
@@ -116,20 +180,36 @@ void jt::Sprite::doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
     }
 
     sf::RenderStates const states { getSfBlendMode() };
+    jt::TextureBindCounter::onDraw(m_sprite.getTexture());
     sptr->draw(m_sprite, states);
 }
 
 void jt::Sprite::doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const
 {
-    if (!sptr) [[unlikely]] {
+    if (!sptr || m_flashSprite.getTexture() == nullptr) [[unlikely]] {
         return;
     }
 
     m_flashSprite.setPosition(m_lastScreenPosition);
     m_flashSprite.setColor(toLib(getFlashColor()));
+    jt::TextureBindCounter::onDraw(m_flashSprite.getTexture());
     sptr->draw(m_flashSprite);
 }
 
+void jt::Sprite::doFlashImpl(float /*t*/, jt::Color /*col*/)
+{
+    if (m_flashSprite.getTexture() != nullptr || m_textureManager == nullptr) {
+        return;
+    }
+    // most sprites are never flashed, so the flash image is only requested here
+    auto const flashRegion
+        = m_textureManager->getRegion(m_textureManager->getFlashHandle(m_handle));
+    m_flashSprite = sf::Sprite { *flashRegion.texture, getSubRect(flashRegion, m_rectInImage) };
+    m_flashSprite.setScale(m_sprite.getScale());
+    m_flashSprite.setRotation(m_sprite.getRotation());
+    m_flashSprite.setOrigin(m_sprite.getOrigin());
+}
+
 void jt::Sprite::doRotate(float rot)
 {
     m_sprite.setRotation(rot);
@@ -21,6 +21,20 @@ public:
     Sprite(std::string const& fileName, jt::Recti const& rect,
         jt::TextureManagerInterface& textureManager);
 
+    /// Constructor for a texture handle. Faster than the file name constructors when many
+    /// sprites share a texture, e.g. animation frames or tiles.
+    /// \param handle texture handle from the texture manager
+    /// \param rect part of the texture shown by the sprite
+    /// \param textureManager the texture manager that created the handle
+    Sprite(jt::TextureHandle handle, jt::Recti const& rect,
+        jt::TextureManagerInterface& textureManager);
+
+    /// Show a different part of a texture. All other properties of the sprite are kept, so one
+    /// sprite can show all frames of an animation.
+    /// \param handle texture handle from the texture manager the sprite was created with
+    /// \param rect part of the texture to show
+    void setTextureRect(jt::TextureHandle handle, jt::Recti const& rect);
+
     // WARNING: This function is slow, because it needs to copy
     // graphics memory to ram first.
     jt::Color getColorAtPixel(jt::Vector2u pixelPos) const;
@@ -53,6 +67,13 @@ private:
     // optimization for getColorAtPixel
     mutable sf::Image m_image;
     mutable bool m_imageStored { false };
+    // region of the texture that belongs to this sprite, empty if it is the whole texture
+    sf::IntRect m_regionRect {};
+
+    // needed to create the flash sprite on the first call to flash()
+    jt::TextureManagerInterface* m_textureManager { nullptr };
+    jt::TextureHandle m_handle {};
+    jt::Recti m_rectInImage {};
 
     jt::Vector2f m_position { 0.0f, 0.0f };
 
@@ -64,6 +85,7 @@ private:
     void doDrawOutline(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDraw(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
     void doDrawFlash(std::shared_ptr<jt::RenderTargetLayer> const sptr) const override;
+    void doFlashImpl(float t, jt::Color col) override;
     void doRotate(float rot) override;
 };
 
@@ -0,0 +1,85 @@
+#include "sprite_batch.hpp"
+#include <color_lib.hpp>
+#include <graphics/texture_manager_stats.hpp>
+#include <vector_lib.hpp>
+#include <algorithm>
+
+void jt::SpriteBatch::clear()
+{
+    for (auto& b : m_batches) {
+        b.vertices.clear();
+    }
+    m_numberOfQuads = 0u;
+    m_lastSprite = nullptr;
+}
+
+void jt::SpriteBatch::add(
+    jt::Sprite const& sprite, QuadCorners const& corners, jt::Color const& color)
+{
+    if (&sprite != m_lastSprite) {
+        auto const sfSprite = sprite.getSFSprite();
+        m_lastSprite = &sprite;
+        m_lastBatchIndex = getBatchIndexForTexture(sfSprite.getTexture());
+
+        auto const rect = sfSprite.getTextureRect();
+        auto const l = static_cast<float>(rect.left);
+        auto const t = static_cast<float>(rect.top);
+        auto const r = static_cast<float>(rect.left + rect.width);
+        auto const b = static_cast<float>(rect.top + rect.height);
+        m_lastTexCoords = { sf::Vector2f { l, t }, sf::Vector2f { r, t }, sf::Vector2f { r, b },
+            sf::Vector2f { l, b } };
+    }
+    auto& batch = m_batches[m_lastBatchIndex];
+
+    auto const col = toLib(color);
+    // two triangles per quad: (0, 1, 2) and (0, 2, 3)
+    for (auto const i : { 0u, 1u, 2u, 0u, 2u, 3u }) {
+        batch.vertices.append(sf::Vertex { toLib(corners[i]), col, m_lastTexCoords[i] });
+    }
+    ++m_numberOfQuads;
+}
+
+void jt::SpriteBatch::draw(std::shared_ptr<jt::RenderTargetLayer> const sptr,
+    jt::Vector2f const& offset, jt::BlendMode blendMode) const
+{
+    if (!sptr) [[unlikely]] {
+        return;
+    }
+
+    sf::RenderStates states { sf::BlendAlpha };
+    if (blendMode == jt::BlendMode::ADD) {
+        states.blendMode = sf::BlendAdd;
+    } else if (blendMode == jt::BlendMode::MUL) {
+        states.blendMode = sf::BlendMultiply;
+    }
+    states.transform.translate(offset.x, offset.y);
+
+    for (auto const& b : m_batches) {
+        if (b.vertices.getVertexCount() == 0) {
+            continue;
+        }
+        states.texture = b.texture;
+        jt::TextureBindCounter::onDraw(b.texture);
+        sptr->draw(b.vertices, states);
+    }
+}
+
+std::size_t jt::SpriteBatch::getNumberOfQuads() const noexcept { return m_numberOfQuads; }
+
+std::size_t jt::SpriteBatch::getNumberOfDrawCalls() const noexcept
+{
+    return static_cast<std::size_t>(std::count_if(m_batches.cbegin(), m_batches.cend(),
+        [](auto const& b) { return b.vertices.getVertexCount() != 0; }));
+}
+
+std::size_t jt::SpriteBatch::getBatchIndexForTexture(sf::Texture const* texture)
+{
+    // linear search: there are typically only very few textures (e.g. tilesets) per batch
+    for (auto i = 0u; i != m_batches.size(); ++i) {
+        if (m_batches[i].texture == texture) {
+            return i;
+        }
+    }
+    m_batches.push_back(Batch { texture, sf::VertexArray { sf::Triangles } });
+    return m_batches.size() - 1u;
+}
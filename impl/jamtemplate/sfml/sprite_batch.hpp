@@ -0,0 +1,65 @@
+#ifndef JAMTEMPLATE_SPRITE_BATCH_HPP
+#define JAMTEMPLATE_SPRITE_BATCH_HPP
+
+#include <SFML/Graphics.hpp>
+#include <color/color.hpp>
+#include <graphics/drawable_interface.hpp>
+#include <render_target_layer.hpp>
+#include <sprite.hpp>
+#include <vector.hpp>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace jt {
+
+/// Collects textured quads and draws all quads sharing a texture with a single draw call
+class SpriteBatch {
+public:
+    /// Corners of a quad in the order top left, top right, bottom right, bottom left
+    using QuadCorners = std::array<jt::Vector2f, 4>;
+
+    /// Remove all quads from the batch. Allocated memory is kept for reuse.
+    void clear();
+
+    /// Add a quad displaying the texture rect of the sprite
+    /// \param sprite the sprite to take texture and texture rect from
+    /// \param corners the corners of the quad in local coordinates
+    /// \param color the vertex color
+    void add(jt::Sprite const& sprite, QuadCorners const& corners, jt::Color const& color);
+
+    /// Draw all quads
+    /// \param sptr the render target
+    /// \param offset offset added to all quads
+    /// \param blendMode the blend mode used for drawing
+    void draw(std::shared_ptr<jt::RenderTargetLayer> const sptr, jt::Vector2f const& offset,
+        jt::BlendMode blendMode) const;
+
+    /// Get the number of quads in the batch
+    /// \return number of quads
+    std::size_t getNumberOfQuads() const noexcept;
+
+    /// Get the number of draw calls issued by one call to draw
+    /// \return number of draw calls
+    std::size_t getNumberOfDrawCalls() const noexcept;
+
+private:
+    struct Batch {
+        sf::Texture const* texture { nullptr };
+        sf::VertexArray vertices { sf::Triangles };
+    };
+    std::vector<Batch> m_batches {};
+    std::size_t m_numberOfQuads { 0u };
+
+    // cache for consecutive quads using the same sprite (e.g. particles)
+    jt::Sprite const* m_lastSprite { nullptr };
+    std::size_t m_lastBatchIndex { 0u };
+    std::array<sf::Vector2f, 4> m_lastTexCoords {};
+
+    std::size_t getBatchIndexForTexture(sf::Texture const* texture);
+};
+
+} // namespace jt
+
+#endif // JAMTEMPLATE_SPRITE_BATCH_HPP
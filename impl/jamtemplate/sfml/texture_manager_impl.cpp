@@ -1,45 +1,30 @@
 #include "texture_manager_impl.hpp"
-#include <aselib/image_builder.hpp>
-#include <color_lib.hpp>
+#include <graphics/alpha_mask.hpp>
+#include <graphics/aseprite_cache.hpp>
+#include <rect_lib.hpp>
 #include <sprite_functions.hpp>
 #include <strutils.hpp>
-#include <tracy/Tracy.hpp>
+#include <trace_profiler.hpp>
+#include <algorithm>
 #include <array>
 #include <stdexcept>
+#include <string_view>
 
 namespace {
 
+constexpr std::string_view flashPostfix { "___flash__" };
+constexpr unsigned int atlasPageSize { 2048u };
+// larger images get a texture of their own, so they do not waste most of an atlas page
+constexpr int maxAtlasImageSize { 512 };
+// transparent gap between packed images
+constexpr int atlasPadding { 1 };
+
 sf::Image createImageFromAse(std::string const& filename)
 {
-    auto const asepritePos = filename.rfind(".aseprite");
-    auto const splittedFilename = filename.substr(0, asepritePos + 9);
-    auto const postFix = filename.substr(asepritePos + 9);
-    aselib::AsepriteData aseData { filename };
-
-    std::unique_ptr<aselib::Image> aseImage { nullptr };
-    if (strutil::contains(postFix, ".layer=")) {
-        auto const layerPos = postFix.find(".layer=");
-        auto const layerName = postFix.substr(layerPos + 7);
-        aseImage = std::make_unique<aselib::Image>(aselib::makeImageFromLayer(aseData, layerName));
-    } else {
-        auto const ignore_transparent = strutil::contains(postFix, ".ignore_transparent");
-        aseImage = std::make_unique<aselib::Image>(
-            aselib::makeImageFromAse(aseData, !ignore_transparent));
-    }
-
+    auto const decoded = jt::loadDecodedAseprite(filename);
+    auto const size = decoded->getImageSize();
     sf::Image sfImgage {};
-    jt::Color emptyColor { 0, 0, 0, 0 };
-    auto const w = aseImage->m_width;
-    auto const h = aseImage->m_height;
-    sfImgage.create(w, h, toLib(emptyColor));
-
-    for (auto i = 0u; i != w; ++i) {
-        for (auto j = 0u; j != h; ++j) {
-            auto const p = aseImage->m_pixels[aseImage->posToIndex(i, j)];
-            auto const col = jt::Color { p.r, p.g, p.b, p.a };
-            sfImgage.setPixel(i, j, toLib(col));
-        }
-    }
+    sfImgage.create(size.x, size.y, decoded->getPixels().data());
     return sfImgage;
 }
 
@@ -120,30 +105,78 @@ sf::Image createRingImage(std::array<std::string, 2> const& ssv)
     return jt::SpriteFunctions::makeRing(ringImageSize);
 }
 
-sf::Image createFlashImage(sf::Image const& in)
+jt::AlphaMask createFlashMask(sf::Image const& image)
 {
-    sf::Image img { in };
+    return jt::createAlphaMask(
+        image.getPixelsPtr(), image.getSize().x, image.getSize().y, 4u * image.getSize().x);
+}
 
-    for (unsigned int i = 0; i != img.getSize().x; ++i) {
-        for (unsigned int j = 0; j != img.getSize().y; ++j) {
-            if (img.getPixel(i, j).a != 0) {
-                img.setPixel(i, j, toLib(jt::Color { 255, 255, 255 }));
-            }
-        }
+sf::Image createFlashImage(jt::AlphaMask const& mask)
+{
+    auto const pixels = jt::createFlashPixels(mask);
+    sf::Image image {};
+    image.create(mask.width, mask.height, pixels.data());
+    return image;
+}
+
+std::string getImageName(std::string const& flashName)
+{
+    return flashName.substr(0, flashName.size() - flashPostfix.size());
+}
+
+// special type of images
+sf::Image createSpecialImage(std::string const& str)
+{
+    if (str.at(1) == 'b') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createButtonImage(ssv);
+    } else if (str.at(1) == 'f') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createBlankImage(ssv);
+    } else if (str.at(1) == 'g') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createGlowImage(ssv);
+    } else if (str.at(1) == 'v') {
+        auto const ssv = strutil::split<3>(str.substr(1), '#');
+        return createVignetteImage(ssv);
+    } else if (str.at(1) == 'r') {
+        auto const ssv = strutil::split<2>(str.substr(1), '#');
+        return createRingImage(ssv);
     }
-    return img;
+    throw std::invalid_argument("ERROR: cannot get texture with name " + str);
 }
 
-sf::Texture loadTextureFromDisk(std::string const& str)
+sf::Image loadImageFromDisk(std::string const& str)
 {
-    sf::Texture t {};
-    if (!t.loadFromFile(str)) {
+    sf::Image img {};
+    if (!img.loadFromFile(str)) {
         throw std::invalid_argument { "invalid filename, cannot load texture from '" + str + "'" };
     }
-    return t;
+    return img;
+}
+
+bool isFileTexture(std::string const& str)
+{
+    return strutil::contains(str, ".aseprite") || !str.starts_with('#');
+}
+
+sf::Image decodeFileImage(std::string const& str)
+{
+    if (strutil::contains(str, ".aseprite")) {
+        return createImageFromAse(str);
+    }
+    return loadImageFromDisk(str);
 }
 } // namespace
 
+jt::TextureManagerImpl::AtlasPage::AtlasPage(unsigned int size)
+    : packer { static_cast<int>(size), static_cast<int>(size) }
+{
+    sf::Image transparent {};
+    transparent.create(size, size, sf::Color::Transparent);
+    texture.loadFromImage(transparent);
+}
+
 jt::TextureManagerImpl::TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> /*renderer*/)
 {
     // Nothing to do here
@@ -151,7 +184,7 @@ jt::TextureManagerImpl::TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer
 
 sf::Texture& jt::TextureManagerImpl::get(std::string const& str)
 {
-    ZoneScopedNC("jt::TextureManagerImpl::get", tracy::Color::Crimson);
+    JT_PROFILE_ZONE_COLOR("jt::TextureManagerImpl::get", tracy::Color::Crimson);
     if (str.empty()) {
         throw std::invalid_argument { "TextureManager get: string must not be empty" };
     }
@@ -162,56 +195,279 @@ sf::Texture& jt::TextureManagerImpl::get(std::string const& str)
         return m_textures[str];
     }
 
-    // Check if special ase parsing is required
-    if (strutil::contains(str, ".aseprite")) {
-        m_textures[str].loadFromImage(createImageFromAse(str));
-        m_textures[getFlashName(str)].loadFromImage(
-            createFlashImage(m_textures[str].copyToImage()));
-        return m_textures[str];
+    if (auto const it = m_regions.find(str); it != m_regions.end()) {
+        return copyFromAtlas(str, it->second);
     }
 
-    // normal filenames do not start with a '#'
-    if (!str.starts_with('#')) {
-        m_textures[str] = loadTextureFromDisk(str);
-        m_textures[getFlashName(str)].loadFromImage(
-            createFlashImage(m_textures[str].copyToImage()));
-        return m_textures[str];
+    // flash images are only created when they are used for the first time
+    if (str.ends_with(flashPostfix)) {
+        return createFlashTexture(str);
     }
 
-    // special type of images
-    if (str.at(1) == 'b') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createButtonImage(ssv));
-    } else if (str.at(1) == 'f') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createBlankImage(ssv));
-    } else if (str.at(1) == 'g') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createGlowImage(ssv));
-    } else if (str.at(1) == 'v') {
-        auto const ssv = strutil::split<3>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createVignetteImage(ssv));
-    } else if (str.at(1) == 'r') {
-        auto const ssv = strutil::split<2>(str.substr(1), '#');
-        m_textures[str].loadFromImage(createRingImage(ssv));
-    } else {
-        throw std::invalid_argument("ERROR: cannot get texture with name " + str);
-    }
+    // aseprite files and normal filenames (not starting with a '#') possibly decoded by prepare(),
+    // and special images
+    auto decoded = createDecodedImage(str);
+    m_textures[str].loadFromImage(decoded.image);
+    m_flashMasks[str] = std::move(decoded.flashMask);
+    return m_textures[str];
+}
 
-    // create Flash Image
-    m_textures[getFlashName(str)].loadFromImage(createFlashImage(m_textures[str].copyToImage()));
+sf::Texture& jt::TextureManagerImpl::createFlashTexture(std::string const& flashName)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::createFlashTexture");
+    auto const str = getImageName(flashName);
+    if (!m_flashMasks.contains(str) && !containsTexture(str) && !m_regions.contains(str)) {
+        get(str);
+    }
+    auto node = m_flashMasks.extract(str);
+    if (node.empty()) {
+        throw std::invalid_argument { "cannot create flash texture for '" + str + "'" };
+    }
+    m_textures[flashName].loadFromImage(createFlashImage(node.mapped()));
+    return m_textures[flashName];
+}
 
+sf::Texture& jt::TextureManagerImpl::copyFromAtlas(
+    std::string const& str, jt::TextureRegion const& region)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::copyFromAtlas");
+    // reading back the page is slow, but only happens once per image and avoids decoding it again
+    auto const page = region.texture->copyToImage();
+    sf::Image image {};
+    auto const rect = toLib(region.rect);
+    image.create(static_cast<unsigned int>(rect.width), static_cast<unsigned int>(rect.height));
+    image.copy(page, 0u, 0u, rect);
+    m_textures[str].loadFromImage(image);
     return m_textures[str];
 }
 
-void jt::TextureManagerImpl::reset() { m_textures.clear(); }
+jt::TextureRegion jt::TextureManagerImpl::getRegion(std::string const& str)
+{
+    return getRegion(getHandle(str));
+}
+
+jt::TextureHandle jt::TextureManagerImpl::getHandle(std::string const& str)
+{
+    if (str.empty()) {
+        throw std::invalid_argument { "TextureManager getHandle: string must not be empty" };
+    }
+    auto const handle = m_names.intern(str);
+    if (handle.id >= m_handleEntries.size()) {
+        m_handleEntries.resize(m_names.size());
+    }
+    return handle;
+}
+
+jt::TextureRegion jt::TextureManagerImpl::getRegion(jt::TextureHandle handle)
+{
+    if (!m_names.contains(handle)) {
+        throw std::invalid_argument { "TextureManager getRegion: unknown texture handle" };
+    }
+    if (auto const& region = m_handleEntries[handle.id].region; region.has_value()) {
+        return region.value();
+    }
+    // copy the name, creating the region might intern further names
+    auto const region = createRegion(std::string { m_names.getName(handle) });
+    m_handleEntries[handle.id].region = region;
+    return region;
+}
+
+jt::TextureHandle jt::TextureManagerImpl::getFlashHandle(jt::TextureHandle handle)
+{
+    if (!m_names.contains(handle)) {
+        throw std::invalid_argument { "TextureManager getFlashHandle: unknown texture handle" };
+    }
+    if (m_handleEntries[handle.id].flash.isValid()) {
+        return m_handleEntries[handle.id].flash;
+    }
+    auto const flash = getHandle(getFlashName(m_names.getName(handle)));
+    m_handleEntries[handle.id].flash = flash;
+    return flash;
+}
+
+std::string jt::TextureManagerImpl::getName(jt::TextureHandle handle) const
+{
+    return m_names.getName(handle);
+}
+
+jt::TextureRegion jt::TextureManagerImpl::createRegion(std::string const& str)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::createRegion");
+    if (auto const it = m_regions.find(str); it != m_regions.end()) {
+        return it->second;
+    }
+
+    if (m_atlasEnabled && !str.empty() && !containsTexture(str)) {
+        if (!str.ends_with(flashPostfix)) {
+            auto decoded = createDecodedImage(str);
+            m_flashMasks[str] = std::move(decoded.flashMask);
+            if (packIntoAtlas(str, decoded.image)) {
+                return m_regions[str];
+            }
+            m_textures[str].loadFromImage(decoded.image);
+        } else {
+            auto const imageName = getImageName(str);
+            getRegion(imageName);
+            // flash images of packed images are packed as well
+            if (m_regions.contains(imageName) && m_flashMasks.contains(imageName)) {
+                auto const flashImage = createFlashImage(m_flashMasks.at(imageName));
+                m_flashMasks.erase(imageName);
+                if (packIntoAtlas(str, flashImage)) {
+                    return m_regions[str];
+                }
+                m_textures[str].loadFromImage(flashImage);
+            }
+        }
+    }
+
+    auto const& texture = get(str);
+    return jt::TextureRegion { &texture,
+        jt::Recti { 0, 0, static_cast<int>(texture.getSize().x),
+            static_cast<int>(texture.getSize().y) } };
+}
+
+void jt::TextureManagerImpl::setAtlasEnabled(bool enabled) { m_atlasEnabled = enabled; }
+
+jt::TextureManagerStats jt::TextureManagerImpl::getStats() const
+{
+    jt::TextureManagerStats stats {};
+    stats.numberOfPages = m_pages.size();
+    stats.numberOfPackedImages = m_regions.size();
+    for (auto const& kvp : m_textures) {
+        if (kvp.first.ends_with(flashPostfix)) {
+            ++stats.numberOfFlashTextures;
+        } else {
+            ++stats.numberOfStandaloneImages;
+        }
+    }
+    for (auto const& page : m_pages) {
+        stats.usedPixels += page->packer.getUsedArea();
+        stats.totalPixels += static_cast<std::uint64_t>(page->packer.getWidth())
+            * static_cast<std::uint64_t>(page->packer.getHeight());
+    }
+    stats.numberOfTextureBinds = jt::TextureBindCounter::getNumberOfBindsInLastFrame();
+    stats.numberOfDraws = jt::TextureBindCounter::getNumberOfDrawsInLastFrame();
+    stats.numberOfDeferredFlashImages = m_flashMasks.size();
+    for (auto const& kvp : m_flashMasks) {
+        auto const& mask = kvp.second;
+        // a flash texture would use four bytes per pixel
+        stats.savedFlashTextureBytes += 4u * static_cast<std::uint64_t>(mask.getSizeInBytes());
+        stats.flashMaskBytes += mask.getSizeInBytes();
+    }
+    return stats;
+}
+
+bool jt::TextureManagerImpl::packIntoAtlas(std::string const& str, sf::Image const& image)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::packIntoAtlas");
+    auto const w = static_cast<int>(image.getSize().x);
+    auto const h = static_cast<int>(image.getSize().y);
+    auto const pageSize = static_cast<int>(std::min(atlasPageSize, sf::Texture::getMaximumSize()));
+    auto const slotWidth = w + atlasPadding;
+    auto const slotHeight = h + atlasPadding;
+    if (w > maxAtlasImageSize || h > maxAtlasImageSize || slotWidth > pageSize
+        || slotHeight > pageSize) {
+        return false;
+    }
+
+    AtlasPage* page { nullptr };
+    std::optional<jt::Recti> slot {};
+    for (auto const& p : m_pages) {
+        slot = p->packer.insert(slotWidth, slotHeight);
+        if (slot.has_value()) {
+            page = p.get();
+            break;
+        }
+    }
+    if (!slot.has_value()) {
+        m_pages.push_back(std::make_unique<AtlasPage>(static_cast<unsigned int>(pageSize)));
+        page = m_pages.back().get();
+        slot = page->packer.insert(slotWidth, slotHeight);
+    }
+
+    auto const x = slot->left;
+    auto const y = slot->top;
+    page->texture.update(image, static_cast<unsigned int>(x), static_cast<unsigned int>(y));
+    m_regions[str] = jt::TextureRegion { &page->texture, jt::Recti { x, y, w, h } };
+    return true;
+}
+
+void jt::TextureManagerImpl::prepare(std::string const& str)
+{
+    JT_PROFILE_ZONE("jt::TextureManagerImpl::prepare");
+    if (str.empty() || !isFileTexture(str)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+        if (m_prepared->images.contains(str) || m_prepared->uploaded.contains(str)) {
+            return;
+        }
+    }
+
+    // decode without holding the lock, so multiple files can be prepared in parallel
+    DecodedImage decoded {};
+    decoded.image = decodeFileImage(str);
+    decoded.flashMask = createFlashMask(decoded.image);
+
+    std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+    if (!m_prepared->uploaded.contains(str)) {
+        m_prepared->images.try_emplace(str, std::move(decoded));
+    }
+}
+
+jt::TextureManagerImpl::DecodedImage jt::TextureManagerImpl::takeDecodedImage(
+    std::string const& str)
+{
+    {
+        std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+        m_prepared->uploaded.insert(str);
+        auto node = m_prepared->images.extract(str);
+        if (!node.empty()) {
+            return std::move(node.mapped());
+        }
+    }
+
+    DecodedImage decoded {};
+    decoded.image = decodeFileImage(str);
+    decoded.flashMask = createFlashMask(decoded.image);
+    return decoded;
+}
+
+jt::TextureManagerImpl::DecodedImage jt::TextureManagerImpl::createDecodedImage(
+    std::string const& str)
+{
+    if (isFileTexture(str)) {
+        return takeDecodedImage(str);
+    }
+    DecodedImage decoded {};
+    decoded.image = createSpecialImage(str);
+    decoded.flashMask = createFlashMask(decoded.image);
+    return decoded;
+}
+
+void jt::TextureManagerImpl::reset()
+{
+    m_textures.clear();
+    m_regions.clear();
+    m_pages.clear();
+    m_flashMasks.clear();
+    m_names.clear();
+    m_handleEntries.clear();
+    std::lock_guard<std::mutex> const lock { m_prepared->mutex };
+    m_prepared->images.clear();
+    m_prepared->uploaded.clear();
+}
 
 std::string jt::TextureManagerImpl::getFlashName(std::string const& str)
 {
-    return str + "___flash__";
+    return str + std::string { flashPostfix };
 }
 
-std::size_t jt::TextureManagerImpl::getNumberOfTextures() noexcept { return m_textures.size(); }
+std::size_t jt::TextureManagerImpl::getNumberOfTextures() noexcept
+{
+    return m_textures.size() + m_pages.size();
+}
 
 bool jt::TextureManagerImpl::containsTexture(std::string const& str) const
 {
@@ -2,22 +2,82 @@
 #define JAMTEMPLATE_TEXTURE_MANAGER_IMPL_HPP
 
 #include <SFML/Graphics.hpp>
+#include <graphics/alpha_mask.hpp>
+#include <graphics/skyline_packer.hpp>
 #include <texture_manager_interface.hpp>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
 
 namespace jt {
 class TextureManagerImpl : public ::jt::TextureManagerInterface {
 public:
     explicit TextureManagerImpl(std::shared_ptr<jt::RenderTargetLayer> renderer);
     sf::Texture& get(std::string const& str) override;
+    jt::TextureRegion getRegion(std::string const& str) override;
+    jt::TextureHandle getHandle(std::string const& str) override;
+    jt::TextureRegion getRegion(jt::TextureHandle handle) override;
+    jt::TextureHandle getFlashHandle(jt::TextureHandle handle) override;
+    std::string getName(jt::TextureHandle handle) const override;
+    void setAtlasEnabled(bool enabled) override;
+    jt::TextureManagerStats getStats() const override;
+    void prepare(std::string const& str) override;
     void reset() override;
     std::string getFlashName(std::string const& str) override;
     std::size_t getNumberOfTextures() noexcept override;
 
 private:
+    struct DecodedImage {
+        sf::Image image {};
+        // the flash image is created from the mask when it is used for the first time
+        jt::AlphaMask flashMask {};
+    };
+
+    // images decoded by prepare(), shared with worker threads
+    struct PreparedImages {
+        std::mutex mutex {};
+        std::map<std::string, DecodedImage> images {};
+        // file textures that are already uploaded, so prepare() does not decode them again
+        std::set<std::string> uploaded {};
+    };
+
+    // state of a handle, indexed by the handle id
+    struct HandleEntry {
+        std::optional<jt::TextureRegion> region {};
+        jt::TextureHandle flash {};
+    };
+
+    struct AtlasPage {
+        explicit AtlasPage(unsigned int size);
+        sf::Texture texture {};
+        jt::SkylinePacker packer;
+    };
+
     std::map<std::string, sf::Texture> m_textures;
+    // in a unique_ptr to keep the texture manager movable
+    std::unique_ptr<PreparedImages> m_prepared { std::make_unique<PreparedImages>() };
+
+    jt::TextureNameTable m_names {};
+    std::vector<HandleEntry> m_handleEntries {};
+
+    bool m_atlasEnabled { false };
+    // pages are not moved when the vector grows, so regions can point to the page textures
+    std::vector<std::unique_ptr<AtlasPage>> m_pages {};
+    std::map<std::string, jt::TextureRegion> m_regions {};
+    // masks of images whose flash image was not requested yet
+    std::map<std::string, jt::AlphaMask> m_flashMasks {};
+
     bool containsTexture(std::string const& str) const;
+    jt::TextureRegion createRegion(std::string const& str);
+    DecodedImage takeDecodedImage(std::string const& str);
+    DecodedImage createDecodedImage(std::string const& str);
+    bool packIntoAtlas(std::string const& str, sf::Image const& image);
+    sf::Texture& createFlashTexture(std::string const& flashName);
+    sf::Texture& copyFromAtlas(std::string const& str, jt::TextureRegion const& region);
 };
 } // namespace jt
 
@@ -1,6 +1,9 @@
 #ifndef JAMTEMPLATE_TEXTURE_MANAGER_INTERFACE_HPP
 #define JAMTEMPLATE_TEXTURE_MANAGER_INTERFACE_HPP
 
+#include <graphics/texture_handle.hpp>
+#include <graphics/texture_manager_stats.hpp>
+#include <rect.hpp>
 #include <render_target_layer.hpp>
 #include <cstddef>
 #include <string>
@@ -10,13 +13,65 @@ class Texture;
 }
 
 namespace jt {
+
+/// Part of a texture. Images packed into an atlas page share the page texture.
+struct TextureRegion {
+    sf::Texture const* texture { nullptr };
+    jt::Recti rect {};
+};
+
 class TextureManagerInterface {
 public:
-    /// get texture for string
+    /// get texture for string. The texture always contains only this image. Images that are
+    /// already packed into an atlas page by getRegion() are copied out of the page instead of
+    /// being decoded again. Use getRegion() or getHandle() to draw from the atlas.
     /// \param str texture identifier
     /// \return reference to sf::Texture
     virtual sf::Texture& get(std::string const& str) = 0;
 
+    /// get texture region for string. If the atlas is enabled, the image and its flash image are
+    /// packed into a shared atlas page, otherwise the region covers the whole texture from get().
+    /// \param str texture identifier or flash name of a texture identifier
+    /// \return the texture region
+    virtual jt::TextureRegion getRegion(std::string const& str) = 0;
+
+    /// Resolve a texture identifier to a handle. The same identifier always resolves to the same
+    /// handle until reset() is called.
+    /// \param str texture identifier or flash name of a texture identifier
+    /// \return the handle
+    virtual jt::TextureHandle getHandle(std::string const& str) = 0;
+
+    /// get texture region for a handle. The region is stored per handle, so only the first call
+    /// for a handle does any string based lookup.
+    /// \param handle the handle, throws std::invalid_argument for unknown handles
+    /// \return the texture region
+    virtual jt::TextureRegion getRegion(jt::TextureHandle handle) = 0;
+
+    /// get handle of the flash version of a texture
+    /// \param handle the handle of the texture
+    /// \return the handle of the flash texture
+    virtual jt::TextureHandle getFlashHandle(jt::TextureHandle handle) = 0;
+
+    /// get the texture identifier a handle was resolved from
+    /// \param handle the handle
+    /// \return the texture identifier
+    virtual std::string getName(jt::TextureHandle handle) const = 0;
+
+    /// Enable or disable packing images into atlas pages in getRegion(). Only affects images that
+    /// are requested afterwards.
+    /// \param enabled true to enable the atlas, false otherwise
+    virtual void setAtlasEnabled(bool enabled) = 0;
+
+    /// get statistics about atlas occupancy and texture binds
+    /// \return the atlas statistics
+    virtual jt::TextureManagerStats getStats() const = 0;
+
+    /// Decode the image for a texture identifier without creating the texture. Thread safe, can be
+    /// called from worker threads so that a later get() only has to upload the decoded image.
+    /// Special identifiers starting with '#' are created in get() and ignored here.
+    /// \param str texture identifier
+    virtual void prepare(std::string const& str) = 0;
+
     /// reset the texture manager
     virtual void reset() = 0;
 
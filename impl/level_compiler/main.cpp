@@ -0,0 +1,17 @@
+#include <tilemap/compiled_map_writer.hpp>
+#include <iostream>
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        std::cerr << "usage: " << argv[0] << " <input.json> <output.jtmap>" << std::endl;
+        return 1;
+    }
+
+    auto const error = jt::tilemap::compileMapFile(argv[1], argv[2]);
+    if (!error.empty()) {
+        std::cerr << "jt_level_compiler: " << error << std::endl;
+        return 1;
+    }
+    return 0;
+}